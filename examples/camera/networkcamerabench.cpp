@@ -0,0 +1,200 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Serve a synthetic camera with NetworkCameraServer and read it back through
+ * NetworkCamera on the loopback device. For each transport and encoding the
+ * frame rate, bandwidth, capture to display latency and dropped frames are
+ * reported, and every received frame is checked against the source image.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <algorithm>
+#include <vector>
+
+#include <wcl/camera/NetworkCamera.h>
+#include <wcl/camera/NetworkCameraServer.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55601
+#define WIDTH 640
+#define HEIGHT 480
+#define SQUARE 64
+
+void usage()
+{
+    printf("Usage: networkcamerabench [seconds] [fps]\n"
+	   "\n"
+	   "Defaults to 2 seconds per test at 60 frames per second\n");
+}
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * Draw frame k, a gradient with a moving square. The frame number is
+ * stored in the first pixels so a receiver can regenerate the image.
+ */
+static void drawFrame(unsigned char *image, const uint32_t k)
+{
+    unsigned sx = (k * 4) % (WIDTH - SQUARE);
+    unsigned sy = (k * 2) % (HEIGHT - SQUARE);
+
+    for(unsigned y = 0; y < HEIGHT; y++ ){
+	for(unsigned x = 0; x < WIDTH; x++ ){
+	    unsigned char *p = image + (y * WIDTH + x) * 3;
+	    bool inside = x >= sx && x < sx + SQUARE && y >= sy && y < sy + SQUARE;
+	    p[0] = inside ? 255 : (x + y) & 0xff;
+	    p[1] = inside ? 0 : x & 0xff;
+	    p[2] = inside ? 0 : y & 0xff;
+	}
+    }
+    memcpy(image, &k, sizeof(k));
+}
+
+/**
+ * A camera producing the frames above at a fixed rate
+ */
+class SyntheticCamera: public Camera
+{
+    public:
+	SyntheticCamera( const float fps ): image(WIDTH * HEIGHT * 3), count(0), last(0)
+	{
+	    Configuration c;
+	    c.format = RGB8;
+	    c.width = WIDTH;
+	    c.height = HEIGHT;
+	    c.fps = fps;
+	    this->supportedConfigurations.push_back(c);
+	    Camera::setConfiguration(c);
+	    this->id = "synthetic";
+	}
+
+	void setConfiguration( const Configuration & ) {}
+	void setExposureMode( const ExposureMode ) {}
+	void setControlValue( const Control, const int ) {}
+	int getControlValue( const Control ) { return 0; }
+	void startup() {}
+	void shutdown() {}
+
+	void update()
+	{
+	    double wait = this->last + 1.0 / this->activeConfiguration.fps - now();
+	    if( wait > 0 )
+		usleep((useconds_t)(wait * 1000000));
+	    this->last = now();
+
+	    drawFrame(&this->image[0], this->count++);
+	    this->currentFrame = &this->image[0];
+	}
+
+    protected:
+	const char *getTypeIdentifier() const { return "SYNTHETIC"; }
+
+    private:
+	vector<unsigned char> image;
+	uint32_t count;
+	double last;
+};
+
+static void runTest( const char *name, const NetworkCameraServer::Transport transport,
+		     const bool compress, const bool deltas, const double seconds, const float fps )
+{
+    SyntheticCamera source(fps);
+    NetworkCameraServer server(&source, PORT, transport);
+    try {
+	if( compress )
+	    server.setCompression(NetworkCameraServer::MJPEG);
+    } catch( CameraException & ){
+	printf("%-16s MJPEG unavailable\n", name);
+	return;
+    }
+    server.setDeltaUpdates(deltas, 30);
+    server.start();
+
+    try {
+	NetworkCamera camera("127.0.0.1", PORT, transport);
+	vector<unsigned char> expected(WIDTH * HEIGHT * 3);
+	vector<double> latencies;
+	unsigned frames = 0, mismatches = 0;
+
+	double start = now();
+	uint64_t startBytes = server.getBytesSent();
+	while( now() - start < seconds ){
+	    camera.update();
+	    latencies.push_back(now() - camera.getFrameTimestamp() / 1000000.0);
+	    frames++;
+
+	    if( !compress ){
+		uint32_t k;
+		memcpy(&k, camera.getCurrentFrame(), sizeof(k));
+		drawFrame(&expected[0], k);
+		if( memcmp(&expected[0], camera.getCurrentFrame(), expected.size()) != 0 )
+		    mismatches++;
+	    }
+	}
+	double elapsed = now() - start;
+	uint64_t bytes = server.getBytesSent() - startBytes;
+
+	sort(latencies.begin(), latencies.end());
+	printf("%-16s %7.1f fps %8.2f MB/s  latency p50 %6.2f ms p99 %6.2f ms  dropped %u  bad %u\n",
+	       name, frames / elapsed, bytes / elapsed / 1e6,
+	       latencies[latencies.size() / 2] * 1000,
+	       latencies[latencies.size() * 99 / 100] * 1000,
+	       camera.getDroppedFrames(), mismatches);
+    } catch( CameraException &e ){
+	printf("%-16s failed: %s\n", name, e.what());
+    }
+
+    server.stop();
+}
+
+int main( int argc, char **argv )
+{
+    if( argc > 1 && argv[1][0] == '-' ){
+	usage();
+	return 1;
+    }
+    double seconds = argc > 1 ? atof(argv[1]) : 2;
+    float fps = argc > 2 ? atof(argv[2]) : 60;
+
+    runTest("tcp raw", NetworkCameraServer::TCP, false, false, seconds, fps);
+    runTest("tcp delta", NetworkCameraServer::TCP, false, true, seconds, fps);
+    runTest("tcp mjpeg", NetworkCameraServer::TCP, true, false, seconds, fps);
+    runTest("udp raw", NetworkCameraServer::UDP, false, false, seconds, fps);
+    runTest("udp delta", NetworkCameraServer::UDP, false, true, seconds, fps);
+    runTest("udp mjpeg", NetworkCameraServer::UDP, true, false, seconds, fps);
+    return 0;
+}
@@ -3,13 +3,38 @@
 
 
 #include <iostream>
-#include <unistd.h>
 
+#include <wcl/network/Reactor.h>
 #include <wcl/tracking/LazySusan.h>
 
 using namespace std;
 using namespace wcl;
 
+/**
+ * Prints the latest reading once a second
+ */
+class Reporter : public TimerHandler
+{
+	public:
+		Reporter(Reactor& reactor, LazySusan& susan) : reactor(reactor), susan(susan)
+		{
+			reactor.addTimer(1000, this);
+		}
+
+		void timerExpired(const unsigned long)
+		{
+			susan.update();
+			cout << susan.getObject("")->getOrientation().toString()
+			     << " " << susan.getRotationRate() << " deg/s, "
+			     << susan.getSampleRate() << " readings/s, "
+			     << susan.getLatency() * 1000 << "ms latency" << endl;
+			reactor.addTimer(1000, this);
+		}
+
+	private:
+		Reactor& reactor;
+		LazySusan& susan;
+};
 
 int main(int argc, char* argv[])
 {
@@ -21,16 +46,11 @@ int main(int argc, char* argv[])
 	}
 
 	cout << "Connecting to Lazy Susan... ";
-	LazySusan* ls = new LazySusan(argv[1]);
-	TrackedObject* to = ls->getObject("blah");
-	cout << to->getOrientation().toString() << endl;
+	Reactor reactor;
+	LazySusan ls(argv[1], reactor);
 	cout << "Done!" << endl;
 
-	while (true)
-	{
-		ls->update();
-		//cout << to->getOrientation().toString() << endl;
-		usleep(30000);
-	}
+	Reporter reporter(reactor, ls);
+	reactor.run();
 	return 0;
 }
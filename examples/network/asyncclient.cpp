@@ -0,0 +1,184 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Exercise AsyncTCPSocket and socket timeouts against servers on the
+ * loopback device: an echo round trip, a read from a silent server that
+ * times out, a cancelled read, a connect to a closed port and a blocking
+ * read with a timeout. Reports how long each took and whether it ended as
+ * expected.
+ */
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <wcl/network/AsyncTCPSocket.h>
+#include <wcl/network/TCPServer.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55557
+#define CLOSED_PORT 55558
+#define TIMEOUT 200
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static const char *statusName( const AsyncHandler::Status status )
+{
+    switch( status ){
+	case AsyncHandler::COMPLETE: return "COMPLETE";
+	case AsyncHandler::TIMEDOUT: return "TIMEDOUT";
+	case AsyncHandler::CANCELLED: return "CANCELLED";
+	case AsyncHandler::CLOSED: return "CLOSED";
+	case AsyncHandler::TOO_LONG: return "TOO_LONG";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * Echoes whatever it receives
+ */
+class EchoHandler: public TCPConnectionHandler
+{
+    public:
+	void dataReceived( TCPConnection *c )
+	{
+	    c->write(c->getReadData(), c->getReadSize());
+	    c->consume(c->getReadSize());
+	}
+};
+
+/**
+ * Remembers how the last operation ended
+ */
+class Result: public AsyncHandler
+{
+    public:
+	Result(): done(false), status(COMPLETE) {}
+
+	void connectComplete( AsyncTCPSocket *, const Status s )
+	{
+	    this->finish(s);
+	}
+
+	void readComplete( AsyncTCPSocket *, const Status s, const unsigned char *data, const size_t size )
+	{
+	    if( data )
+		this->data.assign((const char *)data, size);
+	    this->finish(s);
+	}
+
+	void finish( const Status s )
+	{
+	    this->status = s;
+	    this->done = true;
+	}
+
+	bool done;
+	Status status;
+	string data;
+};
+
+static unsigned failures = 0;
+
+/**
+ * Run the reactor until the operation ends and report it
+ */
+static void wait( Reactor &reactor, Result &result, const char *name,
+		  const AsyncHandler::Status expected )
+{
+    double start = now();
+    while( !result.done )
+	reactor.poll(1000);
+
+    bool ok = result.status == expected;
+    if( !ok )
+	failures++;
+    printf("%-24s %-10s %8.1fms %s\n", name, statusName(result.status),
+	   (now() - start) * 1000, ok ? "ok" : "UNEXPECTED");
+    result.done = false;
+}
+
+int main()
+{
+    Reactor reactor;
+    EchoHandler echo;
+    TCPServer server(PORT);
+    reactor.listen(server, &echo);
+
+    Result result;
+    AsyncTCPSocket socket(reactor, &result);
+
+    socket.connect("127.0.0.1", PORT, TIMEOUT);
+    wait(reactor, result, "connect", AsyncHandler::COMPLETE);
+
+    socket.write("hello\n", 6, TIMEOUT);
+    socket.readUntil("\n", TIMEOUT);
+    wait(reactor, result, "echo", AsyncHandler::COMPLETE);
+    if( result.data != "hello\n" ){
+	printf("echo returned the wrong data\n");
+	failures++;
+    }
+
+    // Nothing has been sent, so nothing will come back
+    socket.readUntil("\n", TIMEOUT);
+    wait(reactor, result, "read timeout", AsyncHandler::TIMEDOUT);
+
+    socket.read(1, -1);
+    socket.cancel();
+    wait(reactor, result, "cancel", AsyncHandler::CANCELLED);
+
+    socket.connect("127.0.0.1", CLOSED_PORT, TIMEOUT);
+    wait(reactor, result, "connect closed port", AsyncHandler::CLOSED);
+
+    // A blocking socket against a server that never answers. The kernel
+    // completes the connect without the server accepting it.
+    TCPServer silent(PORT + 2);
+    TCPSocket blocking("127.0.0.1", PORT + 2, false);
+    blocking.setTimeout(TIMEOUT);
+    blocking.connect(TIMEOUT);
+
+    double start = now();
+    bool timedOut = false;
+    try {
+	char c;
+	blocking.read(&c, 1);
+    }
+    catch( SocketException & ){
+	timedOut = true;
+    }
+    if( !timedOut )
+	failures++;
+    printf("%-24s %-10s %8.1fms %s\n", "blocking read timeout", timedOut ? "THROWN" : "RETURNED",
+	   (now() - start) * 1000, timedOut ? "ok" : "UNEXPECTED");
+
+    return failures ? 1 : 0;
+}
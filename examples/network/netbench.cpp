@@ -0,0 +1,589 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Measure the cost of the network classes on the loopback device. Each case
+ * runs for a fixed time against a server thread and reports one line of
+ * CSV, or JSON with -j, so runs can be compared to find regressions.
+ *
+ * tcp_rtt     Round trips through an echo server with TCPSocket, blocking
+ *             and non blocking, using readUntil/writeUntil or raw system
+ *             calls on the same descriptor
+ * tcp_stream  One way throughput into a server that discards the data
+ * udp_rtt     Round trips through an echo UDPServer
+ * udp_stream  Datagrams per second into a counting UDPServer, one write
+ *             per datagram against batched writes, with the loss
+ * mcast_rtt   Round trips through an echo UDPServer joined to a group
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <wcl/network/TCPServer.h>
+#include <wcl/network/UDPServer.h>
+#include <wcl/network/UDPPacketPool.h>
+#include <wcl/util/Thread.h>
+
+using namespace std;
+using namespace wcl;
+
+#define TCP_PORT 55560
+#define UDP_ECHO_PORT 55561
+#define UDP_SINK_PORT 55562
+#define MCAST_PORT 55563
+#define MCAST_GROUP "239.255.87.90"
+#define WARMUP 100
+#define BATCH 32
+
+void usage()
+{
+    printf("Usage: netbench [-j] [seconds]\n"
+	   "\n"
+	   "Runs every case for the given time, 0.5 seconds by default, and\n"
+	   "prints a CSV line per case, or a JSON object per line with -j\n");
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static void setNoDelay( const int fd )
+{
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+/**
+ * Send and receive the whole buffer with system calls, retrying while a
+ * non blocking descriptor has nothing to give
+ */
+static bool sendAll( const int fd, const char *data, size_t size )
+{
+    while( size > 0 ){
+	ssize_t amount = ::send(fd, data, size, MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR )
+		continue;
+	    return false;
+	}
+	data += amount;
+	size -= amount;
+    }
+    return true;
+}
+
+static bool recvAll( const int fd, char *data, size_t size )
+{
+    while( size > 0 ){
+	ssize_t amount = ::recv(fd, data, size, 0);
+	if( amount == 0 )
+	    return false;
+	if( amount == -1 ){
+	    if( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR )
+		continue;
+	    return false;
+	}
+	data += amount;
+	size -= amount;
+    }
+    return true;
+}
+
+/**
+ * Accepts connections one at a time. The first byte sent picks what the
+ * connection does: E echoes, S discards everything then replies with the
+ * amount received, Q stops the server.
+ */
+class TCPBenchServer: public Thread
+{
+    public:
+	TCPBenchServer(): server(TCP_PORT) {}
+
+	void run()
+	{
+	    vector<char> buffer(1 << 20);
+	    for(;;){
+		TCPSocket client;
+		if( !this->server.accept(&client))
+		    continue;
+		setNoDelay(*client);
+
+		char mode;
+		if( !recvAll(*client, &mode, 1))
+		    continue;
+		if( mode == 'Q' )
+		    return;
+
+		uint64_t total = 0;
+		for(;;){
+		    ssize_t amount = ::recv(*client, &buffer[0], buffer.size(), 0);
+		    if( amount <= 0 )
+			break;
+		    total += amount;
+		    if( mode == 'E' && !sendAll(*client, &buffer[0], amount))
+			break;
+		}
+		if( mode == 'S' )
+		    sendAll(*client, (const char *)&total, sizeof(total));
+		client.close();
+	    }
+	}
+
+    private:
+	TCPServer server;
+};
+
+/**
+ * Echoes datagrams back to their sender, or when counting, counts
+ * datagrams tagged with the current run and answers a zero length
+ * datagram with the count.
+ */
+class UDPBenchServer: public Thread
+{
+    public:
+	UDPBenchServer( const unsigned port, const bool icounting, const string &group = "" ):
+	    server(port, group), counting(icounting), running(true), current(0), count(0)
+	{
+	    this->server.setTimeout(100);
+	}
+
+	void stop()
+	{
+	    this->running = false;
+	    this->join();
+	}
+
+	void run()
+	{
+	    UDPPacketPool pool(BATCH, 65536);
+	    vector<UDPPacket *> packets(BATCH);
+	    pool.acquire(&packets[0], BATCH);
+
+	    while( this->running ){
+		unsigned received;
+		try {
+		    received = this->server.read(&packets[0], BATCH);
+		}
+		catch( SocketException & ){
+		    continue;
+		}
+
+		for(unsigned i = 0; i < received; i++ ){
+		    UDPPacket *p = packets[i];
+		    if( !this->counting ){
+			this->server.write(p);
+			continue;
+		    }
+
+		    uint32_t tag;
+		    if( p->getLength() == sizeof(tag)){
+			// A request for the count of a run, the next run
+			// starts counting from zero
+			memcpy(&tag, p->getData(), sizeof(tag));
+			uint64_t reply = tag == this->current ? this->count : 0;
+			memcpy(p->getData(), &reply, sizeof(reply));
+			p->setLength(sizeof(reply));
+			this->server.write(p);
+			this->current = tag + 1;
+			this->count = 0;
+		    }
+		    else if( p->getLength() > sizeof(tag)){
+			memcpy(&tag, p->getData(), sizeof(tag));
+			if( tag == this->current )
+			    this->count++;
+		    }
+		}
+	    }
+	    pool.release(&packets[0], BATCH);
+	}
+
+    private:
+	UDPServer server;
+	bool counting;
+	volatile bool running;
+	uint32_t current;
+	uint64_t count;
+};
+
+/**
+ * The outcome of one case
+ */
+struct Result
+{
+    Result(): size(0), count(0), lost(0), seconds(0) {}
+
+    string test;
+    string mode;
+    string api;
+    size_t size;
+    unsigned long count;  // Messages, round trips or datagrams
+    unsigned long lost;
+    double seconds;
+    vector<double> latencies; // Round trip times in microseconds
+};
+
+static bool json = false;
+
+static double percentile( const vector<double> &sorted, const double p )
+{
+    if( sorted.empty())
+	return 0;
+    size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+static void report( Result &r )
+{
+    sort(r.latencies.begin(), r.latencies.end());
+    double rate = r.count / r.seconds;
+    double mbps = rate * r.size / (1024 * 1024);
+
+    char latency[256] = "";
+    if( !r.latencies.empty()){
+	double mean = 0;
+	for(size_t i = 0; i < r.latencies.size(); i++ )
+	    mean += r.latencies[i];
+	mean /= r.latencies.size();
+
+	const char *format = json ?
+	    ", \"mean_us\": %.2f, \"p50_us\": %.2f, \"p90_us\": %.2f, \"p99_us\": %.2f, "
+	    "\"p999_us\": %.2f, \"max_us\": %.2f" :
+	    "%.2f,%.2f,%.2f,%.2f,%.2f,%.2f";
+	snprintf(latency, sizeof(latency), format, mean,
+		 percentile(r.latencies, 0.5), percentile(r.latencies, 0.9),
+		 percentile(r.latencies, 0.99), percentile(r.latencies, 0.999),
+		 r.latencies.back());
+    }
+    else if( !json )
+	strcpy(latency, ",,,,,");
+
+    if( json )
+	printf("{\"test\": \"%s\", \"mode\": \"%s\", \"api\": \"%s\", \"size\": %lu, "
+	       "\"count\": %lu, \"seconds\": %.3f, \"per_second\": %.1f, \"mb_per_second\": %.2f, "
+	       "\"lost\": %lu%s}\n",
+	       r.test.c_str(), r.mode.c_str(), r.api.c_str(), (unsigned long)r.size,
+	       r.count, r.seconds, rate, mbps, r.lost, latency);
+    else
+	printf("%s,%s,%s,%lu,%lu,%.3f,%.1f,%.2f,%lu,%s\n",
+	       r.test.c_str(), r.mode.c_str(), r.api.c_str(), (unsigned long)r.size,
+	       r.count, r.seconds, rate, mbps, r.lost, latency);
+    fflush(stdout);
+}
+
+static TCPSocket *connectTCP( const char mode )
+{
+    TCPSocket *s = new TCPSocket("127.0.0.1", TCP_PORT);
+    setNoDelay(**s);
+    s->writeUntil((void *)&mode, 1);
+    return s;
+}
+
+static void tcpRTT( const size_t size, const Socket::BlockingMode mode,
+		    const bool raw, const double seconds )
+{
+    TCPSocket *s = connectTCP('E');
+    s->setBlockingMode(mode);
+    vector<char> buffer(size, 'x');
+
+    Result r;
+    r.test = "tcp_rtt";
+    r.mode = mode == Socket::BLOCKING ? "blocking" : "nonblocking";
+    r.api = raw ? "syscall" : "wcl";
+    r.size = size;
+    r.latencies.reserve(1 << 20);
+
+    double start = 0;
+    double end = 0;
+    for(unsigned long i = 0;; i++ ){
+	if( i == WARMUP ){
+	    start = now();
+	    end = start + seconds;
+	}
+	double sent = now();
+	if( i >= WARMUP && sent >= end )
+	    break;
+
+	if( raw ){
+	    if( !sendAll(**s, &buffer[0], size) || !recvAll(**s, &buffer[0], size))
+		break;
+	}
+	else {
+	    s->writeUntil(&buffer[0], size);
+	    s->readUntil(&buffer[0], size);
+	}
+
+	if( i >= WARMUP ){
+	    r.latencies.push_back((now() - sent) * 1000000);
+	    r.count++;
+	}
+    }
+    r.seconds = now() - start;
+
+    s->close();
+    delete s;
+    report(r);
+}
+
+static void tcpStream( const size_t size, const bool raw, const double seconds )
+{
+    TCPSocket *s = connectTCP('S');
+    vector<char> buffer(size, 'x');
+
+    Result r;
+    r.test = "tcp_stream";
+    r.mode = "blocking";
+    r.api = raw ? "syscall" : "wcl";
+    r.size = size;
+
+    double start = now();
+    while( now() - start < seconds ){
+	for(unsigned i = 0; i < 16; i++ ){
+	    if( raw )
+		sendAll(**s, &buffer[0], size);
+	    else
+		s->writeUntil(&buffer[0], size);
+	}
+	r.count += 16;
+    }
+
+    // The server replies with what it received once it sees the end
+    shutdown(**s, SHUT_WR);
+    uint64_t total = 0;
+    s->readUntil(&total, sizeof(total));
+    r.seconds = now() - start;
+    if( total != (uint64_t)r.count * size )
+	r.lost = r.count - total / size;
+
+    s->close();
+    delete s;
+    report(r);
+}
+
+static void udpRTT( const string &test, const string &host, const unsigned port,
+		    const size_t size, const Socket::BlockingMode mode,
+		    const bool raw, const double seconds )
+{
+    UDPSocket s(host, port);
+    s.setTimeout(1000);
+    s.setBlockingMode(mode);
+    sockaddr_in address = Socket::resolve(host.c_str(), port);
+    UDPPacket packet(size);
+    UDPPacket *p = &packet;
+    memset(packet.getData(), 'x', size);
+
+    Result r;
+    r.test = test;
+    r.mode = mode == Socket::BLOCKING ? "blocking" : "nonblocking";
+    r.api = raw ? "syscall" : "wcl";
+    r.size = size;
+    r.latencies.reserve(1 << 20);
+
+    double start = 0;
+    double end = 0;
+    for(unsigned long i = 0;; i++ ){
+	if( i == WARMUP ){
+	    start = now();
+	    end = start + seconds;
+	}
+	double sent = now();
+	if( i >= WARMUP && sent >= end )
+	    break;
+
+	bool received = true;
+	if( raw ){
+	    ::sendto(*s, packet.getData(), size, 0, (sockaddr *)&address, sizeof(address));
+	    for(;;){
+		if( ::recv(*s, packet.getData(), size, 0) >= 0 )
+		    break;
+		if( errno == EAGAIN && mode == Socket::NONBLOCKING && now() - sent < 1 )
+		    continue;
+		received = false;
+		break;
+	    }
+	}
+	else {
+	    packet.setLength(size);
+	    s.write(&packet);
+	    if( mode == Socket::BLOCKING ){
+		try {
+		    s.read(&packet);
+		}
+		catch( SocketException & ){
+		    received = false;
+		}
+	    }
+	    else {
+		while( s.read(&p, 1, false) == 0 ){
+		    if( now() - sent >= 1 ){
+			received = false;
+			break;
+		    }
+		}
+	    }
+	}
+
+	if( i < WARMUP )
+	    continue;
+	if( received ){
+	    r.latencies.push_back((now() - sent) * 1000000);
+	    r.count++;
+	}
+	else
+	    r.lost++;
+    }
+    r.seconds = now() - start;
+    report(r);
+}
+
+static void udpStream( const size_t size, const bool batched, const double seconds )
+{
+    static uint32_t run = 0;
+    UDPSocket s("127.0.0.1", UDP_SINK_PORT);
+    UDPPacketPool pool(BATCH, size);
+    vector<UDPPacket *> packets(BATCH);
+    pool.acquire(&packets[0], BATCH);
+    for(unsigned i = 0; i < BATCH; i++ )
+	memcpy(packets[i]->getData(), &run, sizeof(run));
+
+    Result r;
+    r.test = "udp_stream";
+    r.mode = "blocking";
+    r.api = batched ? "batched" : "wcl";
+    r.size = size;
+
+    unsigned long sent = 0;
+    double start = now();
+    while( now() - start < seconds ){
+	if( batched )
+	    sent += s.write(&packets[0], (unsigned)BATCH);
+	else {
+	    for(unsigned i = 0; i < BATCH; i++ )
+		s.write(packets[i]);
+	    sent += BATCH;
+	}
+    }
+    r.seconds = now() - start;
+
+    // Ask for the count until the request gets through
+    s.setTimeout(100);
+    uint64_t count = 0;
+    for(unsigned attempt = 0; attempt < 20; attempt++ ){
+	uint32_t request = run;
+	s.write(&request, sizeof(request));
+	try {
+	    if( s.read(&count, sizeof(count)) == sizeof(count))
+		break;
+	}
+	catch( SocketException & ){}
+    }
+    run++;
+
+    r.count = count;
+    r.lost = sent - count;
+    pool.release(&packets[0], BATCH);
+    report(r);
+}
+
+int main( int argc, char *argv[] )
+{
+    double seconds = 0.5;
+    int arg = 1;
+
+    if( arg < argc && strcmp(argv[arg], "-j") == 0 ){
+	json = true;
+	arg++;
+    }
+    if( arg < argc && argv[arg][0] == '-' ){
+	usage();
+	return 1;
+    }
+    if( arg < argc )
+	seconds = atof(argv[arg]);
+
+    if( !json )
+	printf("test,mode,api,size,count,seconds,per_second,mb_per_second,lost,"
+	       "mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n");
+
+    try {
+	TCPBenchServer tcpServer;
+	UDPBenchServer udpEcho(UDP_ECHO_PORT, false);
+	UDPBenchServer udpSink(UDP_SINK_PORT, true);
+	UDPBenchServer mcastEcho(MCAST_PORT, false, MCAST_GROUP);
+	tcpServer.start();
+	udpEcho.start();
+	udpSink.start();
+	mcastEcho.start();
+
+	const size_t tcpSizes[] = { 16, 256, 4096, 65536 };
+	const size_t udpSizes[] = { 16, 256, 1400, 8192 };
+	const Socket::BlockingMode modes[] = { Socket::BLOCKING, Socket::NONBLOCKING };
+
+	for(unsigned size = 0; size < 4; size++ )
+	    for(unsigned mode = 0; mode < 2; mode++ )
+		for(unsigned raw = 0; raw < 2; raw++ )
+		    tcpRTT(tcpSizes[size], modes[mode], raw, seconds);
+
+	for(unsigned size = 1; size < 4; size++ )
+	    for(unsigned raw = 0; raw < 2; raw++ )
+		tcpStream(tcpSizes[size], raw, seconds);
+
+	for(unsigned size = 0; size < 4; size++ )
+	    for(unsigned mode = 0; mode < 2; mode++ )
+		for(unsigned raw = 0; raw < 2; raw++ )
+		    udpRTT("udp_rtt", "127.0.0.1", UDP_ECHO_PORT, udpSizes[size],
+			   modes[mode], raw, seconds);
+
+	for(unsigned size = 0; size < 3; size++ )
+	    for(unsigned batched = 0; batched < 2; batched++ )
+		udpStream(udpSizes[size], batched, seconds);
+
+	for(unsigned size = 0; size < 3; size++ )
+	    udpRTT("mcast_rtt", MCAST_GROUP, MCAST_PORT, udpSizes[size],
+		   Socket::BLOCKING, false, seconds);
+
+	delete connectTCP('Q');
+	tcpServer.join();
+	udpEcho.stop();
+	udpSink.stop();
+	mcastEcho.stop();
+    } catch( SocketException &e ){
+	fprintf(stderr, "netbench: %s\n", e.what());
+	return 1;
+    }
+
+    return 0;
+}
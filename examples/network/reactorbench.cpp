@@ -0,0 +1,209 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Measure how the Reactor copes with many clients on the loopback device.
+ * For each number of clients the connection rate is measured, then every
+ * client ping pongs a small message with an echo server for a fixed time.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <vector>
+
+#include <wcl/network/Reactor.h>
+#include <wcl/util/Thread.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55556
+#define MESSAGE_SIZE 64
+
+void usage()
+{
+    printf("Usage: reactorbench [seconds] [clients...]\n"
+	   "\n"
+	   "Runs an echo server and the given numbers of clients in two reactors\n"
+	   "and reports connections/s and round trips/s.\n"
+	   "Defaults to 2 seconds for 1, 100 and 1000 clients\n");
+}
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * Echo everything received back to the client
+ */
+class EchoHandler: public TCPConnectionHandler
+{
+    public:
+	void dataReceived( TCPConnection *c )
+	{
+	    c->write(c->getReadData(), c->getReadSize());
+	    c->consume(c->getReadSize());
+	}
+};
+
+class ServerThread: public Thread
+{
+    public:
+	ServerThread( Reactor &r ): reactor(r) {}
+	void run() { this->reactor.run(); }
+
+    private:
+	Reactor &reactor;
+};
+
+/**
+ * Send the next message each time the previous one has come back
+ */
+class PingHandler: public TCPConnectionHandler
+{
+    public:
+	PingHandler(): roundTrips(0), disconnects(0)
+	{
+	    for(unsigned i = 0; i < MESSAGE_SIZE; i++ )
+		this->message[i] = (unsigned char)i;
+	}
+
+	void dataReceived( TCPConnection *c )
+	{
+	    while( c->getReadSize() >= MESSAGE_SIZE ){
+		c->consume(MESSAGE_SIZE);
+		this->roundTrips++;
+		c->write(this->message, MESSAGE_SIZE);
+	    }
+	}
+
+	void disconnected( TCPConnection * )
+	{
+	    this->disconnects++;
+	}
+
+	unsigned char message[MESSAGE_SIZE];
+	unsigned long roundTrips;
+	unsigned disconnects;
+};
+
+static void raiseFileLimit( unsigned needed )
+{
+    struct rlimit limit;
+    if( getrlimit(RLIMIT_NOFILE, &limit) != 0 )
+	return;
+    if( limit.rlim_cur < needed ){
+	limit.rlim_cur = needed < limit.rlim_max ? needed : limit.rlim_max;
+	setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+static void bench( unsigned clients, double seconds )
+{
+    Reactor client;
+    PingHandler handler;
+
+    // Connect one at a time, the server accepts in the background
+    double start = now();
+    vector<TCPConnection *> connections;
+    try {
+	for(unsigned i = 0; i < clients; i++ )
+	    connections.push_back(client.connect("127.0.0.1", PORT, &handler));
+    } catch( SocketException &e ){
+	printf("%6u clients: connect failed after %u: %s\n", clients,
+	       (unsigned)connections.size(), e.what());
+	return;
+    }
+    double connectTime = now() - start;
+
+    for(unsigned i = 0; i < connections.size(); i++ )
+	connections[i]->write(handler.message, MESSAGE_SIZE);
+
+    start = now();
+    double elapsed = 0;
+    while( elapsed < seconds ){
+	client.poll(100);
+	elapsed = now() - start;
+    }
+    unsigned long trips = handler.roundTrips;
+
+    printf("%6u clients: %10.0f connections/s %12.0f round trips/s %8.1f us/round trip per client\n",
+	   clients, clients / connectTime, trips / elapsed,
+	   trips ? elapsed * 1000000.0 * clients / trips : 0.0);
+    if( handler.disconnects )
+	printf("%6u clients: %u connections dropped\n", clients, handler.disconnects);
+}
+
+int main( int argc, char *argv[] )
+{
+    double seconds = 2.0;
+    vector<unsigned> clients;
+
+    if( argc > 1 ){
+	if( argv[1][0] == '-' ){
+	    usage();
+	    return 1;
+	}
+	seconds = atof(argv[1]);
+    }
+    for(int i = 2; i < argc; i++ )
+	clients.push_back(atoi(argv[i]));
+    if( clients.empty()){
+	clients.push_back(1);
+	clients.push_back(100);
+	clients.push_back(1000);
+    }
+
+    unsigned most = 0;
+    for(unsigned i = 0; i < clients.size(); i++ )
+	most = clients[i] > most ? clients[i] : most;
+    raiseFileLimit(most * 2 + 64);
+
+    try {
+	Reactor server;
+	TCPServer listener(PORT, 1024);
+	EchoHandler echo;
+	server.listen(listener, &echo);
+
+	ServerThread thread(server);
+	thread.start();
+
+	for(unsigned i = 0; i < clients.size(); i++ )
+	    bench(clients[i], seconds);
+
+	server.stop();
+	thread.join();
+    } catch( SocketException &e ){
+	printf("reactorbench: %s\n", e.what());
+	return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,485 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Compare the shared memory ring against TCP on the loopback device for
+ * passing tracker snapshots and camera frames between threads. Output has
+ * the same columns as netbench, CSV or JSON with -j.
+ *
+ * rtt      Round trips of a message through an echo thread, over two
+ *          rings or one TCP connection
+ * stream   Messages per second to a reader that looks at every message it
+ *          gets, the ring reader skips to the newest message when it falls
+ *          behind and counts the skipped ones as lost
+ * tracker  SharedMemoryTrackerPublisher::publish followed by
+ *          SharedMemoryTracker::update for a tracker of 20 objects
+ */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <wcl/network/TCPServer.h>
+#include <wcl/network/TCPSocket.h>
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/SharedMemoryTracker.h>
+#include <wcl/tracking/SharedMemoryTrackerPublisher.h>
+#include <wcl/util/SharedMemoryRing.h>
+#include <wcl/util/Thread.h>
+
+using namespace std;
+using namespace wcl;
+
+#define TCP_PORT 55564
+#define PING_RING "wcl-shmbench-ping"
+#define PONG_RING "wcl-shmbench-pong"
+#define STREAM_RING "wcl-shmbench-stream"
+#define TRACKER_RING "wcl-shmbench-tracker"
+#define SLOTS 4
+#define WARMUP 100
+
+void usage()
+{
+    printf("Usage: shmbench [-j] [seconds]\n"
+	   "\n"
+	   "Runs every case for the given time, 0.5 seconds by default, and\n"
+	   "prints a CSV line per case, or a JSON object per line with -j\n");
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static bool sendAll( const int fd, const char *data, size_t size )
+{
+    while( size > 0 ){
+	ssize_t amount = ::send(fd, data, size, MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    return false;
+	}
+	data += amount;
+	size -= amount;
+    }
+    return true;
+}
+
+static bool recvAll( const int fd, char *data, size_t size )
+{
+    while( size > 0 ){
+	ssize_t amount = ::recv(fd, data, size, 0);
+	if( amount == 0 )
+	    return false;
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    return false;
+	}
+	data += amount;
+	size -= amount;
+    }
+    return true;
+}
+
+/**
+ * The outcome of one case
+ */
+struct Result
+{
+    Result(): size(0), count(0), lost(0), seconds(0) {}
+
+    string test;
+    string mode;
+    string api;
+    size_t size;
+    unsigned long count;
+    unsigned long lost;
+    double seconds;
+    vector<double> latencies; // In microseconds
+};
+
+static bool json = false;
+
+static double percentile( const vector<double> &sorted, const double p )
+{
+    if( sorted.empty())
+	return 0;
+    size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+static void report( Result &r )
+{
+    sort(r.latencies.begin(), r.latencies.end());
+    double rate = r.count / r.seconds;
+    double mbps = rate * r.size / (1024 * 1024);
+
+    char latency[256] = "";
+    if( !r.latencies.empty()){
+	double mean = 0;
+	for(size_t i = 0; i < r.latencies.size(); i++ )
+	    mean += r.latencies[i];
+	mean /= r.latencies.size();
+
+	const char *format = json ?
+	    ", \"mean_us\": %.2f, \"p50_us\": %.2f, \"p90_us\": %.2f, \"p99_us\": %.2f, "
+	    "\"p999_us\": %.2f, \"max_us\": %.2f" :
+	    "%.2f,%.2f,%.2f,%.2f,%.2f,%.2f";
+	snprintf(latency, sizeof(latency), format, mean,
+		 percentile(r.latencies, 0.5), percentile(r.latencies, 0.9),
+		 percentile(r.latencies, 0.99), percentile(r.latencies, 0.999),
+		 r.latencies.back());
+    }
+    else if( !json )
+	strcpy(latency, ",,,,,");
+
+    if( json )
+	printf("{\"test\": \"%s\", \"mode\": \"%s\", \"api\": \"%s\", \"size\": %lu, "
+	       "\"count\": %lu, \"seconds\": %.3f, \"per_second\": %.1f, \"mb_per_second\": %.2f, "
+	       "\"lost\": %lu%s}\n",
+	       r.test.c_str(), r.mode.c_str(), r.api.c_str(), (unsigned long)r.size,
+	       r.count, r.seconds, rate, mbps, r.lost, latency);
+    else
+	printf("%s,%s,%s,%lu,%lu,%.3f,%.1f,%.2f,%lu,%s\n",
+	       r.test.c_str(), r.mode.c_str(), r.api.c_str(), (unsigned long)r.size,
+	       r.count, r.seconds, rate, mbps, r.lost, latency);
+    fflush(stdout);
+}
+
+/**
+ * The far end of a case, either echoing every message back or reading
+ * messages and touching every cache line of them until told to stop
+ */
+class Peer: public Thread
+{
+    public:
+	Peer( const bool iecho, const bool ishm, const size_t isize ):
+	    received(0), lost(0), ready(false), echo(iecho), shm(ishm), size(isize)
+	{
+	}
+
+	void run()
+	{
+	    if( this->shm )
+		this->runRing();
+	    else
+		this->runTCP();
+	}
+
+	volatile unsigned long received;
+	volatile unsigned long lost;
+	volatile bool ready;
+
+    private:
+	bool echo;
+	bool shm;
+	size_t size;
+
+	static unsigned touch( const unsigned char *data, const size_t size )
+	{
+	    unsigned sum = 0;
+	    for(size_t i = 0; i < size; i += 64 )
+		sum += data[i];
+	    return sum;
+	}
+
+	void runRing()
+	{
+	    SharedMemoryRing in(this->echo ? PING_RING : STREAM_RING);
+	    SharedMemoryRing *out = NULL;
+	    if( this->echo )
+		out = new SharedMemoryRing(PONG_RING, SLOTS, this->size);
+	    this->ready = true;
+
+	    volatile unsigned sum = 0;
+	    uint64_t sequence = 0;
+	    while( in.wait(sequence, -1)){
+		uint64_t latest;
+		size_t length;
+		const unsigned char *data = in.read(latest, length);
+		if( length == 0 )
+		    break;
+
+		if( out ){
+		    memcpy(out->beginWrite(), data, length);
+		    out->endWrite(length);
+		} else {
+		    sum += touch(data, length);
+		    if( sequence > 0 && latest > sequence + 1 )
+			this->lost += latest - sequence - 1;
+		}
+		sequence = latest;
+		this->received++;
+	    }
+	    delete out;
+	}
+
+	void runTCP()
+	{
+	    TCPServer server(TCP_PORT);
+	    this->ready = true;
+	    TCPSocket client;
+	    while( !server.accept(&client))
+		;
+
+	    int on = 1;
+	    setsockopt(*client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	    vector<char> buffer(this->size);
+	    volatile unsigned sum = 0;
+	    while( recvAll(*client, &buffer[0], this->size)){
+		if( this->echo && !sendAll(*client, &buffer[0], this->size))
+		    break;
+		if( !this->echo )
+		    sum += touch((const unsigned char *)&buffer[0], this->size);
+		this->received++;
+	    }
+	    client.close();
+	}
+};
+
+static void waitReady( Peer &peer )
+{
+    while( !peer.ready ){
+	struct timespec ts = { 0, 1000000 };
+	nanosleep(&ts, NULL);
+    }
+}
+
+static TCPSocket *connectTCP()
+{
+    TCPSocket *s = new TCPSocket("127.0.0.1", TCP_PORT);
+    int on = 1;
+    setsockopt(**s, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return s;
+}
+
+static void rtt( const size_t size, const bool shm, const string &mode, const double seconds )
+{
+    vector<char> buffer(size, 'x');
+    SharedMemoryRing *ping = NULL;
+    SharedMemoryRing *pong = NULL;
+    TCPSocket *s = NULL;
+
+    if( shm )
+	ping = new SharedMemoryRing(PING_RING, SLOTS, size);
+    Peer peer(true, shm, size);
+    peer.start();
+    waitReady(peer);
+    if( shm )
+	pong = new SharedMemoryRing(PONG_RING);
+    else
+	s = connectTCP();
+
+    Result r;
+    r.test = "rtt";
+    r.mode = mode;
+    r.api = shm ? "shm" : "tcp";
+    r.size = size;
+    r.latencies.reserve(1 << 20);
+
+    double start = 0;
+    double end = 0;
+    uint64_t sequence = 0;
+    for(unsigned long i = 0;; i++ ){
+	if( i == WARMUP ){
+	    start = now();
+	    end = start + seconds;
+	}
+	double sent = now();
+	if( i >= WARMUP && sent >= end )
+	    break;
+
+	if( shm ){
+	    ping->write(&buffer[0], size);
+	    size_t length;
+	    pong->wait(sequence, -1);
+	    pong->read(sequence, length);
+	} else if( !sendAll(**s, &buffer[0], size) || !recvAll(**s, &buffer[0], size))
+	    break;
+
+	if( i >= WARMUP ){
+	    r.latencies.push_back((now() - sent) * 1000000);
+	    r.count++;
+	}
+    }
+    r.seconds = now() - start;
+
+    if( shm ){
+	// An empty message stops the echo
+	ping->write(&buffer[0], 0);
+	peer.join();
+	delete pong;
+	delete ping;
+    } else {
+	s->close();
+	peer.join();
+	delete s;
+    }
+    report(r);
+}
+
+static void stream( const size_t size, const bool shm, const string &mode, const double seconds )
+{
+    vector<char> buffer(size, 'x');
+    SharedMemoryRing *ring = NULL;
+    TCPSocket *s = NULL;
+
+    if( shm )
+	ring = new SharedMemoryRing(STREAM_RING, SLOTS, size);
+    Peer peer(false, shm, size);
+    peer.start();
+    waitReady(peer);
+    if( !shm )
+	s = connectTCP();
+
+    Result r;
+    r.test = "stream";
+    r.mode = mode;
+    r.api = shm ? "shm" : "tcp";
+    r.size = size;
+
+    unsigned long sent = 0;
+    double start = now();
+    double end = start + seconds;
+    while( now() < end ){
+	if( shm )
+	    ring->write(&buffer[0], size);
+	else if( !sendAll(**s, &buffer[0], size))
+	    break;
+	sent++;
+    }
+
+    if( shm ){
+	ring->write(&buffer[0], 0);
+	peer.join();
+	delete ring;
+    } else {
+	s->close();
+	peer.join();
+	delete s;
+    }
+    r.seconds = now() - start;
+    r.count = peer.received;
+    r.lost = shm ? peer.lost : sent - peer.received;
+    report(r);
+}
+
+static void tracker( const double seconds )
+{
+    DummyTracker dummy;
+    for(unsigned i = 0; i < 20; i++ ){
+	stringstream ss;
+	ss << "object" << i;
+	Vector position(3);
+	position[0] = i;
+	dummy.addTrackedObject(new DummyTrackedObject(ss.str(), position));
+    }
+
+    SharedMemoryTrackerPublisher publisher(&dummy, TRACKER_RING);
+    SharedMemoryTracker follower(TRACKER_RING);
+
+    Result r;
+    r.test = "tracker";
+    r.mode = "20_objects";
+    r.api = "shm";
+    r.latencies.reserve(1 << 20);
+
+    double start = 0;
+    double end = 0;
+    for(unsigned long i = 0;; i++ ){
+	if( i == WARMUP ){
+	    start = now();
+	    end = start + seconds;
+	}
+	double sent = now();
+	if( i >= WARMUP && sent >= end )
+	    break;
+
+	publisher.publish();
+	follower.update();
+
+	if( i >= WARMUP ){
+	    r.latencies.push_back((now() - sent) * 1000000);
+	    r.count++;
+	}
+    }
+    r.seconds = now() - start;
+    report(r);
+}
+
+int main( int argc, char *argv[] )
+{
+    double seconds = 0.5;
+    int arg = 1;
+
+    if( arg < argc && strcmp(argv[arg], "-j") == 0 ){
+	json = true;
+	arg++;
+    }
+    if( arg < argc && argv[arg][0] == '-' ){
+	usage();
+	return 1;
+    }
+    if( arg < argc )
+	seconds = atof(argv[arg]);
+
+    if( !json )
+	printf("test,mode,api,size,count,seconds,per_second,mb_per_second,lost,"
+	       "mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n");
+
+    // A small message, a tracker snapshot of 20 objects and a VGA RGB frame
+    const size_t sizes[] = { 64, 1024, 640 * 480 * 3 };
+    const char *modes[] = { "small", "snapshot", "frame" };
+
+    try {
+	for(unsigned size = 0; size < 3; size++ )
+	    for(unsigned shm = 0; shm < 2; shm++ )
+		rtt(sizes[size], shm, modes[size], seconds);
+
+	for(unsigned size = 0; size < 3; size++ )
+	    for(unsigned shm = 0; shm < 2; shm++ )
+		stream(sizes[size], shm, modes[size], seconds);
+
+	tracker(seconds);
+    } catch( Exception &e ){
+	fprintf(stderr, "shmbench: %s\n", e.what());
+	return 1;
+    }
+
+    return 0;
+}
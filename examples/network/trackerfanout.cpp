@@ -0,0 +1,143 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Publish a tracker with TrackerPublisher and follow it with several
+ * MulticastTrackers on the loopback device, reporting the publish to
+ * receive latency and the updates lost by each subscriber.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sstream>
+#include <sys/time.h>
+#include <algorithm>
+#include <vector>
+
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/MulticastTracker.h>
+#include <wcl/tracking/TrackerPublisher.h>
+#include <wcl/util/Thread.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55700
+#define GROUP "239.255.87.85"
+
+void usage()
+{
+    printf("Usage: trackerfanout [seconds] [subscribers] [objects] [rate]\n"
+	   "\n"
+	   "Defaults to 2 seconds, 4 subscribers, 20 objects at 1000 updates/s\n");
+}
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+class SubscriberThread: public Thread
+{
+    public:
+	SubscriberThread( const double iend ): tracker(GROUP, PORT), end(iend), updates(0)
+	{
+	    this->tracker.setTimeout(100);
+	}
+
+	void run()
+	{
+	    uint32_t last = 0;
+	    while( now() < this->end ){
+		this->tracker.update();
+		if( this->tracker.getSequence() != last ){
+		    last = this->tracker.getSequence();
+		    this->latencies.push_back(now() - this->tracker.getTimestamp() / 1000000.0);
+		    this->updates++;
+		}
+	    }
+	}
+
+	MulticastTracker tracker;
+	double end;
+	unsigned updates;
+	vector<double> latencies;
+};
+
+int main( int argc, char **argv )
+{
+    if( argc > 1 && argv[1][0] == '-' ){
+	usage();
+	return 1;
+    }
+    double seconds = argc > 1 ? atof(argv[1]) : 2;
+    unsigned subscribers = argc > 2 ? atoi(argv[2]) : 4;
+    unsigned objects = argc > 3 ? atoi(argv[3]) : 20;
+    double rate = argc > 4 ? atof(argv[4]) : 1000;
+
+    DummyTracker source;
+    for(unsigned i = 0; i < objects; i++ ){
+	stringstream name;
+	name << "object" << i;
+	Vector position(3);
+	position[0] = i;
+	source.addTrackedObject(new DummyTrackedObject(name.str(), position));
+    }
+
+    TrackerPublisher publisher(&source, GROUP, PORT);
+
+    double end = now() + seconds;
+    vector<SubscriberThread *> threads;
+    for(unsigned i = 0; i < subscribers; i++ ){
+	threads.push_back(new SubscriberThread(end + 0.1));
+	threads.back()->start();
+    }
+
+    unsigned published = 0;
+    double next = now();
+    while( now() < end ){
+	publisher.publish();
+	published++;
+	next += 1 / rate;
+	while( now() < next )
+	    ;
+    }
+
+    printf("published %u updates of %u objects\n", published, objects);
+    for(unsigned i = 0; i < threads.size(); i++ ){
+	SubscriberThread *t = threads[i];
+	t->join();
+	sort(t->latencies.begin(), t->latencies.end());
+	double p50 = t->latencies.empty() ? 0 : t->latencies[t->latencies.size() / 2];
+	double p99 = t->latencies.empty() ? 0 : t->latencies[t->latencies.size() * 99 / 100];
+	printf("subscriber %u: %u updates, %u lost, %u objects, latency p50 %.1f us p99 %.1f us\n",
+	       i, t->updates, t->tracker.getLostUpdates(),
+	       (unsigned)t->tracker.getAllObjects().size(), p50 * 1e6, p99 * 1e6);
+	delete t;
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Measure UDP packets per second on the loopback device, comparing a
+ * system call and an allocation per datagram against the batched
+ * UDPSocket interface backed by a UDPPacketPool.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+#include <wcl/network/UDPServer.h>
+#include <wcl/network/UDPPacketPool.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55557
+
+void usage()
+{
+    printf("Usage: udpbench [seconds] [packet size] [batch]\n"
+	   "\n"
+	   "Sends a burst of packets to a local UDPServer then reads the burst\n"
+	   "back, first one packet at a time then in batches.\n"
+	   "Defaults to 2 seconds of 64 byte packets in bursts of 32\n");
+}
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * The way the tracker code sends and receives samples: a fresh packet
+ * and a system call for every datagram.
+ */
+static unsigned long single( UDPSocket &client, UDPServer &server, size_t size,
+			     unsigned burst, double seconds )
+{
+    unsigned long packets = 0;
+    double start = now();
+
+    while( now() - start < seconds ){
+	for(unsigned i = 0; i < burst; i++ ){
+	    UDPPacket *p = new UDPPacket(size);
+	    memset(p->getData(), i, size);
+	    client.write(p);
+	    delete p;
+	}
+	for(unsigned i = 0; i < burst; i++ ){
+	    UDPPacket *p = new UDPPacket(size);
+	    server.read(p);
+	    delete p;
+	}
+	packets += burst;
+    }
+    return packets;
+}
+
+static unsigned long batched( UDPSocket &client, UDPServer &server, size_t size,
+			      unsigned burst, double seconds )
+{
+    UDPPacketPool pool(burst * 2, size);
+    vector<UDPPacket *> out(burst);
+    vector<UDPPacket *> in(burst);
+    unsigned long packets = 0;
+    double start = now();
+
+    while( now() - start < seconds ){
+	pool.acquire(&out[0], burst);
+	for(unsigned i = 0; i < burst; i++ )
+	    memset(out[i]->getData(), i, size);
+	unsigned sent = 0;
+	while( sent < burst )
+	    sent += client.write(&out[sent], burst - sent);
+	pool.release(&out[0], burst);
+
+	pool.acquire(&in[0], burst);
+	unsigned received = 0;
+	while( received < burst )
+	    received += server.read(&in[received], burst - received);
+	pool.release(&in[0], burst);
+
+	packets += burst;
+    }
+    return packets;
+}
+
+int main( int argc, char *argv[] )
+{
+    double seconds = 2.0;
+    size_t size = 64;
+    unsigned burst = 32;
+
+    if( argc > 1 && argv[1][0] == '-' ){
+	usage();
+	return 1;
+    }
+    if( argc > 1 )
+	seconds = atof(argv[1]);
+    if( argc > 2 )
+	size = atoi(argv[2]);
+    if( argc > 3 )
+	burst = atoi(argv[3]);
+
+    try {
+	UDPServer server(PORT);
+	UDPSocket client("127.0.0.1", PORT);
+
+	unsigned long packets = single(client, server, size, burst, seconds);
+	printf("single : %10.0f packets/s\n", packets / seconds);
+
+	packets = batched(client, server, size, burst, seconds);
+	printf("batched: %10.0f packets/s\n", packets / seconds);
+    } catch( SocketException &e ){
+	printf("udpbench: %s\n", e.what());
+	return 1;
+    }
+
+    return 0;
+}
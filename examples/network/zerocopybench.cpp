@@ -0,0 +1,224 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Compare the ways of sending a large message, a header followed by a
+ * frame sized payload, over a loopback TCP connection: copying into one
+ * buffer, writev, MSG_ZEROCOPY and sendfile from a file. Reports the
+ * throughput and the CPU time the process used per GB sent.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <vector>
+
+#include <wcl/network/TCPServer.h>
+#include <wcl/util/Thread.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55558
+#define HEADER_SIZE 16
+
+void usage()
+{
+    printf("Usage: zerocopybench [seconds] [payload size]\n"
+	   "\n"
+	   "Sends a 16 byte header and payload repeatedly to a local server\n"
+	   "that discards it. Defaults to 2 seconds with a 640x480 RGB payload\n");
+}
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static double cpuTime()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1000000.0 +
+	usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1000000.0;
+}
+
+/**
+ * Read and discard everything sent until the client disconnects
+ */
+class SinkThread: public Thread
+{
+    public:
+	SinkThread( TCPServer &s ): server(s) {}
+
+	void run()
+	{
+	    vector<unsigned char> buffer(1024 * 1024);
+	    while( true ){
+		TCPSocket client;
+		if( !this->server.accept(&client))
+		    return;
+		try {
+		    while( true )
+			client.read(&buffer[0], buffer.size());
+		} catch( SocketException & ){
+		    // Client has gone, wait for the next
+		}
+	    }
+	}
+
+    private:
+	TCPServer &server;
+};
+
+enum Mode { COPY, WRITEV, ZEROCOPY, SENDFILE };
+static const char *modeNames[] = { "copy", "writev", "zerocopy", "sendfile" };
+
+static void bench( Mode mode, double seconds, size_t payloadSize, int fd )
+{
+    TCPSocket socket("127.0.0.1", PORT);
+    vector<unsigned char> payload(payloadSize, 0x55);
+    unsigned char header[HEADER_SIZE];
+    memset(header, 0xAA, sizeof(header));
+
+    if( mode == ZEROCOPY && !socket.setZeroCopy(true)){
+	printf("%-9s: not supported by this kernel\n", modeNames[mode]);
+	return;
+    }
+
+    unsigned long long bytes = 0;
+    double cpuStart = cpuTime();
+    double start = now();
+    double elapsed = 0;
+
+    while( elapsed < seconds ){
+	switch( mode ){
+	    case COPY: {
+		// The way frames are sent today
+		unsigned char *message = new unsigned char[HEADER_SIZE + payloadSize];
+		memcpy(message, header, HEADER_SIZE);
+		memcpy(message + HEADER_SIZE, &payload[0], payloadSize);
+		socket.writeUntil(message, HEADER_SIZE + payloadSize);
+		delete [] message;
+		break;
+	    }
+	    case WRITEV: {
+		struct iovec v[2];
+		v[0].iov_base = header;
+		v[0].iov_len = HEADER_SIZE;
+		v[1].iov_base = &payload[0];
+		v[1].iov_len = payloadSize;
+		socket.writevUntil(v, 2);
+		break;
+	    }
+	    case ZEROCOPY: {
+		socket.writeUntil(header, HEADER_SIZE);
+		size_t sent = 0;
+		while( sent < payloadSize ){
+		    ssize_t amount = socket.writeZeroCopy(&payload[sent], payloadSize - sent);
+		    if( amount == 0 )
+			socket.pollZeroCopyCompletions(-1);
+		    sent += amount;
+		}
+		socket.pollZeroCopyCompletions();
+		break;
+	    }
+	    case SENDFILE:
+		socket.writeUntil(header, HEADER_SIZE);
+		socket.sendFile(fd, 0, payloadSize);
+		break;
+	}
+	bytes += HEADER_SIZE + payloadSize;
+	elapsed = now() - start;
+    }
+
+    // The payload must not be freed while the kernel may still use it
+    while( socket.getZeroCopyPending())
+	socket.pollZeroCopyCompletions(-1);
+
+    double cpu = cpuTime() - cpuStart;
+    double gb = bytes / (1024.0 * 1024.0 * 1024.0);
+    printf("%-9s: %10.1f MB/s %8.3f CPU s/GB", modeNames[mode],
+	   bytes / elapsed / (1024.0 * 1024.0), cpu / gb);
+    if( mode == ZEROCOPY )
+	printf(" (%u sends copied by the kernel)", socket.getZeroCopyCopied());
+    printf("\n");
+}
+
+int main( int argc, char *argv[] )
+{
+    double seconds = 2.0;
+    size_t payloadSize = 640 * 480 * 3;
+
+    if( argc > 1 && argv[1][0] == '-' ){
+	usage();
+	return 1;
+    }
+    if( argc > 1 )
+	seconds = atof(argv[1]);
+    if( argc > 2 )
+	payloadSize = atoi(argv[2]);
+
+    // sendfile needs the payload in a file
+    char path[] = "/tmp/zerocopybenchXXXXXX";
+    int fd = mkstemp(path);
+    if( fd == -1 ){
+	perror("zerocopybench: mkstemp");
+	return 1;
+    }
+    unlink(path);
+    vector<unsigned char> payload(payloadSize, 0x55);
+    if( write(fd, &payload[0], payloadSize) != (ssize_t)payloadSize ){
+	perror("zerocopybench: write");
+	return 1;
+    }
+
+    try {
+	TCPServer server(PORT);
+	SinkThread sink(server);
+	sink.start();
+
+	bench(COPY, seconds, payloadSize, fd);
+	bench(WRITEV, seconds, payloadSize, fd);
+	bench(ZEROCOPY, seconds, payloadSize, fd);
+	bench(SENDFILE, seconds, payloadSize, fd);
+
+	// Wake the sink from accept so it can finish
+	shutdown(*server, SHUT_RDWR);
+	sink.join();
+    } catch( SocketException &e ){
+	printf("zerocopybench: %s\n", e.what());
+	return 1;
+    }
+
+    close(fd);
+    return 0;
+}
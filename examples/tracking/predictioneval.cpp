@@ -0,0 +1,264 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Evaluate PoseFilter prediction offline against a recorded pose log.
+ *
+ * For every sample the filter is given everything up to that sample and
+ * asked for the pose one latency later, which is compared with the log
+ * at that time. The same is done for two baselines:
+ *
+ * hold     The last sample, what a renderer without prediction shows
+ * raw      The last sample extrapolated with the velocity between the
+ *          last two, prediction without filtering
+ * filter   PoseFilter
+ *
+ * The log is either a recording made with TrackerRecorder, of which the
+ * named object or else the first is used, or a text file with one sample
+ * per line:
+ *
+ *     timestamp_us x y z qw qx qy qz
+ *
+ * Without a log, 60 seconds of hand-like motion sampled at 120Hz with
+ * tracker noise is generated.
+ *
+ * Usage: predictioneval [log [alpha beta [object]]]
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <wcl/Exception.h>
+#include <wcl/tracking/PoseFilter.h>
+#include <wcl/tracking/ReplayTracker.h>
+
+using namespace std;
+using namespace wcl;
+
+typedef PoseHistory::Pose Pose;
+
+static double gaussian()
+{
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static vector<Pose> generate()
+{
+    vector<Pose> log;
+    srand(1);
+
+    uint64_t start = 1000000000000ULL;
+    for(unsigned i = 0; i < 60 * 120; i++ ){
+	double t = i / 120.0;
+	Pose p;
+	p.timestamp = start + (uint64_t)(t * 1e6) + (rand() % 2000) - 1000;
+
+	// Millimetres, a hand moving about a work surface
+	p.position[0] = 150 * sin(2 * M_PI * 0.31 * t) + 40 * sin(2 * M_PI * 1.3 * t);
+	p.position[1] = 100 * sin(2 * M_PI * 0.47 * t + 1);
+	p.position[2] = 60 * sin(2 * M_PI * 0.83 * t + 2) + 20 * sin(2 * M_PI * 1.7 * t);
+	for(unsigned j = 0; j < 3; j++ )
+	    p.position[j] += 0.3 * gaussian();
+
+	double yaw = 0.8 * sin(2 * M_PI * 0.4 * t) + 0.01 * M_PI / 180 * gaussian();
+	double pitch = 0.4 * sin(2 * M_PI * 0.7 * t + 0.5) + 0.01 * M_PI / 180 * gaussian();
+	Quaternion qy(cos(yaw / 2), 0, 0, sin(yaw / 2));
+	Quaternion qp(cos(pitch / 2), sin(pitch / 2), 0, 0);
+	p.orientation = qy * qp;
+	log.push_back(p);
+    }
+    return log;
+}
+
+/**
+ * Every visible pose of an object in a tracker recording
+ */
+static bool loadRecording( const char *path, const char *object, vector<Pose> &log )
+{
+    try {
+	ReplayTracker replay(path, ReplayTracker::AS_FAST_AS_POSSIBLE);
+	TrackedObject *o = object ? replay.getObject(object) : replay.getObjectAt(0);
+	if( o == NULL ){
+	    fprintf(stderr, "predictioneval: no such object in the recording\n");
+	    return true;
+	}
+
+	while( !replay.isFinished()){
+	    replay.update();
+	    Pose p;
+	    if( o->isVisible() && o->getHistory().getLatest(p) &&
+		(log.empty() || p.timestamp > log.back().timestamp ))
+		log.push_back(p);
+	}
+	return true;
+    } catch( Exception & ){
+	return false;
+    }
+}
+
+static bool load( const char *path, vector<Pose> &log )
+{
+    FILE *f = fopen(path, "r");
+    if( f == NULL )
+	return false;
+
+    Pose p;
+    unsigned long long timestamp;
+    double w, x, y, z;
+    while( fscanf(f, "%llu %lf %lf %lf %lf %lf %lf %lf", &timestamp, &p.position[0],
+		  &p.position[1], &p.position[2], &w, &x, &y, &z) == 8 ){
+	p.timestamp = timestamp;
+	p.orientation.set(w, x, y, z);
+	p.orientation.normalise();
+	if( log.empty() || p.timestamp > log.back().timestamp )
+	    log.push_back(p);
+    }
+    fclose(f);
+    return true;
+}
+
+/**
+ * The logged pose at time, false past the end of the log
+ */
+static bool truth( const vector<Pose> &log, const uint64_t time, Pose &pose )
+{
+    size_t low = 0, high = log.size();
+    while( low < high ){
+	size_t mid = (low + high) / 2;
+	if( log[mid].timestamp > time )
+	    high = mid;
+	else
+	    low = mid + 1;
+    }
+    if( low == 0 || low == log.size())
+	return false;
+
+    const Pose &a = log[low - 1];
+    const Pose &b = log[low];
+    double u = (double)(time - a.timestamp) / (b.timestamp - a.timestamp);
+    for(unsigned i = 0; i < 3; i++ )
+	pose.position[i] = a.position[i] + (b.position[i] - a.position[i]) * u;
+    pose.orientation = a.orientation.slerp(b.orientation, u);
+    return true;
+}
+
+/**
+ * The last sample moved on with the velocity between the last two
+ */
+static void extrapolate( const Pose &a, const Pose &b, const uint64_t time, Pose &pose )
+{
+    double u = (double)(time - a.timestamp) / (b.timestamp - a.timestamp);
+    for(unsigned i = 0; i < 3; i++ )
+	pose.position[i] = a.position[i] + (b.position[i] - a.position[i]) * u;
+    pose.orientation = a.orientation.slerp(b.orientation, u);
+}
+
+struct Error
+{
+    double position;
+    double positionSquared;
+    double angle;
+    unsigned count;
+
+    Error() : position(0), positionSquared(0), angle(0), count(0) {}
+
+    void add( const Pose &a, const Pose &b )
+    {
+	double d = 0;
+	for(unsigned i = 0; i < 3; i++ )
+	    d += (a.position[i] - b.position[i]) * (a.position[i] - b.position[i]);
+	double dot = fabs(a.orientation.w * b.orientation.w + a.orientation.x * b.orientation.x +
+			  a.orientation.y * b.orientation.y + a.orientation.z * b.orientation.z);
+	position += sqrt(d);
+	positionSquared += d;
+	angle += 2 * acos(dot > 1 ? 1 : dot) * 180 / M_PI;
+	count++;
+    }
+
+    void print( const char *method, const unsigned latency ) const
+    {
+	printf("%s,%u,%u,%.3f,%.3f,%.3f\n", method, latency, count,
+	       count ? position / count : 0, count ? sqrt(positionSquared / count) : 0,
+	       count ? angle / count : 0);
+    }
+};
+
+int main( int argc, char *argv[] )
+{
+    vector<Pose> log;
+    if( argc > 1 ){
+	if( !loadRecording(argv[1], argc > 4 ? argv[4] : NULL, log) && !load(argv[1], log)){
+	    fprintf(stderr, "predictioneval: can't read %s\n", argv[1]);
+	    return 1;
+	}
+    } else {
+	log = generate();
+    }
+    if( log.size() < 10 ){
+	fprintf(stderr, "predictioneval: the log is too short\n");
+	return 1;
+    }
+
+    double alpha = argc > 3 ? atof(argv[2]) : PoseFilter::DEFAULT_ALPHA;
+    double beta = argc > 3 ? atof(argv[3]) : PoseFilter::DEFAULT_BETA;
+    fprintf(stderr, "%lu samples, alpha %.3f, beta %.3f\n", (unsigned long)log.size(), alpha, beta);
+
+    const unsigned latencies[] = { 8, 16, 33, 50, 66 };
+    printf("method,latency_ms,count,mean_error,rms_error,mean_angle_deg\n");
+
+    for(unsigned l = 0; l < sizeof(latencies) / sizeof(latencies[0]); l++ ){
+	uint64_t latency = latencies[l] * 1000;
+	PoseFilter filter(alpha, beta);
+	filter.setPredictionLimit(latency);
+	Error hold, raw, filtered;
+
+	for(size_t i = 0; i < log.size(); i++ ){
+	    filter.update(log[i]);
+
+	    // Let the filter settle before measuring
+	    Pose expected, pose;
+	    if( i < 10 || !truth(log, log[i].timestamp + latency, expected))
+		continue;
+
+	    hold.add(log[i], expected);
+
+	    extrapolate(log[i - 1], log[i], log[i].timestamp + latency, pose);
+	    raw.add(pose, expected);
+
+	    filter.predict(log[i].timestamp + latency, pose);
+	    filtered.add(pose, expected);
+	}
+
+	hold.print("hold", latencies[l]);
+	raw.print("raw", latencies[l]);
+	filtered.print("filter", latencies[l]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,348 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Compare the ways a tracker can be served to other processes on the
+ * loopback device: VirtualTrackerPublisher to VirtualTracker over TCP,
+ * TrackerPublisher to MulticastTracker over UDP and
+ * SharedMemoryTrackerPublisher to SharedMemoryTracker.
+ *
+ * latency     Publish a frame and update the follower until it holds the
+ *             frame, one frame at a time
+ * throughput  Frames a follower applies per second while a thread publishes
+ *             as fast as it can, frames published but never applied are
+ *             counted as lost
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/MulticastTracker.h>
+#include <wcl/tracking/SharedMemoryTracker.h>
+#include <wcl/tracking/SharedMemoryTrackerPublisher.h>
+#include <wcl/tracking/TrackerPublisher.h>
+#include <wcl/tracking/VirtualTracker.h>
+#include <wcl/tracking/VirtualTrackerPublisher.h>
+#include <wcl/util/Thread.h>
+
+using namespace std;
+using namespace wcl;
+
+#define TCP_PORT 55582
+#define UDP_PORT 55583
+#define GROUP "239.255.87.86"
+#define RING "wcl-trackerbench"
+#define TIMEOUT 100
+#define WARMUP 100
+
+enum Api { TCP, UDP, SHM };
+static const char *apis[] = { "tcp", "udp", "shm" };
+
+void usage()
+{
+    printf("Usage: trackerbench [seconds]\n"
+	   "\n"
+	   "Runs every case for the given time, 0.5 seconds by default, and\n"
+	   "prints a CSV line per case\n");
+}
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static double percentile( const vector<double> &sorted, const double p )
+{
+    if( sorted.empty())
+	return 0;
+    size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+/**
+ * A source tracker whose objects all sit at x = frame, so a follower can
+ * tell which frame it holds
+ */
+class Source
+{
+    public:
+	Source( const unsigned count ): position(3)
+	{
+	    for(unsigned i = 0; i < count; i++ ){
+		stringstream name;
+		name << "obj" << i;
+		DummyTrackedObject *o = new DummyTrackedObject(name.str(), this->position);
+		this->objects.push_back(o);
+		this->tracker.addTrackedObject(o);
+	    }
+	}
+
+	void setFrame( const unsigned frame )
+	{
+	    this->position[0] = frame;
+	    for(unsigned i = 0; i < this->objects.size(); i++ )
+		this->objects[i]->setPosition(this->position);
+	}
+
+	DummyTracker tracker;
+
+    private:
+	vector<DummyTrackedObject *> objects;
+	Vector position;
+};
+
+/**
+ * A publisher and a follower of the source over one of the apis
+ */
+class Link
+{
+    public:
+	Link( const Api iapi, Source &source ):
+	    api(iapi), tcp(NULL), udp(NULL), shm(NULL), follower(NULL), last(NULL)
+	{
+	    switch( api ){
+		case TCP:
+		    this->tcp = new VirtualTrackerPublisher(&source.tracker, TCP_PORT);
+		    this->follower = new VirtualTracker("127.0.0.1", TCP_PORT);
+		    break;
+		case UDP: {
+		    this->udp = new TrackerPublisher(&source.tracker, GROUP, UDP_PORT);
+		    MulticastTracker *m = new MulticastTracker(GROUP, UDP_PORT);
+		    m->setTimeout(TIMEOUT);
+		    this->follower = m;
+		    break;
+		}
+		case SHM: {
+		    this->shm = new SharedMemoryTrackerPublisher(&source.tracker, RING);
+		    SharedMemoryTracker *s = new SharedMemoryTracker(RING);
+		    s->setTimeout(TIMEOUT);
+		    this->follower = s;
+		    break;
+		}
+	    }
+	}
+
+	~Link()
+	{
+	    this->disconnect();
+	    delete this->tcp;
+	    delete this->udp;
+	    delete this->shm;
+	}
+
+	void publish()
+	{
+	    if( this->tcp )
+		this->tcp->publish();
+	    else if( this->udp )
+		this->udp->publish();
+	    else
+		this->shm->publish();
+	}
+
+	/**
+	 * Update the follower and return the frame its last object holds,
+	 * -1 before it has any
+	 */
+	double update()
+	{
+	    this->follower->update();
+	    if( this->last == NULL ){
+		unsigned count = this->follower->getObjectCount();
+		if( count == 0 )
+		    return -1;
+		this->last = this->follower->getObjectAt(count - 1);
+	    }
+	    return this->last->getTranslation()[0];
+	}
+
+	/**
+	 * Close the follower, so a publisher blocked on it carries on
+	 */
+	void disconnect()
+	{
+	    delete this->follower;
+	    this->follower = NULL;
+	}
+
+    private:
+	Api api;
+	VirtualTrackerPublisher *tcp;
+	TrackerPublisher *udp;
+	SharedMemoryTrackerPublisher *shm;
+	Tracker *follower;
+	TrackedObject *last;
+};
+
+static void report( const char *test, const Api api, const unsigned objects,
+		    const unsigned long count, const unsigned long lost,
+		    const double seconds, vector<double> &latencies )
+{
+    sort(latencies.begin(), latencies.end());
+    double mean = 0;
+    for(size_t i = 0; i < latencies.size(); i++ )
+	mean += latencies[i];
+    if( !latencies.empty())
+	mean /= latencies.size();
+
+    printf("%s,%s,%u,%lu,%.3f,%.1f,%lu", test, apis[api], objects, count,
+	   seconds, count / seconds, lost);
+    if( latencies.empty())
+	printf(",,,,,\n");
+    else
+	printf(",%.2f,%.2f,%.2f,%.2f,%.2f\n", mean, percentile(latencies, 0.5),
+	       percentile(latencies, 0.99), percentile(latencies, 0.999), latencies.back());
+    fflush(stdout);
+}
+
+static void latency( const Api api, const unsigned objects, const double seconds )
+{
+    Source source(objects);
+    Link link(api, source);
+
+    vector<double> latencies;
+    latencies.reserve(1 << 20);
+    unsigned long count = 0;
+    unsigned long lost = 0;
+    double start = 0;
+    double end = 0;
+    for(unsigned frame = 1;; frame++ ){
+	if( frame == WARMUP ){
+	    start = now();
+	    end = start + seconds;
+	}
+	source.setFrame(frame);
+	double sent = now();
+	if( frame >= WARMUP && sent >= end )
+	    break;
+
+	link.publish();
+	bool applied = false;
+	while( !applied && now() - sent < TIMEOUT / 1000.0 )
+	    applied = link.update() == frame;
+
+	if( frame >= WARMUP ){
+	    if( applied ){
+		latencies.push_back((now() - sent) * 1000000);
+		count++;
+	    } else
+		lost++;
+	}
+    }
+    report("latency", api, objects, count, lost, now() - start, latencies);
+}
+
+/**
+ * Publishes frames as fast as it can until stopped
+ */
+class PublisherThread: public Thread
+{
+    public:
+	PublisherThread( Source &isource, Link &ilink ):
+	    source(isource), link(ilink), published(0), running(true)
+	{
+	}
+
+	void run()
+	{
+	    try {
+		while( this->running ){
+		    this->source.setFrame(this->published + 1);
+		    this->link.publish();
+		    this->published++;
+		}
+	    } catch( Exception &e ){
+		fprintf(stderr, "trackerbench: %s\n", e.what());
+	    }
+	}
+
+	Source &source;
+	Link &link;
+	volatile unsigned long published;
+	volatile bool running;
+};
+
+static void throughput( const Api api, const unsigned objects, const double seconds )
+{
+    Source source(objects);
+    Link link(api, source);
+    PublisherThread publisher(source, link);
+
+    unsigned long count = 0;
+    double frame = -1;
+    publisher.start();
+    double start = now();
+    double end = start + seconds;
+    while( now() < end ){
+	double latest = link.update();
+	if( latest != frame ){
+	    frame = latest;
+	    count++;
+	}
+    }
+    publisher.running = false;
+    link.disconnect();
+    publisher.join();
+
+    double elapsed = now() - start;
+    vector<double> none;
+    report("throughput", api, objects, count, frame > count ? (unsigned long)frame - count : 0,
+	   elapsed, none);
+}
+
+int main( int argc, char *argv[] )
+{
+    if( argc > 1 && argv[1][0] == '-' ){
+	usage();
+	return 1;
+    }
+    double seconds = argc > 1 ? atof(argv[1]) : 0.5;
+
+    printf("test,api,objects,count,seconds,per_second,lost,"
+	   "mean_us,p50_us,p99_us,p999_us,max_us\n");
+    try {
+	const unsigned counts[] = { 1, 10, 100 };
+	for(unsigned i = 0; i < 3; i++ )
+	    for(unsigned api = TCP; api <= SHM; api++ )
+		latency((Api)api, counts[i], seconds);
+
+	for(unsigned i = 0; i < 3; i++ )
+	    for(unsigned api = TCP; api <= SHM; api++ )
+		throughput((Api)api, counts[i], seconds);
+    } catch( Exception &e ){
+	fprintf(stderr, "trackerbench: %s\n", e.what());
+	return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Measure ViconClient against a ViconServer on the loopback device. The
+ * server streams 1000 frames a second while the client calls update in a
+ * tight loop, as a render loop would.
+ *
+ * latency  The age of each new frame when update applies it, from the
+ *          server sending it to the objects holding it
+ * update   The time update takes, with and without a new frame
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <wcl/tracking/ViconClient.h>
+#include <wcl/tracking/ViconServer.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PORT 55581
+
+static double now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static double percentile( const vector<double> &sorted, const double p )
+{
+    if( sorted.empty())
+	return 0;
+    size_t i = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[i];
+}
+
+static void report( const char *test, const unsigned objects, vector<double> &v )
+{
+    sort(v.begin(), v.end());
+    double mean = 0;
+    for(size_t i = 0; i < v.size(); i++ )
+	mean += v[i];
+    if( !v.empty())
+	mean /= v.size();
+
+    printf("%s,%u,%lu,%.2f,%.2f,%.2f,%.2f,%.2f\n", test, objects, (unsigned long)v.size(),
+	   mean, percentile(v, 0.5), percentile(v, 0.99), percentile(v, 0.999),
+	   v.empty() ? 0 : v.back());
+}
+
+static void run( const unsigned count, const double seconds )
+{
+    ViconServer server(PORT, 1000);
+    for(unsigned i = 0; i < count; i++ ){
+	stringstream ss;
+	ss << "Body" << i;
+	server.addSixDOF(ss.str());
+    }
+    server.start();
+
+    ViconClient client("127.0.0.1", PORT, 1000);
+
+    vector<double> latency;
+    vector<double> fresh;
+    vector<double> idle;
+    latency.reserve(1 << 16);
+    fresh.reserve(1 << 16);
+    idle.reserve(1 << 22);
+
+    double end = now() + seconds;
+    uint64_t last = 0;
+    while( now() < end ){
+	double start = now();
+	client.update();
+	double finish = now();
+
+	if( client.getTimestamp() != last ){
+	    last = client.getTimestamp();
+	    fresh.push_back((finish - start) * 1000000);
+	    latency.push_back((finish - client.getFrameTime()) * 1000000);
+	} else if( idle.size() < idle.capacity())
+	    idle.push_back((finish - start) * 1000000);
+    }
+
+    report("latency", count, latency);
+    report("update_new_frame", count, fresh);
+    report("update_no_frame", count, idle);
+    fprintf(stderr, "%u objects: %lu frames received, %lu skipped by update\n", count,
+	    (unsigned long)client.getFramesReceived(), (unsigned long)client.getFramesSkipped());
+}
+
+int main( int argc, char *argv[] )
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 1;
+
+    printf("test,objects,count,mean_us,p50_us,p99_us,p999_us,max_us\n");
+    try {
+	const unsigned counts[] = { 1, 10, 100 };
+	for(unsigned i = 0; i < 3; i++ )
+	    run(counts[i], seconds);
+    } catch( Exception &e ){
+	fprintf(stderr, "viconbench: %s\n", e.what());
+	return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/**
+ * Measure the throughput of VideoEncoder for each codec, then decode the
+ * result again with VideoDecoder to measure the round trip. Each codec is
+ * fed RGB8 frames and MJPEG frames as a webcam would send them.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+
+#include <wcl/video/MJPEGEncoder.h>
+#include <wcl/video/VideoEncoder.h>
+#include <wcl/video/VideoDecoder.h>
+
+using namespace std;
+using namespace wcl;
+
+#define PATTERNS 30
+
+void usage()
+{
+    printf("Usage: videobench [frames] [width] [height] [threads]\n"
+	   "\n"
+	   "Encodes synthetic RGB8 and MJPEG frames with each codec, then\n"
+	   "decodes them again. Codecs not available in libavcodec are skipped.\n"
+	   "Defaults to 300 frames of 640x480 with the codec choosing the threads\n");
+}
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * Generate a moving colour gradient so the codecs have some work to do
+ */
+static void fillPattern(unsigned char *frame, const unsigned width, const unsigned height, const unsigned offset)
+{
+    for(unsigned y = 0; y < height; y++ ){
+	for(unsigned x = 0; x < width; x++ ){
+	    unsigned char *p = frame + (y * width + x) * 3;
+	    p[0] = (x + offset * 4) & 0xff;
+	    p[1] = (y + offset * 2) & 0xff;
+	    p[2] = ((x ^ y) + offset) & 0xff;
+	}
+    }
+}
+
+int main(int argc, char **argv)
+{
+    unsigned frames = 300;
+    unsigned width = 640;
+    unsigned height = 480;
+    unsigned threads = 0;
+
+    if( argc > 1 && strcmp(argv[1], "-h") == 0 ){
+	usage();
+	return 0;
+    }
+    if( argc > 1 ) frames = atoi(argv[1]);
+    if( argc > 2 ) width = atoi(argv[2]);
+    if( argc > 3 ) height = atoi(argv[3]);
+    if( argc > 4 ) threads = atoi(argv[4]);
+
+    // Pregenerate the frames so generating them isn't measured, the MJPEG
+    // frames are the same patterns compressed
+    unsigned frameSize = width * height * 3;
+    vector<unsigned char> patterns(frameSize * PATTERNS);
+    vector< vector<unsigned char> > jpegs(PATTERNS);
+    try {
+	MJPEGEncoder jpeg(width, height, Camera::RGB8);
+	for(unsigned i = 0; i < PATTERNS; i++ ){
+	    fillPattern(&patterns[i * frameSize], width, height, i);
+	    unsigned size;
+	    const unsigned char *image = jpeg.encode(&patterns[i * frameSize], size);
+	    jpegs[i].assign(image, image + size);
+	}
+    }
+    catch( const std::string &s ){
+	printf("Can't compress the MJPEG frames: %s\n", s.c_str());
+	return 1;
+    }
+
+    const char *names[] = { "MJPEG", "H264", "FFV1" };
+    const char *files[] = { "videobench-mjpeg.avi", "videobench-h264.mkv", "videobench-ffv1.mkv" };
+    VideoEncoder::Codec codecs[] = { VideoEncoder::MJPEG, VideoEncoder::H264, VideoEncoder::FFV1 };
+    const char *inputNames[] = { "RGB8", "MJPEG" };
+    Camera::ImageFormat inputs[] = { Camera::RGB8, Camera::MJPEG };
+
+    printf("%-6s %-6s %8s %12s %12s %10s %8s\n",
+	   "input", "codec", "frames", "encode fps", "decode fps", "size (KB)", "dropped");
+
+    for(unsigned in = 0; in < 2; in++ ){
+	for(unsigned c = 0; c < 3; c++ ){
+	    double start, encodeTime, decodeTime;
+	    uint64_t dropped;
+	    unsigned decoded = 0;
+
+	    try {
+		VideoEncoder encoder(files[c], width, height, inputs[in], codecs[c],
+				     30, 8, VideoEncoder::BLOCK, threads);
+
+		start = now();
+		for(unsigned i = 0; i < frames; i++ ){
+		    if( inputs[in] == Camera::MJPEG ){
+			const vector<unsigned char> &image = jpegs[i % PATTERNS];
+			encoder.addFrame(&image[0], image.size());
+		    } else
+			encoder.addFrame(&patterns[(i % PATTERNS) * frameSize], frameSize);
+		}
+		encoder.close();
+		encodeTime = now() - start;
+		dropped = encoder.getDroppedFrames();
+
+		VideoDecoder decoder(files[c], false);
+		start = now();
+		while( decoder.getFrame() != NULL )
+		    decoded++;
+		decodeTime = now() - start;
+	    }
+	    catch( const std::string &s ){
+		printf("%-6s %-6s skipped: %s\n", inputNames[in], names[c], s.c_str());
+		unlink(files[c]);
+		continue;
+	    }
+
+	    struct stat st;
+	    stat(files[c], &st);
+	    unlink(files[c]);
+
+	    printf("%-6s %-6s %8u %12.1f %12.1f %10lu %8lu\n", inputNames[in], names[c], decoded,
+		   frames / encodeTime, decoded / decodeTime,
+		   (unsigned long)(st.st_size / 1024), (unsigned long)dropped);
+	}
+    }
+
+    return 0;
+}
@@ -37,6 +37,9 @@
 #ifdef ENABLE_CAMERA_PTGREY
 #include <wcl/camera/PTGreyCameraFactory.h>
 #endif
+#ifdef ENABLE_CAMERA_NETWORK
+#include <wcl/camera/NetworkCameraFactory.h>
+#endif
 
 using namespace std;
 
@@ -123,6 +126,20 @@ std::vector<Camera *> CameraFactory::getCameras(const SearchScope scope)
     }
 #endif
 
+#ifdef ENABLE_CAMERA_NETWORK
+    if ( scope != LOCAL ){
+	try {
+	    std::vector<NetworkCamera *> network = NetworkCameraFactory::getCameras();
+	    for(std::vector<NetworkCamera *>::iterator it = network.begin();
+		it != network.end();
+		++it )
+		all.push_back( *it );
+	} catch (CameraException &e){
+	    wclclog << "Network Camera(s) Unavailable:" << e.what() << std::endl;
+	}
+    }
+#endif
+
     return all;
 }
 
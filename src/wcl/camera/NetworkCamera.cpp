@@ -0,0 +1,415 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sstream>
+
+#include <wcl/IO.h>
+#include <wcl/camera/NetworkCamera.h>
+#include <wcl/network/SocketStream.h>
+#include <wcl/network/TCPSocket.h>
+#include <wcl/network/UDPSocket.h>
+#include "NetworkCameraProtocol.h"
+
+// How long to wait for the server to answer a subscription, in seconds
+#define SUBSCRIBE_WAIT 2
+
+// The receive buffer requested for UDP frames, bursts of chunks must fit
+#define UDP_RECEIVE_BUFFER (4 * 1024 * 1024)
+
+using namespace std;
+
+namespace wcl
+{
+
+using namespace NetworkCameraProtocol;
+
+static double getTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+NetworkCamera::NetworkCamera(const std::string &ihost, const unsigned iport,
+			     const NetworkCameraServer::Transport itransport) throw (CameraException):
+    host(ihost), port(iport), transport(itransport),
+    tcpSocket(NULL), stream(NULL), udpSocket(NULL),
+    assemblingFrame(0), chunksReceived(0), lastSubscribe(0), lastData(0),
+    haveFrame(false), frameNumber(0), frameTimestamp(0), droppedFrames(0)
+{
+    this->connect();
+}
+
+NetworkCamera::~NetworkCamera()
+{
+    this->disconnect();
+}
+
+void NetworkCamera::connect() throw (CameraException)
+{
+    this->haveFrame = false;
+
+    try {
+	if( this->transport == NetworkCameraServer::TCP ){
+	    this->tcpSocket = new TCPSocket(this->host, this->port);
+	    this->stream = new SocketStream(*this->tcpSocket, 65536);
+
+	    // The hello is fixed size apart from the trailing id
+	    const size_t fixed = PREAMBLE_SIZE + 15;
+	    const unsigned char *p = this->stream->peek(fixed);
+	    size_t size = fixed + (p[fixed - 2] | (p[fixed - 1] << 8));
+	    p = this->stream->peek(size);
+	    if( !this->applyHello(p, size))
+		throw CameraException(CameraException::CONNECTIONISSUE);
+	    this->stream->consume(size);
+	    return;
+	}
+
+	this->udpSocket = new UDPSocket(this->host, this->port);
+	int size = UDP_RECEIVE_BUFFER;
+	setsockopt(**this->udpSocket, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+	this->datagram.resize(65536);
+    } catch( SocketException &e ){
+	wclclog << "NetworkCamera: Failed to connect to " << this->host << ":"
+		<< this->port << ", " << e.what() << endl;
+	this->disconnect();
+	throw CameraException(CameraException::CONNECTIONISSUE);
+    }
+
+    // Subscribe and wait for the server to say hello
+    double start = getTime();
+    while( getTime() - start < SUBSCRIBE_WAIT ){
+	this->subscribe(true);
+	size_t length = this->receiveDatagram(250);
+	if( length && this->applyHello(&this->datagram[0], length))
+	    return;
+    }
+
+    this->disconnect();
+    throw CameraException(CameraException::CONNECTIONISSUE);
+}
+
+void NetworkCamera::disconnect()
+{
+    if( this->udpSocket && this->udpSocket->isValid()){
+	std::vector<unsigned char> unsubscribe;
+	Writer w(unsubscribe);
+	writePreamble(w, UNSUBSCRIBE);
+	try {
+	    this->udpSocket->write(&unsubscribe[0], unsubscribe.size());
+	} catch( SocketException & ){
+	}
+    }
+
+    delete this->stream;
+    delete this->tcpSocket;
+    delete this->udpSocket;
+    this->stream = NULL;
+    this->tcpSocket = NULL;
+    this->udpSocket = NULL;
+
+    // Give the next connection its own timeout and frame to assemble
+    this->lastData = 0;
+    this->received.clear();
+}
+
+void NetworkCamera::subscribe(const bool keyFrame)
+{
+    std::vector<unsigned char> request;
+    Writer w(request);
+    writePreamble(w, SUBSCRIBE);
+    w.put8(keyFrame ? REQUEST_KEY_FRAME : 0);
+
+    try {
+	this->udpSocket->write(&request[0], request.size());
+    } catch( SocketException &e ){
+	wclclog << "NetworkCamera: Subscribe failed, " << e.what() << endl;
+    }
+    this->lastSubscribe = getTime();
+}
+
+bool NetworkCamera::applyHello(const unsigned char *data, const size_t size)
+{
+    Reader r(data, size);
+    MessageType type;
+    Hello h;
+    if( !readPreamble(r, type) || type != HELLO || !readHello(r, h))
+	return false;
+
+    Configuration c;
+    c.format = (ImageFormat)h.format;
+    c.width = h.width;
+    c.height = h.height;
+    c.fps = h.fps;
+    this->supportedConfigurations.clear();
+    this->supportedConfigurations.push_back(c);
+    Camera::setConfiguration(c);
+
+    std::stringstream ss;
+    ss << "NETWORK:" << this->host << ":" << this->port << "/" << h.id;
+    this->id = ss.str();
+
+    this->frame.resize(this->getFormatBufferSize());
+    return true;
+}
+
+void NetworkCamera::printDetails(bool full)
+{
+    Camera::printDetails(full);
+    if( full ){
+	wclclog << "| Server: " << this->host << ":" << this->port
+		<< (this->transport == NetworkCameraServer::TCP ? " (TCP)" : " (UDP)") << endl;
+	wclclog << "| Dropped Frames: " << this->droppedFrames << endl;
+    }
+}
+
+void NetworkCamera::setConfiguration(const Configuration &c)
+{
+    const Configuration &active = this->activeConfiguration;
+    if( c.format != active.format || c.width != active.width || c.height != active.height )
+	throw CameraException(CameraException::INVALIDCONFIGURATION);
+}
+
+void NetworkCamera::setExposureMode(const ExposureMode)
+{
+    throw CameraException(CameraException::EXPOSUREERROR);
+}
+
+void NetworkCamera::setControlValue(const Control, const int)
+{
+    throw CameraException(CameraException::CONTROLERROR);
+}
+
+int NetworkCamera::getControlValue(const Control)
+{
+    throw CameraException(CameraException::CONTROLERROR);
+}
+
+void NetworkCamera::update()
+{
+    if( this->tcpSocket == NULL && this->udpSocket == NULL )
+	this->connect();
+
+    // Deltas that don't apply are skipped, wait for one that does
+    do {
+	if( this->transport == NetworkCameraServer::TCP )
+	    this->readFrameTCP();
+	else
+	    this->readFrameUDP();
+    } while( !this->applyFrame(&this->message[0], this->message.size()));
+}
+
+void NetworkCamera::startup()
+{
+    if( this->tcpSocket == NULL && this->udpSocket == NULL )
+	this->connect();
+}
+
+void NetworkCamera::shutdown()
+{
+    this->disconnect();
+}
+
+uint32_t NetworkCamera::getFrameNumber() const
+{
+    return this->frameNumber;
+}
+
+uint64_t NetworkCamera::getFrameTimestamp() const
+{
+    return this->frameTimestamp;
+}
+
+unsigned NetworkCamera::getDroppedFrames() const
+{
+    return this->droppedFrames;
+}
+
+void NetworkCamera::readFrameTCP() throw (CameraException)
+{
+    try {
+	const unsigned char *p = this->stream->peek(FRAME_HEADER_SIZE);
+	Reader r(p, FRAME_HEADER_SIZE);
+	MessageType type;
+	FrameHeader h;
+	if( !readPreamble(r, type) || type != FRAME || !readFrameHeader(r, h)){
+	    this->disconnect();
+	    throw CameraException(CameraException::CONNECTIONISSUE);
+	}
+
+	this->message.resize(FRAME_HEADER_SIZE + h.size);
+	this->stream->read(&this->message[0], this->message.size());
+    } catch( SocketException &e ){
+	wclclog << "NetworkCamera: Connection lost, " << e.what() << endl;
+	this->disconnect();
+	throw CameraException(CameraException::CONNECTIONISSUE);
+    }
+}
+
+/**
+ * Wait for a datagram from the server
+ *
+ * @param timeout How long to wait in milliseconds
+ * @return The length of the datagram, 0 if none arrived
+ */
+size_t NetworkCamera::receiveDatagram(const int timeout) throw (CameraException)
+{
+    struct pollfd pfd;
+    pfd.fd = **this->udpSocket;
+    pfd.events = POLLIN;
+    if( poll(&pfd, 1, timeout) <= 0 )
+	return 0;
+
+    ssize_t length = ::recv(pfd.fd, &this->datagram[0], this->datagram.size(), MSG_DONTWAIT);
+    if( length == -1 ){
+	if( errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNREFUSED )
+	    return 0;
+	this->disconnect();
+	throw CameraException(CameraException::CONNECTIONISSUE);
+    }
+
+    this->lastData = getTime();
+    return length;
+}
+
+void NetworkCamera::readFrameUDP() throw (CameraException)
+{
+    for(;;){
+	double now = getTime();
+	if( now - this->lastSubscribe >= 1 )
+	    this->subscribe(false);
+	if( this->lastData > 0 && now - this->lastData > SUBSCRIPTION_TIMEOUT ){
+	    wclclog << "NetworkCamera: No frames from " << this->host << ":" << this->port << endl;
+	    this->disconnect();
+	    throw CameraException(CameraException::CONNECTIONISSUE);
+	}
+
+	size_t length = this->receiveDatagram(100);
+	if( length == 0 )
+	    continue;
+
+	Reader r(&this->datagram[0], length);
+	MessageType type;
+	ChunkHeader c;
+	if( !readPreamble(r, type) || type != CHUNK || !readChunkHeader(r, c))
+	    continue;
+
+	size_t dataSize = length - CHUNK_HEADER_SIZE;
+	if( c.chunk >= c.count || c.offset + dataSize > c.total )
+	    continue;
+
+	// Chunks of older frames are late, a newer frame abandons the
+	// frame being assembled
+	if( c.frame != this->assemblingFrame || this->received.empty()){
+	    if( (int32_t)(c.frame - this->assemblingFrame) < 0 && !this->received.empty())
+		continue;
+	    this->assemblingFrame = c.frame;
+	    this->message.resize(c.total);
+	    this->received.assign(c.count, false);
+	    this->chunksReceived = 0;
+	}
+
+	if( this->received[c.chunk] || this->message.size() != c.total )
+	    continue;
+	memcpy(&this->message[c.offset], &this->datagram[CHUNK_HEADER_SIZE], dataSize);
+	this->received[c.chunk] = true;
+	this->chunksReceived++;
+
+	if( this->chunksReceived == this->received.size()){
+	    this->received.clear();
+	    return;
+	}
+    }
+}
+
+/**
+ * Apply a received frame message to the current frame
+ *
+ * @return false if the frame couldn't be applied
+ */
+bool NetworkCamera::applyFrame(const unsigned char *data, const size_t size)
+{
+    Reader r(data, size);
+    MessageType type;
+    FrameHeader h;
+    if( !readPreamble(r, type) || type != FRAME || !readFrameHeader(r, h) ||
+	r.getPosition() + h.size > size )
+	return false;
+
+    const unsigned char *payload = data + r.getPosition();
+    ImageFormat format = (ImageFormat)h.format;
+    Configuration &active = this->activeConfiguration;
+
+    if( h.kind == KEY_FRAME ){
+	// The server may have changed compression
+	if( format != active.format || h.width != active.width || h.height != active.height ){
+	    Configuration c = active;
+	    c.format = format;
+	    c.width = h.width;
+	    c.height = h.height;
+	    this->supportedConfigurations.clear();
+	    this->supportedConfigurations.push_back(c);
+	    Camera::setConfiguration(c);
+	}
+
+	size_t bufferSize = this->getFormatBufferSize();
+	if( this->frame.size() < bufferSize || this->frame.size() < h.size )
+	    this->frame.resize(bufferSize > h.size ? bufferSize : h.size);
+	memcpy(&this->frame[0], payload, h.size);
+    } else {
+	size_t rowSize = getRowSize(format, active.width);
+	size_t regionRowSize = getRowSize(format, h.width);
+	size_t offset = getRowSize(format, h.x);
+
+	if( !this->haveFrame || h.base != this->frameNumber || format != active.format ||
+	    rowSize == 0 || h.x + h.width > active.width || h.y + h.height > active.height ||
+	    regionRowSize * h.height != h.size ){
+	    // We missed the frame this delta is based on
+	    if( this->udpSocket )
+		this->subscribe(true);
+	    return false;
+	}
+
+	for(unsigned y = 0; y < h.height; y++ )
+	    memcpy(&this->frame[(h.y + y) * rowSize + offset],
+		   payload + y * regionRowSize, regionRowSize);
+    }
+
+    if( this->haveFrame && (int32_t)(h.frame - this->frameNumber) > 1 )
+	this->droppedFrames += h.frame - this->frameNumber - 1;
+
+    this->haveFrame = true;
+    this->frameNumber = h.frame;
+    this->frameTimestamp = h.timestamp;
+    this->currentFrame = &this->frame[0];
+    return true;
+}
+
+};
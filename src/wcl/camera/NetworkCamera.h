@@ -0,0 +1,146 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_CAMERA_NETWORKCAMERA_H
+#define WCL_CAMERA_NETWORKCAMERA_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/camera/Camera.h>
+#include <wcl/camera/CameraException.h>
+#include <wcl/camera/NetworkCameraServer.h>
+
+namespace wcl
+{
+	class TCPSocket;
+	class UDPSocket;
+	class SocketStream;
+
+	/**
+	 * A camera published by a NetworkCameraServer on another machine.
+	 *
+	 * The configuration is fixed by the server, frames arrive in whatever
+	 * format the server sends and can be converted with getFrame(format)
+	 * as for any other camera. Delta updates are applied to the previous
+	 * frame, so getCurrentFrame always holds a complete image.
+	 *
+	 * Over UDP a frame with a lost chunk is dropped and a key frame is
+	 * requested when a delta can't be applied.
+	 */
+	class WCL_API NetworkCamera: public Camera
+	{
+		public:
+			/**
+			 * Connect to a camera server
+			 *
+			 * @param host The host name or address of the server
+			 * @param port The port of the server
+			 * @param transport The transport the server uses
+			 * @throw CameraException if the server can't be reached
+			 */
+			NetworkCamera(const std::string &host,
+				      const unsigned port = NetworkCameraServer::DEFAULT_PORT,
+				      const NetworkCameraServer::Transport transport = NetworkCameraServer::TCP) throw (CameraException);
+			~NetworkCamera();
+
+			// Overrides of Camera
+			virtual void printDetails(bool full = true);
+			virtual void setConfiguration(const Configuration &c);
+			virtual void setExposureMode(const ExposureMode t);
+			virtual void setControlValue(const Control control, const int value);
+			virtual int getControlValue(const Control control);
+
+			/**
+			 * Wait for the next frame from the server
+			 *
+			 * @throw CameraException if the connection to the server is lost
+			 */
+			virtual void update();
+			virtual void startup();
+			virtual void shutdown();
+
+			/**
+			 * The number the server gave the current frame
+			 */
+			uint32_t getFrameNumber() const;
+
+			/**
+			 * When the server captured the current frame, in
+			 * microseconds since the epoch on the server clock
+			 */
+			uint64_t getFrameTimestamp() const;
+
+			/**
+			 * The number of frames the server produced that this
+			 * camera never received
+			 */
+			unsigned getDroppedFrames() const;
+
+		protected:
+			const char *getTypeIdentifier() const { return "NETWORK"; }
+
+		private:
+			std::string host;
+			unsigned port;
+			NetworkCameraServer::Transport transport;
+
+			TCPSocket *tcpSocket;
+			SocketStream *stream;
+			UDPSocket *udpSocket;
+
+			std::vector<unsigned char> frame;
+			std::vector<unsigned char> message;
+
+			// Reassembly of chunked frames
+			std::vector<unsigned char> datagram;
+			std::vector<bool> received;
+			uint32_t assemblingFrame;
+			unsigned chunksReceived;
+			double lastSubscribe;
+			double lastData;
+
+			bool haveFrame;
+			uint32_t frameNumber;
+			uint64_t frameTimestamp;
+			unsigned droppedFrames;
+
+			void connect() throw (CameraException);
+			void disconnect();
+			void subscribe(const bool keyFrame);
+			bool applyHello(const unsigned char *data, const size_t size);
+			size_t receiveDatagram(const int timeout) throw (CameraException);
+			void readFrameTCP() throw (CameraException);
+			void readFrameUDP() throw (CameraException);
+			bool applyFrame(const unsigned char *message, const size_t size);
+
+			NetworkCamera(const NetworkCamera &);
+			NetworkCamera &operator =(const NetworkCamera &);
+	};
+};
+
+#endif
@@ -0,0 +1,143 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <poll.h>
+#include <set>
+#include <sstream>
+#include <sys/time.h>
+#include <arpa/inet.h>
+
+#include <wcl/IO.h>
+#include <wcl/camera/NetworkCameraFactory.h>
+#include <wcl/camera/CameraException.h>
+#include <wcl/network/UDPSocket.h>
+#include "NetworkCameraProtocol.h"
+
+// How long to collect replies to a discovery request, in milliseconds
+#define DISCOVERY_WAIT 250
+
+using namespace std;
+
+namespace wcl {
+
+using namespace NetworkCameraProtocol;
+
+NetworkCameraFactory *NetworkCameraFactory::instance;
+std::vector<NetworkCamera *> NetworkCameraFactory::cameras;
+
+NetworkCameraFactory::NetworkCameraFactory()
+{}
+
+NetworkCameraFactory::~NetworkCameraFactory()
+{
+    for(std::vector<NetworkCamera *>::iterator it = this->cameras.begin();
+	it != this->cameras.end();
+	++it )
+    {
+	NetworkCamera *c = *it;
+	delete c;
+    }
+}
+
+NetworkCameraFactory *NetworkCameraFactory::getInstance()
+{
+    if( NetworkCameraFactory::instance == NULL ){
+	NetworkCameraFactory::instance = new NetworkCameraFactory();
+	NetworkCameraFactory::instance->probeCameras();
+    }
+
+    return NetworkCameraFactory::instance;
+}
+
+std::vector<NetworkCamera *> NetworkCameraFactory::getCameras()
+{
+    NetworkCameraFactory *instance = NetworkCameraFactory::getInstance();
+    return instance->cameras;
+}
+
+void NetworkCameraFactory::probeCameras()
+{
+    std::vector<unsigned char> request;
+    Writer w(request);
+    writePreamble(w, DISCOVER);
+
+    // Collect the servers that answer, a server may answer more than once
+    std::set<std::pair<std::string, unsigned> > found;
+    std::vector<std::pair<std::string, Hello> > servers;
+
+    try {
+	UDPSocket socket(DISCOVERY_GROUP, DISCOVERY_PORT);
+	socket.write(&request[0], request.size());
+
+	struct timeval start, now;
+	gettimeofday(&start, NULL);
+	for(;;){
+	    gettimeofday(&now, NULL);
+	    int elapsed = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_usec - start.tv_usec) / 1000;
+	    if( elapsed >= DISCOVERY_WAIT )
+		break;
+
+	    struct pollfd pfd;
+	    pfd.fd = *socket;
+	    pfd.events = POLLIN;
+	    if( poll(&pfd, 1, DISCOVERY_WAIT - elapsed) <= 0 )
+		break;
+
+	    unsigned char data[1024];
+	    sockaddr_in from;
+	    socklen_t fromLength = sizeof(from);
+	    ssize_t length = recvfrom(*socket, data, sizeof(data), 0, (sockaddr *)&from, &fromLength);
+	    if( length <= 0 )
+		continue;
+
+	    Reader r(data, length);
+	    MessageType type;
+	    Hello h;
+	    if( !readPreamble(r, type) || type != HELLO || !readHello(r, h))
+		continue;
+
+	    std::string host = inet_ntoa(from.sin_addr);
+	    if( found.insert(std::make_pair(host, (unsigned)h.port)).second )
+		servers.push_back(std::make_pair(host, h));
+	}
+    } catch( SocketException &e ){
+	wclclog << "NetworkCameraFactory: Discovery failed, " << e.what() << endl;
+	return;
+    }
+
+    for(unsigned i = 0; i < servers.size(); i++ ){
+	try {
+	    NetworkCameraServer::Transport transport = (NetworkCameraServer::Transport)servers[i].second.transport;
+	    NetworkCamera *c = new NetworkCamera(servers[i].first, servers[i].second.port, transport);
+	    this->cameras.push_back(c);
+	} catch( CameraException &e ){
+	    wclclog << "NetworkCameraFactory: " << servers[i].first << ":"
+		    << servers[i].second.port << " unavailable, " << e.what() << endl;
+	}
+    }
+}
+
+}
@@ -0,0 +1,58 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_CAMERA_NETWORKCAMERAFACTORY_H
+#define WCL_CAMERA_NETWORKCAMERAFACTORY_H
+
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/camera/NetworkCamera.h>
+
+namespace wcl {
+
+/**
+ * Finds NetworkCameraServers on the local network that have discovery
+ * enabled. Discovery is a multicast request, so only servers on the same
+ * subnet (or reachable by multicast routing) are found.
+ */
+class WCL_API NetworkCameraFactory
+{
+public:
+    static std::vector<NetworkCamera *> getCameras();
+
+private:
+    NetworkCameraFactory();
+    ~NetworkCameraFactory();
+
+    void probeCameras();
+
+    static NetworkCameraFactory *instance;
+    static NetworkCameraFactory *getInstance();
+    static std::vector<NetworkCamera *> cameras;
+};
+
+};
+#endif
@@ -0,0 +1,253 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Private to the network camera, the wire format shared by
+ * NetworkCameraServer and NetworkCamera. Only include this from source files.
+ *
+ * Every message starts with a preamble: the magic number, the protocol
+ * version and the message type. All fields are little endian.
+ *
+ *  HELLO       server to client on connect/subscribe and in reply to DISCOVER:
+ *              port u16, transport u8, compression u8, width u16, height u16,
+ *              format u8, fps f32, id length u16, id
+ *  FRAME       frame u32, base u32, timestamp u64 (usec), kind u8, format u8,
+ *              x u16, y u16, width u16, height u16, payload size u32, payload.
+ *              A DELTA_FRAME carries the rows of the region x,y,width,height
+ *              and only applies to the frame numbered base.
+ *  CHUNK       UDP only, a piece of a FRAME message: frame u32, chunk u16,
+ *              chunk count u16, offset u32, frame message size u32, data
+ *  SUBSCRIBE   UDP only, client to server, flags u8. Must be repeated at
+ *              least every SUBSCRIPTION_TIMEOUT seconds.
+ *  UNSUBSCRIBE UDP only, client to server
+ *  DISCOVER    Sent to the discovery group, servers reply with HELLO
+ */
+#ifndef WCL_CAMERA_NETWORKCAMERAPROTOCOL_H
+#define WCL_CAMERA_NETWORKCAMERAPROTOCOL_H
+
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <wcl/camera/Camera.h>
+#include "../network/WireFormat.h"
+
+namespace wcl
+{
+namespace NetworkCameraProtocol
+{
+    const uint32_t MAGIC = 0x434c4357; // "WCLC"
+    const uint16_t PROTOCOL_VERSION = 1;
+
+    const unsigned DISCOVERY_PORT = 5600;
+    const char * const DISCOVERY_GROUP = "239.255.87.67";
+    const unsigned SUBSCRIPTION_TIMEOUT = 5;
+
+    enum MessageType { HELLO = 1, FRAME, CHUNK, SUBSCRIBE, UNSUBSCRIBE, DISCOVER };
+    enum FrameKind { KEY_FRAME = 0, DELTA_FRAME };
+
+    // SUBSCRIBE flags
+    const uint8_t REQUEST_KEY_FRAME = 1;
+
+    const size_t PREAMBLE_SIZE = 8;
+    const size_t FRAME_HEADER_SIZE = PREAMBLE_SIZE + 30;
+    const size_t CHUNK_HEADER_SIZE = PREAMBLE_SIZE + 16;
+
+    struct Hello {
+	uint16_t port;
+	uint8_t transport;
+	uint8_t compression;
+	uint16_t width;
+	uint16_t height;
+	uint8_t format;
+	float fps;
+	std::string id;
+    };
+
+    struct FrameHeader {
+	uint32_t frame;
+	uint32_t base;
+	uint64_t timestamp;
+	uint8_t kind;
+	uint8_t format;
+	uint16_t x;
+	uint16_t y;
+	uint16_t width;
+	uint16_t height;
+	uint32_t size;
+    };
+
+    struct ChunkHeader {
+	uint32_t frame;
+	uint16_t chunk;
+	uint16_t count;
+	uint32_t offset;
+	uint32_t total;
+    };
+
+    typedef WireWriter Writer;
+    typedef WireReader Reader;
+
+    inline void writePreamble(Writer &w, const MessageType type)
+    {
+	w.put32(MAGIC);
+	w.put16(PROTOCOL_VERSION);
+	w.put8(type);
+	w.put8(0);
+    }
+
+    /**
+     * Check the preamble and obtain the message type
+     *
+     * @return false if this is not a message we understand
+     */
+    inline bool readPreamble(Reader &r, MessageType &type)
+    {
+	uint32_t magic = r.get32();
+	uint16_t version = r.get16();
+	type = (MessageType)r.get8();
+	r.get8();
+	return r.ok() && magic == MAGIC && version == PROTOCOL_VERSION;
+    }
+
+    inline void writeHello(Writer &w, const Hello &h)
+    {
+	writePreamble(w, HELLO);
+	w.put16(h.port);
+	w.put8(h.transport);
+	w.put8(h.compression);
+	w.put16(h.width);
+	w.put16(h.height);
+	w.put8(h.format);
+	w.putFloat(h.fps);
+	w.putString(h.id);
+    }
+
+    inline bool readHello(Reader &r, Hello &h)
+    {
+	h.port = r.get16();
+	h.transport = r.get8();
+	h.compression = r.get8();
+	h.width = r.get16();
+	h.height = r.get16();
+	h.format = r.get8();
+	h.fps = r.getFloat();
+	h.id = r.getString();
+	return r.ok();
+    }
+
+    inline void writeFrameHeader(Writer &w, const FrameHeader &f)
+    {
+	writePreamble(w, FRAME);
+	w.put32(f.frame);
+	w.put32(f.base);
+	w.put64(f.timestamp);
+	w.put8(f.kind);
+	w.put8(f.format);
+	w.put16(f.x);
+	w.put16(f.y);
+	w.put16(f.width);
+	w.put16(f.height);
+	w.put32(f.size);
+    }
+
+    inline bool readFrameHeader(Reader &r, FrameHeader &f)
+    {
+	f.frame = r.get32();
+	f.base = r.get32();
+	f.timestamp = r.get64();
+	f.kind = r.get8();
+	f.format = r.get8();
+	f.x = r.get16();
+	f.y = r.get16();
+	f.width = r.get16();
+	f.height = r.get16();
+	f.size = r.get32();
+	return r.ok();
+    }
+
+    inline void writeChunkHeader(Writer &w, const ChunkHeader &c)
+    {
+	writePreamble(w, CHUNK);
+	w.put32(c.frame);
+	w.put16(c.chunk);
+	w.put16(c.count);
+	w.put32(c.offset);
+	w.put32(c.total);
+    }
+
+    inline bool readChunkHeader(Reader &r, ChunkHeader &c)
+    {
+	c.frame = r.get32();
+	c.chunk = r.get16();
+	c.count = r.get16();
+	c.offset = r.get32();
+	c.total = r.get32();
+	return r.ok();
+    }
+
+    /**
+     * Obtain how pixels of an uncompressed format are packed, as a number
+     * of bytes holding a number of pixels. Delta regions are aligned to
+     * these units.
+     *
+     * @return false if the format is compressed or unknown
+     */
+    inline bool getPixelPacking(const Camera::ImageFormat format,
+				unsigned &unitBytes, unsigned &unitPixels)
+    {
+	unitPixels = 1;
+	switch( format ){
+	    case Camera::MONO8:
+	    case Camera::RAW8:    unitBytes = 1; return true;
+	    case Camera::MONO16:
+	    case Camera::RAW16:   unitBytes = 2; return true;
+	    case Camera::RGB8:
+	    case Camera::BGR8:    unitBytes = 3; return true;
+	    case Camera::RGB16:   unitBytes = 6; return true;
+	    case Camera::RGB32:   unitBytes = 12; return true;
+	    case Camera::YUYV422: unitBytes = 4; unitPixels = 2; return true;
+	    case Camera::YUYV411: unitBytes = 6; unitPixels = 4; return true;
+	    default:
+		return false;
+	}
+    }
+
+    /**
+     * Obtain the size of one row of an uncompressed frame, or 0 if the
+     * format is compressed
+     */
+    inline size_t getRowSize(const Camera::ImageFormat format, const unsigned width)
+    {
+	unsigned unitBytes, unitPixels;
+	if( !getPixelPacking(format, unitBytes, unitPixels))
+	    return 0;
+	return (width / unitPixels) * unitBytes;
+    }
+};
+};
+
+#endif
@@ -0,0 +1,680 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <config.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/time.h>
+#include <netinet/tcp.h>
+
+#include <wcl/IO.h>
+#include <wcl/camera/NetworkCameraServer.h>
+#include "NetworkCameraProtocol.h"
+
+#if ENABLE_VIDEO
+#include <wcl/video/MJPEGEncoder.h>
+#endif
+
+// Without MSG_NOSIGNAL the SIGPIPE blocked by Socket does the job
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+using namespace std;
+
+namespace wcl
+{
+
+using namespace NetworkCameraProtocol;
+
+/**
+ * The background thread publishing frames, it simply calls
+ * NetworkCameraServer::update until stopped
+ */
+class NetworkCameraServer::ServerThread: public Thread
+{
+    public:
+	ServerThread(NetworkCameraServer *iserver): server(iserver) {}
+
+    protected:
+	void run()
+	{
+	    while( this->server->running ){
+		try {
+		    this->server->update();
+		} catch( Exception &e ){
+		    wclclog << "NetworkCameraServer: Stopping, " << e.what() << endl;
+		    this->server->running = false;
+		}
+	    }
+	}
+
+    private:
+	NetworkCameraServer *server;
+};
+
+static uint64_t getTimestamp()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+NetworkCameraServer::NetworkCameraServer(Camera *icamera, const unsigned iport,
+					 const Transport itransport) throw (SocketException):
+    camera(icamera), transport(itransport), port(iport),
+    tcpServer(NULL), udpServer(NULL), discoveryServer(NULL),
+    compression(RAW), quality(80), deltaUpdates(false), keyFrameInterval(30),
+    threshold(0), maxFrameRate(0), chunkSize(1400), encoder(NULL),
+    frameNumber(0), lastKeyFrame(0), lastSendTime(0), havePreviousFrame(false),
+    framesSent(0), bytesSent(0), running(false), thread(NULL)
+{
+    if( this->transport == TCP ){
+	this->tcpServer = new TCPServer(this->port);
+	this->tcpServer->setBlockingMode(Socket::NONBLOCKING);
+    } else {
+	this->udpServer = new UDPServer(this->port);
+	this->udpServer->setBlockingMode(Socket::NONBLOCKING);
+    }
+}
+
+NetworkCameraServer::~NetworkCameraServer()
+{
+    this->stop();
+
+    while( !this->clients.empty())
+	this->removeClient(this->clients.size() - 1);
+    for(unsigned i = 0; i < this->packets.size(); i++ )
+	delete this->packets[i];
+
+    delete this->tcpServer;
+    delete this->udpServer;
+    delete this->discoveryServer;
+#if ENABLE_VIDEO
+    delete this->encoder;
+#endif
+}
+
+void NetworkCameraServer::setCompression(const Compression c, const unsigned q) throw (CameraException)
+{
+    ScopedLock l(this->lock);
+    Camera::Configuration config = this->camera->getActiveConfiguration();
+
+#if ENABLE_VIDEO
+    delete this->encoder;
+    this->encoder = NULL;
+
+    if( c == MJPEG && config.format != Camera::MJPEG ){
+	try {
+	    this->encoder = new MJPEGEncoder(config.width, config.height, config.format, q);
+	} catch( const std::string & ){
+	    throw CameraException(CameraException::INVALIDFORMAT);
+	}
+    }
+#else
+    if( c == MJPEG && config.format != Camera::MJPEG )
+	throw CameraException(CameraException::INVALIDFORMAT);
+#endif
+
+    this->compression = c;
+    this->quality = q;
+
+    // The format of frames has changed, so deltas no longer apply
+    for(unsigned i = 0; i < this->clients.size(); i++ )
+	this->clients[i]->needKeyFrame = true;
+    this->havePreviousFrame = false;
+}
+
+void NetworkCameraServer::setDeltaUpdates(const bool enable, const unsigned interval,
+					  const unsigned ithreshold)
+{
+    ScopedLock l(this->lock);
+    this->deltaUpdates = enable;
+    this->keyFrameInterval = interval ? interval : 1;
+    this->threshold = ithreshold;
+    this->havePreviousFrame = false;
+}
+
+void NetworkCameraServer::setMaxFrameRate(const float fps)
+{
+    ScopedLock l(this->lock);
+    this->maxFrameRate = fps;
+}
+
+void NetworkCameraServer::setChunkSize(const unsigned size)
+{
+    ScopedLock l(this->lock);
+    this->chunkSize = size > CHUNK_HEADER_SIZE ? size : CHUNK_HEADER_SIZE + 1;
+}
+
+void NetworkCameraServer::setDiscoverable(const bool discoverable) throw (SocketException)
+{
+    ScopedLock l(this->lock);
+
+    if( discoverable && this->discoveryServer == NULL ){
+	this->discoveryServer = new UDPServer(DISCOVERY_PORT, DISCOVERY_GROUP);
+	this->discoveryServer->setBlockingMode(Socket::NONBLOCKING);
+    } else if( !discoverable ){
+	delete this->discoveryServer;
+	this->discoveryServer = NULL;
+    }
+}
+
+void NetworkCameraServer::start()
+{
+    if( this->running )
+	return;
+
+    this->running = true;
+    this->thread = new ServerThread(this);
+    this->thread->start();
+}
+
+void NetworkCameraServer::stop()
+{
+    this->running = false;
+    if( this->thread ){
+	this->thread->join();
+	delete this->thread;
+	this->thread = NULL;
+    }
+}
+
+bool NetworkCameraServer::isRunning() const
+{
+    return this->running;
+}
+
+unsigned NetworkCameraServer::getClientCount()
+{
+    ScopedLock l(this->lock);
+    return this->clients.size();
+}
+
+uint64_t NetworkCameraServer::getFramesSent()
+{
+    ScopedLock l(this->lock);
+    return this->framesSent;
+}
+
+uint64_t NetworkCameraServer::getBytesSent()
+{
+    ScopedLock l(this->lock);
+    return this->bytesSent;
+}
+
+void NetworkCameraServer::update()
+{
+    // Capture outside the lock, this waits for the camera
+    this->camera->update();
+    const unsigned char *frame = this->camera->getCurrentFrame();
+    uint64_t timestamp = getTimestamp();
+
+    ScopedLock l(this->lock);
+
+    try {
+	this->acceptClients();
+	this->readDatagrams();
+	this->answerDiscovery();
+    } catch( SocketException &e ){
+	wclclog << "NetworkCameraServer: " << e.what() << endl;
+    }
+
+    if( frame == NULL || this->clients.empty())
+	return;
+
+    double now = timestamp / 1000000.0;
+    if( this->maxFrameRate > 0 && now - this->lastSendTime < 1.0 / this->maxFrameRate )
+	return;
+    this->lastSendTime = now;
+
+    const unsigned char *payload = frame;
+    size_t size = this->getFrameSize(frame);
+    bool deltas = this->deltaUpdates && this->getWireFormat() != Camera::MJPEG;
+
+#if ENABLE_VIDEO
+    if( this->encoder ){
+	unsigned compressed;
+	payload = this->encoder->encode(frame, compressed);
+	if( payload == NULL )
+	    return;
+	size = compressed;
+    }
+#endif
+
+    this->frameNumber++;
+
+    bool keyFrame = !deltas || !this->havePreviousFrame ||
+	this->frameNumber - this->lastKeyFrame >= this->keyFrameInterval;
+    bool haveDelta = false;
+    if( !keyFrame )
+	haveDelta = this->buildDeltaMessage(frame, timestamp);
+    if( !haveDelta ){
+	keyFrame = true;
+	this->lastKeyFrame = this->frameNumber;
+    }
+
+    bool haveKey = false;
+    for(unsigned i = 0; i < this->clients.size(); i++ ){
+	Client *c = this->clients[i];
+	bool key = keyFrame || c->needKeyFrame;
+
+	if( key && !haveKey ){
+	    this->buildKeyMessage(payload, size, timestamp);
+	    haveKey = true;
+	}
+
+	const std::vector<unsigned char> &message = key ? this->keyMessage : this->deltaMessage;
+	bool sent = this->transport == TCP ? this->sendToClient(c, message)
+					   : this->sendDatagrams(c, message);
+	if( sent && key )
+	    c->needKeyFrame = false;
+	else if( !sent )
+	    c->needKeyFrame = true;
+    }
+
+    // Drop clients whose connection failed
+    for(unsigned i = this->clients.size(); i > 0; i-- ){
+	Client *c = this->clients[i - 1];
+	if( c->socket && !c->socket->isValid())
+	    this->removeClient(i - 1);
+    }
+
+    if( deltas ){
+	this->previousFrame.assign(frame, frame + size);
+	this->havePreviousFrame = true;
+    }
+    this->framesSent++;
+}
+
+Camera::ImageFormat NetworkCameraServer::getWireFormat() const
+{
+    Camera::ImageFormat format = this->camera->getActiveConfiguration().format;
+    if( this->compression == MJPEG )
+	return Camera::MJPEG;
+    return format;
+}
+
+size_t NetworkCameraServer::getFrameSize(const unsigned char *frame) const
+{
+    Camera::Configuration config = this->camera->getActiveConfiguration();
+
+    size_t rowSize = getRowSize(config.format, config.width);
+    if( rowSize )
+	return rowSize * config.height;
+
+    size_t bufferSize = this->camera->getFormatBufferSize();
+    if( config.format == Camera::MJPEG ){
+	// The image ends at the JPEG end of image marker
+	for(size_t i = 0; i + 1 < bufferSize; i++ ){
+	    if( frame[i] == 0xFF && frame[i + 1] == 0xD9 )
+		return i + 2;
+	}
+    }
+    return bufferSize;
+}
+
+std::vector<unsigned char> NetworkCameraServer::getHello()
+{
+    Camera::Configuration config = this->camera->getActiveConfiguration();
+    Hello h;
+    h.port = this->port;
+    h.transport = this->transport;
+    h.compression = this->compression;
+    h.width = config.width;
+    h.height = config.height;
+    h.format = this->getWireFormat();
+    h.fps = config.fps;
+    h.id = this->camera->getID();
+
+    std::vector<unsigned char> message;
+    Writer w(message);
+    writeHello(w, h);
+    return message;
+}
+
+void NetworkCameraServer::acceptClients()
+{
+    if( this->tcpServer == NULL )
+	return;
+
+    for(;;){
+	TCPSocket *s = new TCPSocket;
+	if( !this->tcpServer->accept(s)){
+	    delete s;
+	    return;
+	}
+
+	// Frames should leave as soon as they are written
+	int on = 1;
+	setsockopt(**s, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	s->setBlockingMode(Socket::NONBLOCKING);
+
+	Client *c = new Client;
+	c->socket = s;
+	memset(&c->address, 0, sizeof(c->address));
+	c->pending = this->getHello();
+	c->pendingOffset = 0;
+	c->needKeyFrame = true;
+	c->lastSeen = 0;
+	this->clients.push_back(c);
+	this->flushClient(c);
+    }
+}
+
+void NetworkCameraServer::readDatagrams()
+{
+    if( this->udpServer == NULL )
+	return;
+
+    unsigned char data[64];
+    UDPPacket packet(data, sizeof(data));
+    UDPPacket *p = &packet;
+    double now = getTimestamp() / 1000000.0;
+
+    while( this->udpServer->read(&p, 1, false) == 1 ){
+	Reader r(data, packet.getLength());
+	MessageType type;
+	if( !readPreamble(r, type))
+	    continue;
+
+	Client *c = this->findClient(packet.getRecipient());
+	if( type == SUBSCRIBE ){
+	    uint8_t flags = r.get8();
+	    if( c == NULL ){
+		c = new Client;
+		c->socket = NULL;
+		c->address = packet.getRecipient();
+		c->pendingOffset = 0;
+		c->needKeyFrame = true;
+		this->clients.push_back(c);
+
+		std::vector<unsigned char> hello = this->getHello();
+		UDPPacket reply(&hello[0], hello.size());
+		reply.setRecipient(c->address);
+		this->udpServer->write(&reply);
+	    }
+	    c->lastSeen = now;
+	    if( flags & REQUEST_KEY_FRAME )
+		c->needKeyFrame = true;
+	}
+	else if( type == UNSUBSCRIBE && c != NULL ){
+	    c->lastSeen = 0;
+	}
+    }
+
+    // Forget subscribers that have gone quiet
+    for(unsigned i = this->clients.size(); i > 0; i-- ){
+	if( now - this->clients[i - 1]->lastSeen > SUBSCRIPTION_TIMEOUT )
+	    this->removeClient(i - 1);
+    }
+}
+
+void NetworkCameraServer::answerDiscovery()
+{
+    if( this->discoveryServer == NULL )
+	return;
+
+    unsigned char data[64];
+    UDPPacket packet(data, sizeof(data));
+    UDPPacket *p = &packet;
+
+    while( this->discoveryServer->read(&p, 1, false) == 1 ){
+	Reader r(data, packet.getLength());
+	MessageType type;
+	if( !readPreamble(r, type) || type != DISCOVER )
+	    continue;
+
+	std::vector<unsigned char> hello = this->getHello();
+	UDPPacket reply(&hello[0], hello.size());
+	reply.setRecipient(packet.getRecipient());
+	this->discoveryServer->write(&reply);
+    }
+}
+
+NetworkCameraServer::Client *NetworkCameraServer::findClient(const sockaddr_in &address)
+{
+    for(unsigned i = 0; i < this->clients.size(); i++ ){
+	Client *c = this->clients[i];
+	if( c->address.sin_addr.s_addr == address.sin_addr.s_addr &&
+	    c->address.sin_port == address.sin_port )
+	    return c;
+    }
+    return NULL;
+}
+
+void NetworkCameraServer::removeClient(const unsigned index)
+{
+    Client *c = this->clients[index];
+    delete c->socket;
+    delete c;
+    this->clients.erase(this->clients.begin() + index);
+}
+
+void NetworkCameraServer::buildKeyMessage(const unsigned char *payload, const size_t size,
+					  const uint64_t timestamp)
+{
+    Camera::Configuration config = this->camera->getActiveConfiguration();
+    FrameHeader h;
+    h.frame = this->frameNumber;
+    h.base = this->frameNumber;
+    h.timestamp = timestamp;
+    h.kind = KEY_FRAME;
+    h.format = this->getWireFormat();
+    h.x = 0;
+    h.y = 0;
+    h.width = config.width;
+    h.height = config.height;
+    h.size = size;
+
+    this->keyMessage.clear();
+    Writer w(this->keyMessage);
+    writeFrameHeader(w, h);
+    this->keyMessage.insert(this->keyMessage.end(), payload, payload + size);
+}
+
+/**
+ * Does any byte of a pixel differ by more than the threshold
+ */
+static bool hasChanged(const unsigned char *a, const unsigned char *b,
+		       const unsigned size, const unsigned threshold)
+{
+    for(unsigned i = 0; i < size; i++ ){
+	int difference = (int)a[i] - (int)b[i];
+	if( difference > (int)threshold || -difference > (int)threshold )
+	    return true;
+    }
+    return false;
+}
+
+bool NetworkCameraServer::buildDeltaMessage(const unsigned char *frame, const uint64_t timestamp)
+{
+    Camera::Configuration config = this->camera->getActiveConfiguration();
+    unsigned unitBytes, unitPixels;
+    if( !getPixelPacking(config.format, unitBytes, unitPixels))
+	return false;
+
+    size_t rowSize = getRowSize(config.format, config.width);
+    if( this->previousFrame.size() != rowSize * config.height )
+	return false;
+
+    // Find the bounding box of the changed pixels, in units
+    unsigned units = config.width / unitPixels;
+    unsigned top = config.height, bottom = 0, left = units, right = 0;
+    for(unsigned y = 0; y < config.height; y++ ){
+	const unsigned char *row = frame + y * rowSize;
+	const unsigned char *previous = &this->previousFrame[y * rowSize];
+	if( memcmp(row, previous, rowSize) == 0 )
+	    continue;
+
+	unsigned first = 0;
+	while( first < units && !hasChanged(row + first * unitBytes, previous + first * unitBytes,
+					    unitBytes, this->threshold))
+	    first++;
+	if( first == units )
+	    continue;
+
+	unsigned last = units - 1;
+	while( last > first && !hasChanged(row + last * unitBytes, previous + last * unitBytes,
+					   unitBytes, this->threshold))
+	    last--;
+
+	top = y < top ? y : top;
+	bottom = y;
+	left = first < left ? first : left;
+	right = last > right ? last : right;
+    }
+
+    FrameHeader h;
+    h.frame = this->frameNumber;
+    h.base = this->frameNumber - 1;
+    h.timestamp = timestamp;
+    h.kind = DELTA_FRAME;
+    h.format = config.format;
+    h.x = h.y = h.width = h.height = 0;
+
+    // Nothing changed, the delta has an empty region
+    if( top < config.height ){
+	h.x = left * unitPixels;
+	h.y = top;
+	h.width = (right - left + 1) * unitPixels;
+	h.height = bottom - top + 1;
+    }
+    size_t regionRowSize = (h.width / unitPixels) * unitBytes;
+    h.size = regionRowSize * h.height;
+
+    this->deltaMessage.clear();
+    Writer w(this->deltaMessage);
+    writeFrameHeader(w, h);
+    for(unsigned y = h.y; y < (unsigned)(h.y + h.height); y++ ){
+	const unsigned char *start = frame + y * rowSize + left * unitBytes;
+	this->deltaMessage.insert(this->deltaMessage.end(), start, start + regionRowSize);
+    }
+    return true;
+}
+
+/**
+ * Write as much of a clients queued data as the socket takes
+ *
+ * @return true if nothing remains queued
+ */
+bool NetworkCameraServer::flushClient(Client *c)
+{
+    while( c->pendingOffset < c->pending.size()){
+	ssize_t amount = ::send(**c->socket, &c->pending[c->pendingOffset],
+				c->pending.size() - c->pendingOffset, MSG_DONTWAIT | MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno != EAGAIN && errno != EWOULDBLOCK )
+		c->socket->close();
+	    return false;
+	}
+	c->pendingOffset += amount;
+	this->bytesSent += amount;
+    }
+
+    c->pending.clear();
+    c->pendingOffset = 0;
+    return true;
+}
+
+/**
+ * Send a frame to a TCP client. A client still busy with the previous frame
+ * skips this one.
+ *
+ * @return true if the frame was sent or queued
+ */
+bool NetworkCameraServer::sendToClient(Client *c, const std::vector<unsigned char> &message)
+{
+    if( !c->socket->isValid() || !this->flushClient(c))
+	return false;
+
+    // Write directly, only the part that doesn't fit is copied
+    size_t offset = 0;
+    while( offset < message.size()){
+	ssize_t amount = ::send(**c->socket, &message[offset], message.size() - offset,
+				MSG_DONTWAIT | MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno != EAGAIN && errno != EWOULDBLOCK ){
+		c->socket->close();
+		return false;
+	    }
+	    break;
+	}
+	offset += amount;
+	this->bytesSent += amount;
+    }
+
+    c->pending.assign(message.begin() + offset, message.end());
+    c->pendingOffset = 0;
+    return true;
+}
+
+/**
+ * Send a frame to a UDP client as a series of chunks
+ *
+ * @return true if every chunk was sent
+ */
+bool NetworkCameraServer::sendDatagrams(Client *c, const std::vector<unsigned char> &message)
+{
+    size_t dataSize = this->chunkSize - CHUNK_HEADER_SIZE;
+    unsigned count = (message.size() + dataSize - 1) / dataSize;
+
+    this->chunks.clear();
+    Writer w(this->chunks);
+    for(unsigned i = 0; i < count; i++ ){
+	ChunkHeader h;
+	h.frame = this->frameNumber;
+	h.chunk = i;
+	h.count = count;
+	h.offset = i * dataSize;
+	h.total = message.size();
+	writeChunkHeader(w, h);
+
+	size_t end = h.offset + dataSize < message.size() ? h.offset + dataSize : message.size();
+	this->chunks.insert(this->chunks.end(), message.begin() + h.offset, message.begin() + end);
+    }
+
+    while( this->packets.size() < count )
+	this->packets.push_back(new UDPPacket(&this->chunks[0], 1));
+
+    size_t offset = 0;
+    for(unsigned i = 0; i < count; i++ ){
+	size_t size = CHUNK_HEADER_SIZE + (i + 1 < count ? dataSize : message.size() - i * dataSize);
+	this->packets[i]->setData(&this->chunks[offset], size);
+	this->packets[i]->setRecipient(c->address);
+	offset += size;
+    }
+
+    unsigned sent = this->udpServer->write(&this->packets[0], count);
+    this->bytesSent += sent == count ? this->chunks.size() : 0;
+    return sent == count;
+}
+
+};
@@ -0,0 +1,207 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_CAMERA_NETWORKCAMERASERVER_H
+#define WCL_CAMERA_NETWORKCAMERASERVER_H
+
+#include <stdint.h>
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/camera/Camera.h>
+#include <wcl/camera/CameraException.h>
+#include <wcl/network/TCPServer.h>
+#include <wcl/network/UDPServer.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+	class MJPEGEncoder;
+
+	/**
+	 * Publish the frames of a local camera to NetworkCamera clients so a
+	 * single camera can be shared between several machines.
+	 *
+	 * Frames are sent either over TCP, where every client has its own
+	 * connection and a client that can't keep up skips frames, or as
+	 * chunked UDP datagrams to subscribed clients, where a lost chunk
+	 * only loses that frame. Frames can be sent raw or MJPEG compressed.
+	 * Raw frames can be sent as delta updates that only carry the region
+	 * of the image that changed, with a full key frame at a fixed
+	 * interval and whenever a client needs one.
+	 *
+	 * Servers can also answer discovery requests, which is how
+	 * CameraFactory finds cameras in the NETWORK scope.
+	 */
+	class WCL_API NetworkCameraServer
+	{
+		public:
+			enum Transport { TCP, UDP };
+			enum Compression { RAW, MJPEG };
+
+			static const unsigned DEFAULT_PORT = 5601;
+
+			/**
+			 * Create a server for the given camera. The camera
+			 * should already be configured and started.
+			 *
+			 * @param camera The camera to publish, this is not owned by the server
+			 * @param port The port to listen on
+			 * @param transport How frames are sent to clients
+			 * @throw SocketException if the port can't be used
+			 */
+			NetworkCameraServer(Camera *camera, const unsigned port = DEFAULT_PORT,
+					    const Transport transport = TCP) throw (SocketException);
+			~NetworkCameraServer();
+
+			/**
+			 * Choose how frames are compressed. Cameras that already
+			 * produce MJPEG are always sent as is.
+			 *
+			 * @param compression Send raw frames or compress them
+			 * @param quality The MJPEG image quality from 1 to 100
+			 * @throw CameraException if MJPEG compression isn't
+			 *        available for the camera format
+			 */
+			void setCompression(const Compression compression, const unsigned quality = 80) throw (CameraException);
+
+			/**
+			 * Enable sending only the changed region of raw frames.
+			 *
+			 * @param enable Send deltas if true, full frames otherwise
+			 * @param keyFrameInterval Send a full frame at least this often
+			 * @param threshold Byte differences no larger than this are
+			 *                  ignored, to hide sensor noise
+			 */
+			void setDeltaUpdates(const bool enable, const unsigned keyFrameInterval = 30,
+					     const unsigned threshold = 0);
+
+			/**
+			 * Limit the rate frames are sent at to reduce bandwidth,
+			 * 0 sends every frame the camera produces
+			 */
+			void setMaxFrameRate(const float fps);
+
+			/**
+			 * Set the largest UDP datagram payload, this should fit
+			 * the network MTU
+			 */
+			void setChunkSize(const unsigned size);
+
+			/**
+			 * Answer discovery requests from NetworkCameraFactory
+			 *
+			 * @throw SocketException if the discovery port can't be used
+			 */
+			void setDiscoverable(const bool discoverable) throw (SocketException);
+
+			/**
+			 * Accept new clients, capture a frame from the camera and
+			 * send it to every client. This blocks while the camera
+			 * waits for a frame.
+			 */
+			void update();
+
+			/**
+			 * Call update continuously from a background thread
+			 */
+			void start();
+			void stop();
+			bool isRunning() const;
+
+			unsigned getClientCount();
+			uint64_t getFramesSent();
+			uint64_t getBytesSent();
+
+		private:
+			struct Client {
+				TCPSocket *socket;
+				sockaddr_in address;
+				std::vector<unsigned char> pending;
+				size_t pendingOffset;
+				bool needKeyFrame;
+				double lastSeen;
+			};
+
+			class ServerThread;
+			friend class ServerThread;
+
+			Camera *camera;
+			Transport transport;
+			unsigned port;
+			TCPServer *tcpServer;
+			UDPServer *udpServer;
+			UDPServer *discoveryServer;
+			std::vector<Client *> clients;
+
+			// Settings
+			Compression compression;
+			unsigned quality;
+			bool deltaUpdates;
+			unsigned keyFrameInterval;
+			unsigned threshold;
+			float maxFrameRate;
+			unsigned chunkSize;
+			MJPEGEncoder *encoder;
+
+			// Frame state
+			uint32_t frameNumber;
+			uint32_t lastKeyFrame;
+			double lastSendTime;
+			std::vector<unsigned char> previousFrame;
+			bool havePreviousFrame;
+			std::vector<unsigned char> keyMessage;
+			std::vector<unsigned char> deltaMessage;
+			std::vector<unsigned char> chunks;
+			std::vector<UDPPacket *> packets;
+			uint64_t framesSent;
+			uint64_t bytesSent;
+
+			volatile bool running;
+			ServerThread *thread;
+			Mutex lock;
+
+			void acceptClients();
+			void readDatagrams();
+			void answerDiscovery();
+			std::vector<unsigned char> getHello();
+			Client *findClient(const sockaddr_in &address);
+			void removeClient(const unsigned index);
+
+			Camera::ImageFormat getWireFormat() const;
+			size_t getFrameSize(const unsigned char *frame) const;
+			void buildKeyMessage(const unsigned char *frame, const size_t size, const uint64_t timestamp);
+			bool buildDeltaMessage(const unsigned char *frame, const uint64_t timestamp);
+			bool flushClient(Client *c);
+			bool sendToClient(Client *c, const std::vector<unsigned char> &message);
+			bool sendDatagrams(Client *c, const std::vector<unsigned char> &message);
+
+			// Not copyable
+			NetworkCameraServer(const NetworkCameraServer &);
+			NetworkCameraServer &operator =(const NetworkCameraServer &);
+	};
+};
+
+#endif
@@ -0,0 +1,244 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include <wcl/IO.h>
+#include <wcl/camera/SharedMemoryCamera.h>
+#include <wcl/util/SharedMemoryRing.h>
+#include "SharedMemoryCameraProtocol.h"
+
+using namespace std;
+
+namespace wcl
+{
+
+using namespace SharedMemoryCameraProtocol;
+
+SharedMemoryCamera::SharedMemoryCamera(const std::string &iname, const int itimeout) throw (CameraException):
+    name(iname), timeout(itimeout), copyFrames(false), ring(NULL), sequence(0),
+    haveFrame(false), frameNumber(0), frameTimestamp(0), droppedFrames(0)
+{
+    this->connect();
+}
+
+SharedMemoryCamera::~SharedMemoryCamera()
+{
+    this->disconnect();
+}
+
+void SharedMemoryCamera::connect() throw (CameraException)
+{
+    try {
+	this->ring = new SharedMemoryRing(this->name);
+    } catch( Exception &e ){
+	wclclog << "SharedMemoryCamera: Can't attach to " << this->name << ", " << e.what() << endl;
+	throw CameraException(CameraException::CONNECTIONISSUE);
+    }
+
+    // A new publisher numbers its frames from the start again
+    this->sequence = 0;
+    this->haveFrame = false;
+    while( this->ring->wait(0, this->timeout)){
+	if( this->readFrame())
+	    return;
+    }
+
+    wclclog << "SharedMemoryCamera: No frames from " << this->name << endl;
+    this->disconnect();
+    throw CameraException(CameraException::CONNECTIONISSUE);
+}
+
+void SharedMemoryCamera::disconnect()
+{
+    // The current frame lives in the ring unless it was copied
+    if( !this->isFrameCopied())
+	this->currentFrame = NULL;
+
+    delete this->ring;
+    this->ring = NULL;
+}
+
+/**
+ * Make the latest frame in the ring the current frame
+ *
+ * @return false if the frame was overwritten while reading it
+ */
+bool SharedMemoryCamera::readFrame()
+{
+    uint64_t latest;
+    size_t length;
+    const unsigned char *data = this->ring->read(latest, length);
+    if( data == NULL || length < FRAME_HEADER_SIZE )
+	return false;
+
+    FrameHeader h;
+    memcpy(&h, data, sizeof(h));
+    if( !this->ring->isValid(latest) || h.magic != MAGIC || h.size > length - FRAME_HEADER_SIZE )
+	return false;
+
+    Configuration &active = this->activeConfiguration;
+    if( !this->haveFrame || (ImageFormat)h.format != active.format ||
+	h.width != active.width || h.height != active.height ){
+	Configuration c;
+	c.format = (ImageFormat)h.format;
+	c.width = h.width;
+	c.height = h.height;
+	c.fps = h.fps;
+	this->supportedConfigurations.clear();
+	this->supportedConfigurations.push_back(c);
+	Camera::setConfiguration(c);
+
+	h.id[ID_LENGTH - 1] = '\0';
+	this->id = "SHM:" + this->name + "/" + h.id;
+    }
+
+    const unsigned char *payload = data + FRAME_HEADER_SIZE;
+    if( this->copyFrames ){
+	size_t bufferSize = this->getFormatBufferSize();
+	this->frame.resize(bufferSize > h.size ? bufferSize : h.size);
+	memcpy(&this->frame[0], payload, h.size);
+	if( !this->ring->isValid(latest))
+	    return false;
+	this->currentFrame = &this->frame[0];
+    } else {
+	this->currentFrame = const_cast<unsigned char *>(payload);
+    }
+
+    if( this->haveFrame && latest > this->sequence + 1 )
+	this->droppedFrames += latest - this->sequence - 1;
+
+    this->haveFrame = true;
+    this->sequence = latest;
+    this->frameNumber = h.number;
+    this->frameTimestamp = h.timestamp;
+    return true;
+}
+
+void SharedMemoryCamera::printDetails(bool full)
+{
+    Camera::printDetails(full);
+    if( full ){
+	wclclog << "| Shared Memory: " << this->name
+		<< (this->copyFrames ? " (copied)" : " (in place)") << endl;
+	wclclog << "| Dropped Frames: " << this->droppedFrames << endl;
+    }
+}
+
+void SharedMemoryCamera::setConfiguration(const Configuration &c)
+{
+    const Configuration &active = this->activeConfiguration;
+    if( c.format != active.format || c.width != active.width || c.height != active.height )
+	throw CameraException(CameraException::INVALIDCONFIGURATION);
+}
+
+void SharedMemoryCamera::setExposureMode(const ExposureMode)
+{
+    throw CameraException(CameraException::EXPOSUREERROR);
+}
+
+void SharedMemoryCamera::setControlValue(const Control, const int)
+{
+    throw CameraException(CameraException::CONTROLERROR);
+}
+
+int SharedMemoryCamera::getControlValue(const Control)
+{
+    throw CameraException(CameraException::CONTROLERROR);
+}
+
+void SharedMemoryCamera::update()
+{
+    if( this->ring == NULL ){
+	this->connect();
+	return;
+    }
+
+    for(;;){
+	if( !this->ring->wait(this->sequence, this->timeout)){
+	    if( this->ring->isClosed()){
+		wclclog << "SharedMemoryCamera: " << this->name << " is no longer published" << endl;
+		this->disconnect();
+	    }
+	    throw CameraException(CameraException::CONNECTIONISSUE);
+	}
+
+	if( this->readFrame())
+	    return;
+    }
+}
+
+void SharedMemoryCamera::startup()
+{
+    if( this->ring == NULL )
+	this->connect();
+}
+
+void SharedMemoryCamera::shutdown()
+{
+    this->disconnect();
+}
+
+void SharedMemoryCamera::setTimeout(const int itimeout)
+{
+    this->timeout = itimeout;
+}
+
+void SharedMemoryCamera::setCopyFrames(const bool copy)
+{
+    this->copyFrames = copy;
+}
+
+bool SharedMemoryCamera::isCurrentFrameValid() const
+{
+    if( this->currentFrame == NULL )
+	return false;
+    if( this->isFrameCopied())
+	return true;
+    return this->ring != NULL && this->ring->isValid(this->sequence);
+}
+
+bool SharedMemoryCamera::isFrameCopied() const
+{
+    return !this->frame.empty() && this->currentFrame == &this->frame[0];
+}
+
+uint32_t SharedMemoryCamera::getFrameNumber() const
+{
+    return this->frameNumber;
+}
+
+uint64_t SharedMemoryCamera::getFrameTimestamp() const
+{
+    return this->frameTimestamp;
+}
+
+unsigned SharedMemoryCamera::getDroppedFrames() const
+{
+    return this->droppedFrames;
+}
+
+};
@@ -0,0 +1,148 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_CAMERA_SHAREDMEMORYCAMERA_H
+#define WCL_CAMERA_SHAREDMEMORYCAMERA_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/camera/Camera.h>
+#include <wcl/camera/CameraException.h>
+
+namespace wcl
+{
+	class SharedMemoryRing;
+
+	/**
+	 * A camera published by a SharedMemoryCameraPublisher in another
+	 * process on the same machine.
+	 *
+	 * Frames are not copied, getCurrentFrame points straight into the
+	 * shared memory. The publisher only overwrites a frame once it has
+	 * gone around the whole ring, so the current frame stays intact for
+	 * a few frames after update returns; isCurrentFrameValid says whether
+	 * it still is. Processing that can take longer than that should
+	 * enable setCopyFrames.
+	 *
+	 * update always moves to the newest frame, frames skipped on the way
+	 * are counted as dropped.
+	 */
+	class WCL_API SharedMemoryCamera: public Camera
+	{
+		public:
+			/**
+			 * Attach to a published camera and wait for its first
+			 * frame
+			 *
+			 * @param name The name the camera was published with
+			 * @param timeout How long to wait for a frame in
+			 *                milliseconds, -1 waits forever
+			 * @throw CameraException if there is no such camera or
+			 *        no frame arrived in time
+			 */
+			SharedMemoryCamera(const std::string &name, const int timeout = 2000) throw (CameraException);
+			~SharedMemoryCamera();
+
+			// Overrides of Camera
+			virtual void printDetails(bool full = true);
+			virtual void setConfiguration(const Configuration &c);
+			virtual void setExposureMode(const ExposureMode t);
+			virtual void setControlValue(const Control control, const int value);
+			virtual int getControlValue(const Control control);
+
+			/**
+			 * Wait for a frame newer than the current one
+			 *
+			 * @throw CameraException if the publisher has gone or
+			 *        no frame arrived within the timeout
+			 */
+			virtual void update();
+			virtual void startup();
+			virtual void shutdown();
+
+			/**
+			 * Set how long update waits for a frame
+			 *
+			 * @param timeout The time in milliseconds, -1 to wait forever
+			 */
+			void setTimeout(const int timeout);
+
+			/**
+			 * Copy each frame out of the shared memory rather than
+			 * reading it in place
+			 */
+			void setCopyFrames(const bool copy);
+
+			/**
+			 * Has the publisher started overwriting the current frame
+			 */
+			bool isCurrentFrameValid() const;
+
+			/**
+			 * The number the publisher gave the current frame
+			 */
+			uint32_t getFrameNumber() const;
+
+			/**
+			 * When the publisher captured the current frame, in
+			 * microseconds since the epoch
+			 */
+			uint64_t getFrameTimestamp() const;
+
+			/**
+			 * The number of frames published that this camera skipped
+			 */
+			unsigned getDroppedFrames() const;
+
+		protected:
+			const char *getTypeIdentifier() const { return "SHM"; }
+
+		private:
+			std::string name;
+			int timeout;
+			bool copyFrames;
+
+			SharedMemoryRing *ring;
+			uint64_t sequence;
+			std::vector<unsigned char> frame;
+
+			bool haveFrame;
+			uint32_t frameNumber;
+			uint64_t frameTimestamp;
+			unsigned droppedFrames;
+
+			void connect() throw (CameraException);
+			void disconnect();
+			bool readFrame();
+			bool isFrameCopied() const;
+
+			SharedMemoryCamera(const SharedMemoryCamera &);
+			SharedMemoryCamera &operator =(const SharedMemoryCamera &);
+	};
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+/*
+ * Private to the shared memory camera, the layout of a frame in the ring
+ * shared by SharedMemoryCameraPublisher and SharedMemoryCamera. Only include
+ * this from source files.
+ *
+ * Both ends are on the same host, so the header is a plain struct in host
+ * byte order. The image follows the header at FRAME_HEADER_SIZE, which keeps
+ * it cache line aligned.
+ */
+#ifndef WCL_CAMERA_SHAREDMEMORYCAMERAPROTOCOL_H
+#define WCL_CAMERA_SHAREDMEMORYCAMERAPROTOCOL_H
+
+#include <stdint.h>
+
+namespace wcl
+{
+namespace SharedMemoryCameraProtocol
+{
+    const uint32_t MAGIC = 0x534c4357; // "WCLS"
+
+    const size_t FRAME_HEADER_SIZE = 128;
+    const size_t ID_LENGTH = 64;
+
+    struct FrameHeader {
+	uint32_t magic;
+	uint32_t number;
+	uint32_t format;
+	uint32_t width;
+	uint32_t height;
+	float fps;
+	uint64_t size;
+	uint64_t timestamp; // usec since the epoch
+	char id[ID_LENGTH];
+    };
+};
+};
+
+#endif
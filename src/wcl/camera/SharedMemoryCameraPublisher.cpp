@@ -0,0 +1,152 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <sys/time.h>
+
+#include <wcl/IO.h>
+#include <wcl/camera/SharedMemoryCameraPublisher.h>
+#include <wcl/util/SharedMemoryRing.h>
+#include "SharedMemoryCameraProtocol.h"
+
+using namespace std;
+
+namespace wcl
+{
+
+using namespace SharedMemoryCameraProtocol;
+
+/**
+ * Captures and publishes frames until stopped
+ */
+class SharedMemoryCameraPublisher::PublisherThread: public Thread
+{
+    public:
+	PublisherThread(SharedMemoryCameraPublisher *ipublisher): publisher(ipublisher) {}
+
+    protected:
+	void run()
+	{
+	    while( this->publisher->running ){
+		try {
+		    this->publisher->update();
+		} catch( Exception &e ){
+		    wclclog << "SharedMemoryCameraPublisher: Stopping, " << e.what() << endl;
+		    this->publisher->running = false;
+		}
+	    }
+	}
+
+    private:
+	SharedMemoryCameraPublisher *publisher;
+};
+
+SharedMemoryCameraPublisher::SharedMemoryCameraPublisher(Camera *icamera, const std::string &iname,
+							 const unsigned slots, const mode_t mode) throw (Exception):
+    camera(icamera), name(iname), ring(NULL), frameNumber(0), running(false), thread(NULL)
+{
+    this->ring = new SharedMemoryRing(this->name, slots,
+				      FRAME_HEADER_SIZE + this->camera->getFormatBufferSize(), mode);
+}
+
+SharedMemoryCameraPublisher::~SharedMemoryCameraPublisher()
+{
+    this->stop();
+    delete this->ring;
+}
+
+void SharedMemoryCameraPublisher::publish()
+{
+    const unsigned char *image = this->camera->getCurrentFrame();
+    if( image == NULL )
+	return;
+
+    Camera::Configuration c = this->camera->getActiveConfiguration();
+    size_t size = this->camera->getFormatBufferSize();
+    if( FRAME_HEADER_SIZE + size > this->ring->getSlotSize()){
+	wclclog << "SharedMemoryCameraPublisher: Frame too large for " << this->name
+		<< ", the camera configuration changed" << endl;
+	return;
+    }
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+
+    FrameHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = MAGIC;
+    h.number = ++this->frameNumber;
+    h.format = c.format;
+    h.width = c.width;
+    h.height = c.height;
+    h.fps = c.fps;
+    h.size = size;
+    h.timestamp = (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    strncpy(h.id, this->camera->getID().c_str(), ID_LENGTH - 1);
+
+    unsigned char *slot = this->ring->beginWrite();
+    memcpy(slot, &h, sizeof(h));
+    memcpy(slot + FRAME_HEADER_SIZE, image, size);
+    this->ring->endWrite(FRAME_HEADER_SIZE + size);
+}
+
+void SharedMemoryCameraPublisher::update()
+{
+    this->camera->update();
+    this->publish();
+}
+
+void SharedMemoryCameraPublisher::start()
+{
+    if( this->running )
+	return;
+
+    this->running = true;
+    this->thread = new PublisherThread(this);
+    this->thread->start();
+}
+
+void SharedMemoryCameraPublisher::stop()
+{
+    this->running = false;
+    if( this->thread ){
+	this->thread->join();
+	delete this->thread;
+	this->thread = NULL;
+    }
+}
+
+bool SharedMemoryCameraPublisher::isRunning() const
+{
+    return this->running;
+}
+
+uint64_t SharedMemoryCameraPublisher::getFramesPublished() const
+{
+    return this->ring->getSequence();
+}
+
+};
@@ -0,0 +1,112 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_CAMERA_SHAREDMEMORYCAMERAPUBLISHER_H
+#define WCL_CAMERA_SHAREDMEMORYCAMERAPUBLISHER_H
+
+#include <stdint.h>
+#include <string>
+#include <sys/types.h>
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+#include <wcl/camera/Camera.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+	class SharedMemoryRing;
+
+	/**
+	 * Publish the frames of a local camera to SharedMemoryCameras in other
+	 * processes on the same machine, so several programs can use one
+	 * camera without going through the network stack.
+	 *
+	 * Each frame is copied once, from the camera into a ring of frames in
+	 * shared memory, and read in place by every SharedMemoryCamera. The
+	 * publisher never waits for readers.
+	 */
+	class WCL_API SharedMemoryCameraPublisher
+	{
+		public:
+			static const unsigned DEFAULT_SLOTS = 4;
+
+			/**
+			 * Create the shared memory for the given camera. The
+			 * camera should already be configured and started, the
+			 * ring is sized for its current configuration.
+			 *
+			 * @param camera The camera to publish, this is not owned by the publisher
+			 * @param name The name readers attach with
+			 * @param slots The number of frames in the ring, a frame
+			 *              stays intact until slots - 1 newer frames
+			 *              have been published
+			 * @param mode The permissions of the shared memory, only
+			 *             the current user can attach by default
+			 * @throw Exception if the shared memory can't be created
+			 */
+			SharedMemoryCameraPublisher(Camera *camera, const std::string &name,
+						    const unsigned slots = DEFAULT_SLOTS,
+						    const mode_t mode = 0600) throw (Exception);
+			~SharedMemoryCameraPublisher();
+
+			/**
+			 * Publish the current frame of the camera without
+			 * updating it
+			 */
+			void publish();
+
+			/**
+			 * Capture a frame from the camera and publish it. This
+			 * blocks while the camera waits for a frame.
+			 */
+			void update();
+
+			/**
+			 * Call update continuously from a background thread
+			 */
+			void start();
+			void stop();
+			bool isRunning() const;
+
+			uint64_t getFramesPublished() const;
+
+		private:
+			class PublisherThread;
+			friend class PublisherThread;
+
+			Camera *camera;
+			std::string name;
+			SharedMemoryRing *ring;
+			uint32_t frameNumber;
+
+			volatile bool running;
+			PublisherThread *thread;
+
+			SharedMemoryCameraPublisher(const SharedMemoryCameraPublisher &);
+			SharedMemoryCameraPublisher &operator =(const SharedMemoryCameraPublisher &);
+	};
+};
+
+#endif
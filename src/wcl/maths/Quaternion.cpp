@@ -170,14 +170,41 @@ namespace wcl
 		z *= imag;
 	}
 	
+	Quaternion Quaternion::slerp(const Quaternion& q, T t) const
+	{
+		T cosine = w*q.w + x*q.x + y*q.y + z*q.z;
+		T sign = 1.0;
+		if (cosine < 0)
+		{
+			cosine = -cosine;
+			sign = -1.0;
+		}
+
+		T a = 1.0 - t;
+		T b = t;
+		// nearly the same rotation, lerp to avoid dividing by sin(0)
+		if (cosine < 0.9995)
+		{
+			T angle = acos(cosine);
+			T s = 1.0 / sin(angle);
+			a = sin(a * angle) * s;
+			b = sin(b * angle) * s;
+		}
+		b *= sign;
+
+		Quaternion r(a*w + b*q.w, a*x + b*q.x, a*y + b*q.y, a*z + b*q.z);
+		r.normalise();
+		return r;
+	}
+
 	wcl::Quaternion Quaternion::operator * (const Quaternion& B) const
 	{
 		// this follows closely realtime rendering, 2nd ed. pg72ff
 		return Quaternion(
+				w*B.w - x*B.x - y*B.y - z*B.z,
 				w*B.x + x*B.w + y*B.z - z*B.y,
 				w*B.y - x*B.z + y*B.w + z*B.x,
-				w*B.z + x*B.y - y*B.x + z*B.w,
-				w*B.w - x*B.x - y*B.y - z*B.z);
+				w*B.z + x*B.y - y*B.x + z*B.w);
 	}
 
     bool Quaternion::operator == (const Quaternion &iq) const
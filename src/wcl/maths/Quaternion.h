@@ -96,6 +96,13 @@ namespace wcl
 			*/
 			void normalise();
 
+			/**
+			 * Spherical linear interpolation from this rotation to q,
+			 * along the shorter arc. Values of t outside 0..1
+			 * extrapolate along the same arc.
+			 */
+			Quaternion slerp(const Quaternion& q, T t) const;
+
 			/// \}
 
 			Quaternion operator * (const Quaternion& rhs) const;
@@ -0,0 +1,366 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <algorithm>
+
+#include "AsyncTCPSocket.h"
+
+namespace wcl {
+
+/**
+ * Takes over connections that have been abandoned, so the reactor has
+ * someone to tell while they finish closing
+ */
+class DetachedHandler : public TCPConnectionHandler
+{
+    public:
+	virtual void dataReceived( TCPConnection *c )
+	{
+	    c->consume(c->getReadSize());
+	}
+};
+
+static DetachedHandler detachedHandler;
+
+/**
+ * Notices the socket being deleted while a handler is being called
+ */
+class AsyncTCPSocket::Guard
+{
+    public:
+	Guard( AsyncTCPSocket *isocket ):
+	    socket(isocket), outer(isocket->destroyed), destroyed(false)
+	{
+	    this->socket->destroyed = &this->destroyed;
+	}
+
+	~Guard()
+	{
+	    if( this->destroyed ){
+		if( this->outer )
+		    *this->outer = true;
+	    }
+	    else
+		this->socket->destroyed = this->outer;
+	}
+
+	AsyncTCPSocket *socket;
+	bool *outer;
+	bool destroyed;
+};
+
+AsyncTCPSocket::AsyncTCPSocket( Reactor &ireactor, AsyncHandler *ihandler ):
+    reactor(ireactor), handler(ihandler), connection(NULL),
+    connectPending(false), connectTimer(0),
+    readPending(false), readSize(0), readLimit(0), readTimer(0),
+    writePending(false), writeTimer(0),
+    destroyed(NULL)
+{}
+
+AsyncTCPSocket::~AsyncTCPSocket()
+{
+    this->stopTimer(this->connectTimer);
+    this->stopTimer(this->readTimer);
+    this->stopTimer(this->writeTimer);
+    if( this->connection ){
+	TCPConnection *c = this->connection;
+	this->detach();
+	c->close();
+    }
+
+    if( this->destroyed )
+	*this->destroyed = true;
+}
+
+void AsyncTCPSocket::connect( const std::string &server, const unsigned port,
+			      const int timeout ) throw (SocketException)
+{
+    if( this->connection || this->connectPending || this->readPending || this->writePending ){
+	Guard guard(this);
+	this->close();
+	if( guard.destroyed )
+	    return;
+    }
+
+    this->connection = this->reactor.connectAsync(server, port, this);
+    this->connectPending = true;
+    this->connectTimer = this->startTimer(timeout);
+}
+
+bool AsyncTCPSocket::read( const size_t size, const int timeout )
+{
+    if( this->readPending || !this->isConnected())
+	return false;
+
+    this->readSize = size;
+    this->readDelimiter.clear();
+    return this->startRead(timeout);
+}
+
+bool AsyncTCPSocket::readUntil( const std::string &delimiter, const int timeout,
+				const size_t limit )
+{
+    if( this->readPending || !this->isConnected() || delimiter.empty())
+	return false;
+
+    this->readDelimiter = delimiter;
+    this->readLimit = limit;
+    return this->startRead(timeout);
+}
+
+bool AsyncTCPSocket::startRead( const int timeout )
+{
+    this->readPending = true;
+    this->readTimer = this->startTimer(timeout);
+
+    // The data may already be buffered
+    this->tryRead();
+    return true;
+}
+
+bool AsyncTCPSocket::write( const void *buffer, const size_t size, const int timeout )
+{
+    if( this->writePending || !this->isConnected())
+	return false;
+
+    this->writePending = true;
+
+    // A failed write closes the connection, which fails the write
+    Guard guard(this);
+    this->connection->write(buffer, size);
+    if( guard.destroyed || !this->writePending )
+	return true;
+
+    if( this->connection->getWriteQueueSize() == 0 ){
+	this->writePending = false;
+	this->handler->writeComplete(this, AsyncHandler::COMPLETE);
+    }
+    else
+	this->writeTimer = this->startTimer(timeout);
+    return true;
+}
+
+void AsyncTCPSocket::cancel()
+{
+    if( this->connectPending ){
+	TCPConnection *c = this->connection;
+	this->detach();
+	c->close();
+	if( !this->failConnect(AsyncHandler::CANCELLED))
+	    return;
+    }
+
+    if( !this->failRead(AsyncHandler::CANCELLED))
+	return;
+    this->failWrite(AsyncHandler::CANCELLED);
+}
+
+void AsyncTCPSocket::close()
+{
+    Guard guard(this);
+    this->cancel();
+    if( guard.destroyed || !this->connection )
+	return;
+
+    TCPConnection *c = this->connection;
+    this->detach();
+    c->close();
+}
+
+bool AsyncTCPSocket::isConnected() const
+{
+    return this->connection && this->connection->isConnected();
+}
+
+bool AsyncTCPSocket::isConnecting() const
+{
+    return this->connectPending;
+}
+
+TCPConnection *AsyncTCPSocket::getConnection() const
+{
+    return this->connection;
+}
+
+void AsyncTCPSocket::connected( TCPConnection * )
+{
+    this->stopTimer(this->connectTimer);
+    this->connectPending = false;
+    this->handler->connectComplete(this, AsyncHandler::COMPLETE);
+}
+
+void AsyncTCPSocket::dataReceived( TCPConnection * )
+{
+    this->tryRead();
+}
+
+void AsyncTCPSocket::writeComplete( TCPConnection * )
+{
+    if( !this->writePending )
+	return;
+
+    this->stopTimer(this->writeTimer);
+    this->writePending = false;
+    this->handler->writeComplete(this, AsyncHandler::COMPLETE);
+}
+
+void AsyncTCPSocket::disconnected( TCPConnection * )
+{
+    // The reactor destroys the connection once this returns
+    this->connection = NULL;
+
+    if( !this->failConnect(AsyncHandler::CLOSED))
+	return;
+    if( !this->failRead(AsyncHandler::CLOSED))
+	return;
+    this->failWrite(AsyncHandler::CLOSED);
+}
+
+void AsyncTCPSocket::timerExpired( const unsigned long id )
+{
+    if( id == this->connectTimer ){
+	this->connectTimer = 0;
+	TCPConnection *c = this->connection;
+	this->detach();
+	c->close();
+	this->failConnect(AsyncHandler::TIMEDOUT);
+    }
+    else if( id == this->readTimer ){
+	this->readTimer = 0;
+	this->failRead(AsyncHandler::TIMEDOUT);
+    }
+    else if( id == this->writeTimer ){
+	// Whatever was written can't be taken back, so the stream can't be
+	// trusted any more
+	this->writeTimer = 0;
+	Guard guard(this);
+	if( !this->failWrite(AsyncHandler::TIMEDOUT))
+	    return;
+	if( this->connection ){
+	    TCPConnection *c = this->connection;
+	    this->detach();
+	    c->close();
+	    this->failRead(AsyncHandler::CLOSED);
+	}
+    }
+}
+
+unsigned long AsyncTCPSocket::startTimer( const int timeout )
+{
+    if( timeout < 0 )
+	return 0;
+    return this->reactor.addTimer(timeout, this);
+}
+
+void AsyncTCPSocket::stopTimer( unsigned long &id )
+{
+    if( id ){
+	this->reactor.cancelTimer(id);
+	id = 0;
+    }
+}
+
+void AsyncTCPSocket::detach()
+{
+    this->connection->setHandler(&detachedHandler);
+    this->connection = NULL;
+}
+
+void AsyncTCPSocket::tryRead()
+{
+    if( !this->readPending || !this->connection )
+	return;
+
+    const unsigned char *data = this->connection->getReadData();
+    size_t available = this->connection->getReadSize();
+    size_t size;
+
+    if( this->readDelimiter.empty()){
+	if( available < this->readSize )
+	    return;
+	size = this->readSize;
+    }
+    else {
+	const unsigned char *end = data + available;
+	const unsigned char *found = std::search(data, end,
+						 (const unsigned char *)this->readDelimiter.data(),
+						 (const unsigned char *)this->readDelimiter.data() +
+						 this->readDelimiter.size());
+	if( found == end ){
+	    if( available >= this->readLimit )
+		this->failRead(AsyncHandler::TOO_LONG);
+	    return;
+	}
+	size = (found - data) + this->readDelimiter.size();
+    }
+
+    // Consuming doesn't move the data, and nothing more is read into the
+    // buffer until the handler returns, so the data stays valid
+    this->stopTimer(this->readTimer);
+    this->readPending = false;
+    this->connection->consume(size);
+    this->handler->readComplete(this, AsyncHandler::COMPLETE, data, size);
+}
+
+bool AsyncTCPSocket::failConnect( const AsyncHandler::Status status )
+{
+    if( !this->connectPending )
+	return true;
+
+    this->stopTimer(this->connectTimer);
+    this->connectPending = false;
+
+    Guard guard(this);
+    this->handler->connectComplete(this, status);
+    return !guard.destroyed;
+}
+
+bool AsyncTCPSocket::failRead( const AsyncHandler::Status status )
+{
+    if( !this->readPending )
+	return true;
+
+    this->stopTimer(this->readTimer);
+    this->readPending = false;
+
+    Guard guard(this);
+    this->handler->readComplete(this, status, NULL, 0);
+    return !guard.destroyed;
+}
+
+bool AsyncTCPSocket::failWrite( const AsyncHandler::Status status )
+{
+    if( !this->writePending )
+	return true;
+
+    this->stopTimer(this->writeTimer);
+    this->writePending = false;
+
+    Guard guard(this);
+    this->handler->writeComplete(this, status);
+    return !guard.destroyed;
+}
+
+}; // namespace wcl
@@ -0,0 +1,194 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_NETWORK_ASYNCTCPSOCKET_H
+#define WCL_NETWORK_ASYNCTCPSOCKET_H
+
+#include <string>
+
+#include <wcl/api.h>
+#include <wcl/network/Reactor.h>
+#include <wcl/network/TCPConnection.h>
+
+namespace wcl {
+
+class AsyncTCPSocket;
+
+/**
+ * An AsyncHandler is told when the operations started on an AsyncTCPSocket
+ * finish. All calls are made from the thread running the Reactor, and the
+ * socket may be deleted from within any of them.
+ */
+class WCL_API AsyncHandler
+{
+    public:
+	enum Status {
+	    COMPLETE,  // The operation finished
+	    TIMEDOUT,  // The deadline passed first
+	    CANCELLED, // cancel or close was called
+	    CLOSED,    // The connection was closed or failed
+	    TOO_LONG   // readUntil reached its limit without the delimiter
+	};
+
+	virtual ~AsyncHandler() {}
+
+	virtual void connectComplete( AsyncTCPSocket *, const Status ) {}
+
+	/**
+	 * A read has finished. The data read is only valid until this
+	 * returns, and is NULL unless the status is COMPLETE.
+	 */
+	virtual void readComplete( AsyncTCPSocket *, const Status,
+				   const unsigned char *, const size_t ) {}
+
+	virtual void writeComplete( AsyncTCPSocket *, const Status ) {}
+};
+
+/**
+ * An AsyncTCPSocket performs connects, reads and writes on a Reactor without
+ * blocking, each with an optional deadline. One read and one write may be
+ * pending at a time, and either may complete before the call that started
+ * it returns if it can be done immediately.
+ *
+ * A read that times out leaves the connection open and any partial data
+ * buffered for the next read. A write that times out closes the connection,
+ * as how much of the data was sent is unknown.
+ */
+class WCL_API AsyncTCPSocket : private TCPConnectionHandler, private TimerHandler
+{
+    public:
+	AsyncTCPSocket( Reactor &reactor, AsyncHandler *handler );
+	virtual ~AsyncTCPSocket();
+
+	/**
+	 * Start connecting to a server. Any existing connection is closed
+	 * first.
+	 *
+	 * @param timeout The time to allow in milliseconds, -1 waits forever
+	 * @throws SocketException if the connection couldn't be started
+	 */
+	void connect( const std::string &server, const unsigned port,
+		      const int timeout = -1 ) throw (SocketException);
+
+	/**
+	 * Read exactly the given amount of data
+	 *
+	 * @return false if not connected or a read is already pending
+	 */
+	bool read( const size_t size, const int timeout = -1 );
+
+	/**
+	 * Read up to and including the delimiter
+	 *
+	 * @param limit Give up with TOO_LONG once this much has been
+	 *              buffered without finding the delimiter
+	 * @return false if not connected or a read is already pending
+	 */
+	bool readUntil( const std::string &delimiter, const int timeout = -1,
+			const size_t limit = 65536 );
+
+	/**
+	 * Write the buffer, completing once it has all been handed to the
+	 * operating system. The buffer is copied if it can't be written
+	 * immediately.
+	 *
+	 * @return false if not connected or a write is already pending
+	 */
+	bool write( const void *buffer, const size_t size, const int timeout = -1 );
+
+	/**
+	 * Cancel any pending operations, each is completed with CANCELLED.
+	 * A pending connect is abandoned, data from a pending write is
+	 * still sent.
+	 */
+	void cancel();
+
+	/**
+	 * Cancel pending operations and close the connection once queued
+	 * data has been written
+	 */
+	void close();
+
+	bool isConnected() const;
+	bool isConnecting() const;
+
+	/**
+	 * Obtain the underlying connection, NULL if there isn't one
+	 */
+	TCPConnection *getConnection() const;
+
+    private:
+	class Guard;
+	friend class Guard;
+
+	// TCPConnectionHandler
+	virtual void connected( TCPConnection * );
+	virtual void dataReceived( TCPConnection * );
+	virtual void writeComplete( TCPConnection * );
+	virtual void disconnected( TCPConnection * );
+
+	// TimerHandler
+	virtual void timerExpired( const unsigned long id );
+
+	unsigned long startTimer( const int timeout );
+	void stopTimer( unsigned long &id );
+	void detach();
+	bool startRead( const int timeout );
+	void tryRead();
+
+	/**
+	 * Complete the pending operations with the given status
+	 *
+	 * @return false if the socket was deleted by the handler
+	 */
+	bool failConnect( const AsyncHandler::Status );
+	bool failRead( const AsyncHandler::Status );
+	bool failWrite( const AsyncHandler::Status );
+
+	Reactor &reactor;
+	AsyncHandler *handler;
+	TCPConnection *connection;
+
+	bool connectPending;
+	unsigned long connectTimer;
+
+	bool readPending;
+	size_t readSize;
+	std::string readDelimiter;
+	size_t readLimit;
+	unsigned long readTimer;
+
+	bool writePending;
+	unsigned long writeTimer;
+
+	bool *destroyed; // Set when deleted from a handler
+
+	AsyncTCPSocket( const AsyncTCPSocket & );
+	AsyncTCPSocket &operator =( const AsyncTCPSocket & );
+};
+
+}; // namespace wcl
+
+#endif
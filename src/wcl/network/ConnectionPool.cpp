@@ -0,0 +1,176 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <errno.h>
+#include <poll.h>
+#include <sstream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "ConnectionPool.h"
+
+namespace wcl {
+
+ConnectionPool::ConnectionPool( const unsigned itimeout ):
+    timeout(itimeout), reconnects(0)
+{}
+
+ConnectionPool::~ConnectionPool()
+{
+    this->closeAll();
+}
+
+TCPSocket &ConnectionPool::get( const std::string &host, const unsigned port ) throw (SocketException)
+{
+    std::string key = getKey(host, port);
+    Connections::iterator it = this->connections.find(key);
+    if( it != this->connections.end()){
+	if( isAlive(*it->second))
+	    return *it->second;
+	this->replace(it);
+    }
+
+    TCPSocket *socket = new TCPSocket(host, port, false);
+    try {
+	if( this->timeout ){
+	    socket->setTimeout(this->timeout);
+	    socket->connect(this->timeout);
+	}
+	else
+	    socket->connect();
+    }
+    catch( SocketException & ){
+	delete socket;
+	throw;
+    }
+
+    int on = 1;
+    setsockopt(**socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    this->connections[key] = socket;
+    return *socket;
+}
+
+void ConnectionPool::write( const std::string &host, const unsigned port,
+			    const void *buffer, const size_t size ) throw (SocketException)
+{
+    Connections::iterator it = this->connections.find(getKey(host, port));
+    if( it != this->connections.end() && isAlive(*it->second)){
+	try {
+	    it->second->writeUntil((void *)buffer, size);
+	    return;
+	}
+	catch( SocketException & ){
+	    this->replace(it);
+	}
+    }
+
+    // Only a pooled connection may have gone stale since it was last
+    // used, a new connection that fails would just fail again
+    TCPSocket &socket = this->get(host, port);
+    try {
+	socket.writeUntil((void *)buffer, size);
+    }
+    catch( SocketException & ){
+	this->close(host, port);
+	throw;
+    }
+}
+
+void ConnectionPool::close( const std::string &host, const unsigned port )
+{
+    Connections::iterator it = this->connections.find(getKey(host, port));
+    if( it == this->connections.end())
+	return;
+
+    delete it->second;
+    this->connections.erase(it);
+}
+
+void ConnectionPool::closeAll()
+{
+    for(Connections::iterator it = this->connections.begin(); it != this->connections.end(); ++it )
+	delete it->second;
+    this->connections.clear();
+}
+
+void ConnectionPool::setTimeout( const unsigned milliseconds )
+{
+    this->timeout = milliseconds;
+    for(Connections::iterator it = this->connections.begin(); it != this->connections.end(); ++it )
+	it->second->setTimeout(milliseconds);
+}
+
+unsigned ConnectionPool::getTimeout() const
+{
+    return this->timeout;
+}
+
+size_t ConnectionPool::getConnectionCount() const
+{
+    return this->connections.size();
+}
+
+unsigned long ConnectionPool::getReconnectCount() const
+{
+    return this->reconnects;
+}
+
+std::string ConnectionPool::getKey( const std::string &host, const unsigned port )
+{
+    std::ostringstream key;
+    key << host << ':' << port;
+    return key.str();
+}
+
+void ConnectionPool::replace( Connections::iterator it )
+{
+    delete it->second;
+    this->connections.erase(it);
+    this->reconnects++;
+}
+
+bool ConnectionPool::isAlive( TCPSocket &socket )
+{
+    if( !socket.isValid())
+	return false;
+
+    // An idle connection only becomes readable if the remote end closed
+    // it, reset it, or sent something unasked for, which is left alone
+    struct pollfd pfd;
+    pfd.fd = *socket;
+    pfd.events = POLLIN;
+    if( ::poll(&pfd, 1, 0) <= 0 )
+	return true;
+    if( pfd.revents & (POLLERR | POLLHUP | POLLNVAL))
+	return false;
+
+    char c;
+    ssize_t amount = ::recv(*socket, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return amount > 0 || (amount == -1 && (errno == EAGAIN || errno == EWOULDBLOCK));
+}
+
+}; // namespace wcl
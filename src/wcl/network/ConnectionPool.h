@@ -0,0 +1,123 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_NETWORK_CONNECTIONPOOL_H
+#define WCL_NETWORK_CONNECTIONPOOL_H
+
+#include <map>
+#include <string>
+
+#include <wcl/api.h>
+#include <wcl/network/TCPSocket.h>
+
+namespace wcl {
+
+/**
+ * A ConnectionPool keeps one persistent TCP connection open to each host
+ * and port it is asked for, so devices that are sent many small commands
+ * pay for the connection once. Connections the remote end has closed are
+ * noticed and replaced the next time they are asked for, and a write on
+ * an existing connection that fails is retried once on a fresh one.
+ *
+ * Connections have Nagle's algorithm disabled, as they carry short
+ * commands that should be sent straight away. The pool is not thread safe.
+ */
+class WCL_API ConnectionPool
+{
+    public:
+	/**
+	 * @param timeout The time in milliseconds allowed for connecting and
+	 *                for each read and write, 0 waits forever
+	 */
+	ConnectionPool( const unsigned timeout = 0 );
+	~ConnectionPool();
+
+	/**
+	 * Obtain the connection to a host, connecting if there isn't one or
+	 * the existing one has been closed by the remote end.
+	 *
+	 * @return The connection, owned by the pool
+	 * @throws SocketException if the connection couldn't be made
+	 */
+	TCPSocket &get( const std::string &host, const unsigned port ) throw (SocketException);
+
+	/**
+	 * Write the whole buffer to a host. If the write fails on a pooled
+	 * connection it is replaced and the write tried once more. A write on
+	 * a new connection is not retried, so an unreachable host costs a
+	 * single connect.
+	 *
+	 * @throws SocketException if the connection couldn't be made or the
+	 *         write on a new connection failed
+	 */
+	void write( const std::string &host, const unsigned port,
+		    const void *buffer, const size_t size ) throw (SocketException);
+
+	/**
+	 * Close the connection to a host, the next get will reconnect
+	 */
+	void close( const std::string &host, const unsigned port );
+	void closeAll();
+
+	/**
+	 * Change the time allowed, this applies to open connections too
+	 */
+	void setTimeout( const unsigned milliseconds );
+	unsigned getTimeout() const;
+
+	size_t getConnectionCount() const;
+
+	/**
+	 * Obtain how many connections have been replaced because they failed
+	 */
+	unsigned long getReconnectCount() const;
+
+    private:
+	typedef std::map<std::string, TCPSocket *> Connections;
+
+	static std::string getKey( const std::string &host, const unsigned port );
+
+	/**
+	 * Check an idle connection hasn't been closed or reset by the remote
+	 * end without waiting
+	 */
+	static bool isAlive( TCPSocket &socket );
+
+	/**
+	 * Remove a failed connection, counting it as a reconnect
+	 */
+	void replace( Connections::iterator it );
+
+	Connections connections;
+	unsigned timeout;
+	unsigned long reconnects;
+
+	ConnectionPool( const ConnectionPool & );
+	ConnectionPool &operator =( const ConnectionPool & );
+};
+
+}; // namespace wcl
+
+#endif
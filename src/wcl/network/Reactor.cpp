@@ -0,0 +1,432 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include <wcl/IO.h>
+#include "Reactor.h"
+
+namespace wcl {
+
+#define INITIAL_EVENTS 64
+
+/**
+ * The time in milliseconds on a clock that never goes backwards
+ */
+static uint64_t getMilliseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+Reactor::Reactor() throw (SocketException):
+    stopped(false), events(INITIAL_EVENTS), spare(NULL), nextTimer(1)
+{
+    // Not having the reserve only matters once descriptors run out
+    this->reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+    this->epollfd = epoll_create1(EPOLL_CLOEXEC);
+    if( this->epollfd == -1 ){
+	if( this->reserve != -1 )
+	    ::close(this->reserve);
+	throw SocketException(NULL);
+    }
+
+    this->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if( this->wakefd == -1 ){
+	::close(this->epollfd);
+	if( this->reserve != -1 )
+	    ::close(this->reserve);
+	throw SocketException(NULL);
+    }
+
+    struct epoll_event e;
+    memset(&e, 0, sizeof(e));
+    e.events = EPOLLIN;
+    e.data.ptr = this;
+    if( epoll_ctl(this->epollfd, EPOLL_CTL_ADD, this->wakefd, &e) == -1 ){
+	::close(this->wakefd);
+	::close(this->epollfd);
+	if( this->reserve != -1 )
+	    ::close(this->reserve);
+	throw SocketException(NULL);
+    }
+}
+
+Reactor::~Reactor()
+{
+    for(std::list<TCPConnection *>::iterator it = this->connections.begin();
+	it != this->connections.end(); ++it )
+	delete *it;
+    this->destroyClosedConnections();
+
+    for(unsigned i = 0; i < this->listeners.size(); i++ )
+	delete this->listeners[i];
+    for(unsigned i = 0; i < this->watchers.size(); i++ )
+	delete this->watchers[i];
+    delete this->spare;
+
+    ::close(this->wakefd);
+    ::close(this->epollfd);
+    if( this->reserve != -1 )
+	::close(this->reserve);
+}
+
+void Reactor::listen( TCPServer &server, TCPConnectionHandler *handler ) throw (SocketException)
+{
+    if( !server.setBlockingMode(Socket::NONBLOCKING))
+	throw SocketException(NULL);
+
+    Listener *l = new Listener;
+    l->server = &server;
+    l->handler = handler;
+
+    // Connections already waiting are reported as soon as we are watching
+    struct epoll_event e;
+    memset(&e, 0, sizeof(e));
+    e.events = EPOLLIN | EPOLLET;
+    e.data.ptr = l;
+    if( epoll_ctl(this->epollfd, EPOLL_CTL_ADD, *server, &e) == -1 ){
+	delete l;
+	throw SocketException(NULL);
+    }
+
+    this->listeners.push_back(l);
+}
+
+TCPConnection *Reactor::connect( const std::string &server, const unsigned port,
+				 TCPConnectionHandler *handler ) throw (SocketException)
+{
+    TCPConnection *c = new TCPConnection(this, handler, server, port);
+    this->addConnection(c);
+    if( !c->closed )
+	handler->connected(c);
+    return c;
+}
+
+TCPConnection *Reactor::connectAsync( const std::string &server, const unsigned port,
+				      TCPConnectionHandler *handler ) throw (SocketException)
+{
+    TCPConnection *c = new TCPConnection(this, handler, server, port, false);
+    this->addConnection(c);
+    return c;
+}
+
+void Reactor::watch( const int fd, DescriptorHandler *handler ) throw (SocketException)
+{
+    Watcher *w = new Watcher;
+    w->fd = fd;
+    w->handler = handler;
+
+    struct epoll_event e;
+    memset(&e, 0, sizeof(e));
+    e.events = EPOLLIN;
+    e.data.ptr = w;
+    if( epoll_ctl(this->epollfd, EPOLL_CTL_ADD, fd, &e) == -1 ){
+	delete w;
+	throw SocketException(NULL);
+    }
+
+    this->watchers.push_back(w);
+}
+
+void Reactor::unwatch( const int fd )
+{
+    // Events for the watcher may still be waiting in this batch, so it
+    // is only destroyed once the batch is done
+    for(unsigned i = 0; i < this->watchers.size(); i++ ){
+	Watcher *w = this->watchers[i];
+	if( w->fd == fd && w->handler != NULL ){
+	    epoll_ctl(this->epollfd, EPOLL_CTL_DEL, fd, NULL);
+	    w->handler = NULL;
+	    return;
+	}
+    }
+}
+
+unsigned long Reactor::addTimer( const unsigned milliseconds, TimerHandler *handler )
+{
+    unsigned long id = this->nextTimer++;
+    if( id == 0 )
+	id = this->nextTimer++;
+
+    uint64_t deadline = getMilliseconds() + milliseconds;
+    this->timers[TimerKey(deadline, id)] = handler;
+    this->timerDeadlines[id] = deadline;
+    return id;
+}
+
+bool Reactor::cancelTimer( const unsigned long id )
+{
+    std::map<unsigned long, uint64_t>::iterator it = this->timerDeadlines.find(id);
+    if( it == this->timerDeadlines.end())
+	return false;
+
+    this->timers.erase(TimerKey(it->second, id));
+    this->timerDeadlines.erase(it);
+    return true;
+}
+
+unsigned Reactor::runTimers()
+{
+    unsigned count = 0;
+    uint64_t now = getMilliseconds();
+
+    // Handlers may add and cancel timers, so take one at a time
+    while( !this->timers.empty() && this->timers.begin()->first.first <= now ){
+	std::map<TimerKey, TimerHandler *>::iterator first = this->timers.begin();
+	unsigned long id = first->first.second;
+	TimerHandler *handler = first->second;
+	this->timers.erase(first);
+	this->timerDeadlines.erase(id);
+
+	handler->timerExpired(id);
+	count++;
+    }
+    return count;
+}
+
+unsigned Reactor::poll( const int timeout ) throw (SocketException)
+{
+    // Wake in time for the next timer
+    int wait = timeout;
+    if( !this->timers.empty()){
+	uint64_t now = getMilliseconds();
+	uint64_t next = this->timers.begin()->first.first;
+	int until = next > now ? (int)(next - now) : 0;
+	if( wait < 0 || until < wait )
+	    wait = until;
+    }
+
+    int count = epoll_wait(this->epollfd, &this->events[0], this->events.size(), wait);
+    if( count == -1 ){
+	if( errno == EINTR )
+	    return this->runTimers();
+	throw SocketException(NULL);
+    }
+
+    for(int i = 0; i < count; i++ ){
+	void *source = this->events[i].data.ptr;
+
+	if( source == this ){
+	    uint64_t value;
+	    ssize_t ignored = ::read(this->wakefd, &value, sizeof(value));
+	    (void)ignored;
+	    continue;
+	}
+
+	// There are only ever a few listeners, so a search is cheaper
+	// than tagging every event
+	bool isListener = false;
+	for(unsigned l = 0; l < this->listeners.size(); l++ ){
+	    if( source == this->listeners[l] ){
+		this->acceptConnections(this->listeners[l]);
+		isListener = true;
+		break;
+	    }
+	}
+	if( isListener )
+	    continue;
+
+	bool isWatcher = false;
+	for(unsigned w = 0; w < this->watchers.size(); w++ ){
+	    Watcher *watcher = this->watchers[w];
+	    if( source == watcher ){
+		if( watcher->handler != NULL )
+		    watcher->handler->readable(watcher->fd);
+		isWatcher = true;
+		break;
+	    }
+	}
+	if( isWatcher )
+	    continue;
+
+	// A connection closed by an earlier event in this batch is only
+	// destroyed once the batch is done, so this is always safe
+	TCPConnection *c = (TCPConnection *)source;
+	if( !c->closed )
+	    c->handleEvents(this->events[i].events);
+    }
+
+    // Make room for more events next time if we are busy
+    if( count == (int)this->events.size())
+	this->events.resize(this->events.size() * 2);
+
+    unsigned handled = count + this->runTimers();
+    this->destroyClosedConnections();
+    this->removeWatchers();
+    return handled;
+}
+
+void Reactor::run() throw (SocketException)
+{
+    try {
+	while( !this->stopped )
+	    this->poll();
+    } catch( ... ){
+	this->stopped = false;
+	throw;
+    }
+    this->stopped = false;
+}
+
+void Reactor::stop()
+{
+    uint64_t value = 1;
+    this->stopped = true;
+    ssize_t ignored = ::write(this->wakefd, &value, sizeof(value));
+    (void)ignored;
+}
+
+const std::list<TCPConnection *> &Reactor::getConnections() const
+{
+    return this->connections;
+}
+
+unsigned Reactor::getConnectionCount() const
+{
+    return this->connections.size();
+}
+
+void Reactor::acceptConnections( Listener *listener )
+{
+    // Edge triggered, so accept until there is nothing left
+    for(;;){
+	if( this->spare == NULL )
+	    this->spare = new TCPConnection(this, listener->handler);
+	this->spare->handler = listener->handler;
+
+	if( !listener->server->accept(&this->spare->getSocket())){
+	    if( errno == EMFILE || errno == ENFILE )
+		this->refuseConnections(listener);
+	    else if( errno == EINTR || errno == ECONNABORTED )
+		continue;
+	    return;
+	}
+
+	TCPConnection *c = this->spare;
+	this->spare = NULL;
+	this->addConnection(c);
+	if( !c->closed )
+	    c->handler->connected(c);
+    }
+}
+
+/**
+ * Out of descriptors, close the connections waiting on a listener. It is
+ * edge triggered, so those left waiting wouldn't be reported again until
+ * another arrived.
+ */
+void Reactor::refuseConnections( Listener *listener )
+{
+    unsigned refused = 0;
+    while( this->reserve != -1 ){
+	// Free a descriptor for long enough to accept and close one
+	::close(this->reserve);
+	int fd = ::accept(**listener->server, NULL, NULL);
+	if( fd != -1 ){
+	    ::close(fd);
+	    refused++;
+	}
+	this->reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+	if( fd == -1 && errno != EINTR && errno != ECONNABORTED )
+	    break;
+    }
+
+    wclclog << "Reactor: Out of file descriptors, refused " << refused << " connections" << std::endl;
+}
+
+void Reactor::addConnection( TCPConnection *c )
+{
+    c->self = this->connections.insert(this->connections.end(), c);
+
+    // Watch for writability too, with edge triggering this is only reported
+    // when the socket becomes writable, so doesn't cost anything
+    struct epoll_event e;
+    memset(&e, 0, sizeof(e));
+    e.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    e.data.ptr = c;
+    if( epoll_ctl(this->epollfd, EPOLL_CTL_ADD, *c->getSocket(), &e) == -1 ){
+	c->closed = true;
+	c->socket.close();
+	this->connections.erase(c->self);
+	this->closedConnections.push_back(c);
+    }
+}
+
+/**
+ * Have epoll report a connection again if it is ready, for one that
+ * stopped reading with data still waiting
+ */
+void Reactor::rearmConnection( TCPConnection *c )
+{
+    struct epoll_event e;
+    memset(&e, 0, sizeof(e));
+    e.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    e.data.ptr = c;
+    if( epoll_ctl(this->epollfd, EPOLL_CTL_MOD, *c->getSocket(), &e) == -1 )
+	this->closeConnection(c);
+}
+
+void Reactor::closeConnection( TCPConnection *c )
+{
+    if( c->closed )
+	return;
+
+    c->closed = true;
+    epoll_ctl(this->epollfd, EPOLL_CTL_DEL, *c->getSocket(), NULL);
+    c->socket.close();
+    this->connections.erase(c->self);
+    this->closedConnections.push_back(c);
+
+    c->handler->disconnected(c);
+}
+
+void Reactor::destroyClosedConnections()
+{
+    for(unsigned i = 0; i < this->closedConnections.size(); i++ )
+	delete this->closedConnections[i];
+    this->closedConnections.clear();
+}
+
+void Reactor::removeWatchers()
+{
+    unsigned kept = 0;
+    for(unsigned i = 0; i < this->watchers.size(); i++ ){
+	if( this->watchers[i]->handler == NULL )
+	    delete this->watchers[i];
+	else
+	    this->watchers[kept++] = this->watchers[i];
+    }
+    this->watchers.resize(kept);
+}
+
+}; // namespace wcl
@@ -0,0 +1,223 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_NETWORK_REACTOR_H
+#define WCL_NETWORK_REACTOR_H
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include <wcl/api.h>
+#include <wcl/network/SocketException.h>
+#include <wcl/network/TCPConnection.h>
+#include <wcl/network/TCPServer.h>
+
+namespace wcl {
+
+/**
+ * A TimerHandler is told when a timer added to a Reactor expires
+ */
+class WCL_API TimerHandler
+{
+    public:
+	virtual ~TimerHandler() {}
+	virtual void timerExpired( const unsigned long id ) = 0;
+};
+
+/**
+ * A DescriptorHandler is told when a descriptor given to Reactor::watch
+ * can be read
+ */
+class WCL_API DescriptorHandler
+{
+    public:
+	virtual ~DescriptorHandler() {}
+	virtual void readable( const int fd ) = 0;
+};
+
+/**
+ * A Reactor drives any number of non blocking TCP connections from a single
+ * thread using edge triggered epoll. Servers given to listen have their
+ * connections accepted automatically, and each connection reports its
+ * events to a TCPConnectionHandler. Timers run from the same thread, which
+ * is how operations are given deadlines.
+ *
+ * The reactor is not thread safe, other than stop which may be called from
+ * any thread.
+ */
+class WCL_API Reactor
+{
+    public:
+	/**
+	 * @throws SocketException if epoll is not available
+	 */
+	Reactor() throw (SocketException);
+
+	/**
+	 * Close all connections. Handlers are not told of connections
+	 * closed by the destructor
+	 */
+	~Reactor();
+
+	/**
+	 * Accept connections from the given server. The server is set non
+	 * blocking and must remain valid while the reactor exists.
+	 *
+	 * @param server The server to accept connections from
+	 * @param handler The handler for all connections accepted from the server
+	 * @throws SocketException if the server can't be watched
+	 */
+	void listen( TCPServer &server, TCPConnectionHandler *handler ) throw (SocketException);
+
+	/**
+	 * Connect to a server and drive the resulting connection. The connect
+	 * itself blocks.
+	 *
+	 * @return The new connection, owned by the reactor
+	 * @throws SocketException if the connection failed
+	 */
+	TCPConnection *connect( const std::string &server, const unsigned port,
+				TCPConnectionHandler *handler ) throw (SocketException);
+
+	/**
+	 * Start connecting to a server without waiting for the connection.
+	 * The handler is told connected once it is established, or
+	 * disconnected without connected if it fails. Resolving the server
+	 * name may still block.
+	 *
+	 * @return The new connection, owned by the reactor
+	 * @throws SocketException if the connection couldn't be started
+	 */
+	TCPConnection *connectAsync( const std::string &server, const unsigned port,
+				     TCPConnectionHandler *handler ) throw (SocketException);
+
+	/**
+	 * Tell the handler whenever the descriptor can be read. The
+	 * descriptor is watched level triggered, so the handler need not
+	 * read everything available. The descriptor is not closed by the
+	 * reactor.
+	 *
+	 * @throws SocketException if the descriptor can't be watched
+	 */
+	void watch( const int fd, DescriptorHandler *handler ) throw (SocketException);
+
+	/**
+	 * Stop watching a descriptor. This must be done before it is
+	 * closed, and may be done from its handler.
+	 */
+	void unwatch( const int fd );
+
+	/**
+	 * Call the handler once the given time has passed
+	 *
+	 * @param milliseconds The time until the timer expires
+	 * @param handler The handler to tell
+	 * @return An id for the timer, never 0
+	 */
+	unsigned long addTimer( const unsigned milliseconds, TimerHandler *handler );
+
+	/**
+	 * Stop a timer that hasn't expired yet
+	 *
+	 * @return false if there was no such timer
+	 */
+	bool cancelTimer( const unsigned long id );
+
+	/**
+	 * Wait for and handle events and expired timers
+	 *
+	 * @param timeout The time to wait in milliseconds, -1 waits forever
+	 * @return The amount of events and timers handled
+	 * @throws SocketException if epoll failed
+	 */
+	unsigned poll( const int timeout = -1 ) throw (SocketException);
+
+	/**
+	 * Handle events until stop is called. If stop was called before
+	 * run started, run returns at once.
+	 */
+	void run() throw (SocketException);
+
+	/**
+	 * Make run return. This may be called from any thread
+	 */
+	void stop();
+
+	/**
+	 * Obtain the open connections
+	 */
+	const std::list<TCPConnection *> &getConnections() const;
+	unsigned getConnectionCount() const;
+
+    private:
+	friend class TCPConnection;
+
+	struct Listener {
+	    TCPServer *server;
+	    TCPConnectionHandler *handler;
+	};
+
+	struct Watcher {
+	    int fd;
+	    DescriptorHandler *handler; // NULL once unwatched
+	};
+
+	int epollfd;
+	int wakefd; // eventfd used to interrupt epoll_wait from stop
+	volatile bool stopped; // Set by stop, cleared as run returns
+	int reserve; // Given up to refuse connections when out of descriptors
+	std::vector<struct epoll_event> events;
+	std::vector<Listener *> listeners;
+	std::vector<Watcher *> watchers;
+	std::list<TCPConnection *> connections;
+	std::vector<TCPConnection *> closedConnections; // Destroyed once events are handled
+	TCPConnection *spare; // Reused when accept has nothing to accept
+
+	// Timers ordered by deadline, and the deadline of each timer by id
+	typedef std::pair<uint64_t, unsigned long> TimerKey;
+	std::map<TimerKey, TimerHandler *> timers;
+	std::map<unsigned long, uint64_t> timerDeadlines;
+	unsigned long nextTimer;
+
+	unsigned runTimers();
+	void acceptConnections( Listener *listener );
+	void refuseConnections( Listener *listener );
+	void addConnection( TCPConnection *connection );
+	void rearmConnection( TCPConnection *connection );
+	void closeConnection( TCPConnection *connection );
+	void destroyClosedConnections();
+	void removeWatchers();
+
+	Reactor( const Reactor & );
+	Reactor &operator =( const Reactor & );
+};
+
+}; // namespace wcl
+
+#endif
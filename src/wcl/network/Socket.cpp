@@ -32,12 +32,22 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 #include <netdb.h>
 #include <arpa/inet.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
+#endif
 
 #include "Socket.h"
 #include "SocketException.h"
 
+// Without MSG_NOSIGNAL the SIGPIPE blocked by the constructor does the job
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
 namespace wcl {
 
 
@@ -47,7 +57,8 @@ namespace wcl {
  * responsibility to create the socket.
  */
 Socket::Socket():
-    sockfd(-1),blocking(BLOCKING)
+    sockfd(-1),blocking(BLOCKING), timeout(0),
+    zeroCopy(false), zeroCopySent(0), zeroCopyCompleted(0), zeroCopyNext(0), zeroCopyCopied(0)
 {
     memset( &this->address, 0, sizeof( this->address ));
 
@@ -156,9 +167,12 @@ ssize_t Socket::read ( void *buffer, const size_t size, const bool peek) throw (
 
 	// Non blocking will have errno set to
 	// EAGAIN, we return 0 in this case
-	if ( this->blocking == NONBLOCKING &&
-	     (errno == EAGAIN || errno == EWOULDBLOCK )){
-	    return 0;
+	if ( errno == EAGAIN || errno == EWOULDBLOCK ){
+	    if ( this->blocking == NONBLOCKING )
+		return 0;
+
+	    // A blocking read only fails this way when it timed out
+	    throw SocketException(this);
 	}
     } else if (retval == 0 && this->blocking == BLOCKING ){
 	// The remote has gracefully closed the connection.
@@ -196,7 +210,8 @@ void Socket::readUntil ( void *buffer, const size_t size ) throw (SocketExceptio
 
 /**
  * Will attempt to write to a socket form a buffer. This method will block
- * until the requested size has been written. 
+ * until the requested size has been written, even if the socket is non
+ * blocking, by waiting for a full socket to become writable.
  *
  * @param buffer The buffer to read from.
  * @param size The amount of data to write, the buffer must be at least this size.
@@ -209,6 +224,19 @@ void Socket::writeUntil ( void *buffer, const size_t size ) throw (SocketExcepti
 
     while( total > 0 ){
 		amount = this->write( buffer, total );
+		if( amount == -1 )
+			throw SocketException(this);
+
+		// A full non blocking socket, wait rather than spin
+		if( amount == 0 ){
+			struct pollfd p;
+			p.fd = this->sockfd;
+			p.events = POLLOUT;
+			p.revents = 0;
+			if( ::poll( &p, 1, -1 ) == -1 && errno != EINTR )
+				throw SocketException(this);
+			continue;
+		}
 
 		// We just can't increment a void * pointer as we don't know what it is
 		// pointing too. However, we know that ::read returns in bytes so we 
@@ -219,6 +247,435 @@ void Socket::writeUntil ( void *buffer, const size_t size ) throw (SocketExcepti
 }
 
 
+/**
+ * Read into several buffers with a single call. Like read, this returns as
+ * soon as some data is available.
+ *
+ * @param vectors The buffers to fill, in order
+ * @param count The number of buffers
+ * @return The amount of data read, 0 if none is available on a non blocking
+ *         socket or -1 if the socket is invalid
+ * @throws SocketException if the read fails or the remote end has closed the
+ *         socket
+ */
+ssize_t Socket::readv( const struct iovec *vectors, const int count ) throw (SocketException)
+{
+    if ( !isValid()){
+	return -1;
+    }
+
+    ssize_t retval = ::readv( this->sockfd, vectors, count );
+    if ( retval == -1 ){
+	if ( this->blocking == NONBLOCKING &&
+	     (errno == EAGAIN || errno == EWOULDBLOCK )){
+	    return 0;
+	}
+	throw SocketException(this);
+    } else if (retval == 0 && this->blocking == BLOCKING ){
+	throw SocketException(this);
+    }
+    return retval;
+}
+
+/**
+ * Write several buffers with a single call, avoiding the need to copy a
+ * header and payload into one buffer first.
+ *
+ * @param vectors The buffers to write, in order
+ * @param count The number of buffers
+ * @return The amount of data written, 0 if the socket is non blocking and
+ *         full, or -1 if the socket is invalid
+ * @throws SocketException if the write fails
+ */
+ssize_t Socket::writev( const struct iovec *vectors, const int count ) throw (SocketException)
+{
+    if ( !isValid()){
+	return -1;
+    }
+
+    ssize_t retval = ::writev( this->sockfd, vectors, count );
+    if ( retval == -1 ){
+	if ( this->blocking == NONBLOCKING &&
+	     (errno == EAGAIN || errno == EWOULDBLOCK )){
+	    return 0;
+	}
+	throw SocketException(this);
+    }
+    return retval;
+}
+
+/**
+ * Step over amount bytes of an iovec array, returning the number of
+ * vectors left. The vectors are adjusted in place.
+ */
+static int advanceVectors( struct iovec *&vectors, int count, size_t amount )
+{
+    while( count > 0 && amount >= vectors->iov_len ){
+	amount -= vectors->iov_len;
+	vectors++;
+	count--;
+    }
+    if( count > 0 ){
+	vectors->iov_base = amount + (uint8_t *)vectors->iov_base;
+	vectors->iov_len -= amount;
+    }
+    return count;
+}
+
+/**
+ * Fill all the given buffers, blocking until they are full. The iovec
+ * array is modified to track progress.
+ *
+ * @param vectors The buffers to fill
+ * @param count The number of buffers
+ * @throws SocketException if the read fails or the socket is closed
+ */
+void Socket::readvUntil( struct iovec *vectors, const int count ) throw (SocketException)
+{
+    int remaining = advanceVectors(vectors, count, 0);
+
+    while( remaining > 0 ){
+	ssize_t amount = this->readv( vectors, remaining );
+	if( amount < 0 ){
+	    throw SocketException(this);
+	}
+	remaining = advanceVectors(vectors, remaining, amount);
+    }
+}
+
+/**
+ * Write all the given buffers, blocking until they are written. The iovec
+ * array is modified to track progress.
+ *
+ * @param vectors The buffers to write
+ * @param count The number of buffers
+ * @throws SocketException if the write fails
+ */
+void Socket::writevUntil( struct iovec *vectors, const int count ) throw (SocketException)
+{
+    int remaining = advanceVectors(vectors, count, 0);
+
+    while( remaining > 0 ){
+	ssize_t amount = this->writev( vectors, remaining );
+	if( amount < 0 ){
+	    throw SocketException(this);
+	}
+	remaining = advanceVectors(vectors, remaining, amount);
+    }
+}
+
+/**
+ * Enable or disable zero copy sends (MSG_ZEROCOPY). With zero copy the
+ * kernel sends directly from the callers buffer, so the buffer must not be
+ * changed until the send is reported complete by pollZeroCopyCompletions.
+ * This only pays off for large writes, and on the loopback device the
+ * kernel copies anyway.
+ *
+ * @return true if the mode was set, false if the kernel doesn't support it
+ */
+bool Socket::setZeroCopy( const bool enable )
+{
+#ifdef SO_ZEROCOPY
+    if ( !this->isValid()){
+	return false;
+    }
+
+    int on = enable;
+    if ( setsockopt( this->sockfd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) == -1 ){
+	return false;
+    }
+
+    // The kernel numbers sends from zero for each socket
+    if( enable && !this->zeroCopy ){
+	this->zeroCopySent = this->zeroCopyCompleted = this->zeroCopyNext = 0;
+	this->zeroCopyCopied = 0;
+    }
+    this->zeroCopy = enable;
+    return true;
+#else
+    return enable == false;
+#endif
+}
+
+bool Socket::getZeroCopy() const
+{
+    return this->zeroCopy;
+}
+
+/**
+ * Write data using zero copy if enabled, otherwise this is a normal write.
+ * Each successful zero copy write is given an id, counting from zero, that
+ * can be passed to isZeroCopyComplete.
+ *
+ * @param buffer The data to write, this must not change until the write
+ *               completes
+ * @param size The amount of data to write
+ * @param id Set to the id of the write if not NULL
+ * @return The amount of data written, 0 if the socket is non blocking and
+ *         full or the kernel has too many zero copy writes outstanding. In
+ *         the latter case poll for completions before trying again.
+ * @throws SocketException if the write fails
+ */
+ssize_t Socket::writeZeroCopy( const void *buffer, const size_t size, uint32_t *id ) throw (SocketException)
+{
+    if ( !isValid()){
+	return -1;
+    }
+
+    int flags = MSG_NOSIGNAL;
+#ifdef MSG_ZEROCOPY
+    if( this->zeroCopy )
+	flags |= MSG_ZEROCOPY;
+#endif
+
+    ssize_t retval = ::send( this->sockfd, buffer, size, flags );
+    if ( retval == -1 ){
+	if ( errno == ENOBUFS ||
+	     (this->blocking == NONBLOCKING && (errno == EAGAIN || errno == EWOULDBLOCK ))){
+	    return 0;
+	}
+	throw SocketException(this);
+    }
+
+    if( this->zeroCopy ){
+	if( id )
+	    *id = this->zeroCopySent;
+	this->zeroCopySent++;
+    }
+    return retval;
+}
+
+/**
+ * Collect the completion notifications for zero copy writes. The kernel
+ * reports completions on the socket error queue.
+ *
+ * @param timeout How long to wait for a notification in milliseconds, 0 to
+ *                only collect those already queued, -1 to wait forever
+ * @return The number of writes newly reported complete
+ * @throws SocketException if reading the error queue fails
+ */
+unsigned Socket::pollZeroCopyCompletions( const int timeout ) throw (SocketException)
+{
+    unsigned completed = 0;
+
+    if( !this->isValid() || this->getZeroCopyPending() == 0 )
+	return 0;
+
+    if( timeout != 0 ){
+	// Errors are always reported, no events need to be requested
+	struct pollfd p;
+	p.fd = this->sockfd;
+	p.events = 0;
+	p.revents = 0;
+	if( ::poll( &p, 1, timeout ) == -1 && errno != EINTR )
+	    throw SocketException(this);
+    }
+
+#ifdef __linux__
+    for(;;){
+	char control[128];
+	struct msghdr msg;
+	memset( &msg, 0, sizeof(msg));
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	if( ::recvmsg( this->sockfd, &msg, MSG_ERRQUEUE ) == -1 ){
+	    if( errno == EAGAIN || errno == EWOULDBLOCK )
+		break;
+	    if( errno == EINTR )
+		continue;
+	    throw SocketException(this);
+	}
+
+	for(struct cmsghdr *c = CMSG_FIRSTHDR(&msg); c != NULL; c = CMSG_NXTHDR(&msg, c)){
+	    if( !((c->cmsg_level == SOL_IP && c->cmsg_type == IP_RECVERR) ||
+		  (c->cmsg_level == SOL_IPV6 && c->cmsg_type == IPV6_RECVERR)))
+		continue;
+
+	    struct sock_extended_err *error = (struct sock_extended_err *)CMSG_DATA(c);
+#ifdef SO_EE_ORIGIN_ZEROCOPY
+	    if( error->ee_origin != SO_EE_ORIGIN_ZEROCOPY || error->ee_errno != 0 )
+		continue;
+
+	    // The notification covers the range of writes [ee_info, ee_data]
+	    uint32_t count = error->ee_data - error->ee_info + 1;
+	    completed += count;
+	    this->zeroCopyCompleted += count;
+	    if( error->ee_code & SO_EE_CODE_ZEROCOPY_COPIED )
+		this->zeroCopyCopied += count;
+	    if( error->ee_data + 1 > this->zeroCopyNext )
+		this->zeroCopyNext = error->ee_data + 1;
+#else
+	    (void)error;
+#endif
+	}
+    }
+#endif
+
+    return completed;
+}
+
+/**
+ * Indicate if the zero copy write with the given id has completed, so its
+ * buffer may be reused. TCP reports completions in order.
+ */
+bool Socket::isZeroCopyComplete( const uint32_t id ) const
+{
+    return id < this->zeroCopyNext;
+}
+
+/**
+ * Obtain the number of zero copy writes not yet reported complete
+ */
+uint32_t Socket::getZeroCopyPending() const
+{
+    return this->zeroCopySent - this->zeroCopyCompleted;
+}
+
+/**
+ * Obtain the number of zero copy writes where the kernel fell back to
+ * copying the data, as it does on the loopback device
+ */
+uint32_t Socket::getZeroCopyCopied() const
+{
+    return this->zeroCopyCopied;
+}
+
+/**
+ * Send part of a file to the socket with sendfile, without the data
+ * passing through userspace. Blocks until size bytes have been sent or
+ * the file ends.
+ *
+ * @param fd The file to send from
+ * @param offset Where in the file to start
+ * @param size The amount to send
+ * @return The amount sent, less than size if the file ended or the socket
+ *         is non blocking and full
+ * @throws SocketException if the send fails
+ */
+size_t Socket::sendFile( const int fd, off_t offset, const size_t size ) throw (SocketException)
+{
+    size_t total = 0;
+
+    while( total < size ){
+#ifdef __linux__
+	ssize_t amount = ::sendfile( this->sockfd, fd, &offset, size - total );
+#else
+	// Copy through a buffer where sendfile differs or is missing
+	char buffer[65536];
+	size_t wanted = size - total < sizeof(buffer) ? size - total : sizeof(buffer);
+	ssize_t amount = ::pread( fd, buffer, wanted, offset );
+	if( amount > 0 ){
+	    amount = ::send( this->sockfd, buffer, amount, MSG_NOSIGNAL );
+	    if( amount > 0 )
+		offset += amount;
+	}
+#endif
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( this->blocking == NONBLOCKING && (errno == EAGAIN || errno == EWOULDBLOCK ))
+		break;
+	    throw SocketException(this);
+	}
+	if( amount == 0 )
+	    break;
+	total += amount;
+    }
+    return total;
+}
+
+/**
+ * Move data arriving on the socket into a file with splice, for example
+ * to record a stream, without the data passing through userspace.
+ * Blocks until size bytes have been moved or the remote end closes.
+ *
+ * @param fd The file to write to
+ * @param offset Where to write in the file, updated as data is written.
+ *               NULL writes at the files current position.
+ * @param size The amount to move
+ * @return The amount moved, less than size if the socket closed or is non
+ *         blocking and has no more data
+ * @throws SocketException if the splice fails
+ */
+size_t Socket::spliceToFile( const int fd, loff_t *offset, const size_t size ) throw (SocketException)
+{
+#ifdef __linux__
+    // splice needs a pipe at one end
+    int p[2];
+    if( pipe2( p, O_CLOEXEC ) == -1 )
+	throw SocketException(this);
+
+    size_t total = 0;
+    try {
+	while( total < size ){
+	    ssize_t in = ::splice( this->sockfd, NULL, p[1], NULL, size - total,
+				   SPLICE_F_MOVE | SPLICE_F_MORE );
+	    if( in == -1 ){
+		if( errno == EINTR )
+		    continue;
+		if( this->blocking == NONBLOCKING && (errno == EAGAIN || errno == EWOULDBLOCK ))
+		    break;
+		throw SocketException(this);
+	    }
+	    if( in == 0 )
+		break;
+
+	    while( in > 0 ){
+		ssize_t out = ::splice( p[0], NULL, fd, offset, in, SPLICE_F_MOVE | SPLICE_F_MORE );
+		if( out == -1 ){
+		    if( errno == EINTR )
+			continue;
+		    throw SocketException(this);
+		}
+		in -= out;
+		total += out;
+	    }
+	}
+    } catch( ... ){
+	::close(p[0]);
+	::close(p[1]);
+	throw;
+    }
+
+    ::close(p[0]);
+    ::close(p[1]);
+    return total;
+#else
+    // Copy through a buffer where splice is missing
+    char buffer[65536];
+    size_t total = 0;
+    while( total < size ){
+	size_t wanted = size - total < sizeof(buffer) ? size - total : sizeof(buffer);
+	ssize_t in = ::recv( this->sockfd, buffer, wanted, 0 );
+	if( in == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( this->blocking == NONBLOCKING && (errno == EAGAIN || errno == EWOULDBLOCK ))
+		break;
+	    throw SocketException(this);
+	}
+	if( in == 0 )
+	    break;
+
+	for(ssize_t done = 0; done < in; ){
+	    ssize_t out = offset ? ::pwrite( fd, buffer + done, in - done, *offset ) :
+				   ::write( fd, buffer + done, in - done );
+	    if( out == -1 ){
+		if( errno == EINTR )
+		    continue;
+		throw SocketException(this);
+	    }
+	    if( offset )
+		*offset += out;
+	    done += out;
+	    total += out;
+	}
+    }
+    return total;
+#endif
+}
+
 /**
  * Attempt to write size characters from buffer to the socket.
  * This method throws an exception if the remote end has forcable closed
@@ -226,7 +683,7 @@ void Socket::writeUntil ( void *buffer, const size_t size ) throw (SocketExcepti
  *
  * @param buffer The buffer containing the data to write
  * @param size The amount of characters to write, the buffer must be this big
- * @return The amount of charaters written
+ * @return The amount of charaters written, 0 if a non blocking socket is full
  * @throws SockcetException if the remote peer has forced the socket * closed
  */
 ssize_t Socket::write( const void *buffer, const size_t size ) throw (SocketException)
@@ -235,8 +692,15 @@ ssize_t Socket::write( const void *buffer, const size_t size ) throw (SocketExce
 		return -1;
 	}
 
-	ssize_t retval =  ::write( this->sockfd, buffer, size );
+	// A connection the remote end has reset fails with EPIPE rather
+	// than raising SIGPIPE, so callers can recover from it
+	ssize_t retval =  ::send( this->sockfd, buffer, size, MSG_NOSIGNAL );
 	if ( retval == -1 ){
+		// Like read, a non blocking socket that is full writes nothing
+		if ( this->blocking == NONBLOCKING &&
+		     (errno == EAGAIN || errno == EWOULDBLOCK )){
+			return 0;
+		}
 		throw SocketException(this);
 	}
 	return retval;
@@ -258,40 +722,46 @@ ssize_t Socket::write( const std::string &string ) throw (SocketException)
  * Set the blocking mode of this socket.
  * The blocking mode of a socket indicates whether read / accept / write calls will
  * block. Win32 does not support non blocking sockets without a HWND hence this library doesnt
+ * If the socket has no descriptor yet, the mode is remembered and applied
+ * when one is given to it, ie by TCPServer::accept
  * 
  * @param mode The mode to set this socket too
  * @return true if the call was successful, false otherwise
  */
 bool Socket::setBlockingMode( const BlockingMode mode)
 {
-    int flags;
+    int flags, newflags;
 
     if ( !isValid()){
-	return false;
+	this->blocking = mode;
+	return true;
     }
 
     // In order to set the blocking flag, we must be careful not 
     // to stop on any other flags that have been set. Hence
     // we obtain all the flags and adjust the blocking flag only
     flags = ::fcntl(this->sockfd, F_GETFL, 0 /* ALLFLAGS */);
+    if ( flags == -1 ){
+	return false;
+    }
 
     switch( mode ) {
 	case BLOCKING:
-	    flags &=~O_NONBLOCK;
-	    if ( ::fcntl( this->sockfd, F_SETFL, flags ) == 0 ){
-                this->blocking = mode;
-		return true;
-	    } 
+	    newflags = flags & ~O_NONBLOCK;
 	    break;
 	case NONBLOCKING:
-	    flags |= O_NONBLOCK;
-	    if ( ::fcntl( this->sockfd, F_SETFL, flags ) == 0 ){
-                this->blocking = mode;
-		return true;
-	    } 
+	default:
+	    newflags = flags | O_NONBLOCK;
 	    break;
     }
 
+    // Avoid the second system call if the descriptor is already set up,
+    // as is the case for sockets accepted in non blocking mode
+    if ( newflags == flags || ::fcntl( this->sockfd, F_SETFL, newflags ) == 0 ){
+	this->blocking = mode;
+	return true;
+    }
+
     return false;
 }
 
@@ -307,6 +777,32 @@ Socket::BlockingMode Socket::getBlockingMode() const
     return this->blocking;
 }
 
+/**
+ * Limit how long blocking reads and writes wait. A read or write that runs
+ * out of time throws a SocketException with the error EAGAIN.
+ *
+ * @param milliseconds The longest time to wait, 0 waits forever
+ * @return false if the limit could not be set
+ */
+bool Socket::setTimeout( const unsigned milliseconds )
+{
+    this->timeout = milliseconds;
+    if ( !isValid()){
+	return true;
+    }
+
+    struct timeval tv;
+    tv.tv_sec = milliseconds / 1000;
+    tv.tv_usec = (milliseconds % 1000) * 1000;
+    return setsockopt( this->sockfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0 &&
+	setsockopt( this->sockfd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) == 0;
+}
+
+unsigned Socket::getTimeout() const
+{
+    return this->timeout;
+}
+
 /**
  * Return the file descriptor associated with this socket
  *
@@ -31,6 +31,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <signal.h>
@@ -42,6 +43,11 @@
 
 namespace wcl {
 
+#ifndef __linux__
+// The file offset spliceToFile takes, as splice calls it on Linux
+typedef off_t loff_t;
+#endif
+
 /**
  * The Socket class is the base class for all networking transactions.
  * It provides default operations for tcp/udp and the ability to get
@@ -59,11 +65,32 @@ class WCL_API Socket
 		virtual ssize_t write( const std::string & ) throw (SocketException);
 		virtual void readUntil ( void *buffer, const size_t size ) throw (SocketException);
 		virtual void writeUntil ( void *buffer, const size_t size ) throw (SocketException);
+
+		// Scatter/gather interface
+		virtual ssize_t readv ( const struct iovec *vectors, const int count ) throw (SocketException);
+		virtual ssize_t writev ( const struct iovec *vectors, const int count ) throw (SocketException);
+		virtual void readvUntil ( struct iovec *vectors, const int count ) throw (SocketException);
+		virtual void writevUntil ( struct iovec *vectors, const int count ) throw (SocketException);
+
+		// Zero copy interface
+		bool setZeroCopy( const bool );
+		bool getZeroCopy() const;
+		ssize_t writeZeroCopy( const void *buffer, const size_t size, uint32_t *id = NULL ) throw (SocketException);
+		unsigned pollZeroCopyCompletions( const int timeout = 0 ) throw (SocketException);
+		bool isZeroCopyComplete( const uint32_t id ) const;
+		uint32_t getZeroCopyPending() const;
+		uint32_t getZeroCopyCopied() const;
+
+		// File interface
+		size_t sendFile( const int fd, off_t offset, const size_t size ) throw (SocketException);
+		size_t spliceToFile( const int fd, loff_t *offset, const size_t size ) throw (SocketException);
 		virtual ssize_t getAvailableCount();
 		virtual void close();
 		virtual bool isValid() const;
 		virtual bool setBlockingMode( const BlockingMode );
 		virtual BlockingMode getBlockingMode() const;
+		bool setTimeout( const unsigned milliseconds );
+		unsigned getTimeout() const;
 
 		int operator *() const;
 
@@ -100,6 +127,13 @@ class WCL_API Socket
 		int sockfd;
 		struct sockaddr_in address;
                 BlockingMode blocking;
+		unsigned timeout;
+
+		bool zeroCopy;
+		uint32_t zeroCopySent;
+		uint32_t zeroCopyCompleted;
+		uint32_t zeroCopyNext;
+		uint32_t zeroCopyCopied;
 
 		Socket();
 
@@ -0,0 +1,290 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "SocketStream.h"
+
+namespace wcl {
+
+static bool isHostLittleEndian()
+{
+    const uint16_t probe = 1;
+    return *(const uint8_t *)&probe == 1;
+}
+
+/**
+ * Create a stream over the given socket.
+ *
+ * @param socket The socket to read from and write to
+ * @param bufferSize The size of the read and write buffers. The read buffer
+ *                   grows if a larger peek is requested.
+ */
+SocketStream::SocketStream( Socket &isocket, const size_t bufferSize ):
+    socket(isocket), readBuffer(bufferSize), readStart(0), readEnd(0),
+    writeBuffer(bufferSize), writeSize(0)
+{
+    assert( bufferSize > 0 );
+}
+
+const unsigned char *SocketStream::peek( const size_t size ) throw (SocketException)
+{
+    if( this->readEnd - this->readStart < size ){
+	// Make room at the end of the buffer for the rest
+	if( this->readStart + size > this->readBuffer.size()){
+	    memmove(&this->readBuffer[0], &this->readBuffer[this->readStart],
+		    this->readEnd - this->readStart);
+	    this->readEnd -= this->readStart;
+	    this->readStart = 0;
+	    if( size > this->readBuffer.size())
+		this->readBuffer.resize(size);
+	}
+
+	while( this->readEnd - this->readStart < size )
+	    this->fill();
+    }
+
+    return &this->readBuffer[this->readStart];
+}
+
+void SocketStream::consume( const size_t size )
+{
+    assert( size <= this->getBufferedCount());
+
+    this->readStart += size;
+    if( this->readStart == this->readEnd )
+	this->readStart = this->readEnd = 0;
+}
+
+size_t SocketStream::fill() throw (SocketException)
+{
+    if( this->readEnd == this->readBuffer.size()){
+	if( this->readStart == 0 )
+	    return 0;
+	memmove(&this->readBuffer[0], &this->readBuffer[this->readStart],
+		this->readEnd - this->readStart);
+	this->readEnd -= this->readStart;
+	this->readStart = 0;
+    }
+
+    ssize_t amount = this->socket.read(&this->readBuffer[this->readEnd],
+				       this->readBuffer.size() - this->readEnd);
+    if( amount < 0 )
+	throw SocketException(&this->socket);
+
+    this->readEnd += amount;
+    return amount;
+}
+
+size_t SocketStream::getBufferedCount() const
+{
+    return this->readEnd - this->readStart;
+}
+
+void SocketStream::read( void *buffer, const size_t size ) throw (SocketException)
+{
+    unsigned char *out = (unsigned char *)buffer;
+    size_t remaining = size;
+
+    // Large reads are copied out as they arrive rather than growing the buffer
+    while( remaining > 0 ){
+	if( this->getBufferedCount() == 0 )
+	    this->fill();
+
+	size_t amount = this->getBufferedCount() < remaining ? this->getBufferedCount() : remaining;
+	memcpy(out, &this->readBuffer[this->readStart], amount);
+	this->consume(amount);
+	out += amount;
+	remaining -= amount;
+    }
+}
+
+std::string SocketStream::readString( const size_t size ) throw (SocketException)
+{
+    std::string s;
+    if( size ){
+	s.resize(size);
+	this->read(&s[0], size);
+    }
+    return s;
+}
+
+uint64_t SocketStream::readOrdered( const size_t size, const ByteOrder order ) throw (SocketException)
+{
+    const unsigned char *data = this->peek(size);
+    uint64_t value = 0;
+
+    bool little = order == LITTLE || (order == HOST && isHostLittleEndian());
+    if( little ){
+	for(size_t i = size; i > 0; i-- )
+	    value = (value << 8) | data[i - 1];
+    }
+    else {
+	for(size_t i = 0; i < size; i++ )
+	    value = (value << 8) | data[i];
+    }
+
+    this->consume(size);
+    return value;
+}
+
+uint8_t SocketStream::readUInt8() throw (SocketException)
+{
+    uint8_t value = *this->peek(1);
+    this->consume(1);
+    return value;
+}
+
+uint16_t SocketStream::readUInt16( const ByteOrder order ) throw (SocketException)
+{
+    return (uint16_t)this->readOrdered(2, order);
+}
+
+uint32_t SocketStream::readUInt32( const ByteOrder order ) throw (SocketException)
+{
+    return (uint32_t)this->readOrdered(4, order);
+}
+
+int32_t SocketStream::readInt32( const ByteOrder order ) throw (SocketException)
+{
+    return (int32_t)this->readOrdered(4, order);
+}
+
+uint64_t SocketStream::readUInt64( const ByteOrder order ) throw (SocketException)
+{
+    return this->readOrdered(8, order);
+}
+
+float SocketStream::readFloat( const ByteOrder order ) throw (SocketException)
+{
+    uint32_t bits = (uint32_t)this->readOrdered(4, order);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double SocketStream::readDouble( const ByteOrder order ) throw (SocketException)
+{
+    uint64_t bits = this->readOrdered(8, order);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void SocketStream::write( const void *buffer, const size_t size ) throw (SocketException)
+{
+    if( this->writeSize + size > this->writeBuffer.size())
+	this->flush();
+
+    if( size >= this->writeBuffer.size()){
+	this->socket.writeUntil((void *)buffer, size);
+	return;
+    }
+
+    memcpy(&this->writeBuffer[this->writeSize], buffer, size);
+    this->writeSize += size;
+}
+
+void SocketStream::write( const std::string &s ) throw (SocketException)
+{
+    this->write(s.data(), s.size());
+}
+
+void SocketStream::writeOrdered( const uint64_t value, const size_t size, const ByteOrder order ) throw (SocketException)
+{
+    unsigned char data[8];
+
+    bool little = order == LITTLE || (order == HOST && isHostLittleEndian());
+    for(size_t i = 0; i < size; i++ ){
+	unsigned char byte = (unsigned char)(value >> (8 * i));
+	data[little ? i : size - 1 - i] = byte;
+    }
+
+    this->write(data, size);
+}
+
+void SocketStream::writeUInt8( const uint8_t value ) throw (SocketException)
+{
+    this->write(&value, 1);
+}
+
+void SocketStream::writeUInt16( const uint16_t value, const ByteOrder order ) throw (SocketException)
+{
+    this->writeOrdered(value, 2, order);
+}
+
+void SocketStream::writeUInt32( const uint32_t value, const ByteOrder order ) throw (SocketException)
+{
+    this->writeOrdered(value, 4, order);
+}
+
+void SocketStream::writeInt32( const int32_t value, const ByteOrder order ) throw (SocketException)
+{
+    this->writeOrdered((uint32_t)value, 4, order);
+}
+
+void SocketStream::writeUInt64( const uint64_t value, const ByteOrder order ) throw (SocketException)
+{
+    this->writeOrdered(value, 8, order);
+}
+
+void SocketStream::writeFloat( const float value, const ByteOrder order ) throw (SocketException)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    this->writeOrdered(bits, 4, order);
+}
+
+void SocketStream::writeDouble( const double value, const ByteOrder order ) throw (SocketException)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    this->writeOrdered(bits, 8, order);
+}
+
+void SocketStream::flush() throw (SocketException)
+{
+    if( this->writeSize == 0 )
+	return;
+
+    // Clear the queue first so a failed write doesn't resend a partial message
+    size_t size = this->writeSize;
+    this->writeSize = 0;
+    this->socket.writeUntil(&this->writeBuffer[0], size);
+}
+
+size_t SocketStream::getWriteQueueSize() const
+{
+    return this->writeSize;
+}
+
+Socket &SocketStream::getSocket()
+{
+    return this->socket;
+}
+
+}; // namespace wcl
@@ -0,0 +1,151 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_NETWORK_SOCKETSTREAM_H
+#define WCL_NETWORK_SOCKETSTREAM_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <wcl/api.h>
+#include <wcl/network/Socket.h>
+
+namespace wcl {
+
+/**
+ * A SocketStream adds userspace buffering to a Socket. Reads fetch as much
+ * as the socket has available in one call and fields are then taken from
+ * the buffer, so a protocol made of many small fields costs one system call
+ * per message rather than one per field. Writes are collected until flush()
+ * is called or the buffer fills.
+ *
+ * The typed readers and writers take the byte order of the field on the
+ * wire. HOST copies the bytes unchanged.
+ *
+ * The stream does not own the socket. Data written but not flushed when the
+ * stream is destroyed is discarded.
+ */
+class WCL_API SocketStream
+{
+    public:
+	enum ByteOrder { LITTLE, BIG, HOST };
+
+	SocketStream( Socket &socket, const size_t bufferSize = 16384 );
+
+	/**
+	 * Make sure at least size bytes are buffered, blocking until they
+	 * arrive, and return a pointer to them. The data stays in the buffer
+	 * until consumed. The pointer is valid until the next read.
+	 *
+	 * @throw SocketException if the socket fails or is closed
+	 */
+	const unsigned char *peek( const size_t size ) throw (SocketException);
+
+	/**
+	 * Discard size bytes from the front of the buffer, these must have
+	 * been buffered by peek or fill
+	 */
+	void consume( const size_t size );
+
+	/**
+	 * Read whatever the socket has available into the buffer with a
+	 * single read. A blocking socket waits for data to arrive, a non
+	 * blocking socket returns 0 if there is none.
+	 *
+	 * @return The amount of data added to the buffer
+	 * @throw SocketException if the socket fails or is closed
+	 */
+	size_t fill() throw (SocketException);
+
+	/**
+	 * Obtain the amount of data buffered and not yet consumed
+	 */
+	size_t getBufferedCount() const;
+
+	/**
+	 * Read exactly size bytes, blocking until they arrive
+	 */
+	void read( void *buffer, const size_t size ) throw (SocketException);
+	std::string readString( const size_t size ) throw (SocketException);
+
+	uint8_t readUInt8() throw (SocketException);
+	uint16_t readUInt16( const ByteOrder ) throw (SocketException);
+	uint32_t readUInt32( const ByteOrder ) throw (SocketException);
+	int32_t readInt32( const ByteOrder ) throw (SocketException);
+	uint64_t readUInt64( const ByteOrder ) throw (SocketException);
+	float readFloat( const ByteOrder ) throw (SocketException);
+	double readDouble( const ByteOrder ) throw (SocketException);
+
+	/**
+	 * Queue data to be written. Data is only sent when the buffer fills
+	 * or flush is called. Writes larger than the buffer are sent
+	 * straight away.
+	 */
+	void write( const void *buffer, const size_t size ) throw (SocketException);
+	void write( const std::string & ) throw (SocketException);
+
+	void writeUInt8( const uint8_t ) throw (SocketException);
+	void writeUInt16( const uint16_t, const ByteOrder ) throw (SocketException);
+	void writeUInt32( const uint32_t, const ByteOrder ) throw (SocketException);
+	void writeInt32( const int32_t, const ByteOrder ) throw (SocketException);
+	void writeUInt64( const uint64_t, const ByteOrder ) throw (SocketException);
+	void writeFloat( const float, const ByteOrder ) throw (SocketException);
+	void writeDouble( const double, const ByteOrder ) throw (SocketException);
+
+	/**
+	 * Write all queued data to the socket, blocking until it is written
+	 */
+	void flush() throw (SocketException);
+
+	/**
+	 * Obtain the amount of data queued for writing
+	 */
+	size_t getWriteQueueSize() const;
+
+	Socket &getSocket();
+
+    private:
+	// Not copyable
+	SocketStream( const SocketStream & );
+	SocketStream &operator =( const SocketStream & );
+
+	uint64_t readOrdered( const size_t size, const ByteOrder ) throw (SocketException);
+	void writeOrdered( const uint64_t value, const size_t size, const ByteOrder ) throw (SocketException);
+
+	Socket &socket;
+
+	std::vector<unsigned char> readBuffer;
+	size_t readStart;
+	size_t readEnd;
+
+	std::vector<unsigned char> writeBuffer;
+	size_t writeSize;
+};
+
+}; // namespace wcl
+
+#endif
@@ -0,0 +1,340 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+
+#include "TCPConnection.h"
+#include "Reactor.h"
+
+namespace wcl {
+
+#define READ_CHUNK 4096
+
+const size_t TCPConnection::DEFAULT_READ_LIMIT = 16 * 1024 * 1024;
+const size_t TCPConnection::DEFAULT_WRITE_QUEUE_LIMIT = 64 * 1024 * 1024;
+
+TCPConnection::TCPConnection( Reactor *ireactor, TCPConnectionHandler *ihandler ):
+    reactor(ireactor), handler(ihandler),
+    readBuffer(READ_CHUNK), readStart(0), readEnd(0), readLimit(DEFAULT_READ_LIMIT), paused(false),
+    writeStart(0), writeLimit(DEFAULT_WRITE_QUEUE_LIMIT), connecting(false), closing(false), closed(false), userData(NULL)
+{
+    this->socket.setBlockingMode(Socket::NONBLOCKING);
+}
+
+TCPConnection::TCPConnection( Reactor *ireactor, TCPConnectionHandler *ihandler,
+			      const std::string &server, const unsigned port,
+			      const bool wait ) throw (SocketException):
+    reactor(ireactor), handler(ihandler), socket(server, port, wait),
+    readBuffer(READ_CHUNK), readStart(0), readEnd(0), readLimit(DEFAULT_READ_LIMIT), paused(false),
+    writeStart(0), writeLimit(DEFAULT_WRITE_QUEUE_LIMIT), connecting(!wait), closing(false), closed(false), userData(NULL)
+{
+    if( !this->socket.setBlockingMode(Socket::NONBLOCKING))
+	throw SocketException(&this->socket);
+
+    // The reactor is told when the connect completes by the socket
+    // becoming writable, even if it completed immediately
+    if( this->connecting ){
+	sockaddr_in address = this->socket.getRemoteAddress();
+	if( ::connect(*this->socket, (sockaddr *)&address, sizeof(address)) == -1 &&
+	    errno != EINPROGRESS ){
+	    SocketException e(&this->socket);
+	    this->socket.close();
+	    throw e;
+	}
+    }
+}
+
+TCPConnection::~TCPConnection()
+{}
+
+const unsigned char *TCPConnection::getReadData() const
+{
+    return &this->readBuffer[this->readStart];
+}
+
+size_t TCPConnection::getReadSize() const
+{
+    return this->readEnd - this->readStart;
+}
+
+void TCPConnection::consume( const size_t size )
+{
+    this->readStart += size < this->getReadSize() ? size : this->getReadSize();
+    if( this->readStart == this->readEnd )
+	this->readStart = this->readEnd = 0;
+
+    // Anything that arrived while paused won't be reported again by itself
+    if( this->paused && this->getReadSize() < this->readLimit && !this->closed ){
+	this->paused = false;
+	this->reactor->rearmConnection(this);
+    }
+}
+
+void TCPConnection::setReadLimit( const size_t limit )
+{
+    this->readLimit = limit;
+    if( this->paused && this->getReadSize() < this->readLimit && !this->closed ){
+	this->paused = false;
+	this->reactor->rearmConnection(this);
+    }
+}
+
+size_t TCPConnection::getReadLimit() const
+{
+    return this->readLimit;
+}
+
+void TCPConnection::write( const void *buffer, const size_t size )
+{
+    const unsigned char *data = (const unsigned char *)buffer;
+    size_t remaining = size;
+
+    if( this->closed || this->closing )
+	return;
+
+    // Only write directly if nothing is queued, else the data would be
+    // written out of order. Data written while connecting waits for the
+    // connection.
+    if( this->getWriteQueueSize() == 0 && !this->connecting ){
+	while( remaining > 0 ){
+	    ssize_t amount = ::send(*this->socket, data, remaining, MSG_NOSIGNAL);
+	    if( amount == -1 ){
+		if( errno == EINTR )
+		    continue;
+		if( errno == EAGAIN || errno == EWOULDBLOCK )
+		    break;
+		this->reactor->closeConnection(this);
+		return;
+	    }
+	    data += amount;
+	    remaining -= amount;
+	}
+    }
+
+    if( remaining > 0 && this->getWriteQueueSize() + remaining > this->writeLimit ){
+	this->reactor->closeConnection(this);
+	return;
+    }
+
+    // The socket will tell the reactor when it can be written to again
+    if( remaining > 0 )
+	this->writeBuffer.insert(this->writeBuffer.end(), data, data + remaining);
+}
+
+void TCPConnection::write( const std::string &string )
+{
+    this->write(string.c_str(), string.size());
+}
+
+size_t TCPConnection::getWriteQueueSize() const
+{
+    return this->writeBuffer.size() - this->writeStart;
+}
+
+void TCPConnection::setWriteQueueLimit( const size_t limit )
+{
+    this->writeLimit = limit;
+}
+
+size_t TCPConnection::getWriteQueueLimit() const
+{
+    return this->writeLimit;
+}
+
+void TCPConnection::close()
+{
+    if( this->closed )
+	return;
+
+    this->closing = true;
+    if( this->getWriteQueueSize() == 0 || this->connecting )
+	this->reactor->closeConnection(this);
+}
+
+bool TCPConnection::isClosed() const
+{
+    return this->closed || this->closing;
+}
+
+bool TCPConnection::isConnected() const
+{
+    return !this->connecting && !this->isClosed();
+}
+
+void TCPConnection::setHandler( TCPConnectionHandler *ihandler )
+{
+    this->handler = ihandler;
+}
+
+void TCPConnection::setUserData( void *data )
+{
+    this->userData = data;
+}
+
+void *TCPConnection::getUserData() const
+{
+    return this->userData;
+}
+
+TCPSocket &TCPConnection::getSocket()
+{
+    return this->socket;
+}
+
+Reactor *TCPConnection::getReactor() const
+{
+    return this->reactor;
+}
+
+void TCPConnection::handleEvents( const uint32_t events )
+{
+    if( this->connecting ){
+	if( !(events & (EPOLLOUT | EPOLLERR | EPOLLHUP)))
+	    return;
+	if( !this->finishConnect()){
+	    this->reactor->closeConnection(this);
+	    return;
+	}
+
+	this->handler->connected(this);
+	if( this->closed )
+	    return;
+    }
+
+    if( events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)){
+	bool received = false;
+	bool open = this->readAvailable(received);
+
+	// Hand over whatever arrived before the connection closed
+	if( received && !this->closed )
+	    this->handler->dataReceived(this);
+
+	if( !open ){
+	    this->reactor->closeConnection(this);
+	    return;
+	}
+    }
+
+    if( (events & EPOLLOUT) && !this->closed && this->getWriteQueueSize()){
+	if( !this->flush()){
+	    this->reactor->closeConnection(this);
+	    return;
+	}
+
+	if( this->getWriteQueueSize() == 0 ){
+	    if( this->closing )
+		this->reactor->closeConnection(this);
+	    else
+		this->handler->writeComplete(this);
+	}
+    }
+}
+
+bool TCPConnection::readAvailable( bool &received )
+{
+    // Edge triggered, so everything must be read now, unless the limit
+    // is reached in which case consume rearms the connection
+    for(;;){
+	if( this->getReadSize() >= this->readLimit ){
+	    this->paused = true;
+	    return true;
+	}
+
+	if( this->readEnd == this->readBuffer.size()){
+	    if( this->readStart > 0 ){
+		memmove(&this->readBuffer[0], &this->readBuffer[this->readStart], this->getReadSize());
+		this->readEnd -= this->readStart;
+		this->readStart = 0;
+	    }
+	    else
+		this->readBuffer.resize(this->readBuffer.size() * 2);
+	}
+
+	size_t space = this->readBuffer.size() - this->readEnd;
+	if( space > this->readLimit - this->getReadSize())
+	    space = this->readLimit - this->getReadSize();
+
+	ssize_t amount = ::recv(*this->socket, &this->readBuffer[this->readEnd], space, 0);
+	if( amount > 0 ){
+	    this->readEnd += amount;
+	    received = true;
+	    continue;
+	}
+
+	if( amount == 0 )
+	    return false;
+	if( errno == EINTR )
+	    continue;
+	return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+bool TCPConnection::finishConnect()
+{
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if( getsockopt(*this->socket, SOL_SOCKET, SO_ERROR, &error, &length) == -1 )
+	return false;
+    if( error != 0 ){
+	errno = error;
+	return false;
+    }
+
+    this->connecting = false;
+    return true;
+}
+
+bool TCPConnection::flush()
+{
+    while( this->getWriteQueueSize()){
+	ssize_t amount = ::send(*this->socket, &this->writeBuffer[this->writeStart],
+				this->getWriteQueueSize(), MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno == EAGAIN || errno == EWOULDBLOCK )
+		break;
+	    return false;
+	}
+	this->writeStart += amount;
+    }
+
+    // Keep the buffer allocated for the next write
+    if( this->writeStart == this->writeBuffer.size()){
+	this->writeBuffer.clear();
+	this->writeStart = 0;
+    }
+    else if( this->writeStart > this->writeBuffer.size() / 2 ){
+	this->writeBuffer.erase(this->writeBuffer.begin(),
+				this->writeBuffer.begin() + this->writeStart);
+	this->writeStart = 0;
+    }
+    return true;
+}
+
+}; // namespace wcl
@@ -0,0 +1,212 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_NETWORK_TCPCONNECTION_H
+#define WCL_NETWORK_TCPCONNECTION_H
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/TCPSocket.h>
+
+namespace wcl {
+
+class Reactor;
+class TCPConnection;
+
+/**
+ * A TCPConnectionHandler is told about events on the connections a
+ * Reactor drives. All calls are made from the thread running the Reactor.
+ */
+class WCL_API TCPConnectionHandler
+{
+    public:
+	virtual ~TCPConnectionHandler() {}
+
+	/**
+	 * A connection has been accepted or connected. A connection started
+	 * with Reactor::connectAsync that fails is disconnected without
+	 * being connected.
+	 */
+	virtual void connected( TCPConnection * ) {}
+
+	/**
+	 * New data has arrived and has been added to the connections read
+	 * buffer. Data that is not consumed remains in the buffer and is
+	 * presented again with the next data that arrives.
+	 */
+	virtual void dataReceived( TCPConnection * ) = 0;
+
+	/**
+	 * All data queued for writing has been written
+	 */
+	virtual void writeComplete( TCPConnection * ) {}
+
+	/**
+	 * The connection has been closed, either end closed it or it failed.
+	 * The connection is destroyed after this returns.
+	 */
+	virtual void disconnected( TCPConnection * ) {}
+};
+
+/**
+ * A TCPConnection is a non blocking TCP connection driven by a Reactor.
+ * Incoming data is buffered and handed to the handler, outgoing data is
+ * written immediately where possible and buffered otherwise. Connections
+ * are created and destroyed by the Reactor.
+ */
+class WCL_API TCPConnection
+{
+    public:
+	/**
+	 * Obtain the data read from the socket that has not been consumed
+	 */
+	const unsigned char *getReadData() const;
+	size_t getReadSize() const;
+
+	/**
+	 * Remove the given amount of data from the front of the read buffer
+	 */
+	void consume( const size_t size );
+
+	/**
+	 * Limit the amount of unconsumed data held in the read buffer. Once
+	 * it is reached the connection stops reading, leaving the remote end
+	 * to be held back by TCP, until enough has been consumed to drop
+	 * below it again.
+	 */
+	void setReadLimit( const size_t limit );
+	size_t getReadLimit() const;
+
+	/**
+	 * Write data to the connection. Whatever can't be written without
+	 * blocking is queued and written when the socket allows. If the
+	 * write fails the connection is closed.
+	 */
+	void write( const void *buffer, const size_t size );
+	void write( const std::string & );
+
+	/**
+	 * Obtain the amount of data waiting to be written
+	 */
+	size_t getWriteQueueSize() const;
+
+	/**
+	 * Limit the amount of data waiting to be written. A write that would
+	 * take the queue over the limit closes the connection instead, so a
+	 * remote end that stops reading can't hold on to unbounded memory.
+	 */
+	void setWriteQueueLimit( const size_t limit );
+	size_t getWriteQueueLimit() const;
+
+	static const size_t DEFAULT_READ_LIMIT;
+	static const size_t DEFAULT_WRITE_QUEUE_LIMIT;
+
+	/**
+	 * Close the connection once all queued data has been written
+	 */
+	void close();
+	bool isClosed() const;
+
+	/**
+	 * Has the connection been established and not yet closed
+	 */
+	bool isConnected() const;
+
+	/**
+	 * Change the handler told about events on this connection
+	 */
+	void setHandler( TCPConnectionHandler * );
+
+	/**
+	 * Associate application data with the connection
+	 */
+	void setUserData( void * );
+	void *getUserData() const;
+
+	TCPSocket &getSocket();
+	Reactor *getReactor() const;
+
+    private:
+	friend class Reactor;
+
+	TCPConnection( Reactor *, TCPConnectionHandler * );
+	TCPConnection( Reactor *, TCPConnectionHandler *, const std::string &server, const unsigned port,
+		       const bool wait = true ) throw (SocketException);
+	~TCPConnection();
+
+	/**
+	 * Handle the events epoll reported for the connection
+	 */
+	void handleEvents( const uint32_t events );
+
+	/**
+	 * Read everything available from the socket, or until the read
+	 * limit is reached
+	 *
+	 * @return false if the remote end closed the connection or it failed
+	 */
+	bool readAvailable( bool &received );
+
+	/**
+	 * Finish a connect started without waiting
+	 *
+	 * @return false if the connection failed
+	 */
+	bool finishConnect();
+
+	/**
+	 * Write as much queued data as possible
+	 *
+	 * @return false if the connection failed
+	 */
+	bool flush();
+
+	Reactor *reactor;
+	TCPConnectionHandler *handler;
+	TCPSocket socket;
+	std::list<TCPConnection *>::iterator self; // Position in the reactors list
+	std::vector<unsigned char> readBuffer;
+	size_t readStart;
+	size_t readEnd;
+	size_t readLimit;
+	bool paused; // Stopped reading at the read limit
+	std::vector<unsigned char> writeBuffer;
+	size_t writeStart;
+	size_t writeLimit;
+	bool connecting;
+	bool closing;
+	bool closed;
+	void *userData;
+
+	TCPConnection( const TCPConnection & );
+	TCPConnection &operator =( const TCPConnection & );
+};
+
+}; // namespace wcl
+
+#endif
@@ -59,6 +59,10 @@ TCPServer::TCPServer( const unsigned port, const unsigned queuelength )
  * a connection waiting, if there is not, it will return with status of false, else it
  * will return with a status of true and modify the input socket.
  *
+ * The new connection takes on the blocking mode of the given socket. This
+ * can be set before the socket is valid, in which case non blocking
+ * connections are accepted without further system calls.
+ *
  * @param socket A socket that can be modified to indicate the new client. If the socket is already valid, it will first be closed
  * @return true on a successful client connection, false if in non blocking mode and no clients waiting
  */
@@ -66,8 +70,17 @@ bool TCPServer::accept( TCPSocket *socket )
 {
     assert( socket != NULL );
 
-    int addr_length = sizeof(this->address);
-    int newfd  = ::accept( this->sockfd, (sockaddr *)&this->address, (socklen_t*)&addr_length);
+    sockaddr_in remote;
+    socklen_t addr_length = sizeof(remote);
+
+#ifdef SOCK_NONBLOCK
+    int flags = 0;
+    if( socket->getBlockingMode() == NONBLOCKING )
+	flags = SOCK_NONBLOCK;
+    int newfd  = ::accept4( this->sockfd, (sockaddr *)&remote, &addr_length, flags);
+#else
+    int newfd  = ::accept( this->sockfd, (sockaddr *)&remote, &addr_length);
+#endif
 
     // Close the existing socket if it allocated
     if( socket->isValid()){
@@ -76,7 +89,8 @@ bool TCPServer::accept( TCPSocket *socket )
 
     // Set the content of the new socket
     socket->setFileDescriptor( newfd );
-    socket->setRemoteAddress( this->address );
+    if( newfd != -1 )
+	socket->setRemoteAddress( remote );
 
     return socket->isValid();
 }
@@ -29,6 +29,8 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <errno.h>
+#include <poll.h>
 
 namespace wcl {
 
@@ -81,6 +83,57 @@ void TCPSocket::connect() throw (SocketException)
 	}
 }
 
+/**
+ * Connect to the server given to the constructor, giving up if the
+ * connection isn't made in time. The blocking mode of the socket is
+ * unchanged.
+ *
+ * @param timeout The longest time to wait in milliseconds
+ * @throws SocketException if the connection failed, the error is ETIMEDOUT
+ *         if it took too long
+ */
+void TCPSocket::connect( const unsigned timeout ) throw (SocketException)
+{
+	if (!this->isValid() && !this->create())
+	{
+		throw SocketException(this);
+	}
+
+	BlockingMode mode = this->blocking;
+	this->setBlockingMode(NONBLOCKING);
+
+	if ( ::connect( this->sockfd, (sockaddr *)&address, sizeof(address)) == -1 ){
+		if ( errno != EINPROGRESS ){
+			SocketException e(this);
+			this->close();
+			throw e;
+		}
+
+		struct pollfd pfd;
+		pfd.fd = this->sockfd;
+		pfd.events = POLLOUT;
+		int ready = ::poll(&pfd, 1, timeout);
+
+		int error = 0;
+		socklen_t length = sizeof(error);
+		if ( ready == 0 )
+			error = ETIMEDOUT;
+		else if ( ready == -1 )
+			error = errno;
+		else if ( getsockopt(this->sockfd, SOL_SOCKET, SO_ERROR, &error, &length) == -1 )
+			error = errno;
+
+		if ( error != 0 ){
+			errno = error;
+			SocketException e(this);
+			this->close();
+			throw e;
+		}
+	}
+
+	this->setBlockingMode(mode);
+}
+
 /**
  * Create a socket of type SOCK_STREAM and allow more than one socket to listen on 
  * the one port if required
@@ -127,6 +180,8 @@ void TCPSocket::setFileDescriptor( const int input)
 
     // We must update the blocking state of the input descriptor else
     this->setBlockingMode( this->blocking );
+    if ( this->timeout )
+	this->setTimeout( this->timeout );
 }
 
 /**
@@ -42,6 +42,7 @@ class WCL_API TCPSocket: public Socket
 		TCPSocket();
 		TCPSocket ( const std::string &, const unsigned port, bool autoConnect = true) throw (SocketException);
 		void connect() throw (SocketException);
+		void connect( const unsigned timeout ) throw (SocketException);
 		void setFileDescriptor( const int );
 		void setRemoteAddress( const sockaddr_in );
 
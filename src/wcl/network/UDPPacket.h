@@ -50,8 +50,16 @@ class WCL_API UDPPacket
 	size_t getSize() const;
 	sockaddr_in getRecipient() const;
 
+	/**
+	 * Obtain the amount of data in the packet. This is set when a packet
+	 * is read and is otherwise the size of the packet.
+	 */
+	size_t getLength() const;
+	void setLength( const size_t );
+
 	void setData( void *, const size_t );
 	void setRecipient( const sockaddr_in );
+	void clearRecipient();
 	bool hasAddress() const;
 
     private:
@@ -59,6 +67,7 @@ class WCL_API UDPPacket
 
 	void *data;
 	size_t size;
+	size_t length;
 
 	bool needdelete;
 	bool addressset;
@@ -72,7 +81,7 @@ class WCL_API UDPPacket
  * @throws a string exception on memory allocation error
  */
 inline UDPPacket::UDPPacket( const size_t length ):
-    size(length),needdelete(true),addressset(false)
+    size(length),length(length),needdelete(true),addressset(false)
 {
     this->data = (void *) malloc( this->size );
 }
@@ -85,7 +94,7 @@ inline UDPPacket::UDPPacket( const size_t length ):
  * @param length The length of the buffer
  */ 
 inline UDPPacket::UDPPacket( void *buffer, const size_t length ):
-    data(buffer), size(length), needdelete(false),addressset(false)
+    data(buffer), size(length), length(length), needdelete(false),addressset(false)
 {
 
     assert(buffer!=NULL && length!=0);
@@ -122,6 +131,20 @@ inline size_t UDPPacket::getSize() const
     return this->size;
 }
 
+/**
+ * obtain the amount of valid data in the packet
+ */
+inline size_t UDPPacket::getLength() const
+{
+    return this->length;
+}
+
+inline void UDPPacket::setLength( const size_t amount )
+{
+    assert( amount <= this->size );
+    this->length = amount;
+}
+
 /**
  * obtain the recipient associated with this packet
  */
@@ -135,6 +158,7 @@ inline void UDPPacket::setData( void *buffer, const size_t length )
 {
     this->data = buffer;
     this->size = length;
+    this->length = length;
 }
 
 inline void UDPPacket::setRecipient( const sockaddr_in recipient )
@@ -143,6 +167,14 @@ inline void UDPPacket::setRecipient( const sockaddr_in recipient )
     this->addressset = true;;
 }
 
+/**
+ * Forget the recipient, the packet will be sent to the socket's address
+ */
+inline void UDPPacket::clearRecipient()
+{
+    this->addressset = false;
+}
+
 inline bool UDPPacket::hasAddress() const
 {
     return this->addressset;
@@ -0,0 +1,127 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <assert.h>
+
+#include "UDPPacketPool.h"
+
+namespace wcl {
+
+/**
+ * Create a pool of packets. All storage is allocated here.
+ *
+ * @param count The number of packets in the pool
+ * @param packetSize The size of each packet, this should be the largest
+ *                   datagram expected
+ */
+UDPPacketPool::UDPPacketPool( const unsigned count, const size_t ipacketSize ):
+    packetSize(ipacketSize)
+{
+    assert( count > 0 && ipacketSize > 0 );
+
+    this->storage = new unsigned char[count * ipacketSize];
+    this->packets.reserve(count);
+    this->available.reserve(count);
+    for(unsigned i = 0; i < count; i++ ){
+	UDPPacket *p = new UDPPacket(this->storage + i * ipacketSize, ipacketSize);
+	this->packets.push_back(p);
+	this->available.push_back(p);
+    }
+}
+
+UDPPacketPool::~UDPPacketPool()
+{
+    for(unsigned i = 0; i < this->packets.size(); i++ )
+	delete this->packets[i];
+    delete [] this->storage;
+}
+
+UDPPacket *UDPPacketPool::acquire()
+{
+    ScopedLock l(this->lock);
+
+    if( this->available.empty())
+	return NULL;
+
+    UDPPacket *p = this->available.back();
+    this->available.pop_back();
+    return p;
+}
+
+unsigned UDPPacketPool::acquire( UDPPacket **out, const unsigned count )
+{
+    ScopedLock l(this->lock);
+
+    unsigned amount = count < this->available.size() ? count : this->available.size();
+    for(unsigned i = 0; i < amount; i++ ){
+	out[i] = this->available.back();
+	this->available.pop_back();
+    }
+    return amount;
+}
+
+void UDPPacketPool::release( UDPPacket *packet )
+{
+    assert( packet != NULL );
+
+    // A read may have shortened the packet and set where it came from
+    packet->setLength(packet->getSize());
+    packet->clearRecipient();
+
+    ScopedLock l(this->lock);
+    assert( this->available.size() < this->packets.size());
+    this->available.push_back(packet);
+}
+
+void UDPPacketPool::release( UDPPacket * const *in, const unsigned count )
+{
+    for(unsigned i = 0; i < count; i++ ){
+	in[i]->setLength(in[i]->getSize());
+	in[i]->clearRecipient();
+    }
+
+    ScopedLock l(this->lock);
+    assert( this->available.size() + count <= this->packets.size());
+    this->available.insert(this->available.end(), in, in + count);
+}
+
+unsigned UDPPacketPool::getAvailable()
+{
+    ScopedLock l(this->lock);
+    return this->available.size();
+}
+
+unsigned UDPPacketPool::getCount() const
+{
+    return this->packets.size();
+}
+
+size_t UDPPacketPool::getPacketSize() const
+{
+    return this->packetSize;
+}
+
+}; // namespace wcl
@@ -0,0 +1,89 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_NETWORK_UDPPACKETPOOL_H
+#define WCL_NETWORK_UDPPACKETPOOL_H
+
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/UDPPacket.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl {
+
+/**
+ * A UDPPacketPool preallocates a fixed number of equally sized UDPPackets
+ * so packets can be sent and received without touching the allocator.
+ * Packets are acquired from the pool, filled by UDPSocket::read or by the
+ * application, and released back to the pool once finished with. The pool
+ * may be shared between threads.
+ */
+class WCL_API UDPPacketPool
+{
+    public:
+	UDPPacketPool( const unsigned count, const size_t packetSize );
+	~UDPPacketPool();
+
+	/**
+	 * Obtain a packet from the pool.
+	 *
+	 * @return A packet, or NULL if all packets are in use
+	 */
+	UDPPacket *acquire();
+
+	/**
+	 * Obtain up to count packets from the pool.
+	 *
+	 * @return The number of packets placed into the array
+	 */
+	unsigned acquire( UDPPacket **packets, const unsigned count );
+
+	/**
+	 * Return packets to the pool. The packets must have come from this pool.
+	 */
+	void release( UDPPacket *packet );
+	void release( UDPPacket * const *packets, const unsigned count );
+
+	unsigned getAvailable();
+	unsigned getCount() const;
+	size_t getPacketSize() const;
+
+    private:
+	// Not copyable
+	UDPPacketPool( const UDPPacketPool & );
+	UDPPacketPool &operator =( const UDPPacketPool & );
+
+	unsigned char *storage;
+	size_t packetSize;
+	std::vector<UDPPacket *> packets;
+	std::vector<UDPPacket *> available;
+	Mutex lock;
+};
+
+}; // namespace wcl
+
+#endif
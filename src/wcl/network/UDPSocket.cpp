@@ -31,11 +31,17 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/uio.h>
 
 #include <wcl/network/UDPSocket.h>
 
 namespace wcl {
 
+// The number of packets handed to the kernel per system call
+#define UDP_BATCH_SIZE 64
+
 /**
  * Called by subclasses. No initialisation is done
  * as we don't know the intent of the subclass.
@@ -143,7 +149,7 @@ ssize_t UDPSocket::write( const UDPPacket *packet ) throw (SocketException)
 
     ssize_t retval = sendto( this->sockfd, 
 		    packet->getData(), 
-		    packet->getSize(), 
+		    packet->getLength(), 
 		    0x0, 
 		    (struct sockaddr *)&raddress, 
 		    sizeof(raddress));
@@ -185,8 +191,181 @@ ssize_t UDPSocket::read( UDPPacket *packet, const bool peek) throw (SocketExcept
     }
 
     packet->setRecipient( clientAddress );
+    packet->setLength( result );
     return result;
 }
 
+/**
+ * Read as many packets as are available, up to count, using as few system
+ * calls as possible. Each packet's length and recipient are set to those
+ * of the datagram received into it.
+ *
+ * @param packets The packets to read into
+ * @param count The number of packets
+ * @param wait Wait for at least one packet to arrive, the socket must be
+ *             in blocking mode for this to have any effect
+ * @return The number of packets read, 0 if none were waiting and the
+ *         socket does not block
+ * @throw SocketException if the read fails before any packet is read
+ */
+unsigned UDPSocket::read( UDPPacket **packets, const unsigned count, const bool wait ) throw (SocketException)
+{
+#ifdef __linux__
+    struct mmsghdr messages[UDP_BATCH_SIZE];
+    struct iovec vectors[UDP_BATCH_SIZE];
+    struct sockaddr_in addresses[UDP_BATCH_SIZE];
+    unsigned total = 0;
+    int flags = wait ? MSG_WAITFORONE : MSG_DONTWAIT;
+
+    assert( packets != NULL );
+
+    while( total < count ){
+	unsigned amount = count - total < UDP_BATCH_SIZE ? count - total : UDP_BATCH_SIZE;
+
+	memset(messages, 0, sizeof(struct mmsghdr) * amount);
+	for(unsigned i = 0; i < amount; i++ ){
+	    UDPPacket *packet = packets[total + i];
+	    assert( packet != NULL && packet->getData() != NULL );
+
+	    vectors[i].iov_base = packet->getData();
+	    vectors[i].iov_len = packet->getSize();
+	    messages[i].msg_hdr.msg_iov = &vectors[i];
+	    messages[i].msg_hdr.msg_iovlen = 1;
+	    messages[i].msg_hdr.msg_name = &addresses[i];
+	    messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+
+	int result = recvmmsg(this->sockfd, messages, amount, flags, NULL);
+	if( result == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno == EAGAIN || errno == EWOULDBLOCK || total > 0 )
+		break;
+	    throw SocketException(this);
+	}
+
+	for(int i = 0; i < result; i++ ){
+	    packets[total + i]->setRecipient(addresses[i]);
+	    packets[total + i]->setLength(messages[i].msg_len);
+	}
+	total += result;
+
+	// Only the first call waits, after that take what is there
+	if( (unsigned)result < amount )
+	    break;
+	flags = MSG_DONTWAIT;
+    }
+
+#else
+    // One system call per packet where recvmmsg is missing
+    unsigned total = 0;
+    int flags = wait ? 0 : MSG_DONTWAIT;
+
+    assert( packets != NULL );
+
+    while( total < count ){
+	UDPPacket *packet = packets[total];
+	assert( packet != NULL && packet->getData() != NULL );
+
+	struct sockaddr_in address;
+	socklen_t length = sizeof(address);
+	ssize_t result = recvfrom(this->sockfd, packet->getData(), packet->getSize(), flags,
+				  (struct sockaddr *)&address, &length);
+	if( result == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno == EAGAIN || errno == EWOULDBLOCK || total > 0 )
+		break;
+	    throw SocketException(this);
+	}
+
+	packet->setRecipient(address);
+	packet->setLength(result);
+	total++;
+	flags = MSG_DONTWAIT;
+    }
+#endif
+
+    return total;
+}
+
+/**
+ * Write the given packets using as few system calls as possible. Packets
+ * without a recipient are sent to the address the socket was created with.
+ *
+ * @param packets The packets to write
+ * @param count The number of packets
+ * @return The number of packets written, this is less than count if the
+ *         socket is non blocking and its buffer filled
+ * @throw SocketException if the write fails before any packet is written
+ */
+unsigned UDPSocket::write( UDPPacket * const *packets, const unsigned count ) throw (SocketException)
+{
+#ifdef __linux__
+    struct mmsghdr messages[UDP_BATCH_SIZE];
+    struct iovec vectors[UDP_BATCH_SIZE];
+    struct sockaddr_in addresses[UDP_BATCH_SIZE];
+    unsigned total = 0;
+
+    assert( packets != NULL );
+
+    while( total < count ){
+	unsigned amount = count - total < UDP_BATCH_SIZE ? count - total : UDP_BATCH_SIZE;
+
+	memset(messages, 0, sizeof(struct mmsghdr) * amount);
+	for(unsigned i = 0; i < amount; i++ ){
+	    const UDPPacket *packet = packets[total + i];
+	    assert( packet != NULL && packet->getData() != NULL );
+
+	    addresses[i] = packet->hasAddress() ? packet->getRecipient() : this->address;
+	    vectors[i].iov_base = packet->getData();
+	    vectors[i].iov_len = packet->getLength();
+	    messages[i].msg_hdr.msg_iov = &vectors[i];
+	    messages[i].msg_hdr.msg_iovlen = 1;
+	    messages[i].msg_hdr.msg_name = &addresses[i];
+	    messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+	}
+
+	int result = sendmmsg(this->sockfd, messages, amount, 0);
+	if( result == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno == EAGAIN || errno == EWOULDBLOCK || total > 0 )
+		break;
+	    throw SocketException(this);
+	}
+
+	total += result;
+	if( (unsigned)result < amount )
+	    break;
+    }
+
+#else
+    // One system call per packet where sendmmsg is missing
+    unsigned total = 0;
+
+    assert( packets != NULL );
+
+    while( total < count ){
+	const UDPPacket *packet = packets[total];
+	assert( packet != NULL && packet->getData() != NULL );
+
+	struct sockaddr_in address = packet->hasAddress() ? packet->getRecipient() : this->address;
+	ssize_t result = sendto(this->sockfd, packet->getData(), packet->getLength(), 0,
+				(struct sockaddr *)&address, sizeof(address));
+	if( result == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno == EAGAIN || errno == EWOULDBLOCK || total > 0 )
+		break;
+	    throw SocketException(this);
+	}
+	total++;
+    }
+#endif
+
+    return total;
+}
+
 
 }; // namespace wcl
@@ -49,6 +49,10 @@ class WCL_API UDPSocket: public Socket
 	ssize_t write( const UDPPacket * ) throw (SocketException);
 	ssize_t read( UDPPacket *, const bool peek = false) throw (SocketException);
 
+	// Batched UDP Packet interface
+	unsigned read( UDPPacket **packets, const unsigned count, const bool wait = true ) throw (SocketException);
+	unsigned write( UDPPacket * const *packets, const unsigned count ) throw (SocketException);
+
     protected:
 	UDPSocket();
 	virtual bool create();
@@ -0,0 +1,149 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Private to the library, little endian encoding of the fields of network
+ * messages. Only include this from source files.
+ */
+#ifndef WCL_NETWORK_WIREFORMAT_H
+#define WCL_NETWORK_WIREFORMAT_H
+
+#include <string.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace wcl
+{
+
+/**
+ * Appends little endian fields to a buffer
+ */
+class WireWriter
+{
+public:
+	WireWriter(std::vector<unsigned char> &ibuffer): buffer(ibuffer) {}
+
+	void put8(const uint8_t v) { this->buffer.push_back(v); }
+	void put16(const uint16_t v) { this->put(v, 2); }
+	void put32(const uint32_t v) { this->put(v, 4); }
+	void put64(const uint64_t v) { this->put(v, 8); }
+	void putFloat(const float v)
+	{
+	    uint32_t bits;
+	    memcpy(&bits, &v, sizeof(bits));
+	    this->put32(bits);
+	}
+	void putString(const std::string &s)
+	{
+	    this->put16(s.size());
+	    this->buffer.insert(this->buffer.end(), s.begin(), s.end());
+	}
+	void putBytes(const void *data, const size_t length)
+	{
+	    const unsigned char *bytes = (const unsigned char *)data;
+	    this->buffer.insert(this->buffer.end(), bytes, bytes + length);
+	}
+
+private:
+	std::vector<unsigned char> &buffer;
+
+	void put(const uint64_t v, const unsigned size)
+	{
+	    for(unsigned i = 0; i < size; i++ )
+		this->buffer.push_back((unsigned char)(v >> (8 * i)));
+	}
+};
+
+/**
+ * Reads little endian fields from a buffer. Reading past the end
+ * returns zeros and marks the reader as failed.
+ */
+class WireReader
+{
+public:
+	WireReader(const unsigned char *idata, const size_t isize):
+	    data(idata), size(isize), position(0), failed(false) {}
+
+	uint8_t get8() { return (uint8_t)this->get(1); }
+	uint16_t get16() { return (uint16_t)this->get(2); }
+	uint32_t get32() { return (uint32_t)this->get(4); }
+	uint64_t get64() { return this->get(8); }
+	float getFloat()
+	{
+	    uint32_t bits = this->get32();
+	    float v;
+	    memcpy(&v, &bits, sizeof(v));
+	    return v;
+	}
+	std::string getString()
+	{
+	    size_t length = this->get16();
+	    if( this->failed || this->position + length > this->size ){
+		this->failed = true;
+		return std::string();
+	    }
+	    std::string s((const char *)this->data + this->position, length);
+	    this->position += length;
+	    return s;
+	}
+	void getBytes(std::string &s, const size_t length)
+	{
+	    if( this->failed || this->position + length > this->size ){
+		this->failed = true;
+		s.clear();
+		return;
+	    }
+	    s.assign((const char *)this->data + this->position, length);
+	    this->position += length;
+	}
+
+	bool ok() const { return !this->failed; }
+	size_t getPosition() const { return this->position; }
+
+private:
+	const unsigned char *data;
+	size_t size;
+	size_t position;
+	bool failed;
+
+	uint64_t get(const unsigned length)
+	{
+	    if( this->failed || this->position + length > this->size ){
+		this->failed = true;
+		return 0;
+	    }
+	    uint64_t v = 0;
+	    for(unsigned i = length; i > 0; i-- )
+		v = (v << 8) | this->data[this->position + i - 1];
+	    this->position += length;
+	    return v;
+	}
+};
+
+};
+
+#endif
@@ -28,61 +28,88 @@
 
 #include "MatrixSwitch.h"
 
+#include <stdio.h>
+
 
 namespace wcl
 {
+	const unsigned int MatrixSwitch::MAX_ID;
+	const unsigned int MatrixSwitch::COMMAND_LENGTH;
 
-	MatrixSwitch::MatrixSwitch(const std::string& ipAddress, unsigned int switchID)
-		: mIP(ipAddress), mSwitchID(switchID)
+	MatrixSwitch::MatrixSwitch(const std::string& ipAddress, unsigned int switchID,
+				   ConnectionPool *pool, unsigned int port)
+		: mIP(ipAddress), mSwitchID(switchID), mPort(port), mPool(pool), mOwnPool(pool == NULL)
 	{
-		// nothing to do here...
+		if (mOwnPool)
+			mPool = new ConnectionPool();
 	}
 
 	MatrixSwitch::~MatrixSwitch()
 	{
-		// nothing to do here either...
+		if (mOwnPool)
+			delete mPool;
 	}
 
 
 	bool MatrixSwitch::route(unsigned int inputID, unsigned int outputID)
 	{
-		// note: I don't know how many simultaneous connections
-		// the matrix switch supports. So, rather than connect
-		// on creation and disconnect on destruction, we'll just
-		// create a socket each method call.
-
-		if (inputID < 1 && inputID >36 && outputID < 1 && outputID > 36)
+		if (inputID < 1 || inputID > MAX_ID || outputID < 1 || outputID > MAX_ID)
 			return false;
 
-		// connects on port 23 always
-		wcl::TCPSocket s(mIP, 23);
-
-		char message[14];
-		message[13] = 0;
-
-		sprintf(message, "*%3d0004%2d%2d!", mSwitchID, outputID, inputID);
-		s.writeUntil(message, 13);
-		s.close();
+		char message[COMMAND_LENGTH + 1];
+		format(message, outputID, inputID);
+		mPool->write(mIP, mPort, message, COMMAND_LENGTH);
 		return true;
 	}
 
 
 	bool MatrixSwitch::disconnect(unsigned int outputID)
 	{
-		if (outputID < 1 && outputID > 36)
+		if (outputID < 1 || outputID > MAX_ID)
 			return false;
 
-		// connects on port 23 always
-		wcl::TCPSocket s(mIP, 23);
+		char message[COMMAND_LENGTH + 1];
+		format(message, outputID, 0);
+		mPool->write(mIP, mPort, message, COMMAND_LENGTH);
+		return true;
+	}
 
-		char message[14];
-		message[13] = 0;
 
-		sprintf(message, "*%3d0004%2d%2d!", mSwitchID, outputID, 0);
-		s.writeUntil(message, 13);
-		s.close();
+	bool MatrixSwitch::applyRoutingTable(const RoutingTable &table)
+	{
+		// Check everything first so a bad table changes nothing
+		for (RoutingTable::const_iterator it = table.begin(); it != table.end(); ++it)
+		{
+			if (it->first < 1 || it->first > MAX_ID || it->second > MAX_ID)
+				return false;
+		}
+
+		if (table.empty())
+			return true;
+
+		std::string commands;
+		commands.reserve(table.size() * COMMAND_LENGTH);
+		for (RoutingTable::const_iterator it = table.begin(); it != table.end(); ++it)
+		{
+			char message[COMMAND_LENGTH + 1];
+			format(message, it->first, it->second);
+			commands.append(message, COMMAND_LENGTH);
+		}
+
+		mPool->write(mIP, mPort, commands.data(), commands.size());
 		return true;
 	}
 
-};
 
+	void MatrixSwitch::setTimeout(unsigned int milliseconds)
+	{
+		mPool->setTimeout(milliseconds);
+	}
+
+
+	void MatrixSwitch::format(char *message, unsigned int outputID, unsigned int inputID) const
+	{
+		snprintf(message, COMMAND_LENGTH + 1, "*%3d0004%2d%2d!", mSwitchID, outputID, inputID);
+	}
+
+};
@@ -29,9 +29,11 @@
 #ifndef LIBWCL_MATRIX_SWITCH_H
 #define LIBWCL_MATRIX_SWITCH_H
 
+#include <map>
+#include <string>
 
 #include <wcl/api.h>
-#include <wcl/network/TCPSocket.h>
+#include <wcl/network/ConnectionPool.h>
 
 
 namespace wcl
@@ -40,13 +42,34 @@ namespace wcl
 	 * A simple abstraction around the Emcore VX Modular Matrix Router.
 	 *
 	 * This allows programs to route signals in the matrix switch.
+	 * Commands are sent over a persistent connection from a
+	 * ConnectionPool, which is reopened if the switch drops it.
 	 *
 	 * @author Michael Marner <michael@20papercups.net>
 	 */
 	class WCL_API MatrixSwitch
 	{
 		public:
-			MatrixSwitch(const std::string& ipAddress, unsigned int switchID);
+			/**
+			 * Maps outputs to the input they should show, an input
+			 * of 0 disconnects the output.
+			 */
+			typedef std::map<unsigned int, unsigned int> RoutingTable;
+
+			/**
+			 * The highest input or output on the switch.
+			 */
+			static const unsigned int MAX_ID = 36;
+
+			/**
+			 * @param ipAddress The address of the switch.
+			 * @param switchID The id of the switch.
+			 * @param pool The pool to share connections with other
+			 *        devices, if NULL the switch has its own.
+			 * @param port The port the switch listens on.
+			 */
+			MatrixSwitch(const std::string& ipAddress, unsigned int switchID,
+				     ConnectionPool *pool = NULL, unsigned int port = 23);
 			~MatrixSwitch();
 
 			/**
@@ -55,11 +78,12 @@ namespace wcl
 			 * Connects the input specified to the output specified,
 			 * does not mess with any other connections.
 			 *
-			 * @param inputID The input on the switch, inputID > 0, <=32
-			 * @param outputID The output on the switch, inputID > 0, <=32
+			 * @param inputID The input on the switch, inputID > 0, <=36
+			 * @param outputID The output on the switch, outputID > 0, <=36
 			 *
 			 * @return Returns true if the connection was made, false
 			 *         if the parameters were invalid.
+			 * @throws SocketException if the switch couldn't be reached.
 			 */
 			bool route(unsigned int inputID, unsigned int outputID);
 
@@ -69,14 +93,54 @@ namespace wcl
 			 *
 			 * @param outputID The output on the swtich to disconnect.
 			 * @return True if successful, false if outputID was invalid.
+			 * @throws SocketException if the switch couldn't be reached.
 			 */
 			bool disconnect(unsigned int outputID);
 
+			/**
+			 * Applies a whole routing table at once. Every command is
+			 * sent in a single write, so the outputs change together
+			 * rather than one by one. Outputs not in the table are left
+			 * alone.
+			 *
+			 * @param table The input each output should show.
+			 * @return False if any entry was invalid, in which case
+			 *         nothing is sent.
+			 * @throws SocketException if the switch couldn't be reached.
+			 */
+			bool applyRoutingTable(const RoutingTable &table);
+
+			/**
+			 * Limit the time allowed for connecting to the switch and
+			 * sending commands. Commands that run out of time throw a
+			 * SocketException rather than blocking the caller. This
+			 * applies to everything sharing the pool.
+			 *
+			 * @param milliseconds The time allowed, 0 waits forever.
+			 */
+			void setTimeout(unsigned int milliseconds);
+
 		private:
+			/**
+			 * The length of a command, without the terminator.
+			 */
+			static const unsigned int COMMAND_LENGTH = 13;
+
+			/**
+			 * Format the command routing an input to an output,
+			 * message must hold COMMAND_LENGTH + 1 characters.
+			 */
+			void format(char *message, unsigned int outputID, unsigned int inputID) const;
+
 			std::string mIP;
 			unsigned int mSwitchID;
+			unsigned int mPort;
+			ConnectionPool *mPool;
+			bool mOwnPool;
+
+			MatrixSwitch(const MatrixSwitch &);
+			MatrixSwitch &operator =(const MatrixSwitch &);
 	};
 };
 
 #endif
-
@@ -0,0 +1,201 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include "ProjectorGroup.h"
+#include "RemoteProjector.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/socket.h>
+
+namespace wcl {
+
+	/**
+	 * Responses have a five byte header, the last byte of which is the
+	 * length of the data that follows, then a checksum.
+	 */
+	static const size_t HEADER_SIZE = 5;
+
+	static long getMilliseconds()
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+	}
+
+	ProjectorGroup::ProjectorGroup(ConnectionPool *ipool, const unsigned itimeout)
+		: pool(ipool), ownPool(ipool == NULL), timeout(itimeout)
+	{
+		if (ownPool)
+			pool = new ConnectionPool(itimeout);
+	}
+
+	ProjectorGroup::~ProjectorGroup()
+	{
+		if (ownPool)
+			delete pool;
+	}
+
+	size_t ProjectorGroup::addProjector(const std::string &host, const unsigned port)
+	{
+		Projector p;
+		p.host = host;
+		p.port = port;
+		p.fd = -1;
+		p.acknowledged = false;
+		projectors.push_back(p);
+		return projectors.size() - 1;
+	}
+
+	size_t ProjectorGroup::getProjectorCount() const
+	{
+		return projectors.size();
+	}
+
+	unsigned ProjectorGroup::turnOn()
+	{
+		return send(RemoteProjector::POWER_ON, sizeof(RemoteProjector::POWER_ON));
+	}
+
+	unsigned ProjectorGroup::turnOff()
+	{
+		return send(RemoteProjector::POWER_OFF, sizeof(RemoteProjector::POWER_OFF));
+	}
+
+	unsigned ProjectorGroup::send(const unsigned char *command, const size_t size)
+	{
+		// Send to everyone first so the projectors work in parallel
+		for (size_t i = 0; i < projectors.size(); i++)
+		{
+			Projector &p = projectors[i];
+			p.response.clear();
+			p.acknowledged = false;
+			p.fd = -1;
+			try
+			{
+				pool->write(p.host, p.port, command, size);
+				p.fd = *pool->get(p.host, p.port);
+			}
+			catch (SocketException &)
+			{
+				pool->close(p.host, p.port);
+			}
+		}
+
+		unsigned acknowledged = 0;
+		long deadline = getMilliseconds() + timeout;
+		std::vector<struct pollfd> fds;
+		std::vector<size_t> waiting;
+
+		for (;;)
+		{
+			fds.clear();
+			waiting.clear();
+			for (size_t i = 0; i < projectors.size(); i++)
+			{
+				if (projectors[i].fd == -1)
+					continue;
+				struct pollfd pfd;
+				pfd.fd = projectors[i].fd;
+				pfd.events = POLLIN;
+				pfd.revents = 0;
+				fds.push_back(pfd);
+				waiting.push_back(i);
+			}
+
+			long remaining = deadline - getMilliseconds();
+			if (fds.empty() || remaining <= 0)
+				break;
+
+			int ready = ::poll(&fds[0], fds.size(), remaining);
+			if (ready == -1 && errno != EINTR)
+				break;
+
+			for (size_t i = 0; i < fds.size() && ready > 0; i++)
+			{
+				if (fds[i].revents == 0)
+					continue;
+
+				Projector &p = projectors[waiting[i]];
+				if (!receive(p))
+				{
+					p.fd = -1;
+					pool->close(p.host, p.port);
+					continue;
+				}
+
+				if (p.response.size() >= HEADER_SIZE &&
+				    p.response.size() >= HEADER_SIZE + p.response[4] + 1u)
+				{
+					// Errors come back with the high bit set
+					p.acknowledged = p.response[0] == (command[0] | 0x20);
+					if (p.acknowledged)
+						acknowledged++;
+					p.fd = -1;
+				}
+			}
+		}
+
+		// A late response would be mistaken for the answer to the next
+		// command, so start again with those that didn't answer
+		for (size_t i = 0; i < projectors.size(); i++)
+		{
+			if (projectors[i].fd != -1)
+			{
+				projectors[i].fd = -1;
+				pool->close(projectors[i].host, projectors[i].port);
+			}
+		}
+
+		return acknowledged;
+	}
+
+	bool ProjectorGroup::receive(Projector &p)
+	{
+		unsigned char buffer[256];
+		ssize_t amount = ::recv(p.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+		if (amount == 0)
+			return false;
+		if (amount == -1)
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+		p.response.insert(p.response.end(), buffer, buffer + amount);
+		return true;
+	}
+
+	bool ProjectorGroup::isAcknowledged(const size_t index) const
+	{
+		return index < projectors.size() && projectors[index].acknowledged;
+	}
+
+	void ProjectorGroup::setTimeout(const unsigned milliseconds)
+	{
+		timeout = milliseconds;
+		if (ownPool)
+			pool->setTimeout(milliseconds);
+	}
+
+};  // namespace wcl
@@ -0,0 +1,118 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_PROJECTORGROUP_H
+#define WCL_PROJECTORGROUP_H
+
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/ConnectionPool.h>
+
+namespace wcl {
+
+	/**
+	 * A ProjectorGroup sends commands to many projectors at once over
+	 * persistent connections. A command is written to every projector
+	 * before any response is read, so the whole group answers in about
+	 * the time of one round trip rather than one per projector. A
+	 * projector that drops its connection is reconnected the next time
+	 * it is sent a command.
+	 */
+	class WCL_API ProjectorGroup
+	{
+		public:
+			/**
+			 * @param pool The pool to share connections with other
+			 *        devices, if NULL the group has its own.
+			 * @param timeout The time in milliseconds allowed for
+			 *        every projector to respond.
+			 */
+			ProjectorGroup(ConnectionPool *pool = NULL, const unsigned timeout = 1000);
+			~ProjectorGroup();
+
+			/**
+			 * Add a projector to the group. No connection is made
+			 * until it is first sent a command.
+			 *
+			 * @return The index of the projector
+			 */
+			size_t addProjector(const std::string &host, const unsigned port = 7142);
+			size_t getProjectorCount() const;
+
+			/**
+			 * Turn every projector on or off.
+			 *
+			 * @return The number of projectors that acknowledged
+			 */
+			unsigned turnOn();
+			unsigned turnOff();
+
+			/**
+			 * Send a command to every projector and wait for their
+			 * responses.
+			 *
+			 * @return The number of projectors that acknowledged
+			 */
+			unsigned send(const unsigned char *command, const size_t size);
+
+			/**
+			 * Did the projector acknowledge the last command sent
+			 */
+			bool isAcknowledged(const size_t index) const;
+
+			void setTimeout(const unsigned milliseconds);
+
+		private:
+			struct Projector
+			{
+				std::string host;
+				unsigned port;
+				int fd; // -1 once answered or failed
+				std::vector<unsigned char> response;
+				bool acknowledged;
+			};
+
+			/**
+			 * Add data received from a projector to its response
+			 *
+			 * @return false if the connection failed
+			 */
+			bool receive(Projector &p);
+
+			ConnectionPool *pool;
+			bool ownPool;
+			unsigned timeout;
+			std::vector<Projector> projectors;
+
+			ProjectorGroup(const ProjectorGroup &);
+			ProjectorGroup &operator =(const ProjectorGroup &);
+	};
+
+};  // namespace wcl
+
+#endif
@@ -31,6 +31,11 @@
 
 namespace wcl {
 
+	// 02H 00H 00H 00H 00H 02H
+	const unsigned char RemoteProjector::POWER_ON[6] = { 2, 0, 0, 0, 0, 2 };
+
+	// 02H 01H 00H 00H 00H 03H
+	const unsigned char RemoteProjector::POWER_OFF[6] = { 2, 1, 0, 0, 0, 3 };
 
 	/**
 	 * Create a RemoteProjector and attempt to connect the socket to the specified
@@ -41,12 +46,32 @@ namespace wcl {
 	 *
 	 * @param port The remote port to connect to
 	 *
+	 * @param timeout The time in milliseconds to allow for connecting and
+	 * for each command and response, 0 waits forever
+	 *
 	 * @throws SocketError If there was a problem resolving the hostname or
-	 * connecting to the host
+	 * connecting to the host, or the projector took too long
 	 */
-	RemoteProjector::RemoteProjector( const std::string &server, const unsigned port) throw (SocketException)
+	RemoteProjector::RemoteProjector( const std::string &server, const unsigned port,
+					  const unsigned timeout) throw (SocketException)
 	{
-		mConnection = new TCPSocket(server, port, true);
+		if (timeout == 0)
+		{
+			mConnection = new TCPSocket(server, port, true);
+			return;
+		}
+
+		mConnection = new TCPSocket(server, port, false);
+		try
+		{
+			mConnection->setTimeout(timeout);
+			mConnection->connect(timeout);
+		}
+		catch (SocketException &)
+		{
+			delete mConnection;
+			throw;
+		}
 	}
 
 
@@ -68,9 +93,7 @@ namespace wcl {
 	 * Turns on the projector.
 	 */
 	void RemoteProjector::turnOn() {
-		// 02H 00H 00H 00H 00H 00H 02H
-		unsigned char toSend[] = { (unsigned char)2, 0, 0, 0, 0, (unsigned char)2 };
-		mConnection->write((char*) toSend, 6);
+		mConnection->write(POWER_ON, sizeof(POWER_ON));
 	}
 
 
@@ -78,9 +101,7 @@ namespace wcl {
 	 * Turns the projector off.
 	 */
 	void RemoteProjector::turnOff() {
-		// 02H 01H 00H 00H 00H 03H
-		unsigned char toSend[] = { (unsigned char)2, (unsigned char)1, 0, 0, 0, (unsigned char)3 };
-		mConnection->write((char*) toSend, 6);
+		mConnection->write(POWER_OFF, sizeof(POWER_OFF));
 	}
 
 
@@ -43,13 +43,21 @@ namespace wcl {
 	{
 		public:
 			RemoteProjector(const std::string& ip,
-					const unsigned port = 7142) throw (SocketException);
+					const unsigned port = 7142,
+					const unsigned timeout = 0) throw (SocketException);
 
 			~RemoteProjector();
 
 			void turnOn();
 			void turnOff();
 			void getResponse();
+
+			/**
+			 * The commands sent to the projector. Each is a five byte
+			 * header, no data and a checksum.
+			 */
+			static const unsigned char POWER_ON[6];
+			static const unsigned char POWER_OFF[6];
 		protected:
 			TCPSocket *mConnection;
 
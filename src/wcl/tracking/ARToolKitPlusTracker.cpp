@@ -34,25 +34,49 @@ using namespace ARToolKitPlus;
 
 namespace wcl {
 
+struct ARToolKitPlusTracker::Frame
+{
+    struct Pose
+    {
+	ARFloat conv[3][4];
+    };
+
+    /**
+     * Owned by the tracker, valid until the next detection
+     */
+    ARMarkerInfo *markers;
+    std::vector<Pose> poses;
+
+    /**
+     * Trackers only used to estimate poses, as estimating with one
+     * tracker isn't safe from several threads. The first estimator
+     * is the tracker itself and isn't in the list.
+     */
+    std::vector<TrackerSingleMarker *> estimators;
+    unsigned estimatorCount;
+
+    /**
+     * The camera's parameters, for setting up the estimators
+     */
+    Camera::CameraParameters parameters;
+};
+
 
 ARToolKitPlusTracker::ARToolKitPlusTracker( const unsigned imarkerWidth, const int thresholdValue,
 					    const unsigned iscreenWidth, const unsigned iscreenHeight,
 					    const float inearplane, const float ifarplane):
-    markerWidth(imarkerWidth), cameraBuffer(NULL),
+    frame(new Frame), markerWidth(imarkerWidth), screenWidth(iscreenWidth), screenHeight(iscreenHeight),
+    camera(NULL), cameraBuffer(NULL),
     nearplane(inearplane), farplane(ifarplane),inited(false),scale(CM),cameraFormat(Camera::RGB8)
 {
 
     assert( imarkerWidth != 0 && "Using ARToolKitPlus with a marker width of zero doesn't make sense");
 
-    // create a tracker that does:
-    //  - 6x6 sized marker images (in bch pixel) - we hard code this as 4096 images is huge
-    //  - samples at a maximum of 6x6 -??? Seems to relate to image division maximum
-    //  - can load a maximum of 0 pattern - not required as we use BCH patterns
-    //  - can detect a maximum of imaxMarkserPerImage patterns in one image
-    this->tracker=
-	new ARToolKitPlus::TrackerSingleMarkerImpl<6,6,6, 0, WCL_ARTOOLKITPLUSTRACKER_MARKER_DETECTION_COUNT>(iscreenWidth, iscreenHeight);
+    this->frame->markers = NULL;
+    this->frame->estimatorCount = 1;
+    this->markersFound = 0;
 
-    this->tracker->setPatternWidth(imarkerWidth);
+    this->tracker = this->createTracker();
 
     // Use LUT lookups to speed up calculations, these only works with images up to 1024x1024
     if( iscreenWidth < 1024 && iscreenHeight < 1024 )
@@ -61,15 +85,9 @@ ARToolKitPlusTracker::ARToolKitPlusTracker( const unsigned imarkerWidth, const i
     // Use binary encoded markers
     this->tracker->setMarkerMode(ARToolKitPlus::MARKER_ID_BCH);
 
-    // We use BCH images which have a thinner border
-    this->tracker->setBorderWidth (0.125f);
-
     // Set the threshold to either a user value or auto by default
     this->setThreshold( thresholdValue );
 
-    // Use the updated pose estimator (Robust Pose Estimation From a Planar Target)
-    this->tracker->setPoseEstimator(POSE_ESTIMATOR_RPP);
-
     // Create 4096 base markers as we use BCH, and also populate the map
     for(unsigned i=0; i < 4096; i++ ){
 	ARToolKitPlusTrackedObject *o = new ARToolKitPlusTrackedObject(imarkerWidth, i);
@@ -86,6 +104,9 @@ ARToolKitPlusTracker::~ARToolKitPlusTracker()
     // need to call: delete this->c_ptr as it's already done and
     // would cause a SIGSEGV if we try it
     delete this->tracker;
+    for(unsigned i = 0; i < this->frame->estimators.size(); i++ )
+	delete this->frame->estimators[i];
+    delete this->frame;
 
 	if (cameraBuffer != NULL)
 		delete [] cameraBuffer;
@@ -98,6 +119,30 @@ ARToolKitPlusTracker::~ARToolKitPlusTracker()
     }
 }
 
+/**
+ * Create an ARToolKitPlus tracker set up to estimate poses like ours
+ */
+TrackerSingleMarker *ARToolKitPlusTracker::createTracker() const
+{
+    // create a tracker that does:
+    //  - 6x6 sized marker images (in bch pixel) - we hard code this as 4096 images is huge
+    //  - samples at a maximum of 6x6 -??? Seems to relate to image division maximum
+    //  - can load a maximum of 0 pattern - not required as we use BCH patterns
+    //  - can detect a maximum of imaxMarkserPerImage patterns in one image
+    TrackerSingleMarker *t =
+	new ARToolKitPlus::TrackerSingleMarkerImpl<6,6,6, 0, WCL_ARTOOLKITPLUSTRACKER_MARKER_DETECTION_COUNT>(this->screenWidth, this->screenHeight);
+
+    t->setPatternWidth(this->markerWidth);
+
+    // We use BCH images which have a thinner border
+    t->setBorderWidth (0.125f);
+
+    // Use the updated pose estimator (Robust Pose Estimation From a Planar Target)
+    t->setPoseEstimator(POSE_ESTIMATOR_RPP);
+
+    return t;
+}
+
 void ARToolKitPlusTracker::setCamera(const Camera *camera)
 {
     assert( camera != NULL && "You Can't specifiy NULL for the camera");
@@ -105,35 +150,63 @@ void ARToolKitPlusTracker::setCamera(const Camera *camera)
 
     this->camera = camera;
 
-    ARToolKitPlus::PIXEL_FORMAT format;
-
-    // Set the format based on what the camera is using
+    // Set the format based on what the camera is using. Marker detection
+    // only needs luminance, so YUYV gives up its luma plane rather than
+    // being converted to colour
     switch (this->camera->getActiveConfiguration().format){
 	case Camera::RGB8:
-            format=ARToolKitPlus::PIXEL_FORMAT_RGB;
 	    this->cameraFormat = Camera::RGB8;
             break;
 	case Camera::BGR8:
-            format=ARToolKitPlus::PIXEL_FORMAT_BGR;
 	    this->cameraFormat = Camera::BGR8;
+            break;
 	case Camera::MONO8:
-	    format=ARToolKitPlus::PIXEL_FORMAT_LUM;
+	case Camera::YUYV422:
 	    this->cameraFormat = Camera::MONO8;
             break;
         default:
 	case Camera::MJPEG:
-	case Camera::YUYV422:
             printf("ARToolKitPlusTracker:SetCamera: Unsupported Camera Image Format converting to RGB8 via software\n");
 	    this->cameraFormat = Camera::RGB8;
-            format=ARToolKitPlus::PIXEL_FORMAT_RGB;
 	    break;
     }
 
 	if (cameraBuffer != NULL)
 	{
-		delete cameraBuffer;
+		delete [] cameraBuffer;
+		cameraBuffer = NULL;
 	}
-	cameraBuffer = new unsigned char[camera->getFormatBufferSize(cameraFormat)];
+	if (this->camera->getActiveConfiguration().format != this->cameraFormat)
+		cameraBuffer = new unsigned char[camera->getFormatBufferSize(cameraFormat)];
+
+    this->frame->parameters = this->getParameters();
+    this->setupCamera(this->tracker);
+
+    // The estimators are recreated for the new camera by the next detection
+    for(unsigned i = 0; i < this->frame->estimators.size(); i++ )
+	delete this->frame->estimators[i];
+    this->frame->estimators.clear();
+
+    this->inited = true;
+}
+
+/**
+ * Give an ARToolKitPlus tracker the camera's parameters and our format
+ */
+void ARToolKitPlusTracker::setupCamera(TrackerSingleMarker *t)
+{
+    ARToolKitPlus::PIXEL_FORMAT format;
+    switch (this->cameraFormat){
+	case Camera::BGR8:
+	    format=ARToolKitPlus::PIXEL_FORMAT_BGR;
+	    break;
+	case Camera::MONO8:
+	    format=ARToolKitPlus::PIXEL_FORMAT_LUM;
+	    break;
+	default:
+	    format=ARToolKitPlus::PIXEL_FORMAT_RGB;
+	    break;
+    }
 
     // Create a new ARToolkit Camera to
     // init the tracker, note ARToolKitPlus will remove
@@ -141,7 +214,7 @@ void ARToolKitPlusTracker::setCamera(const Camera *camera)
     ARToolKitPlus::Camera *c_ptr = new ARToolKitPlus::CameraAdvImpl;
     c_ptr->xsize=this->camera->getActiveConfiguration().width;
     c_ptr->ysize=this->camera->getActiveConfiguration().height;
-    Camera::CameraParameters d = this->getParameters();
+    const Camera::CameraParameters &d = this->frame->parameters;
     c_ptr->mat[0][0]=d.intrinsicMatrix[0][0];
     c_ptr->mat[0][1]=d.intrinsicMatrix[0][1];
     c_ptr->mat[0][2]=d.intrinsicMatrix[0][2];
@@ -160,47 +233,102 @@ void ARToolKitPlusTracker::setCamera(const Camera *camera)
     c_ptr->dist_factor[3]=d.distortion[3];
     c_ptr->dist_factor[4]=0;
 
-    this->tracker->setPixelFormat(format);
-    this->tracker->init(NULL, this->nearplane, this->farplane);
-    this->tracker->setCamera(c_ptr, this->nearplane, this->farplane);
-    this->inited = true;
+    t->setPixelFormat(format);
+    t->init(NULL, this->nearplane, this->farplane);
+    t->setCamera(c_ptr, this->nearplane, this->farplane);
 }
 
-void ARToolKitPlusTracker::update()
+Camera::ImageFormat ARToolKitPlusTracker::getFrameFormat() const
 {
-    int i=0;
-    ARMarkerInfo *markers;
-    ARFloat conv[3][4];
-    ARFloat center[2]={0.0,0.0};// Hard coded as per ARToolKitPlus::TrackerSingleMarkerImpl.cxx
+    return this->cameraFormat;
+}
 
+const unsigned char *ARToolKitPlusTracker::getCameraFrame()
+{
+    const unsigned char *current = this->camera->getCurrentFrame();
+    if( current == NULL || this->cameraBuffer == NULL )
+	return current;
+
+    Camera::Configuration c = this->camera->getActiveConfiguration();
+    if( c.format == Camera::YUYV422 ){
+	unsigned pixels = c.width * c.height;
+	for(unsigned i = 0; i < pixels; i++ )
+	    this->cameraBuffer[i] = current[i * 2];
+    }
+    else
+	this->camera->getCurrentFrame(this->cameraBuffer, this->cameraFormat);
+
+    return this->cameraBuffer;
+}
+
+void ARToolKitPlusTracker::update()
+{
     assert( this->inited && "ARToolKitPlusTracker:update() : The tracker has not yet been inited, please call setCamera First" );
 
-    // set all markers to not visable
-	for(std::vector<ARToolKitPlusTrackedObject *>::iterator it = this->objects.begin();
-			it != this->objects.end();
-			++it ){
-		ARToolKitPlusTrackedObject *marker=*it;
-		marker->setVisible(false);
-		// invisible markers are not very confident markers.
-		marker->setConfidence(0.0f);
-	}
+    this->update(this->getCameraFrame());
+}
 
-	this->camera->getCurrentFrame(cameraBuffer, this->cameraFormat);
-	// Check a frame is available 
-	if( cameraBuffer == NULL )
-		return;
+void ARToolKitPlusTracker::update(const unsigned char *image)
+{
+    this->detect(image);
+    for(int i = 0; i < this->markersFound; i++ )
+	this->estimate(i, 0);
+    this->apply();
+}
 
-    this->bestMarker=this->tracker->calc(cameraBuffer, -1, true, &markers, &this->markersFound);
+void ARToolKitPlusTracker::setEstimatorCount(const unsigned count)
+{
+    this->frame->estimatorCount = count > 0 ? count : 1;
+}
+
+void ARToolKitPlusTracker::detect(const unsigned char *image)
+{
+    // set all markers to not visable, only those seen before can be
+    for(std::vector<TrackedObject *>::iterator it = this->seenObjects.begin();
+	it != this->seenObjects.end();
+	++it ){
+	ARToolKitPlusTrackedObject *marker=(ARToolKitPlusTrackedObject *)*it;
+	marker->setVisible(false);
+	// invisible markers are not very confident markers.
+	marker->setConfidence(0.0f);
+    }
+
+    this->markersFound = 0;
+
+    // Check a frame is available
+    if( image == NULL )
+	return;
+
+    while( this->frame->estimators.size() + 1 < this->frame->estimatorCount ){
+	TrackerSingleMarker *t = this->createTracker();
+	this->setupCamera(t);
+	this->frame->estimators.push_back(t);
+    }
+
+    this->bestMarker=this->tracker->calc(image, -1, true, &this->frame->markers, &this->markersFound);
     this->confidence = (float)tracker->getConfidence();
+    this->frame->poses.resize(this->markersFound);
+}
+
+void ARToolKitPlusTracker::estimate(const unsigned marker, const unsigned estimator)
+{
+    ARFloat center[2]={0.0,0.0};// Hard coded as per ARToolKitPlus::TrackerSingleMarkerImpl.cxx
+
+    TrackerSingleMarker *t = estimator == 0 ? this->tracker : this->frame->estimators[estimator - 1];
+    t->executeSingleMarkerPoseEstimator(&this->frame->markers[marker],
+					center,
+					this->markerWidth,
+					this->frame->poses[marker].conv );
+}
+
+void ARToolKitPlusTracker::apply()
+{
+    ARMarkerInfo *markers = this->frame->markers;
 
     // Update the found markers
-    while( i < this->markersFound ){
+    for(int i = 0; i < this->markersFound; i++ ){
 	SMatrix m(4);
 	m.storeIdentity();
-	this->tracker->executeSingleMarkerPoseEstimator(&markers[i],
-							center,
-							this->markerWidth,
-							conv );
 
 	//
 	// ARToolkit may return marker ids not in the map in the case of
@@ -210,6 +338,7 @@ void ARToolKitPlusTracker::update()
 	if( it != this->mapping.end()){
 	    ARToolKitPlusTrackedObject *marker = it->second;
 	    if( marker != NULL ){
+		ARFloat (*conv)[4] = this->frame->poses[i].conv;
 
 		for(unsigned row=0; row < 3; row++ )
 		    for(unsigned c =0; c < 4; c++)
@@ -255,8 +384,9 @@ void ARToolKitPlusTracker::update()
 		marker->setCorners(corners);
 	    }
 	}
-	i++;
     }
+
+    this->recordPoses(Tracker::getCurrentTime());
 }
 
 TrackedObject* ARToolKitPlusTracker::getObject(const std::string name)
@@ -278,6 +408,16 @@ std::vector<TrackedObject *> ARToolKitPlusTracker::getAllObjects()
     return seenObjects;
 }
 
+unsigned ARToolKitPlusTracker::getObjectCount()
+{
+    return this->seenObjects.size();
+}
+
+TrackedObject *ARToolKitPlusTracker::getObjectAt(const unsigned index)
+{
+    return index < this->seenObjects.size() ? this->seenObjects[index] : NULL;
+}
+
 void ARToolKitPlusTracker::setUnits(Units u)
 {
     this->scale = u;
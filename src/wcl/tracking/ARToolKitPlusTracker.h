@@ -54,10 +54,18 @@ namespace ARToolKitPlus
 namespace wcl
 {
 
+class ARToolKitPlusTrackerPool;
+
 /**
  * The ARToolKitPlusTracker class integrates ARToolKitPlus
  * with libWCL. By default ARToolkitPlus is setup to use BCH markers (up to
  * 1024) and detects a maximum of WCL_ARTOOLKITPLUSTRACKER_MARKER_DETECTION_COUNT marker
+ *
+ * Frames the camera delivers as MONO8, RGB8 or BGR8 are used where they
+ * are without being copied. YUYV422 frames only have their luma
+ * extracted, anything else is converted to RGB8. To track several
+ * cameras at once, or spread the pose estimation of many markers over
+ * several cpus, add the trackers to an ARToolKitPlusTrackerPool.
  */
 class WCL_API ARToolKitPlusTracker: public Tracker
 {
@@ -72,8 +80,26 @@ public:
     virtual void setCamera(const Camera *);
 
     virtual void update();
+
+    /**
+     * Detect markers in a frame the caller already has, rather than the
+     * camera's current frame. The frame is used without being copied.
+     *
+     * @param frame An image the size of the camera's, in getFrameFormat()
+     */
+    void update(const unsigned char *frame);
+
+    /**
+     * The format frames are given to ARToolKitPlus in, MONO8 unless the
+     * camera delivers RGB8 or BGR8 (or a format that has to be converted
+     * to RGB8)
+     */
+    Camera::ImageFormat getFrameFormat() const;
+
     virtual TrackedObject* getObject(const std::string name);
     virtual std::vector<TrackedObject *> getAllObjects();
+    virtual unsigned getObjectCount();
+    virtual TrackedObject *getObjectAt(const unsigned index);
     virtual void setUnits(const Units u);
     SMatrix getProjectionMatrix();
     SMatrix getModelViewMatrix();
@@ -91,14 +117,25 @@ public:
     void toString();
 
 private:
+    friend class ARToolKitPlusTrackerPool;
+
+    /**
+     * The markers of the frame being processed, and what is needed to
+     * estimate their poses concurrently
+     */
+    struct Frame;
+
     std::vector<TrackedObject *> seenObjects;
     std::vector<ARToolKitPlusTrackedObject *>objects;
     std::map<unsigned, ARToolKitPlusTrackedObject *> mapping;
 
     ARToolKitPlus::TrackerSingleMarker *tracker;
+    Frame *frame;
     unsigned markerWidth;
+    unsigned screenWidth;
+    unsigned screenHeight;
     const Camera *camera;
-	unsigned char* cameraBuffer;
+    unsigned char* cameraBuffer;
 
     float confidence;
     float nearplane;
@@ -111,6 +148,35 @@ private:
     Camera::ImageFormat cameraFormat;
     Camera::CameraParameters getParameters();
 
+    ARToolKitPlus::TrackerSingleMarker *createTracker() const;
+    void setupCamera(ARToolKitPlus::TrackerSingleMarker *t);
+
+    /**
+     * The camera's current frame in cameraFormat, converted only if
+     * it has to be
+     */
+    const unsigned char *getCameraFrame();
+
+    /**
+     * An update happens in three steps. Markers are detected in the
+     * frame, their poses are estimated, each with one of the estimators
+     * of the frame, and the poses are applied to the tracked objects.
+     * Different markers may be estimated at the same time with
+     * different estimators.
+     */
+    void detect(const unsigned char *image);
+    void estimate(const unsigned marker, const unsigned estimator);
+    void apply();
+
+    /**
+     * Have detect prepare enough estimators for the given amount of
+     * markers to be estimated at once
+     */
+    void setEstimatorCount(const unsigned count);
+
+    ARToolKitPlusTracker(const ARToolKitPlusTracker &);
+    ARToolKitPlusTracker &operator =(const ARToolKitPlusTracker &);
+
 };
 
 };
@@ -0,0 +1,195 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <unistd.h>
+
+#include "ARToolKitPlusTracker.h"
+#include "ARToolKitPlusTrackerPool.h"
+
+namespace wcl
+{
+
+/**
+ * A pool thread, it runs the jobs of each stage with its own estimator
+ */
+class ARToolKitPlusTrackerPool::Worker: public Thread
+{
+public:
+    Worker(ARToolKitPlusTrackerPool *ipool, const unsigned iestimator):
+	pool(ipool), estimator(iestimator) {}
+
+protected:
+    void run() { this->pool->work(this->estimator); }
+
+private:
+    ARToolKitPlusTrackerPool *pool;
+    unsigned estimator;
+};
+
+ARToolKitPlusTrackerPool::ARToolKitPlusTrackerPool(const unsigned threads):
+    stage(DETECT), next(0), busy(0), generation(0), stopping(false)
+{
+    unsigned count = threads;
+    if( count == 0 ){
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	count = cpus > 1 ? cpus - 1 : 1;
+    }
+
+    // The caller uses the trackers own estimator
+    for(unsigned i = 0; i < count; i++ ){
+	Worker *w = new Worker(this, i + 1);
+	this->workers.push_back(w);
+	w->start();
+    }
+}
+
+ARToolKitPlusTrackerPool::~ARToolKitPlusTrackerPool()
+{
+    {
+	ScopedLock l(this->lock);
+	this->stopping = true;
+	this->workAvailable.broadcast();
+    }
+
+    for(unsigned i = 0; i < this->workers.size(); i++ ){
+	this->workers[i]->join();
+	delete this->workers[i];
+    }
+}
+
+void ARToolKitPlusTrackerPool::add(ARToolKitPlusTracker *tracker)
+{
+    if( !tracker->inited )
+	throw Exception("ARToolKitPlusTrackerPool::add: The tracker has no camera");
+
+    tracker->setEstimatorCount(this->workers.size() + 1);
+    this->trackers.push_back(tracker);
+}
+
+void ARToolKitPlusTrackerPool::remove(ARToolKitPlusTracker *tracker)
+{
+    std::vector<ARToolKitPlusTracker *>::iterator it =
+	std::find(this->trackers.begin(), this->trackers.end(), tracker);
+    if( it != this->trackers.end())
+	this->trackers.erase(it);
+}
+
+unsigned ARToolKitPlusTrackerPool::size() const
+{
+    return this->trackers.size();
+}
+
+unsigned ARToolKitPlusTrackerPool::getThreadCount() const
+{
+    return this->workers.size();
+}
+
+void ARToolKitPlusTrackerPool::update()
+{
+    // Detect markers in every frame
+    this->jobs.resize(this->trackers.size());
+    for(unsigned i = 0; i < this->trackers.size(); i++ ){
+	this->jobs[i].tracker = this->trackers[i];
+	this->jobs[i].marker = 0;
+    }
+    this->runStage(DETECT);
+
+    // Estimate the pose of every marker found
+    this->jobs.clear();
+    for(unsigned i = 0; i < this->trackers.size(); i++ ){
+	Job j;
+	j.tracker = this->trackers[i];
+	for(j.marker = 0; (int)j.marker < j.tracker->markersFound; j.marker++ )
+	    this->jobs.push_back(j);
+    }
+    this->runStage(ESTIMATE);
+
+    for(unsigned i = 0; i < this->trackers.size(); i++ )
+	this->trackers[i]->apply();
+}
+
+/**
+ * Run the jobs with the pool's threads and wait until they are done
+ */
+void ARToolKitPlusTrackerPool::runStage(const Stage s)
+{
+    if( this->jobs.empty())
+	return;
+
+    {
+	ScopedLock l(this->lock);
+	this->stage = s;
+	this->next = 0;
+	this->busy = this->workers.size();
+	this->generation++;
+	this->workAvailable.broadcast();
+    }
+
+    this->runJobs(0);
+
+    ScopedLock l(this->lock);
+    while( this->busy > 0 )
+	this->stageDone.wait(this->lock);
+}
+
+void ARToolKitPlusTrackerPool::runJobs(const unsigned estimator)
+{
+    for(;;){
+	unsigned i = __sync_fetch_and_add(&this->next, 1);
+	if( i >= this->jobs.size())
+	    return;
+
+	Job &j = this->jobs[i];
+	if( this->stage == DETECT )
+	    j.tracker->detect(j.tracker->getCameraFrame());
+	else
+	    j.tracker->estimate(j.marker, estimator);
+    }
+}
+
+void ARToolKitPlusTrackerPool::work(const unsigned estimator)
+{
+    unsigned seen = 0;
+    for(;;){
+	{
+	    ScopedLock l(this->lock);
+	    while( !this->stopping && this->generation == seen )
+		this->workAvailable.wait(this->lock);
+	    if( this->stopping )
+		return;
+	    seen = this->generation;
+	}
+
+	this->runJobs(estimator);
+
+	ScopedLock l(this->lock);
+	if( --this->busy == 0 )
+	    this->stageDone.signal();
+    }
+}
+
+};
@@ -0,0 +1,122 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_ARTOOLKITPLUSTRACKERPOOL_H
+#define WCL_TRACKING_ARTOOLKITPLUSTRACKERPOOL_H
+
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+    class ARToolKitPlusTracker;
+
+    /**
+     * ARToolKitPlusTrackerPool updates many ARToolKitPlusTrackers, one
+     * per camera, on a fixed number of shared threads. Each update first
+     * detects the markers in every tracker's frame at the same time, then
+     * estimates the poses of all the markers found at the same time, so a
+     * single camera seeing many markers benefits as much as many cameras.
+     *
+     * The calling thread works alongside the pool's threads, and update
+     * returns once every tracker is up to date. The trackers must not be
+     * updated in any other way while they are in the pool.
+     */
+    class WCL_API ARToolKitPlusTrackerPool
+    {
+    public:
+	/**
+	 * Create the pool and start its threads
+	 *
+	 * @param threads The amount of threads besides the caller's, 0 uses one for
+	 *        every cpu but the first
+	 */
+	ARToolKitPlusTrackerPool(const unsigned threads = 0);
+	~ARToolKitPlusTrackerPool();
+
+	/**
+	 * Have the pool update a tracker. Its camera must have been set.
+	 */
+	void add(ARToolKitPlusTracker *tracker);
+	void remove(ARToolKitPlusTracker *tracker);
+
+	/**
+	 * Obtain the amount of trackers in the pool
+	 */
+	unsigned size() const;
+
+	/**
+	 * Obtain the amount of threads, not counting the caller's
+	 */
+	unsigned getThreadCount() const;
+
+	/**
+	 * Update every tracker from its camera's current frame. The
+	 * cameras should have been updated first.
+	 */
+	void update();
+
+    private:
+	enum Stage { DETECT, ESTIMATE };
+
+	struct Job {
+	    ARToolKitPlusTracker *tracker;
+	    unsigned marker;
+	};
+
+	class Worker;
+	friend class Worker;
+
+	std::vector<ARToolKitPlusTracker *> trackers;
+	std::vector<Worker *> workers;
+
+	/**
+	 * The jobs of the current stage. Threads claim the next job by
+	 * incrementing next, busy counts the pool threads still working.
+	 */
+	Stage stage;
+	std::vector<Job> jobs;
+	volatile unsigned next;
+	unsigned busy;
+
+	unsigned generation; // Changes whenever a stage starts
+	bool stopping;
+	Mutex lock;
+	Condition workAvailable;
+	Condition stageDone;
+
+	void work(const unsigned estimator);
+	void runStage(const Stage s);
+	void runJobs(const unsigned estimator);
+
+	ARToolKitPlusTrackerPool(const ARToolKitPlusTrackerPool &);
+	ARToolKitPlusTrackerPool &operator =(const ARToolKitPlusTrackerPool &);
+    };
+};
+
+#endif
@@ -40,6 +40,11 @@ Vector DummyTrackedObject::getTranslation() const
 	return position;
 }
 
+void DummyTrackedObject::setPosition(const Vector& pos)
+{
+	position = pos;
+}
+
 SMatrix DummyTrackedObject::getTransform() const
 {
 	SMatrix t(4);
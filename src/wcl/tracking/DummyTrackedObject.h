@@ -49,7 +49,10 @@ public:
 	
 	/// \}
 	
-	/// TODO: add methods for setting position, looking at stuff, etc
+	/// Moves the object
+	void setPosition(const Vector& position);
+
+	/// TODO: add methods for looking at stuff, etc
 	
 private:
 	Vector		position;
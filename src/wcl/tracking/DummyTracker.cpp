@@ -39,11 +39,15 @@ DummyTracker::~DummyTracker()
 
 void DummyTracker::update()
 {
+	recordPoses(getCurrentTime());
 }
 
 TrackedObject* DummyTracker::getObject(std::string name)
 {
-	return trackedObjects[name];
+	TrackedObjectList::iterator it = trackedObjects.find(name);
+	if (it == trackedObjects.end())
+		return NULL;
+	return it->second;
 }
 
 std::vector<TrackedObject*> DummyTracker::getAllObjects()
@@ -55,6 +59,16 @@ std::vector<TrackedObject*> DummyTracker::getAllObjects()
 	return objects;
 }
 
+unsigned DummyTracker::getObjectCount()
+{
+	return objectList.size();
+}
+
+TrackedObject *DummyTracker::getObjectAt(const unsigned index)
+{
+	return index < objectList.size() ? objectList[index] : NULL;
+}
+
 void DummyTracker::setUnits(Units u)
 {
 }
@@ -62,9 +76,10 @@ void DummyTracker::setUnits(Units u)
 void DummyTracker::addTrackedObject(DummyTrackedObject* to)
 {
 	std::string name = to->getName();
-	if (trackedObjects[name])
+	if (trackedObjects.find(name) != trackedObjects.end())
 		throw Exception("Dummy tracker with name '" + name + "' already registered.");
 
 	trackedObjects[name] = to;
+	objectList.push_back(to);
 }
 
@@ -47,11 +47,14 @@ public:
 
 	TrackedObject* getObject(std::string name);
 	std::vector<TrackedObject *> getAllObjects();
+	unsigned getObjectCount();
+	TrackedObject *getObjectAt(const unsigned index);
 	void setUnits(Units u);
 
 private:
 	typedef std::map<std::string, DummyTrackedObject*> TrackedObjectList;
 	TrackedObjectList	trackedObjects;
+	std::vector<TrackedObject *> objectList;
 };
 	
 } /* wcl */
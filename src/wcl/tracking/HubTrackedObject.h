@@ -0,0 +1,75 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_HUBTRACKEDOBJECT_H
+#define WCL_TRACKING_HUBTRACKEDOBJECT_H
+
+#include <stdint.h>
+#include <string>
+
+#include <wcl/api.h>
+#include <wcl/maths/Quaternion.h>
+#include <wcl/maths/SMatrix.h>
+#include <wcl/maths/Vector.h>
+#include <wcl/tracking/PoseHistory.h>
+#include <wcl/tracking/TrackedObject.h>
+
+namespace wcl
+{
+	class TrackerHub;
+
+	/**
+	 * An object of one of the trackers merged by a TrackerHub. It holds
+	 * the pose of the original object as of the hub's last update, in the
+	 * hub's units and coordinate frame.
+	 */
+	class WCL_API HubTrackedObject : public TrackedObject
+	{
+		friend class TrackerHub;
+
+		public:
+			HubTrackedObject(const std::string &name, const ObjectType type);
+			virtual ~HubTrackedObject(){}
+
+			virtual std::string toString() const;
+			virtual SMatrix getTransform() const;
+			virtual Vector getTranslation() const;
+			virtual Quaternion getOrientation() const;
+			virtual bool isVisible() const;
+
+		private:
+			/**
+			 * Set the pose and add it to the history
+			 */
+			void set(const PoseHistory::Pose &pose, const bool visible,
+				 const float confidence);
+
+			PoseHistory::Pose pose;
+			bool visible;
+	};
+};
+
+#endif
@@ -25,101 +25,326 @@
  */
 
 
-#include <sstream>
-#include <iostream>
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+
+#include <wcl/Exception.h>
 #include "LazySusan.h"
 
 namespace wcl
 {
+	/**
+	 * How much of each new measurement goes into the reported rotation
+	 * rate, latency and sample rate
+	 */
+	static const double SMOOTHING = 0.2;
+
+	const unsigned LazySusan::RESPONSE_TIMEOUT;
+	const unsigned LazySusan::RESPONSE_SIZE;
+	const unsigned LazySusan::DIGITS;
+	const unsigned LazySusan::COUNTS_PER_TURN;
 
-	LazySusan::LazySusan(std::string device)
+	/**
+	 * Sends the requests and receives the readings when the turntable
+	 * is driven by a reactor
+	 */
+	class LazySusan::Driver : public DescriptorHandler, public TimerHandler
 	{
-		// I think the defaults are fine...
-		mConnection.open(device.c_str(),
-				         Serial::BAUD_115200,
-						 Serial::DB_EIGHT,
-						 Serial::NONE,
-						 Serial::ONE,
-						 Serial::RAW,
-						 Serial::DISABLED,
-						 Serial::NONBLOCKING,
-						 Serial::BOTH);
+		public:
+			Driver(LazySusan &susan) : susan(susan) {}
+
+			void readable(const int)
+			{
+				if (!susan.receive())
+					return;
+
+				susan.publish();
+				susan.mReactor->cancelTimer(susan.mTimer);
+				if (susan.mInterval == 0)
+					send();
+				else
+					susan.mTimer = susan.mReactor->addTimer(susan.mInterval, this);
+			}
+
+			void timerExpired(const unsigned long)
+			{
+				if (susan.mPending)
+					susan.expire();
+				send();
+			}
 
+			/**
+			 * Ask for a reading and wait for it, for a while
+			 */
+			void send()
+			{
+				susan.request();
+				susan.mTimer = susan.mReactor->addTimer(RESPONSE_TIMEOUT, this);
+			}
+
+		private:
+			LazySusan &susan;
+	};
+
+	LazySusan::LazySusan(std::string device) :
+		mReactor(NULL),
+		mDriver(NULL),
+		mInterval(0),
+		mTimer(0)
+	{
+		open(device);
+	}
+
+	LazySusan::LazySusan(const std::string &device, Reactor &reactor,
+			     const unsigned interval) :
+		mReactor(&reactor),
+		mDriver(NULL),
+		mInterval(interval),
+		mTimer(0)
+	{
+		open(device);
+
+		mDriver = new Driver(*this);
+		try
+		{
+			mReactor->watch(*mConnection, mDriver);
+		}
+		catch (Exception &)
+		{
+			delete mDriver;
+			mConnection.close();
+			throw;
+		}
+		mDriver->send();
 	}
 
 	LazySusan::~LazySusan()
 	{
+		if (mReactor)
+		{
+			mReactor->unwatch(*mConnection);
+			mReactor->cancelTimer(mTimer);
+		}
+		delete mDriver;
 		mConnection.close();
 	}
 
+	void LazySusan::open(const std::string &device)
+	{
+		if (!mConnection.open(device.c_str(),
+				      Serial::BAUD_115200,
+				      Serial::DB_EIGHT,
+				      Serial::NONE,
+				      Serial::ONE,
+				      Serial::RAW,
+				      Serial::DISABLED,
+				      Serial::NONBLOCKING,
+				      Serial::BOTH))
+			throw Exception("LazySusan: Unable to open device");
 
-	void LazySusan::update()
+		mPending = false;
+		mRequestTime = 0;
+		mReceived = 0;
+
+		mLatest.timestamp = 0;
+		mLatest.rotation = 0;
+		mLatest.rate = 0;
+		mLatest.latency = 0;
+		mLatest.sampleRate = 0;
+		mLatest.count = 0;
+		mSamples.reset(mLatest);
+
+		mTimeouts = 0;
+		mErrors = 0;
+	}
+
+	void LazySusan::request()
+	{
+		if (mConnection.write("p\r", 2) != 2)
+			mErrors++;
+		mPending = true;
+		mRequestTime = getMonotonicTime();
+	}
+
+	/**
+	 * Give up on the request in flight, and anything received of it
+	 */
+	void LazySusan::expire()
+	{
+		mTimeouts++;
+		mConnection.flush(Serial::INPUT);
+		mPending = false;
+		mReceived = 0;
+	}
+
+	/**
+	 * Read whatever has arrived, without blocking
+	 *
+	 * @return true if a reading is complete
+	 */
+	bool LazySusan::receive()
 	{
-		using namespace std;
+		ssize_t count = mConnection.read(mResponse + mReceived, RESPONSE_SIZE - mReceived);
+		if (count <= 0)
+			return false;
 
-		static bool responsePending = false;
-		static int bytesRead = 0;
-		static char response[7];
-		static int noReadCount = 0;
-		response[6] = '\0';
+		mReceived += count;
+		if (mReceived < RESPONSE_SIZE)
+			return false;
 
-		if (!responsePending)
+		for (unsigned i = 0; i < DIGITS; i++)
 		{
-			std::string request = "p\r";
-			mConnection.write(request);
-			mConnection.drain();
-			responsePending = true;
-			bytesRead = 0;
-			noReadCount = 0;
+			if (!isxdigit(mResponse[i]))
+			{
+				// We started part way through a reading, keep
+				// whatever follows the end of it
+				mErrors++;
+				unsigned end = RESPONSE_SIZE;
+				while (end > 0 && mResponse[end - 1] != '\n')
+					end--;
+				mReceived = end > 0 ? RESPONSE_SIZE - end : 0;
+				memmove(mResponse, mResponse + end, mReceived);
+				return false;
+			}
 		}
 
-		bytesRead += mConnection.read(response+bytesRead, 7 - bytesRead);
+		parse(getCurrentTime());
+		mReceived = 0;
+		return true;
+	}
 
-		if (bytesRead == 0)
-			noReadCount++;
+	/**
+	 * Take the angle from a complete reading and update the rotation
+	 * rate, latency and sample rate
+	 */
+	void LazySusan::parse(const uint64_t now)
+	{
+		unsigned value = 0;
+		for (unsigned i = 0; i < DIGITS; i++)
+		{
+			char c = mResponse[i];
+			value = value * 16 + (isdigit(c) ? c - '0' : tolower(c) - 'a' + 10);
+		}
+		double rotation = (double)value / COUNTS_PER_TURN;
 
-		if (noReadCount > 10)
+		// The turntable was read at some point during the round
+		// trip, the middle is the best guess. A reading nobody asked
+		// for is as old as it can be.
+		uint64_t timestamp = now;
+		double latency = mLatest.latency;
+		if (mPending)
 		{
-			responsePending = false;
+			// Measured on the monotonic clock, so setting the
+			// clock doesn't make the round trip negative
+			uint64_t elapsed = getMonotonicTime() - mRequestTime;
+			timestamp = now - elapsed / 2;
+			latency = elapsed / 1e6;
 		}
+		mPending = false;
 
-		if (bytesRead == 7)
+		if (mLatest.count == 0)
+			mLatest.latency = latency;
+		else if (timestamp > mLatest.timestamp)
 		{
-			cout << "Response: " << response << endl;
-			// null out the dollar sign/newline char
-			response[4] = '\0';
-			responsePending = false;
-			bytesRead = 0;
-			// convert hex to decimal...
-			unsigned int x;   
-			std::stringstream ss;
-			ss << std::hex << response;
-			ss >> x;
-			double d = ((double) x)/4096;
-			cout << "Degrees: " << d*360 << endl;
-			mTrackedObject.setRotation(d);
+			double dt = (timestamp - mLatest.timestamp) / 1e6;
+
+			// Take the shorter way round
+			double turns = rotation - mLatest.rotation;
+			turns -= floor(turns + 0.5);
+
+			mLatest.rate += SMOOTHING * (turns * 360 / dt - mLatest.rate);
+			mLatest.sampleRate += SMOOTHING * (1 / dt - mLatest.sampleRate);
+			mLatest.latency += SMOOTHING * (latency - mLatest.latency);
 		}
+
+		mLatest.timestamp = timestamp;
+		mLatest.rotation = rotation;
+		mLatest.count++;
 	}
 
-	TrackedObject* LazySusan::getObject(std::string name)
+	/**
+	 * Hand the latest reading over to update()
+	 */
+	void LazySusan::publish()
+	{
+		mSamples.getBack() = mLatest;
+		mSamples.publish();
+	}
+
+	void LazySusan::update()
+	{
+		if (!mReactor)
+		{
+			if (mPending && getMonotonicTime() - mRequestTime > RESPONSE_TIMEOUT * 1000)
+				expire();
+
+			if (!mPending)
+				request();
+			else if (receive())
+			{
+				publish();
+				request();
+			}
+		}
+
+		if (!mSamples.take())
+			return;
+
+		mTrackedObject.setRotation(mSamples.getFront().rotation);
+		recordPoses(mSamples.getFront().timestamp);
+	}
+
+	TrackedObject* LazySusan::getObject(std::string)
 	{
 		return &mTrackedObject;
 	}
 
 	std::vector<TrackedObject* > LazySusan::getAllObjects()
 	{
-		static std::vector<TrackedObject*> objects;
-		static bool filled = false;
+		return std::vector<TrackedObject *>(1, &mTrackedObject);
+	}
 
-		if (!filled)
-		{
-			objects.push_back(&mTrackedObject);
-			filled = true;
-		}
+	unsigned LazySusan::getObjectCount()
+	{
+		return 1;
+	}
+
+	TrackedObject *LazySusan::getObjectAt(const unsigned index)
+	{
+		return index == 0 ? &mTrackedObject : NULL;
+	}
+
+	void LazySusan::setUnits(Units) {}
+
+	double LazySusan::getRotationRate() const
+	{
+		return mSamples.getFront().rate;
+	}
+
+	double LazySusan::getLatency() const
+	{
+		return mSamples.getFront().latency;
+	}
 
-		return objects;
+	double LazySusan::getSampleRate() const
+	{
+		return mSamples.getFront().sampleRate;
 	}
 
-	void LazySusan::setUnits(Units u) {}
+	uint64_t LazySusan::getSampleCount() const
+	{
+		return mSamples.getFront().count;
+	}
+
+	uint64_t LazySusan::getTimeoutCount() const
+	{
+		return mTimeouts;
+	}
+
+	uint64_t LazySusan::getErrorCount() const
+	{
+		return mErrors;
+	}
 
 };
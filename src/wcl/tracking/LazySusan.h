@@ -28,33 +28,171 @@
 #ifndef WCL_TRACKING_LAZY_SUSAN
 #define WCL_TRACKING_LAZY_SUSAN
 
+#include <stdint.h>
+
 #include "LazySusanTrackedObject.h"
 #include "Tracker.h"
+#include <wcl/network/Reactor.h>
 #include <wcl/rawports/Serial.h>
+#include <wcl/util/TripleBuffer.h>
 
 namespace wcl
 {
 	/**
 	 * An abstraction of the lazy susan, so it can be used
 	 * like any other WCL Tracker.
+	 *
+	 * The turntable answers each request with one reading. A new
+	 * request is sent as soon as a reading arrives, so readings stream
+	 * in as fast as the turntable answers. Each reading is timestamped
+	 * with the middle of its round trip.
+	 *
+	 * The turntable can be driven in two ways. Given only a device,
+	 * update() sends requests and reads whatever has arrived without
+	 * blocking. Given a Reactor too, the requests and readings are
+	 * handled by the reactor, independent of how often update() is
+	 * called, and update() only picks up the latest reading. The reactor
+	 * may run on another thread, but the LazySusan must then be created
+	 * and destroyed while it isn't running.
 	 */
 	class WCL_API LazySusan : public Tracker
 	{
 		public:
+			/**
+			 * How long to wait for a reading, in milliseconds,
+			 * before asking again
+			 */
+			static const unsigned RESPONSE_TIMEOUT = 100;
+
+			/**
+			 * Open the turntable and read it from update()
+			 *
+			 * @throws Exception if the device can't be opened
+			 */
 			LazySusan(std::string device);
+
+			/**
+			 * Open the turntable and read it from a reactor
+			 *
+			 * @param device The serial device
+			 * @param reactor The reactor to read from, which must
+			 *        outlive this object
+			 * @param interval The time to wait after a reading
+			 *        before asking for the next, in milliseconds
+			 * @throws Exception if the device can't be opened
+			 */
+			LazySusan(const std::string &device, Reactor &reactor,
+				  const unsigned interval = 0);
 			~LazySusan();
 
 			virtual void update();
 			virtual TrackedObject* getObject(std::string name);
 			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
 			virtual void setUnits(Units u);
 
+			/**
+			 * The speed the turntable is turning at, in degrees
+			 * per second, as of the last update
+			 */
+			double getRotationRate() const;
+
+			/**
+			 * The time between sending a request and the reading
+			 * arriving, in seconds, as of the last update
+			 */
+			double getLatency() const;
+
+			/**
+			 * The readings received per second, as of the last
+			 * update
+			 */
+			double getSampleRate() const;
+
+			/**
+			 * The number of readings received, as of the last
+			 * update
+			 */
+			uint64_t getSampleCount() const;
+
+			/**
+			 * The number of requests that went unanswered
+			 */
+			uint64_t getTimeoutCount() const;
+
+			/**
+			 * The number of malformed readings
+			 */
+			uint64_t getErrorCount() const;
+
 		private:
+			class Driver;
+			friend class Driver;
+
+			/**
+			 * The reply to "p\r", four hex digits of the angle
+			 * followed by the terminator
+			 */
+			static const unsigned RESPONSE_SIZE = 7;
+			static const unsigned DIGITS = 4;
+			static const unsigned COUNTS_PER_TURN = 4096;
+
+			/**
+			 * A reading and the measurements as of it
+			 */
+			struct Sample
+			{
+				uint64_t timestamp;
+				double rotation;
+				double rate;
+				double latency;
+				double sampleRate;
+				uint64_t count;
+			};
+
 			LazySusanTrackedObject mTrackedObject;
 			Serial mConnection;
 
+			Reactor *mReactor;
+			Driver *mDriver;
+			unsigned mInterval;
+			unsigned long mTimer;
+
+			/**
+			 * The request in flight, when it was made on the
+			 * monotonic clock, and the reply so far
+			 */
+			bool mPending;
+			uint64_t mRequestTime;
+			char mResponse[RESPONSE_SIZE];
+			unsigned mReceived;
+
+			/**
+			 * The latest reading, with the measurements kept up
+			 * to date as readings arrive
+			 */
+			Sample mLatest;
+
+			/**
+			 * Readings from whoever receives them, which fills the
+			 * back, to update(), which reads the front
+			 */
+			TripleBuffer<Sample> mSamples;
+
+			volatile uint64_t mTimeouts;
+			volatile uint64_t mErrors;
+
+			void open(const std::string &device);
+			void request();
+			bool receive();
+			void parse(const uint64_t now);
+			void publish();
+			void expire();
+
+			LazySusan(const LazySusan &);
+			LazySusan &operator =(const LazySusan &);
 	};
 };
 
 #endif
-
@@ -0,0 +1,65 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_MULTICASTTRACKEDOBJECT_H
+#define WCL_TRACKING_MULTICASTTRACKEDOBJECT_H
+
+#include <string>
+
+#include <wcl/api.h>
+#include <wcl/maths/Quaternion.h>
+#include <wcl/maths/SMatrix.h>
+#include <wcl/maths/Vector.h>
+#include <wcl/tracking/TrackedObject.h>
+
+namespace wcl
+{
+	/**
+	 * An object received from a TrackerPublisher by a MulticastTracker.
+	 */
+	class WCL_API MulticastTrackedObject : public TrackedObject
+	{
+		public:
+			MulticastTrackedObject(const std::string &name, const ObjectType type);
+			virtual ~MulticastTrackedObject(){}
+
+			virtual std::string toString() const;
+			virtual SMatrix getTransform() const;
+			virtual Vector getTranslation() const;
+			virtual Quaternion getOrientation() const;
+			virtual bool isVisible() const;
+
+			void setData(const ObjectType type, const bool visible, const float confidence,
+				     const Vector &translation, const Quaternion &orientation);
+
+		private:
+			Vector translation;
+			Quaternion orientation;
+			bool visible;
+	};
+};
+
+#endif
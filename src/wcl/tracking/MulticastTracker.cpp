@@ -0,0 +1,158 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <poll.h>
+
+#include <wcl/tracking/MulticastTracker.h>
+#include "TrackerPacket.h"
+#include "TrackerPacketObjects.h"
+
+// The number of datagrams read per system call
+#define BATCH_SIZE 16
+
+namespace wcl
+{
+
+using namespace TrackerPacket;
+
+MulticastTracker::MulticastTracker(const std::string &group, const unsigned port) throw (SocketException):
+    socket(port, group), storage(BATCH_SIZE * MAX_DATAGRAM_SIZE), table(new ObjectTable()), units(MM), timeout(0),
+    haveUpdate(false), sequence(0), timestamp(0), lostUpdates(0)
+{
+    this->socket.setBlockingMode(Socket::NONBLOCKING);
+    for(unsigned i = 0; i < BATCH_SIZE; i++ )
+	this->packets.push_back(new UDPPacket(&this->storage[i * MAX_DATAGRAM_SIZE], MAX_DATAGRAM_SIZE));
+}
+
+MulticastTracker::~MulticastTracker()
+{
+    delete this->table;
+    for(unsigned i = 0; i < this->packets.size(); i++ )
+	delete this->packets[i];
+}
+
+void MulticastTracker::update()
+{
+    bool applied = false;
+    bool waited = false;
+
+    for(;;){
+	unsigned count = this->socket.read(&this->packets[0], BATCH_SIZE, false);
+	for(unsigned i = 0; i < count; i++ ){
+	    UDPPacket *p = this->packets[i];
+	    if( this->apply((const unsigned char *)p->getData(), p->getLength()))
+		applied = true;
+	}
+
+	if( count == BATCH_SIZE )
+	    continue;
+	if( applied || waited || this->timeout == 0 )
+	    return;
+
+	struct pollfd pfd;
+	pfd.fd = *this->socket;
+	pfd.events = POLLIN;
+	poll(&pfd, 1, this->timeout);
+	waited = true;
+    }
+}
+
+/**
+ * Apply one datagram from the publisher
+ *
+ * @return true if the datagram was newer than the last applied
+ */
+bool MulticastTracker::apply(const unsigned char *data, const size_t size)
+{
+    WireReader r(data, size);
+    Header h;
+    if( !readHeader(r, h))
+	return false;
+
+    // Order by time rather than sequence, so a restarted publisher isn't
+    // taken as a stream of old updates
+    if( this->haveUpdate ){
+	if( h.timestamp < this->timestamp )
+	    return false;
+	int32_t gap = h.sequence - this->sequence;
+	if( gap > 1 )
+	    this->lostUpdates += gap - 1;
+    }
+    this->haveUpdate = true;
+    this->sequence = h.sequence;
+    this->timestamp = h.timestamp;
+
+    this->table->apply(r, h.count, getUnitScale(this->units));
+    this->recordPoses(h.timestamp);
+    return true;
+}
+
+TrackedObject* MulticastTracker::getObject(std::string name)
+{
+    return this->table->getObject(name);
+}
+
+std::vector<TrackedObject *> MulticastTracker::getAllObjects()
+{
+    return this->table->getAllObjects();
+}
+
+unsigned MulticastTracker::getObjectCount()
+{
+    return this->table->getObjectCount();
+}
+
+TrackedObject *MulticastTracker::getObjectAt(const unsigned index)
+{
+    return this->table->getObjectAt(index);
+}
+
+void MulticastTracker::setUnits(Units u)
+{
+    this->units = u;
+}
+
+void MulticastTracker::setTimeout(const int itimeout)
+{
+    this->timeout = itimeout;
+}
+
+uint32_t MulticastTracker::getSequence() const
+{
+    return this->sequence;
+}
+
+uint64_t MulticastTracker::getTimestamp() const
+{
+    return this->timestamp;
+}
+
+unsigned MulticastTracker::getLostUpdates() const
+{
+    return this->lostUpdates;
+}
+
+};
@@ -0,0 +1,122 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_MULTICASTTRACKER_H
+#define WCL_TRACKING_MULTICASTTRACKER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/SocketException.h>
+#include <wcl/network/UDPPacket.h>
+#include <wcl/network/UDPServer.h>
+#include <wcl/tracking/Tracker.h>
+#include <wcl/tracking/TrackerPublisher.h>
+
+namespace wcl
+{
+	namespace TrackerPacket { class ObjectTable; }
+
+	/**
+	 * Follows a tracker published by a TrackerPublisher.
+	 *
+	 * Any number of MulticastTrackers, on any number of machines, can
+	 * follow a publisher. Updates that arrive out of order are ignored and
+	 * lost updates are counted.
+	 */
+	class WCL_API MulticastTracker : public Tracker
+	{
+		public:
+			/**
+			 * @param group The multicast group the publisher sends to
+			 * @param port The port the publisher sends to
+			 * @throw SocketException if the group can't be joined
+			 */
+			MulticastTracker(const std::string &group = TrackerPublisher::DEFAULT_GROUP,
+					 const unsigned port = TrackerPublisher::DEFAULT_PORT) throw (SocketException);
+			~MulticastTracker();
+
+			/**
+			 * Apply every update received since the last call. If
+			 * nothing new has arrived this waits up to the timeout.
+			 */
+			virtual void update();
+
+			virtual TrackedObject* getObject(std::string name);
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+			virtual void setUnits(Units u);
+
+			/**
+			 * Set how long update waits for an update to arrive
+			 *
+			 * @param timeout The time in milliseconds, 0 to return
+			 *                immediately or -1 to wait forever
+			 */
+			void setTimeout(const int timeout);
+
+			/**
+			 * The sequence number of the last update applied
+			 */
+			uint32_t getSequence() const;
+
+			/**
+			 * When the last update applied was published, in
+			 * microseconds since the epoch on the publisher clock
+			 */
+			uint64_t getTimestamp() const;
+
+			/**
+			 * The number of updates published that never arrived
+			 */
+			unsigned getLostUpdates() const;
+
+		private:
+			UDPServer socket;
+			std::vector<unsigned char> storage;
+			std::vector<UDPPacket *> packets;
+
+			TrackerPacket::ObjectTable *table;
+
+			Units units;
+			int timeout;
+
+			bool haveUpdate;
+			uint32_t sequence;
+			uint64_t timestamp;
+			unsigned lostUpdates;
+
+			bool apply(const unsigned char *data, const size_t size);
+
+			MulticastTracker(const MulticastTracker &);
+			MulticastTracker &operator =(const MulticastTracker &);
+	};
+};
+
+#endif
@@ -34,7 +34,10 @@
 #include <wcl/tracking/TrackedObject.h>
 #include <wcl/Exception.h>
 #include <errno.h>
+#include <poll.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sstream>
 #include <unistd.h>
@@ -44,8 +47,15 @@ namespace wcl
 
 	static std::map<char, std::string> PolhemusAsciiErrorCodes;
 
-	Polhemus::Polhemus(std::string path, TrackerType t) : Tracker(),  activeSensorCount(-1), type(t),continuous(false)
+	const size_t Polhemus::BUFFER_SIZE;
+	const unsigned Polhemus::REPLY_TIMEOUT;
+
+	Polhemus::Polhemus(std::string path, TrackerType t, OutputFormat f) : Tracker(),  activeSensorCount(-1), type(t),continuous(false),
+		format(f), bufferStart(0), bufferEnd(0), resyncs(0), lastError(0)
 	{
+		if (format == BINARY && type != PATRIOT)
+			throw Exception("Polhemus: Binary output is only supported on the Patriot");
+
 		std::cout << "About to connect to " << path << std::endl;
 		if (!connection.open(path.c_str(), Serial::BAUD_115200))
 		{
@@ -64,7 +74,7 @@ namespace wcl
 		
 		
 		clearInput();
-		setAsciiOutput();
+		setOutputFormat();
 		setDataFormat();
 		setUnits(MM);
 
@@ -130,117 +140,231 @@ namespace wcl
 		delete[] rubbish;
 	}
 	
+	/**
+	 * Read a little endian IEEE float
+	 */
+	static float readFloat(const unsigned char *p)
+	{
+		uint32_t u = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+		float f;
+		memcpy(&f, &u, sizeof(f));
+		return f;
+	}
+
+	/**
+	 * Whether a record looks like a real pose rather than bytes that
+	 * happened to follow something that looked like a header
+	 */
+	static bool isPlausible(const double *values)
+	{
+		for (int i = 0; i < 7; i++)
+		{
+			if (!(values[i] > -1e6 && values[i] < 1e6))
+				return false;
+		}
+
+		double n = values[3]*values[3] + values[4]*values[4] + values[5]*values[5] + values[6]*values[6];
+		return n > 0.9 && n < 1.1;
+	}
+
 	void Polhemus::update()
 	{
-		char response[70] = {0};
-		double x, y, z, rx, ry, rz, rw;
-		unsigned number;
-		size_t expectedBytes=0;
-		if (type == PATRIOT)
-			expectedBytes = 69;
-		else if (type == FASTRAK)
-			expectedBytes = 54;
+		if (activeSensorCount <= 0)
+			throw Exception("Could not figure out how many sensors are connected to polhemus");
 
+		if (!continuous)
+		{
+			connection.write("P");
+			connection.drain();
+		}
 
-		if (activeSensorCount > 0)
+		// Read in bulk until every sensor has reported. In continuous mode
+		// also take whatever else has arrived, so the newest poses are used.
+		// A polled reply with a record dropped as corrupt never completes,
+		// so give up on it after a while
+		unsigned all = activeSensorCount >= 32 ? ~0u : (1u << activeSensorCount) - 1;
+		unsigned reported = 0;
+		uint64_t deadline = getMonotonicTime() + REPLY_TIMEOUT * 1000;
+		while ((reported & all) != all || (continuous && connection.getAvailableCount() > 0))
 		{
 			if (!continuous)
 			{
-				connection.write("P");
-				connection.drain();
+				uint64_t now = getMonotonicTime();
+				struct pollfd pfd;
+				pfd.fd = *connection;
+				pfd.events = POLLIN;
+				if (now >= deadline || poll(&pfd, 1, (deadline - now + 999) / 1000) == 0)
+					break;
 			}
-			
-			/*
-			char response[140];
-			memset(response, 0, 140);
-			size_t sz = connection.getAvailableCount();
-			connection.readUntil(response, 138);
-			printf("%d:%s\n", sz, response);
-			*/
-	
-	
-			for (int i=0; i<activeSensorCount; i++)
-			{
 
-				/* 	Modified read loop to stop at a line break. The polhemus
-					and SAR system sometimes get out of sync by half a line or
-					so and keeps going like that. This loop prevents that by
-					reading one entry (until the line break) at a time. 
-				*/
- 				{
-					size_t count = 0;
-					char byte;
-					
-					while (count < expectedBytes)
-					{
-						int read = connection.read(&byte, 1);
-						assert(read >= 0);
-						
-						if (byte == '\n')
-							break;
-							
-						response[count++] = byte;
-					}
-					/*
-					std::clog << "Read " << count << " bytes: [";
-					for (size_t i = 0; i < count; ++i)
-						std::clog << response[i] << " ";
-					std::clog << "]\n";
-					*/
-				}
-				
-				
-				char error;
-				int count = sscanf(response, "%u%c %lf %lf %lf %lf %lf %lf %lf", &number, &error, &x, &y, &z, &rw, &rx, &ry, &rz);
-				if (count == EOF)
-					throw Exception("Input read error; message: [" + std::string(response) +"]");
-				
-				if( count != 9 )
-				{
-					std::stringstream ss;
-					ss << "Could not read all items from polhemus; read " << count << ", expected 9, message: " << response;
-				    throw Exception(ss.str());
-				}
-				
-				if (number > sensors.size() || number == 0)
-				{
-					std::stringstream ss;
-					ss << "Invalid polhemus sensor number (" << number << ") in libwcl. Valid range: 1-" << sensors.size();
-					throw Exception(ss.str());
-				}
-				
-				// error messages according to the patriot user manual
-				if (error != ' ')
-				{
-					// squelch old errors
-					static char lastError = ' ';
-					if (error != lastError)
-					{
-						lastError = error;
-						// clear BIT error flag -- this hangs the connection after a while
-						//connection.write("^T");
-						throw Exception("Polhemus tracker reported error: " + PolhemusAsciiErrorCodes[error]);
-					}
-				}
-				//printf("%d: (%f,%f,%f)\n", number, x, y, z);
-				
-				if (units == MM)
-				{
-					sensors[number-1].update(x*10,y*10,z*10,rw,rx,ry,rz);
-				}
-				else
-				{
-					sensors[number-1].update(x,y,z,rw,rx,ry,rz);
-				}
-				
+			if (!fill())
+				throw Exception("Polhemus: Could not read from the tracker");
+
+			int station;
+			while ((station = (format == BINARY ? parseBinary() : parseAscii())) > 0)
+			{
+				if (station <= 32)
+					reported |= 1u << (station - 1);
 			}
 		}
+
+		if (reported == 0)
+			throw Exception("Polhemus: No reply from the tracker");
+
+		recordPoses(getCurrentTime());
+	}
+
+	bool Polhemus::fill()
+	{
+		if (bufferEnd == BUFFER_SIZE)
+		{
+			// Move what is left of a record to the front
+			memmove(buffer, buffer + bufferStart, bufferEnd - bufferStart);
+			bufferEnd -= bufferStart;
+			bufferStart = 0;
+			if (bufferEnd == BUFFER_SIZE)
+				bufferEnd = 0;
+		}
+
+		ssize_t count = connection.read(buffer + bufferEnd, BUFFER_SIZE - bufferEnd);
+		if (count < 0)
+			return errno == EINTR || errno == EAGAIN;
+		if (count == 0)
+			return false;
+
+		bufferEnd += count;
+		return true;
+	}
+
+	void Polhemus::skip()
+	{
+		// Drop the byte we were on and find the next that could start a record
+		const unsigned char sync = format == BINARY ? 'P' : '\n';
+		const void *next = memchr(buffer + bufferStart + 1, sync, bufferEnd - bufferStart - 1);
+		if (next == NULL)
+			bufferStart = bufferEnd;
 		else
+			bufferStart = (const unsigned char *)next - buffer + (format == BINARY ? 0 : 1);
+		resyncs++;
+	}
+
+	int Polhemus::parseBinary()
+	{
+		while (bufferEnd - bufferStart >= BINARY_HEADER_SIZE)
 		{
-			throw Exception("Could not figure out how many sensors are connected to polhemus");
+			const unsigned char *p = buffer + bufferStart;
+			unsigned station = p[2];
+			unsigned size = p[6] | (p[7] << 8);
+			if (p[0] != 'P' || p[1] != 'A' || station == 0 || station > sensors.size() ||
+				size != BINARY_PAYLOAD_SIZE)
+			{
+				skip();
+				continue;
+			}
+
+			if (bufferEnd - bufferStart < BINARY_HEADER_SIZE + size)
+				return 0;
+
+			// Position then quaternion, as asked for in setDataFormat
+			double values[7];
+			for (int i = 0; i < 7; i++)
+				values[i] = readFloat(p + BINARY_HEADER_SIZE + 4*i);
+			if (!isPlausible(values))
+			{
+				skip();
+				continue;
+			}
+
+			bufferStart += BINARY_HEADER_SIZE + size;
+			apply(station, p[4] == ' ' ? 0 : p[4], values);
+			return station;
+		}
+
+		return 0;
+	}
+
+	int Polhemus::parseAscii()
+	{
+		for (;;)
+		{
+			const unsigned char *p = buffer + bufferStart;
+			size_t available = bufferEnd - bufferStart;
+			const unsigned char *end = (const unsigned char *)memchr(p, '\n', available);
+			if (end == NULL)
+			{
+				// Nothing that long is a record
+				if (available > MAX_LINE)
+					skip();
+				return 0;
+			}
+
+			size_t length = end - p;
+			bufferStart += length + 1;
+			if (length > MAX_LINE)
+			{
+				resyncs++;
+				continue;
+			}
+
+			char line[MAX_LINE + 1];
+			memcpy(line, p, length);
+			line[length] = '\0';
+
+			// The station, an error character, then the values
+			char *s = line;
+			char *next;
+			unsigned long station = strtoul(s, &next, 10);
+			if (next == s || *next == '\0' || station == 0 || station > sensors.size())
+			{
+				resyncs++;
+				continue;
+			}
+			char error = *next;
+			s = next + 1;
+
+			double values[7];
+			int i;
+			for (i = 0; i < 7; i++)
+			{
+				values[i] = strtod(s, &next);
+				if (next == s)
+					break;
+				s = next;
+			}
+			if (i < 7 || !isPlausible(values))
+			{
+				resyncs++;
+				continue;
+			}
+
+			apply(station, error == ' ' ? 0 : error, values);
+			return station;
 		}
 	}
 
+	void Polhemus::apply(unsigned station, char error, const double *values)
+	{
+		if (error != lastError)
+		{
+			// Report each error once, according to the patriot user manual
+			lastError = error;
+			if (error != 0)
+			{
+				// clear BIT error flag -- this hangs the connection after a while
+				//connection.write("^T");
+				std::map<char, std::string>::const_iterator it = PolhemusAsciiErrorCodes.find(error);
+				if (it != PolhemusAsciiErrorCodes.end())
+					throw Exception(it->second.c_str());
+				throw Exception("Polhemus tracker reported an unknown error");
+			}
+		}
+
+		// The hardware measures in cm at best
+		double scale = units == MM ? 10 : 1;
+		sensors[station-1].update(values[0]*scale, values[1]*scale, values[2]*scale,
+								  values[3], values[4], values[5], values[6]);
+	}
+
 	TrackedObject* Polhemus::getObject(std::string name)
 	{
 		if (sensors.empty())
@@ -272,6 +396,16 @@ namespace wcl
 	    return objects;
 	}
 
+	unsigned Polhemus::getObjectCount()
+	{
+	    return activeSensorCount;
+	}
+
+	TrackedObject *Polhemus::getObjectAt(const unsigned index)
+	{
+	    return index < (unsigned)activeSensorCount ? &sensors[index] : NULL;
+	}
+
 	
 	void Polhemus::setHemisphere(const wcl::Vector& hemisphere)
 	{
@@ -377,13 +511,13 @@ namespace wcl
 		}
 	}
 
-	void Polhemus::setAsciiOutput()
+	void Polhemus::setOutputFormat()
 	{
 		int bytesWritten = 0;
 		int expected = 0;
 		if (type == PATRIOT)
 		{
-			bytesWritten = connection.write("F0\r");
+			bytesWritten = connection.write(format == BINARY ? "F1\r" : "F0\r");
 			expected = 3;
 		}
 		else
@@ -425,7 +559,13 @@ namespace wcl
 		// and a quaternion for rotation, with a CRLF separating stations
 		int bytesWritten = 0;
 		int expected = 0;
-		if (type == PATRIOT)
+		if (type == PATRIOT && format == BINARY)
+		{
+			// binary records are framed by their header instead
+			expected = 7;
+			bytesWritten = connection.write("O*,2,7\r");
+		}
+		else if (type == PATRIOT)
 		{
 			expected = 9;
 			bytesWritten = connection.write("O*,2,7,1\r");
@@ -456,6 +596,11 @@ namespace wcl
 
 	}
 
+	unsigned Polhemus::getResyncCount() const
+	{
+		return resyncs;
+	}
+
 	void Polhemus::setSensorCount(int c)
 	{
 		if (c > 0)
@@ -51,13 +51,31 @@ namespace wcl
 				FASTRAK
 			};
 
+			/**
+			 * How the tracker sends records.
+			 */
+			enum OutputFormat
+			{
+				/**
+				 * Text, one line per sensor.
+				 */
+				ASCII,
+
+				/**
+				 * Fixed size binary records, which are smaller and
+				 * cheaper to parse. Patriot only.
+				 */
+				BINARY
+			};
+
 			/**
 			 * Creates a new connection to the Patriot tracker
 			 * over a serial connection.
 			 *
 			 * @param path The path to the serial connection (/etc/ttyUSB0 or something)
+			 * @param f The output format to ask the tracker for
 			 */
-			Polhemus(std::string path, TrackerType t);
+			Polhemus(std::string path, TrackerType t, OutputFormat f = ASCII);
 
 			/**
 			 * DESTRUCTOR!
@@ -66,6 +84,11 @@ namespace wcl
 
 			/**
 			 * Fills the tracked objects witht he latest frame of data from the server.
+			 *
+			 * When polling, sensors whose record is lost or corrupt
+			 * keep their last pose once the reply times out.
+			 *
+			 * @throw Exception if no sensor replied or the tracker has gone
 			 */
 			virtual void update();
 
@@ -81,6 +104,8 @@ namespace wcl
 			 * Return every possible object 
 			 */
 			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
 
 			/**
 			 * Set the hemisphere of operation for the system.
@@ -125,6 +150,20 @@ namespace wcl
 			 */
 			void setAlignmentFrame(const wcl::Vector& origin, const wcl::Vector& xPos, const wcl::Vector& yPos);
 
+			/**
+			 * Puts the tracker into continuous mode, where it sends
+			 * records without being polled. update then applies the
+			 * newest record of every sensor.
+			 */
+			void setContinuous(bool c);
+
+			/**
+			 * The number of times the input had to be searched for
+			 * the start of a record, because of corrupt or partial
+			 * records.
+			 */
+			unsigned getResyncCount() const;
+
 		private:
 			/**
 			 * The serial connection to the Patriot.
@@ -137,15 +176,9 @@ namespace wcl
 			Units units;
 
 			/**
-			 * Tells the patriot to send ASCII data.
-			 */
-			void setAsciiOutput();
-			
-			/**
-			 * Puts the tracker into continuous mode.
-			 * Currently not used.
+			 * Tells the tracker which output format to send.
 			 */
-			void setContinuous(bool c);
+			void setOutputFormat();
 
 			/**
 			 * Sets the data format to what we want.
@@ -180,6 +213,63 @@ namespace wcl
 			TrackerType type;
 
 			bool continuous;
+
+			OutputFormat format;
+
+			/**
+			 * Input is read in bulk into the buffer, records are
+			 * parsed from bufferStart and the rest is moved to the
+			 * front when the end is reached.
+			 */
+			static const size_t BUFFER_SIZE = 4096;
+			unsigned char buffer[BUFFER_SIZE];
+			size_t bufferStart;
+			size_t bufferEnd;
+
+			/**
+			 * A binary record is an 8 byte header, starting with
+			 * "PA", then the position and quaternion as 7 floats.
+			 */
+			static const size_t BINARY_HEADER_SIZE = 8;
+			static const size_t BINARY_PAYLOAD_SIZE = 28;
+
+			/**
+			 * Longer ASCII lines can't be records.
+			 */
+			static const size_t MAX_LINE = 128;
+
+			/**
+			 * How long a polled update waits for the reply, in
+			 * milliseconds
+			 */
+			static const unsigned REPLY_TIMEOUT = 100;
+
+			unsigned resyncs;
+			char lastError;
+
+			/**
+			 * Read whatever the tracker has sent into the buffer,
+			 * blocking until there is something.
+			 *
+			 * @return false if the read failed or the tracker has gone
+			 */
+			bool fill();
+
+			/**
+			 * Parse the next record in the buffer and apply it.
+			 *
+			 * @return The station it was for, or 0 if there is no
+			 *         whole record
+			 */
+			int parseBinary();
+			int parseAscii();
+
+			/**
+			 * Drop input up to where the next record could start.
+			 */
+			void skip();
+
+			void apply(unsigned station, char error, const double *values);
 	};
 }
 
@@ -0,0 +1,197 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <cmath>
+
+#include <wcl/tracking/PoseFilter.h>
+
+namespace wcl
+{
+
+// Benedict-Bordner gains, beta = alpha^2 / (2 - alpha), which trade noise
+// against lag on a steadily moving target. They are slightly underdamped.
+const T PoseFilter::DEFAULT_ALPHA = 0.6;
+const T PoseFilter::DEFAULT_BETA = 0.257;
+const uint64_t PoseFilter::RESET_INTERVAL;
+const uint64_t PoseFilter::DEFAULT_PREDICTION_LIMIT;
+
+/**
+ * The rotation vector (axis * angle) of a unit quaternion
+ */
+static void toRotationVector(const Quaternion &q, T r[3])
+{
+    // Take the shorter way round
+    T s = q.w < 0 ? -1 : 1;
+    T length = sqrt(q.x*q.x + q.y*q.y + q.z*q.z);
+    T scale = 2;
+    if( length > 1e-12 )
+	scale = 2 * atan2(length, s * q.w) / length;
+    r[0] = s * q.x * scale;
+    r[1] = s * q.y * scale;
+    r[2] = s * q.z * scale;
+}
+
+static Quaternion fromRotationVector(const T r[3])
+{
+    T angle = sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2]);
+    T scale = 0.5;
+    if( angle > 1e-12 )
+	scale = sin(angle / 2) / angle;
+    Quaternion q(cos(angle / 2), r[0] * scale, r[1] * scale, r[2] * scale);
+    q.normalise();
+    return q;
+}
+
+PoseFilter::PoseFilter(const T alpha, const T beta) :
+    alpha(alpha),
+    beta(beta),
+    valid(false),
+    predictionLimit(DEFAULT_PREDICTION_LIMIT)
+{
+    this->reset();
+}
+
+void PoseFilter::reset()
+{
+    this->valid = false;
+    this->estimate.timestamp = 0;
+    for(unsigned i = 0; i < 3; i++ ){
+	this->velocity[i] = 0;
+	this->angularVelocity[i] = 0;
+    }
+}
+
+void PoseFilter::update(const PoseHistory::Pose &measurement)
+{
+    if( this->valid && measurement.timestamp <= this->estimate.timestamp )
+	return;
+
+    if( !this->valid || measurement.timestamp - this->estimate.timestamp > RESET_INTERVAL ){
+	this->reset();
+	this->estimate = measurement;
+	this->valid = true;
+	return;
+    }
+
+    T dt = (measurement.timestamp - this->estimate.timestamp) / 1e6;
+    T velocityGain = this->beta / dt;
+
+    for(unsigned i = 0; i < 3; i++ ){
+	T predicted = this->estimate.position[i] + this->velocity[i] * dt;
+	T residual = measurement.position[i] - predicted;
+	this->estimate.position[i] = predicted + this->alpha * residual;
+	this->velocity[i] += velocityGain * residual;
+    }
+
+    // The same on the orientation, with the residual as the rotation
+    // from the predicted orientation to the measured one
+    T step[3];
+    for(unsigned i = 0; i < 3; i++ )
+	step[i] = this->angularVelocity[i] * dt;
+    Quaternion predicted = this->estimate.orientation * fromRotationVector(step);
+    predicted.normalise();
+
+    T residual[3];
+    toRotationVector(predicted.getConjugate() * measurement.orientation, residual);
+    for(unsigned i = 0; i < 3; i++ ){
+	step[i] = residual[i] * this->alpha;
+	this->angularVelocity[i] += velocityGain * residual[i];
+    }
+    this->estimate.orientation = predicted * fromRotationVector(step);
+    this->estimate.orientation.normalise();
+
+    this->estimate.timestamp = measurement.timestamp;
+}
+
+bool PoseFilter::predict(const uint64_t time, PoseHistory::Pose &pose) const
+{
+    if( !this->valid )
+	return false;
+
+    // Signed, a time before the last measurement runs the motion back
+    int64_t ahead = (int64_t)(time - this->estimate.timestamp);
+    if( ahead > (int64_t)this->predictionLimit )
+	ahead = this->predictionLimit;
+    T dt = ahead / 1e6;
+
+    T step[3];
+    for(unsigned i = 0; i < 3; i++ ){
+	pose.position[i] = this->estimate.position[i] + this->velocity[i] * dt;
+	step[i] = this->angularVelocity[i] * dt;
+    }
+    pose.orientation = this->estimate.orientation * fromRotationVector(step);
+    pose.orientation.normalise();
+    pose.timestamp = time;
+    return true;
+}
+
+bool PoseFilter::isValid() const
+{
+    return this->valid;
+}
+
+uint64_t PoseFilter::getTimestamp() const
+{
+    return this->estimate.timestamp;
+}
+
+const T *PoseFilter::getVelocity() const
+{
+    return this->velocity;
+}
+
+const T *PoseFilter::getAngularVelocity() const
+{
+    return this->angularVelocity;
+}
+
+void PoseFilter::setPredictionLimit(const uint64_t limit)
+{
+    this->predictionLimit = limit;
+}
+
+uint64_t PoseFilter::getPredictionLimit() const
+{
+    return this->predictionLimit;
+}
+
+void PoseFilter::setGains(const T alpha, const T beta)
+{
+    this->alpha = alpha;
+    this->beta = beta;
+}
+
+T PoseFilter::getAlpha() const
+{
+    return this->alpha;
+}
+
+T PoseFilter::getBeta() const
+{
+    return this->beta;
+}
+
+};
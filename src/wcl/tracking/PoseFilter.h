@@ -0,0 +1,136 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_POSEFILTER_H
+#define WCL_TRACKING_POSEFILTER_H
+
+#include <stdint.h>
+
+#include <wcl/api.h>
+#include <wcl/maths/Quaternion.h>
+#include <wcl/tracking/PoseHistory.h>
+
+namespace wcl
+{
+	/**
+	 * Estimates the velocity of a pose from noisy measurements so it can
+	 * be predicted a short time ahead, hiding the latency between a
+	 * tracker sample and the frame it is displayed in.
+	 *
+	 * This is an alpha-beta filter, the steady state form of a constant
+	 * velocity Kalman filter, run on the position and on the orientation
+	 * as a rotation vector. Unlike double exponential smoothing it takes
+	 * the time between measurements into account, so irregular or
+	 * dropped samples don't skew the velocity.
+	 *
+	 * Alpha is how much of a measurement's residual corrects the pose,
+	 * beta how much corrects the velocity. Larger values follow the
+	 * measurements more closely, smaller ones smooth out more noise.
+	 */
+	class WCL_API PoseFilter
+	{
+		public:
+			static const T DEFAULT_ALPHA;
+			static const T DEFAULT_BETA;
+
+			/**
+			 * Measurements further apart than this, in microseconds,
+			 * restart the filter rather than being taken as motion
+			 */
+			static const uint64_t RESET_INTERVAL = 250000;
+
+			/**
+			 * How far past the last measurement predict goes by
+			 * default, in microseconds
+			 */
+			static const uint64_t DEFAULT_PREDICTION_LIMIT = 100000;
+
+			PoseFilter(const T alpha = DEFAULT_ALPHA, const T beta = DEFAULT_BETA);
+
+			/**
+			 * Correct the estimate with a measurement. Measurements
+			 * older than the last one are ignored.
+			 */
+			void update(const PoseHistory::Pose &measurement);
+
+			/**
+			 * Predict the pose at a point in time from the last
+			 * measurement. Times further ahead than the prediction
+			 * limit are taken as the limit, so an object that is no
+			 * longer measured doesn't drift off.
+			 *
+			 * @param time Microseconds since the epoch
+			 * @param pose Set to the predicted pose
+			 * @return false if there has been no measurement
+			 */
+			bool predict(const uint64_t time, PoseHistory::Pose &pose) const;
+
+			/**
+			 * Forget the estimate, the next measurement is taken as is
+			 */
+			void reset();
+
+			/**
+			 * Whether there has been a measurement since the last reset
+			 */
+			bool isValid() const;
+
+			/**
+			 * The time of the last measurement
+			 */
+			uint64_t getTimestamp() const;
+
+			/**
+			 * The linear velocity, in units per second
+			 */
+			const T *getVelocity() const;
+
+			/**
+			 * The angular velocity, in radians per second about the
+			 * object's axes
+			 */
+			const T *getAngularVelocity() const;
+
+			void setPredictionLimit(const uint64_t limit);
+			uint64_t getPredictionLimit() const;
+
+			void setGains(const T alpha, const T beta);
+			T getAlpha() const;
+			T getBeta() const;
+
+		private:
+			T alpha;
+			T beta;
+			bool valid;
+			uint64_t predictionLimit;
+
+			PoseHistory::Pose estimate;
+			T velocity[3];
+			T angularVelocity[3];
+	};
+};
+
+#endif
@@ -0,0 +1,220 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <sched.h>
+
+#include <wcl/tracking/PoseHistory.h>
+
+namespace wcl
+{
+
+const unsigned PoseHistory::CAPACITY;
+const uint64_t PoseHistory::DEFAULT_EXTRAPOLATION;
+
+PoseHistory::PoseHistory() :
+    head(0),
+    size(0),
+    extrapolationLimit(DEFAULT_EXTRAPOLATION),
+    sequence(0)
+{
+}
+
+const PoseHistory::Pose &PoseHistory::at(const unsigned index) const
+{
+    return this->poses[(this->head + CAPACITY - this->size + index) % CAPACITY];
+}
+
+void PoseHistory::push(const uint64_t timestamp, const Vector &position,
+		       const Quaternion &orientation)
+{
+    bool replace = false;
+    if( this->size > 0 ){
+	uint64_t latest = this->at(this->size - 1).timestamp;
+	if( timestamp < latest )
+	    return;
+	replace = timestamp == latest;
+    }
+
+    // Readers retry while the sequence is odd or has changed
+    this->sequence++;
+    __sync_synchronize();
+
+    unsigned slot = replace ? (this->head + CAPACITY - 1) % CAPACITY : this->head;
+    Pose &p = this->poses[slot];
+    p.timestamp = timestamp;
+    for(unsigned i = 0; i < 3; i++ )
+	p.position[i] = position[i];
+    p.orientation = orientation;
+
+    if( !replace ){
+	this->head = (this->head + 1) % CAPACITY;
+	if( this->size < CAPACITY )
+	    this->size++;
+    }
+
+    __sync_synchronize();
+    this->sequence++;
+}
+
+void PoseHistory::clear()
+{
+    this->sequence++;
+    __sync_synchronize();
+    this->head = 0;
+    this->size = 0;
+    __sync_synchronize();
+    this->sequence++;
+}
+
+bool PoseHistory::getPoseAt(const uint64_t time, Pose &pose) const
+{
+    Pose a, b;
+    bool found;
+    unsigned count;
+
+    for(;;){
+	uint32_t s = this->sequence;
+	if( s & 1 ){
+	    sched_yield();
+	    continue;
+	}
+	__sync_synchronize();
+
+	found = false;
+	count = this->size;
+	if( count > 0 && time >= this->at(0).timestamp ){
+	    b = this->at(count - 1);
+	    if( time >= b.timestamp ){
+		// Continue the motion between the last two poses
+		if( time - b.timestamp <= this->extrapolationLimit ){
+		    found = true;
+		    a = count > 1 ? this->at(count - 2) : b;
+		}
+	    } else {
+		// The first pose newer than time, there is one older
+		unsigned low = 1, high = count - 1;
+		while( low < high ){
+		    unsigned mid = (low + high) / 2;
+		    if( this->at(mid).timestamp > time )
+			high = mid;
+		    else
+			low = mid + 1;
+		}
+		a = this->at(low - 1);
+		b = this->at(low);
+		found = true;
+	    }
+	}
+
+	__sync_synchronize();
+	if( this->sequence == s )
+	    break;
+    }
+
+    if( !found )
+	return false;
+
+    if( a.timestamp == b.timestamp ){
+	pose = b;
+	pose.timestamp = time;
+	return true;
+    }
+
+    pose.timestamp = time;
+    T u = (T)(time - a.timestamp) / (T)(b.timestamp - a.timestamp);
+    for(unsigned i = 0; i < 3; i++ )
+	pose.position[i] = a.position[i] + (b.position[i] - a.position[i]) * u;
+    pose.orientation = a.orientation.slerp(b.orientation, u);
+    return true;
+}
+
+bool PoseHistory::getLatest(Pose &pose) const
+{
+    bool found;
+    for(;;){
+	uint32_t s = this->sequence;
+	if( s & 1 ){
+	    sched_yield();
+	    continue;
+	}
+	__sync_synchronize();
+
+	found = this->size > 0;
+	if( found )
+	    pose = this->at(this->size - 1);
+
+	__sync_synchronize();
+	if( this->sequence == s )
+	    return found;
+    }
+}
+
+unsigned PoseHistory::getSince(const uint64_t time, Pose *poses, const unsigned max) const
+{
+    unsigned copied;
+    for(;;){
+	uint32_t s = this->sequence;
+	if( s & 1 ){
+	    sched_yield();
+	    continue;
+	}
+	__sync_synchronize();
+
+	unsigned first = this->size;
+	while( first > 0 && this->at(first - 1).timestamp > time && this->size - first < max )
+	    first--;
+	copied = this->size - first;
+	for(unsigned i = 0; i < copied; i++ )
+	    poses[i] = this->at(first + i);
+
+	__sync_synchronize();
+	if( this->sequence == s )
+	    return copied;
+    }
+}
+
+uint64_t PoseHistory::getLatestTime() const
+{
+    Pose pose;
+    return this->getLatest(pose) ? pose.timestamp : 0;
+}
+
+unsigned PoseHistory::getSize() const
+{
+    return this->size;
+}
+
+void PoseHistory::setExtrapolationLimit(const uint64_t limit)
+{
+    this->extrapolationLimit = limit;
+}
+
+uint64_t PoseHistory::getExtrapolationLimit() const
+{
+    return this->extrapolationLimit;
+}
+
+};
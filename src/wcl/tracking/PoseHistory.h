@@ -0,0 +1,158 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_POSEHISTORY_H
+#define WCL_TRACKING_POSEHISTORY_H
+
+#include <stdint.h>
+
+#include <wcl/api.h>
+#include <wcl/maths/Quaternion.h>
+#include <wcl/maths/Vector.h>
+
+namespace wcl
+{
+	/**
+	 * The most recent poses of a tracked object, so the pose at the time
+	 * a camera frame was captured or a render frame will be displayed can
+	 * be found even though the tracker runs on a different clock.
+	 *
+	 * The history has a fixed capacity and never allocates. One thread
+	 * may push while any number of others query; a query that overlaps a
+	 * push simply reads again.
+	 */
+	class WCL_API PoseHistory
+	{
+		public:
+			/**
+			 * The number of poses kept
+			 */
+			static const unsigned CAPACITY = 64;
+
+			/**
+			 * How far past the newest pose getPoseAt extrapolates
+			 * by default, in microseconds
+			 */
+			static const uint64_t DEFAULT_EXTRAPOLATION = 50000;
+
+			/**
+			 * A pose at a point in time. The timestamp is in
+			 * microseconds since the epoch.
+			 */
+			struct Pose
+			{
+				uint64_t timestamp;
+				T position[3];
+				Quaternion orientation;
+			};
+
+			PoseHistory();
+
+			/**
+			 * Add the newest pose. Poses must arrive in time order, a
+			 * pose older than the newest is dropped and one with the
+			 * same timestamp replaces it.
+			 *
+			 * @param timestamp When the pose was measured
+			 */
+			void push(const uint64_t timestamp, const Vector &position,
+				  const Quaternion &orientation);
+
+			/**
+			 * Forget every pose
+			 */
+			void clear();
+
+			/**
+			 * Find the pose at a point in time. Between two poses the
+			 * position is interpolated linearly and the orientation
+			 * spherically. Past the newest pose the motion between the
+			 * last two is continued for at most the extrapolation
+			 * limit.
+			 *
+			 * @param time The time in microseconds since the epoch
+			 * @param pose Set to the pose, with its timestamp set to time
+			 * @return false if the history doesn't cover the time
+			 */
+			bool getPoseAt(const uint64_t time, Pose &pose) const;
+
+			/**
+			 * Obtain the newest pose
+			 *
+			 * @return false if the history is empty
+			 */
+			bool getLatest(Pose &pose) const;
+
+			/**
+			 * Copy out the poses newer than a point in time, oldest
+			 * first. If there are more than max the newest are
+			 * returned.
+			 *
+			 * @param time Microseconds since the epoch
+			 * @param poses Filled with up to max poses
+			 * @return The number of poses copied
+			 */
+			unsigned getSince(const uint64_t time, Pose *poses, const unsigned max) const;
+
+			/**
+			 * The timestamp of the newest pose, 0 if there is none
+			 */
+			uint64_t getLatestTime() const;
+
+			/**
+			 * The number of poses held, at most CAPACITY
+			 */
+			unsigned getSize() const;
+
+			/**
+			 * Set how far past the newest pose getPoseAt will answer
+			 *
+			 * @param limit The time in microseconds, 0 to only
+			 *              interpolate
+			 */
+			void setExtrapolationLimit(const uint64_t limit);
+			uint64_t getExtrapolationLimit() const;
+
+		private:
+			Pose poses[CAPACITY];
+
+			/**
+			 * Where the next pose goes
+			 */
+			unsigned head;
+			unsigned size;
+			uint64_t extrapolationLimit;
+
+			/**
+			 * Odd while a push is in progress
+			 */
+			volatile uint32_t sequence;
+
+			const Pose &at(const unsigned index) const;
+	};
+};
+
+#endif
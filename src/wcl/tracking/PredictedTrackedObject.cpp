@@ -0,0 +1,122 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <sstream>
+
+#include <wcl/tracking/PredictedTrackedObject.h>
+#include <wcl/tracking/Tracker.h>
+
+namespace wcl
+{
+
+PredictedTrackedObject::PredictedTrackedObject(TrackedObject &source) :
+    source(source),
+    valid(false)
+{
+    this->name = source.getName();
+    this->type = source.getType();
+    this->pose.timestamp = 0;
+    for(unsigned i = 0; i < 3; i++ )
+	this->pose.position[i] = 0;
+    this->pose.orientation.set(1, 0, 0, 0);
+}
+
+std::string PredictedTrackedObject::toString() const
+{
+    std::stringstream ss;
+    ss << "PredictedTrackedObject '" << this->name << "'";
+    return ss.str();
+}
+
+SMatrix PredictedTrackedObject::getTransform() const
+{
+    SMatrix T(4);
+    T[0][0] = 1;
+    T[1][1] = 1;
+    T[2][2] = 1;
+    T[3][3] = 1;
+
+    T[0][3] = this->pose.position[0];
+    T[1][3] = this->pose.position[1];
+    T[2][3] = this->pose.position[2];
+
+    return T * this->pose.orientation.getRotation();
+}
+
+Vector PredictedTrackedObject::getTranslation() const
+{
+    return Vector(this->pose.position[0], this->pose.position[1], this->pose.position[2]);
+}
+
+Quaternion PredictedTrackedObject::getOrientation() const
+{
+    return this->pose.orientation;
+}
+
+bool PredictedTrackedObject::isVisible() const
+{
+    return this->valid && this->source.isVisible();
+}
+
+float PredictedTrackedObject::getConfidence() const
+{
+    return this->source.getConfidence();
+}
+
+bool PredictedTrackedObject::predict(const T dt, PoseHistory::Pose &pose) const
+{
+    return this->predictAt(Tracker::getCurrentTime() + (int64_t)(dt * 1e6), pose);
+}
+
+bool PredictedTrackedObject::predictAt(const uint64_t time, PoseHistory::Pose &pose) const
+{
+    return this->filter.predict(time, pose);
+}
+
+TrackedObject &PredictedTrackedObject::getSource()
+{
+    return this->source;
+}
+
+PoseFilter &PredictedTrackedObject::getFilter()
+{
+    return this->filter;
+}
+
+void PredictedTrackedObject::update(const uint64_t time)
+{
+    PoseHistory::Pose poses[PoseHistory::CAPACITY];
+    unsigned count = this->source.getHistory().getSince(this->filter.getTimestamp(),
+							  poses, PoseHistory::CAPACITY);
+    for(unsigned i = 0; i < count; i++ )
+	this->filter.update(poses[i]);
+
+    this->valid = this->filter.predict(time, this->pose);
+    if( this->valid )
+	this->record(time);
+}
+
+};
@@ -0,0 +1,102 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_PREDICTEDTRACKEDOBJECT_H
+#define WCL_TRACKING_PREDICTEDTRACKEDOBJECT_H
+
+#include <stdint.h>
+#include <string>
+
+#include <wcl/api.h>
+#include <wcl/maths/Quaternion.h>
+#include <wcl/maths/SMatrix.h>
+#include <wcl/maths/Vector.h>
+#include <wcl/tracking/PoseFilter.h>
+#include <wcl/tracking/TrackedObject.h>
+
+namespace wcl
+{
+	class PredictiveTracker;
+
+	/**
+	 * An object of the tracker wrapped by a PredictiveTracker. Its pose
+	 * is the filtered pose of the original object, predicted ahead by
+	 * the tracker's latency.
+	 */
+	class WCL_API PredictedTrackedObject : public TrackedObject
+	{
+		friend class PredictiveTracker;
+
+		public:
+			PredictedTrackedObject(TrackedObject &source);
+			virtual ~PredictedTrackedObject(){}
+
+			virtual std::string toString() const;
+			virtual SMatrix getTransform() const;
+			virtual Vector getTranslation() const;
+			virtual Quaternion getOrientation() const;
+			virtual bool isVisible() const;
+			virtual float getConfidence() const;
+
+			/**
+			 * Predict the pose a time from now, for example when the
+			 * frame being rendered will reach the display.
+			 *
+			 * @param dt The time ahead in seconds
+			 * @param pose Set to the predicted pose
+			 * @return false if the object hasn't been seen yet
+			 */
+			bool predict(const T dt, PoseHistory::Pose &pose) const;
+
+			/**
+			 * Predict the pose at a point in time
+			 *
+			 * @param time Microseconds since the epoch
+			 */
+			bool predictAt(const uint64_t time, PoseHistory::Pose &pose) const;
+
+			/**
+			 * The object being predicted
+			 */
+			TrackedObject &getSource();
+
+			PoseFilter &getFilter();
+
+		private:
+			/**
+			 * Filter the source's new poses and predict the pose
+			 * at time
+			 */
+			void update(const uint64_t time);
+
+			TrackedObject &source;
+			PoseFilter filter;
+			PoseHistory::Pose pose;
+			bool valid;
+	};
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <wcl/tracking/PredictiveTracker.h>
+
+namespace wcl
+{
+
+PredictiveTracker::PredictiveTracker(Tracker &source, const T latency) :
+    source(source),
+    latency(latency),
+    alpha(PoseFilter::DEFAULT_ALPHA),
+    beta(PoseFilter::DEFAULT_BETA)
+{
+}
+
+PredictiveTracker::~PredictiveTracker()
+{
+    for(std::vector<PredictedTrackedObject *>::iterator it = this->objectList.begin();
+	it != this->objectList.end();
+	++it )
+	delete *it;
+}
+
+PredictedTrackedObject *PredictiveTracker::wrap(TrackedObject *object)
+{
+    ObjectMap::iterator it = this->objects.find(object);
+    if( it != this->objects.end())
+	return it->second;
+
+    PredictedTrackedObject *p = new PredictedTrackedObject(*object);
+    p->getFilter().setGains(this->alpha, this->beta);
+    this->objects[object] = p;
+    this->objectList.push_back(p);
+    return p;
+}
+
+void PredictiveTracker::update()
+{
+    this->source.update();
+
+    uint64_t time = getCurrentTime() + (int64_t)(this->latency * 1e6);
+    unsigned count = this->source.getObjectCount();
+    for(unsigned i = 0; i < count; i++ ){
+	TrackedObject *object = this->source.getObjectAt(i);
+	if( object )
+	    this->wrap(object)->update(time);
+    }
+}
+
+TrackedObject *PredictiveTracker::getObject(std::string name)
+{
+    TrackedObject *object = this->source.getObject(name);
+    return object ? this->wrap(object) : NULL;
+}
+
+std::vector<TrackedObject *> PredictiveTracker::getAllObjects()
+{
+    return std::vector<TrackedObject *>(this->objectList.begin(), this->objectList.end());
+}
+
+unsigned PredictiveTracker::getObjectCount()
+{
+    return this->objectList.size();
+}
+
+TrackedObject *PredictiveTracker::getObjectAt(const unsigned index)
+{
+    return index < this->objectList.size() ? this->objectList[index] : NULL;
+}
+
+void PredictiveTracker::setUnits(Units u)
+{
+    this->source.setUnits(u);
+    for(std::vector<PredictedTrackedObject *>::iterator it = this->objectList.begin();
+	it != this->objectList.end();
+	++it )
+	(*it)->getFilter().reset();
+}
+
+void PredictiveTracker::setLatency(const T latency)
+{
+    this->latency = latency;
+}
+
+T PredictiveTracker::getLatency() const
+{
+    return this->latency;
+}
+
+void PredictiveTracker::setGains(const T alpha, const T beta)
+{
+    this->alpha = alpha;
+    this->beta = beta;
+    for(std::vector<PredictedTrackedObject *>::iterator it = this->objectList.begin();
+	it != this->objectList.end();
+	++it )
+	(*it)->getFilter().setGains(alpha, beta);
+}
+
+Tracker &PredictiveTracker::getSource()
+{
+    return this->source;
+}
+
+};
@@ -0,0 +1,116 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_PREDICTIVETRACKER_H
+#define WCL_TRACKING_PREDICTIVETRACKER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/tracking/PredictedTrackedObject.h>
+#include <wcl/tracking/Tracker.h>
+
+namespace wcl
+{
+	/**
+	 * Wraps another tracker and predicts its objects ahead in time, to
+	 * hide the latency between a tracker sample and the frame showing it
+	 * reaching the display.
+	 *
+	 * Each update filters every new pose of the wrapped tracker's objects
+	 * with a PoseFilter and sets the objects here to the pose predicted
+	 * for now plus the latency. Renderers that know more precisely when a
+	 * frame will be displayed can ask an object for its pose at that
+	 * time with predict.
+	 *
+	 * The wrapped tracker must outlive this one and shouldn't be updated
+	 * by anything else.
+	 */
+	class WCL_API PredictiveTracker : public Tracker
+	{
+		public:
+			/**
+			 * @param source The tracker to predict
+			 * @param latency How far ahead to predict, in seconds
+			 */
+			PredictiveTracker(Tracker &source, const T latency = 0);
+			~PredictiveTracker();
+
+			/**
+			 * Update the wrapped tracker, then filter and predict
+			 * its objects.
+			 */
+			virtual void update();
+
+			virtual TrackedObject* getObject(std::string name);
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+
+			/**
+			 * Set the units of the wrapped tracker. The filters
+			 * restart as the old estimates are in the old units.
+			 */
+			virtual void setUnits(Units u);
+
+			/**
+			 * Set how far ahead update predicts
+			 *
+			 * @param latency The time in seconds
+			 */
+			void setLatency(const T latency);
+			T getLatency() const;
+
+			/**
+			 * Set the filter gains of every object, now and in future.
+			 *
+			 * @see PoseFilter
+			 */
+			void setGains(const T alpha, const T beta);
+
+			Tracker &getSource();
+
+		private:
+			typedef std::map<TrackedObject *, PredictedTrackedObject *> ObjectMap;
+
+			Tracker &source;
+			T latency;
+			T alpha;
+			T beta;
+
+			ObjectMap objects;
+			std::vector<PredictedTrackedObject *> objectList;
+
+			PredictedTrackedObject *wrap(TrackedObject *object);
+
+			PredictiveTracker(const PredictiveTracker &);
+			PredictiveTracker &operator =(const PredictiveTracker &);
+	};
+};
+
+#endif
@@ -0,0 +1,85 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <wcl/tracking/ReplayTrackedObject.h>
+
+namespace wcl
+{
+
+ReplayTrackedObject::ReplayTrackedObject(const std::string &iname, const ObjectType itype):
+    translation(3), orientation(1, 0, 0, 0), visible(false)
+{
+    this->name = iname;
+    this->type = itype;
+}
+
+std::string ReplayTrackedObject::toString() const
+{
+    return "ReplayTrackedObject '" + this->name + "'";
+}
+
+SMatrix ReplayTrackedObject::getTransform() const
+{
+    SMatrix T(4);
+    T[0][0] = 1;
+    T[1][1] = 1;
+    T[2][2] = 1;
+    T[3][3] = 1;
+
+    T[0][3] = this->translation[0];
+    T[1][3] = this->translation[1];
+    T[2][3] = this->translation[2];
+
+    return T * this->orientation.getRotation();
+}
+
+Vector ReplayTrackedObject::getTranslation() const
+{
+    return this->translation;
+}
+
+Quaternion ReplayTrackedObject::getOrientation() const
+{
+    return this->orientation;
+}
+
+bool ReplayTrackedObject::isVisible() const
+{
+    return this->visible;
+}
+
+void ReplayTrackedObject::setData(const bool ivisible, const float iconfidence,
+				  const double *position, const double *iorientation,
+				  const double scale)
+{
+    this->visible = ivisible;
+    this->confidence = iconfidence;
+    for(unsigned i = 0; i < 3; i++ )
+	this->translation[i] = position[i] * scale;
+    this->orientation.set(iorientation[0], iorientation[1], iorientation[2], iorientation[3]);
+}
+
+};
@@ -0,0 +1,272 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <wcl/tracking/ReplayTracker.h>
+#include <wcl/tracking/TrackerRecording.h>
+
+namespace wcl
+{
+
+using namespace TrackerRecording;
+
+/**
+ * Millimetres per unit, or 0 if the units are unknown
+ */
+static double getUnitLength(const int units)
+{
+    if( units < Tracker::INCHES || units > Tracker::MM )
+	return 0;
+    return Tracker::getMillimetres((Tracker::Units)units);
+}
+
+ReplayTracker::ReplayTracker(const std::string &path, const Mode mode) throw (Exception) :
+    data(NULL),
+    size(0),
+    mode(mode),
+    loop(false),
+    units(-1),
+    position(0),
+    started(false),
+    start(0),
+    base(0),
+    offset(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if( fd < 0 )
+	throw Exception("ReplayTracker: Could not open the recording");
+
+    struct stat st;
+    if( fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(FileHeader)){
+	close(fd);
+	throw Exception("ReplayTracker: Not a tracker recording");
+    }
+
+    this->size = st.st_size;
+    void *map = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if( map == MAP_FAILED )
+	throw Exception("ReplayTracker: Could not map the recording");
+    this->data = (unsigned char *)map;
+
+    try {
+	this->index();
+    } catch( Exception & ){
+	for(unsigned i = 0; i < this->objects.size(); i++ )
+	    delete this->objects[i];
+	munmap(this->data, this->size);
+	throw;
+    }
+}
+
+ReplayTracker::~ReplayTracker()
+{
+    for(unsigned i = 0; i < this->objects.size(); i++ )
+	delete this->objects[i];
+    munmap(this->data, this->size);
+}
+
+void ReplayTracker::index()
+{
+    const FileHeader *h = (const FileHeader *)this->data;
+    if( h->magic != MAGIC )
+	throw Exception("ReplayTracker: Not a tracker recording");
+    if( h->byteOrder != ENDIAN_MARK )
+	throw Exception("ReplayTracker: The recording was made on a host of different byte order");
+    if( h->version != FORMAT_VERSION || h->headerSize < sizeof(FileHeader))
+	throw Exception("ReplayTracker: Unsupported recording version");
+
+    // A recording that was cut short ends at the last whole record
+    size_t offset = align(h->headerSize);
+    while( offset + sizeof(RecordHeader) <= this->size ){
+	const RecordHeader *r = (const RecordHeader *)(this->data + offset);
+	if( r->size < sizeof(RecordHeader) || r->size % 8 != 0 || r->size > this->size - offset )
+	    break;
+
+	if( r->type == OBJECT ){
+	    const ObjectRecord *o = (const ObjectRecord *)r;
+	    if( r->size <= sizeof(ObjectRecord) || o->id != this->objects.size())
+		throw Exception("ReplayTracker: Corrupt object in the recording");
+
+	    const char *name = (const char *)(o + 1);
+	    std::string n(name, strnlen(name, r->size - sizeof(ObjectRecord)));
+	    ReplayTrackedObject *t = new ReplayTrackedObject(n, (ObjectType)o->type);
+	    this->objects.push_back(t);
+	    this->names[n] = t;
+	} else if( r->type == FRAME ){
+	    const FrameRecord *f = (const FrameRecord *)r;
+	    if( r->size < sizeof(FrameRecord) ||
+		r->size < sizeof(FrameRecord) + (uint64_t)f->count * sizeof(ObjectState))
+		throw Exception("ReplayTracker: Corrupt frame in the recording");
+
+	    const ObjectState *states = (const ObjectState *)(f + 1);
+	    for(unsigned i = 0; i < f->count; i++ )
+		if( states[i].id >= this->objects.size())
+		    throw Exception("ReplayTracker: Frame refers to an unknown object");
+	    this->frames.push_back(offset);
+	}
+	// Skip records from newer recorders
+
+	offset += r->size;
+    }
+}
+
+uint64_t ReplayTracker::getFrameTime(const unsigned frame) const
+{
+    return ((const FrameRecord *)(this->data + this->frames[frame]))->timestamp;
+}
+
+void ReplayTracker::apply(const unsigned frame, const uint64_t timestamp)
+{
+    const FrameRecord *f = (const FrameRecord *)(this->data + this->frames[frame]);
+
+    double scale = 1;
+    double from = getUnitLength(f->units);
+    double to = getUnitLength(this->units);
+    if( from > 0 && to > 0 )
+	scale = from / to;
+
+    const ObjectState *states = (const ObjectState *)(f + 1);
+    for(unsigned i = 0; i < f->count; i++ ){
+	const ObjectState &s = states[i];
+	this->objects[s.id]->setData(s.flags & VISIBLE, s.confidence, s.position,
+				     s.orientation, scale);
+    }
+
+    this->recordPoses(timestamp);
+}
+
+void ReplayTracker::update()
+{
+    if( this->frames.empty())
+	return;
+
+    if( this->position >= this->frames.size()){
+	if( !this->loop )
+	    return;
+	this->offset += this->getDuration() + 1;
+	this->rewind();
+    }
+
+    if( this->mode == AS_FAST_AS_POSSIBLE ){
+	this->apply(this->position, this->getFrameTime(this->position) + this->offset);
+	this->position++;
+	return;
+    }
+
+    uint64_t now = getCurrentTime();
+    if( !this->started ){
+	this->started = true;
+	this->start = now;
+	this->base = this->getFrameTime(this->position);
+    }
+
+    // Apply every frame that has come due, moved to the current clock
+    while( this->position < this->frames.size()){
+	uint64_t due = this->start + (this->getFrameTime(this->position) - this->base);
+	if( due > now )
+	    break;
+	this->apply(this->position, due);
+	this->position++;
+    }
+}
+
+TrackedObject *ReplayTracker::getObject(std::string name)
+{
+    std::map<std::string, ReplayTrackedObject *>::iterator it = this->names.find(name);
+    return it == this->names.end() ? NULL : it->second;
+}
+
+std::vector<TrackedObject *> ReplayTracker::getAllObjects()
+{
+    return std::vector<TrackedObject *>(this->objects.begin(), this->objects.end());
+}
+
+unsigned ReplayTracker::getObjectCount()
+{
+    return this->objects.size();
+}
+
+TrackedObject *ReplayTracker::getObjectAt(const unsigned index)
+{
+    return index < this->objects.size() ? this->objects[index] : NULL;
+}
+
+void ReplayTracker::setUnits(Units u)
+{
+    this->units = u;
+}
+
+void ReplayTracker::setMode(const Mode mode)
+{
+    this->mode = mode;
+    this->started = false;
+}
+
+ReplayTracker::Mode ReplayTracker::getMode() const
+{
+    return this->mode;
+}
+
+void ReplayTracker::setLoop(const bool loop)
+{
+    this->loop = loop;
+}
+
+void ReplayTracker::rewind()
+{
+    this->position = 0;
+    this->started = false;
+}
+
+bool ReplayTracker::isFinished() const
+{
+    return this->position >= this->frames.size();
+}
+
+unsigned ReplayTracker::getFrameCount() const
+{
+    return this->frames.size();
+}
+
+unsigned ReplayTracker::getPosition() const
+{
+    return this->position;
+}
+
+uint64_t ReplayTracker::getDuration() const
+{
+    if( this->frames.empty())
+	return 0;
+    return this->getFrameTime(this->frames.size() - 1) - this->getFrameTime(0);
+}
+
+};
@@ -0,0 +1,167 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_REPLAYTRACKER_H
+#define WCL_TRACKING_REPLAYTRACKER_H
+
+#include <map>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+#include <wcl/tracking/ReplayTrackedObject.h>
+#include <wcl/tracking/Tracker.h>
+
+namespace wcl
+{
+	/**
+	 * Plays back a recording made by a TrackerRecorder, so code that
+	 * needs a tracker can be run and profiled without the hardware.
+	 *
+	 * The recording is memory mapped and indexed when opened, after
+	 * which update reads frames in place and doesn't allocate. Every
+	 * object in the recording exists from the start, invisible until the
+	 * first frame it appears in.
+	 */
+	class WCL_API ReplayTracker : public Tracker
+	{
+		public:
+			enum Mode
+			{
+				/**
+				 * Frames are played at the rate they were recorded.
+				 * update applies every frame that has come due and
+				 * doesn't wait. Timestamps are moved to the current
+				 * time, so prediction and history queries work as
+				 * they would live.
+				 */
+				REAL_TIME,
+
+				/**
+				 * Each update applies the next frame, keeping the
+				 * recorded timestamps
+				 */
+				AS_FAST_AS_POSSIBLE
+			};
+
+			/**
+			 * @param path The recording to play
+			 * @throw Exception if the file isn't a recording
+			 */
+			ReplayTracker(const std::string &path, const Mode mode = REAL_TIME) throw (Exception);
+			~ReplayTracker();
+
+			virtual void update();
+
+			virtual TrackedObject* getObject(std::string name);
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+
+			/**
+			 * Convert positions to these units. Recordings made
+			 * without setting units are played as recorded.
+			 */
+			virtual void setUnits(Units u);
+
+			void setMode(const Mode mode);
+			Mode getMode() const;
+
+			/**
+			 * Start again from the first frame after the last
+			 */
+			void setLoop(const bool loop);
+
+			/**
+			 * Go back to the first frame
+			 */
+			void rewind();
+
+			/**
+			 * Whether every frame has been played
+			 */
+			bool isFinished() const;
+
+			/**
+			 * The number of frames in the recording
+			 */
+			unsigned getFrameCount() const;
+
+			/**
+			 * The index of the next frame update will apply
+			 */
+			unsigned getPosition() const;
+
+			/**
+			 * The time from the first frame to the last, in
+			 * microseconds
+			 */
+			uint64_t getDuration() const;
+
+		private:
+			unsigned char *data;
+			size_t size;
+
+			std::vector<ReplayTrackedObject *> objects;
+			std::map<std::string, ReplayTrackedObject *> names;
+
+			/**
+			 * Offsets of the frame records
+			 */
+			std::vector<size_t> frames;
+
+			Mode mode;
+			bool loop;
+			int units;
+			unsigned position;
+
+			/**
+			 * In REAL_TIME, when playing started and the recorded
+			 * time of the frame it started at
+			 */
+			bool started;
+			uint64_t start;
+			uint64_t base;
+
+			/**
+			 * Added to recorded timestamps so they keep increasing
+			 * when AS_FAST_AS_POSSIBLE loops
+			 */
+			uint64_t offset;
+
+			void index();
+			uint64_t getFrameTime(const unsigned frame) const;
+			void apply(const unsigned frame, const uint64_t timestamp);
+
+			ReplayTracker(const ReplayTracker &);
+			ReplayTracker &operator =(const ReplayTracker &);
+	};
+};
+
+#endif
@@ -0,0 +1,179 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <wcl/tracking/SharedMemoryTracker.h>
+#include <wcl/util/SharedMemoryRing.h>
+#include "TrackerPacket.h"
+#include "TrackerPacketObjects.h"
+
+namespace wcl
+{
+
+using namespace TrackerPacket;
+
+/**
+ * Checks the snapshot being read hasn't been overwritten
+ */
+class RingValidator : public Validator
+{
+    public:
+	RingValidator(SharedMemoryRing *iring, const uint64_t iposition):
+	    ring(iring), position(iposition)
+	{
+	}
+
+	virtual bool isValid()
+	{
+	    return this->ring->isValid(this->position);
+	}
+
+    private:
+	SharedMemoryRing *ring;
+	uint64_t position;
+};
+
+SharedMemoryTracker::SharedMemoryTracker(const std::string &iname) throw (Exception):
+    name(iname), ring(NULL), position(0), table(new ObjectTable()), units(MM), timeout(0),
+    sequence(0), timestamp(0), skippedUpdates(0)
+{
+    this->ring = new SharedMemoryRing(this->name);
+}
+
+SharedMemoryTracker::~SharedMemoryTracker()
+{
+    delete this->table;
+    delete this->ring;
+}
+
+void SharedMemoryTracker::update()
+{
+    if( this->ring == NULL ){
+	try {
+	    this->ring = new SharedMemoryRing(this->name);
+	    this->position = 0;
+	} catch( Exception & ){
+	    return;
+	}
+    }
+
+    if( !this->ring->wait(this->position, this->timeout)){
+	// Let go of the old ring so the next publisher can be found
+	if( this->ring->isClosed()){
+	    delete this->ring;
+	    this->ring = NULL;
+	}
+	return;
+    }
+
+    // Try again if the publisher overwrote the snapshot while it was read
+    while( !this->apply())
+	;
+}
+
+/**
+ * Apply the newest snapshot in the ring
+ *
+ * @return false if the snapshot was overwritten while applying it
+ */
+bool SharedMemoryTracker::apply()
+{
+    uint64_t latest;
+    size_t length;
+    const unsigned char *data = this->ring->read(latest, length);
+    if( data == NULL )
+	return true;
+
+    WireReader r(data, length);
+    Header h;
+    if( !readHeader(r, h)){
+	if( !this->ring->isValid(latest))
+	    return false;
+	this->position = latest;
+	return true;
+    }
+
+    RingValidator validator(this->ring, latest);
+    if( !this->table->apply(r, h.count, getUnitScale(this->units), &validator))
+	return false;
+
+    if( !this->ring->isValid(latest))
+	return false;
+
+    if( this->position > 0 && latest > this->position + 1 )
+	this->skippedUpdates += latest - this->position - 1;
+    this->position = latest;
+    this->sequence = h.sequence;
+    this->timestamp = h.timestamp;
+    this->recordPoses(h.timestamp);
+    return true;
+}
+
+TrackedObject* SharedMemoryTracker::getObject(std::string name)
+{
+    return this->table->getObject(name);
+}
+
+std::vector<TrackedObject *> SharedMemoryTracker::getAllObjects()
+{
+    return this->table->getAllObjects();
+}
+
+unsigned SharedMemoryTracker::getObjectCount()
+{
+    return this->table->getObjectCount();
+}
+
+TrackedObject *SharedMemoryTracker::getObjectAt(const unsigned index)
+{
+    return this->table->getObjectAt(index);
+}
+
+void SharedMemoryTracker::setUnits(Units u)
+{
+    this->units = u;
+}
+
+void SharedMemoryTracker::setTimeout(const int itimeout)
+{
+    this->timeout = itimeout;
+}
+
+uint32_t SharedMemoryTracker::getSequence() const
+{
+    return this->sequence;
+}
+
+uint64_t SharedMemoryTracker::getTimestamp() const
+{
+    return this->timestamp;
+}
+
+unsigned SharedMemoryTracker::getSkippedUpdates() const
+{
+    return this->skippedUpdates;
+}
+
+};
@@ -0,0 +1,119 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_TRACKING_SHAREDMEMORYTRACKER_H
+#define WCL_TRACKING_SHAREDMEMORYTRACKER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+#include <wcl/tracking/Tracker.h>
+
+namespace wcl
+{
+	class SharedMemoryRing;
+	namespace TrackerPacket { class ObjectTable; }
+
+	/**
+	 * Follows a tracker published by a SharedMemoryTrackerPublisher in
+	 * another process on the same machine.
+	 *
+	 * Snapshots are parsed where they lie in the shared memory. update
+	 * always applies the newest snapshot, older ones it never saw are
+	 * counted as skipped. If the publisher goes away the objects keep
+	 * their last state and update attaches to the next publisher of the
+	 * same name.
+	 */
+	class WCL_API SharedMemoryTracker : public Tracker
+	{
+		public:
+			/**
+			 * @param name The name the tracker was published with
+			 * @throw Exception if there is no such tracker
+			 */
+			SharedMemoryTracker(const std::string &name) throw (Exception);
+			~SharedMemoryTracker();
+
+			/**
+			 * Apply the newest snapshot. If nothing new has been
+			 * published this waits up to the timeout.
+			 */
+			virtual void update();
+
+			virtual TrackedObject* getObject(std::string name);
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+			virtual void setUnits(Units u);
+
+			/**
+			 * Set how long update waits for a snapshot
+			 *
+			 * @param timeout The time in milliseconds, 0 to return
+			 *                immediately or -1 to wait forever
+			 */
+			void setTimeout(const int timeout);
+
+			/**
+			 * The sequence number of the last update applied
+			 */
+			uint32_t getSequence() const;
+
+			/**
+			 * When the last update applied was published, in
+			 * microseconds since the epoch
+			 */
+			uint64_t getTimestamp() const;
+
+			/**
+			 * The number of updates published that were never applied
+			 */
+			unsigned getSkippedUpdates() const;
+
+		private:
+			std::string name;
+			SharedMemoryRing *ring;
+			uint64_t position;
+
+			TrackerPacket::ObjectTable *table;
+
+			Units units;
+			int timeout;
+
+			uint32_t sequence;
+			uint64_t timestamp;
+			unsigned skippedUpdates;
+
+			bool apply();
+
+			SharedMemoryTracker(const SharedMemoryTracker &);
+			SharedMemoryTracker &operator =(const SharedMemoryTracker &);
+	};
+};
+
+#endif
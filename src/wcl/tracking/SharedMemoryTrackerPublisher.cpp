@@ -0,0 +1,152 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include <wcl/IO.h>
+#include <wcl/tracking/SharedMemoryTrackerPublisher.h>
+#include <wcl/util/SharedMemoryRing.h>
+#include "TrackerPacket.h"
+
+using namespace std;
+
+namespace wcl
+{
+
+using namespace TrackerPacket;
+
+/**
+ * Updates and publishes the tracker until stopped
+ */
+class SharedMemoryTrackerPublisher::PublisherThread: public Thread
+{
+    public:
+	PublisherThread(SharedMemoryTrackerPublisher *ipublisher): publisher(ipublisher) {}
+
+    protected:
+	void run()
+	{
+	    while( this->publisher->running ){
+		try {
+		    this->publisher->update();
+		} catch( Exception &e ){
+		    wclclog << "SharedMemoryTrackerPublisher: Stopping, " << e.what() << endl;
+		    this->publisher->running = false;
+		}
+	    }
+	}
+
+    private:
+	SharedMemoryTrackerPublisher *publisher;
+};
+
+SharedMemoryTrackerPublisher::SharedMemoryTrackerPublisher(Tracker *itracker, const std::string &iname,
+							   const unsigned slots, const size_t slotSize,
+							   const mode_t mode) throw (Exception):
+    tracker(itracker), name(iname), ring(NULL), sequence(0), running(false), thread(NULL)
+{
+    this->ring = new SharedMemoryRing(this->name, slots, slotSize, mode);
+    this->tracker->setUnits(Tracker::MM);
+}
+
+SharedMemoryTrackerPublisher::~SharedMemoryTrackerPublisher()
+{
+    this->stop();
+    delete this->ring;
+}
+
+void SharedMemoryTrackerPublisher::publish()
+{
+    unsigned objects = this->tracker->getObjectCount();
+    if( objects > MAX_OBJECTS )
+	objects = MAX_OBJECTS;
+
+    Header h;
+    h.part = 0;
+    h.parts = 1;
+    h.sequence = this->sequence + 1;
+    h.timestamp = Tracker::getCurrentTime();
+    h.count = objects;
+
+    this->buffer.clear();
+    WireWriter w(this->buffer);
+    writeHeader(w, h);
+
+    // Readers may skip slots, so every object carries its name
+    Object o;
+    std::string name;
+    for(unsigned i = 0; i < objects; i++ ){
+	TrackedObject *t = this->tracker->getObjectAt(i);
+	fromTrackedObject(i, t, o);
+	name = t->getName();
+	writeObject(w, o, &name);
+    }
+
+    if( this->buffer.size() > this->ring->getSlotSize()){
+	wclclog << "SharedMemoryTrackerPublisher: Too many objects to publish in " << this->name << endl;
+	return;
+    }
+
+    this->ring->write(&this->buffer[0], this->buffer.size());
+    this->sequence = h.sequence;
+}
+
+void SharedMemoryTrackerPublisher::update()
+{
+    this->tracker->update();
+    this->publish();
+}
+
+void SharedMemoryTrackerPublisher::start()
+{
+    if( this->running )
+	return;
+
+    this->running = true;
+    this->thread = new PublisherThread(this);
+    this->thread->start();
+}
+
+void SharedMemoryTrackerPublisher::stop()
+{
+    this->running = false;
+    if( this->thread ){
+	this->thread->join();
+	delete this->thread;
+	this->thread = NULL;
+    }
+}
+
+bool SharedMemoryTrackerPublisher::isRunning() const
+{
+    return this->running;
+}
+
+uint32_t SharedMemoryTrackerPublisher::getSequence() const
+{
+    return this->sequence;
+}
+
+};
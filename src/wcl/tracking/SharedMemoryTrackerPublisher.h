@@ -0,0 +1,114 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_TRACKING_SHAREDMEMORYTRACKERPUBLISHER_H
+#define WCL_TRACKING_SHAREDMEMORYTRACKERPUBLISHER_H
+
+#include <stdint.h>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+#include <wcl/tracking/Tracker.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+	class SharedMemoryRing;
+
+	/**
+	 * Publishes the state of a tracker through shared memory so any number
+	 * of SharedMemoryTrackers in other processes on the same machine can
+	 * follow it.
+	 *
+	 * Each publish writes one snapshot of every object of the tracker, in
+	 * the same format TrackerPublisher multicasts. Positions are published
+	 * in mm, so the publisher sets the units of the tracker to MM.
+	 */
+	class WCL_API SharedMemoryTrackerPublisher
+	{
+		public:
+			static const unsigned DEFAULT_SLOTS = 8;
+			static const size_t DEFAULT_SLOT_SIZE = 65536;
+
+			/**
+			 * @param tracker The tracker to publish, not owned by the publisher
+			 * @param name The name readers attach with
+			 * @param slots The number of snapshots in the ring
+			 * @param slotSize The largest snapshot, about 40 bytes
+			 *                 per object plus the object names
+			 * @param mode The permissions of the shared memory, only
+			 *             the current user can attach by default
+			 * @throw Exception if the shared memory can't be created
+			 */
+			SharedMemoryTrackerPublisher(Tracker *tracker, const std::string &name,
+						     const unsigned slots = DEFAULT_SLOTS,
+						     const size_t slotSize = DEFAULT_SLOT_SIZE,
+						     const mode_t mode = 0600) throw (Exception);
+			~SharedMemoryTrackerPublisher();
+
+			/**
+			 * Publish the current state of the tracker without updating it
+			 */
+			void publish();
+
+			/**
+			 * Update the tracker and publish the result
+			 */
+			void update();
+
+			/**
+			 * Call update continuously from a background thread
+			 */
+			void start();
+			void stop();
+			bool isRunning() const;
+
+			/**
+			 * The sequence number of the last update published
+			 */
+			uint32_t getSequence() const;
+
+		private:
+			class PublisherThread;
+			friend class PublisherThread;
+
+			Tracker *tracker;
+			std::string name;
+			SharedMemoryRing *ring;
+			uint32_t sequence;
+			std::vector<unsigned char> buffer;
+
+			volatile bool running;
+			PublisherThread *thread;
+
+			SharedMemoryTrackerPublisher(const SharedMemoryTrackerPublisher &);
+			SharedMemoryTrackerPublisher &operator =(const SharedMemoryTrackerPublisher &);
+	};
+};
+
+#endif
@@ -27,6 +27,7 @@
 #ifndef WCL_TRACKING_TRACKEDOBJECT_H
 #define WCL_TRACKING_TRACKEDOBJECT_H
 
+#include <stdint.h>
 #include <string>
 
 #include <wcl/api.h>
@@ -34,6 +35,7 @@
 #include <wcl/maths/Quaternion.h>
 #include <wcl/maths/SMatrix.h>
 #include <wcl/maths/Vector.h>
+#include <wcl/tracking/PoseHistory.h>
 
 namespace wcl
 {
@@ -60,12 +62,18 @@ namespace wcl
 		SIX_DOF
 	};
 
+	class Tracker;
+
 	/**
 	 * Represents an object that can be tracked by the Vicon system.
 	 *
+	 * Every time its tracker updates, a visible object's pose is added to
+	 * its history, so the pose at other times can be found with getPoseAt.
 	 */
 	class WCL_API TrackedObject
 	{
+		friend class Tracker;
+
 		public:
 			/**
 			 * Destructor.
@@ -97,6 +105,31 @@ namespace wcl
 
 			virtual float getConfidence() const {return confidence;}
 
+			/**
+			 * When the object was last seen, in microseconds since
+			 * the epoch, or 0 if it never has been.
+			 */
+			uint64_t getTimestamp() const { return history.getLatestTime(); }
+
+			/**
+			 * Find the pose of the object at a point in time. This
+			 * doesn't allocate and may be called from any thread.
+			 *
+			 * @param time The time in microseconds since the epoch
+			 * @param pose Set to the pose at that time
+			 * @return false if the object's history doesn't cover the time
+			 */
+			bool getPoseAt(const uint64_t time, PoseHistory::Pose &pose) const
+			{
+				return history.getPoseAt(time, pose);
+			}
+
+			/**
+			 * The recent poses of the object.
+			 */
+			PoseHistory &getHistory() { return history; }
+			const PoseHistory &getHistory() const { return history; }
+
 		protected:
 			TrackedObject():
 			    confidence(0.0){};
@@ -112,6 +145,19 @@ namespace wcl
 			ObjectType type;
 
 			float confidence;
+
+			/**
+			 * Add the current pose to the history if the object
+			 * is visible. Called by the tracker after each update.
+			 */
+			void record(const uint64_t timestamp)
+			{
+				if (isVisible())
+					history.push(timestamp, getTranslation(), getOrientation());
+			}
+
+		private:
+			PoseHistory history;
 	};
 
 };
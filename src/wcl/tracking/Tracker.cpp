@@ -0,0 +1,155 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <sys/time.h>
+#include <time.h>
+
+#include <wcl/Exception.h>
+#include <wcl/tracking/Tracker.h>
+
+namespace wcl
+{
+
+Tracker::ObjectHandle Tracker::getHandle(const std::string &name)
+{
+	std::map<std::string, ObjectHandle>::iterator it = handleNames.find(name);
+	if (it != handleNames.end())
+		return it->second;
+
+	ObjectHandle handle = intern(name);
+	resolve(handle);
+	return handle;
+}
+
+unsigned Tracker::getObjectCount()
+{
+	std::vector<TrackedObject *> objects = getAllObjects();
+
+	listed.clear();
+	for (std::vector<TrackedObject *>::iterator it = objects.begin(); it != objects.end(); ++it)
+	{
+		if (*it == NULL)
+			continue;
+		ObjectHandle handle = intern((*it)->getName());
+		handles[handle].object = *it;
+		handles[handle].missed = false;
+		listed.push_back(handle);
+	}
+	return listed.size();
+}
+
+TrackedObject *Tracker::getObjectAt(const unsigned index)
+{
+	if (index >= listed.size())
+		return NULL;
+	return handles[listed[index]].object;
+}
+
+/**
+ * Add a name to the handles without looking it up
+ */
+Tracker::ObjectHandle Tracker::intern(const std::string &name)
+{
+	std::map<std::string, ObjectHandle>::iterator it = handleNames.find(name);
+	if (it != handleNames.end())
+		return it->second;
+
+	Handle h;
+	h.name = name;
+	h.object = NULL;
+	h.generation = 0;
+	h.missed = false;
+	ObjectHandle handle = handles.size();
+	handles.push_back(h);
+	handleNames[name] = handle;
+	return handle;
+}
+
+/**
+ * Look the object of a handle up by name, until the tracker has it. A
+ * name that wasn't found is only looked up again once objects are added.
+ */
+TrackedObject *Tracker::resolve(const ObjectHandle handle)
+{
+	Handle &h = handles[handle];
+	unsigned generation = getObjectCount();
+	if (h.missed && h.generation == generation)
+		return NULL;
+
+	try
+	{
+		h.object = getObject(h.name);
+	}
+	catch (Exception &)
+	{
+		// Some trackers throw for names they don't know
+		h.object = NULL;
+	}
+	h.generation = generation;
+	h.missed = h.object == NULL;
+	return h.object;
+}
+
+uint64_t Tracker::getCurrentTime()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+uint64_t Tracker::getMonotonicTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+double Tracker::getMillimetres(const Units units)
+{
+	switch (units)
+	{
+		case INCHES:
+			return 25.4;
+		case CM:
+			return 10;
+		case MM:
+			return 1;
+	}
+	return 0;
+}
+
+void Tracker::recordPoses(const uint64_t timestamp)
+{
+	unsigned count = getObjectCount();
+	for (unsigned i = 0; i < count; i++)
+	{
+		TrackedObject *object = getObjectAt(i);
+		if (object)
+			object->record(timestamp);
+	}
+}
+
+}
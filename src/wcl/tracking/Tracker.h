@@ -28,6 +28,9 @@
 #ifndef WCL_TRACKING_TRACKER_H
 #define WCL_TRACKING_TRACKER_H
 
+#include <map>
+#include <stdint.h>
+#include <string>
 #include <vector>
 
 #include <wcl/api.h>
@@ -40,10 +43,23 @@ namespace wcl
 	 * Abstract Base Class that Trackers should extend.
 	 * Provides (as best possible) a unified interface for all
 	 * tracker types.
+	 *
+	 * Objects that are looked up every frame should be found through a
+	 * handle rather than by name. The name is resolved once, by
+	 * getHandle, after which get finds the object in constant time.
+	 * Trackers keep their objects for as long as the tracker exists, so
+	 * a resolved handle stays valid, and only ever add objects, so a
+	 * name not found is only looked up again once getObjectCount has
+	 * changed.
 	 */
 	class WCL_API Tracker
 	{
 		public:
+			/**
+			 * An interned object name, only meaningful to the
+			 * tracker that issued it.
+			 */
+			typedef unsigned ObjectHandle;
 			/**
 			 * The units to receive values in.
 			 */
@@ -71,6 +87,39 @@ namespace wcl
 			Tracker(){}
 			virtual ~Tracker(){}
 
+			/**
+			 * Intern an object name for use with get. The object
+			 * need not exist yet, get returns NULL until the tracker
+			 * has seen it.
+			 *
+			 * @param name The name as given to getObject
+			 * @return The handle, the same for every call with the same name
+			 */
+			ObjectHandle getHandle(const std::string &name);
+
+			/**
+			 * Obtain the object for a handle in constant time
+			 *
+			 * @return The object, or NULL if the tracker hasn't seen it
+			 */
+			TrackedObject *get(const ObjectHandle handle)
+			{
+				if (handle >= handles.size())
+					return NULL;
+				TrackedObject *object = handles[handle].object;
+				return object ? object : resolve(handle);
+			}
+
+			/**
+			 * Iterate over the objects getAllObjects would return,
+			 * index from 0 to getObjectCount() - 1. By default
+			 * getObjectCount calls getAllObjects and interns the
+			 * objects it returns, trackers override both to iterate
+			 * without allocating.
+			 */
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+
 			/**
 			 * Fills the tracked objects witht he latest frame of data from the server.
 			 */
@@ -99,6 +148,58 @@ namespace wcl
 			 */
 			virtual void setUnits(Units u) = 0;
 
+			/**
+			 * The clock tracked objects are timestamped with,
+			 * microseconds since the epoch. It is the wall clock so
+			 * timestamps published to other machines can be
+			 * compared, which means it steps when the clock is set.
+			 * Measure intervals with getMonotonicTime.
+			 */
+			static uint64_t getCurrentTime();
+
+			/**
+			 * Microseconds since an arbitrary point that never goes
+			 * backwards, for intervals and deadlines. It can't be
+			 * compared with getCurrentTime.
+			 */
+			static uint64_t getMonotonicTime();
+
+			/**
+			 * The length of one of the units in millimetres, for
+			 * converting between them.
+			 */
+			static double getMillimetres(const Units units);
+
+		protected:
+			/**
+			 * Add the current pose of every visible object to its
+			 * history. Trackers call this whenever update has
+			 * applied new data.
+			 *
+			 * @param timestamp When the data was measured
+			 */
+			void recordPoses(const uint64_t timestamp);
+
+		private:
+			struct Handle
+			{
+				std::string name;
+				TrackedObject *object;
+
+				/**
+				 * The object count when the name was last looked
+				 * up and not found
+				 */
+				unsigned generation;
+				bool missed;
+			};
+
+			std::vector<Handle> handles;
+			std::map<std::string, ObjectHandle> handleNames;
+			std::vector<ObjectHandle> listed; // Objects found by the default getObjectCount
+
+			ObjectHandle intern(const std::string &name);
+			TrackedObject *resolve(const ObjectHandle handle);
 	};
 
 }
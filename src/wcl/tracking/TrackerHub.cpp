@@ -0,0 +1,330 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include <wcl/Exception.h>
+#include <wcl/IO.h>
+#include <wcl/maths/Vector.h>
+#include <wcl/tracking/TrackerHub.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+
+const unsigned TrackerHub::IDLE_DELAY;
+const unsigned TrackerHub::ERROR_DELAY;
+
+/**
+ * Updates one tracker and hands every update with new data to the hub
+ */
+class TrackerHub::PollThread : public Thread
+{
+    public:
+	PollThread(Source &source, const unsigned index) :
+	    source(source), index(index), failing(false) {}
+
+    protected:
+	void run()
+	{
+	    while( this->source.running ){
+		try {
+		    this->source.tracker.update();
+		}
+		catch( Exception &e ){
+		    this->source.errors++;
+		    if( !this->failing )
+			wclclog << "TrackerHub: Update of tracker " << this->index
+				<< " failed, " << e.what() << std::endl;
+		    this->failing = true;
+		    usleep(ERROR_DELAY);
+		    continue;
+		}
+		this->failing = false;
+
+		if( !this->capture()){
+		    usleep(IDLE_DELAY);
+		    continue;
+		}
+
+		this->source.snapshots.publish();
+		this->source.updates++;
+	    }
+	}
+
+    private:
+	/**
+	 * Copy the tracker's objects into the back snapshot
+	 *
+	 * @return false if nothing changed since the last snapshot handed over
+	 */
+	bool capture()
+	{
+	    std::vector<Entry> &entries = this->source.snapshots.getBack().entries;
+	    Tracker &tracker = this->source.tracker;
+	    unsigned count = tracker.getObjectCount();
+
+	    entries.resize(count);
+	    bool changed = count != this->last.size();
+	    for(unsigned i = 0; i < count; i++ ){
+		Entry &e = entries[i];
+		TrackedObject *object = tracker.getObjectAt(i);
+		e.object = object;
+		if( !object )
+		    continue;
+
+		Vector position = object->getTranslation();
+		e.pose.timestamp = object->getTimestamp();
+		for(unsigned j = 0; j < 3; j++ )
+		    e.pose.position[j] = position[j];
+		e.pose.orientation = object->getOrientation();
+		e.visible = object->isVisible();
+		e.confidence = object->getConfidence();
+
+		if( !changed && (e.object != this->last[i].object ||
+				 e.pose.timestamp != this->last[i].timestamp ||
+				 e.visible != this->last[i].visible))
+		    changed = true;
+	    }
+
+	    if( !changed )
+		return false;
+
+	    this->last.resize(count);
+	    for(unsigned i = 0; i < count; i++ ){
+		this->last[i].object = entries[i].object;
+		this->last[i].timestamp = entries[i].pose.timestamp;
+		this->last[i].visible = entries[i].visible;
+	    }
+	    return true;
+	}
+
+	struct State
+	{
+	    TrackedObject *object;
+	    uint64_t timestamp;
+	    bool visible;
+	};
+
+	Source &source;
+	unsigned index;
+	std::vector<State> last;
+	bool failing;
+};
+
+TrackerHub::Source::Source(Tracker &tracker, const Units units, const std::string &prefix) :
+    tracker(tracker),
+    units(units),
+    prefix(prefix),
+    calibration(4),
+    rotation(1, 0, 0, 0),
+    thread(NULL),
+    running(false),
+    updates(0),
+    errors(0)
+{
+    for(unsigned i = 0; i < 4; i++ )
+	this->calibration[i][i] = 1;
+    for(unsigned i = 0; i < 3; i++ )
+	this->translation[i] = 0;
+}
+
+TrackerHub::TrackerHub() :
+    units(MM)
+{
+}
+
+TrackerHub::~TrackerHub()
+{
+    for(std::vector<Source *>::iterator it = this->sources.begin();
+	it != this->sources.end();
+	++it )
+	(*it)->running = false;
+
+    for(std::vector<Source *>::iterator it = this->sources.begin();
+	it != this->sources.end();
+	++it ){
+	(*it)->thread->join();
+	delete (*it)->thread;
+	delete *it;
+    }
+
+    for(std::vector<HubTrackedObject *>::iterator it = this->objectList.begin();
+	it != this->objectList.end();
+	++it )
+	delete *it;
+}
+
+unsigned TrackerHub::addTracker(Tracker &tracker, const Units units,
+				const std::string &prefix)
+{
+    Source *source = new Source(tracker, units, prefix);
+    source->thread = new PollThread(*source, this->sources.size());
+    source->running = true;
+    try {
+	source->thread->start();
+    }
+    catch( Exception & ){
+	delete source->thread;
+	delete source;
+	throw;
+    }
+
+    this->sources.push_back(source);
+    return this->sources.size() - 1;
+}
+
+TrackerHub::Source &TrackerHub::getSource(const unsigned index) const
+{
+    if( index >= this->sources.size())
+	throw Exception("TrackerHub: No such tracker");
+    return *this->sources[index];
+}
+
+void TrackerHub::setCalibration(const unsigned index, const SMatrix &transform)
+{
+    if( transform.getRows() != 4 || transform.getCols() != 4 )
+	throw Exception("TrackerHub: Calibration must be a 4x4 transform");
+
+    Source &source = this->getSource(index);
+    source.calibration = transform;
+    source.rotation = Quaternion(transform);
+    for(unsigned i = 0; i < 3; i++ )
+	source.translation[i] = transform[i][3];
+}
+
+SMatrix TrackerHub::getCalibration(const unsigned index) const
+{
+    return this->getSource(index).calibration;
+}
+
+unsigned TrackerHub::getTrackerCount() const
+{
+    return this->sources.size();
+}
+
+uint64_t TrackerHub::getUpdateCount(const unsigned index) const
+{
+    return this->getSource(index).updates;
+}
+
+uint64_t TrackerHub::getErrorCount(const unsigned index) const
+{
+    return this->getSource(index).errors;
+}
+
+void TrackerHub::update()
+{
+    for(std::vector<Source *>::iterator it = this->sources.begin();
+	it != this->sources.end();
+	++it ){
+	Source &source = **it;
+	if( source.snapshots.take())
+	    this->merge(source, source.snapshots.getFront());
+    }
+}
+
+/**
+ * Set the hub's objects from a tracker's snapshot
+ */
+void TrackerHub::merge(Source &source, const Snapshot &snapshot)
+{
+    T from = getMillimetres(source.units);
+    T to = getMillimetres(this->units);
+    T scale = from / to;
+
+    for(std::vector<Entry>::const_iterator it = snapshot.entries.begin();
+	it != snapshot.entries.end();
+	++it ){
+	if( !it->object )
+	    continue;
+	HubTrackedObject *object = this->wrap(source, it->object);
+	if( !object )
+	    continue;
+
+	PoseHistory::Pose pose;
+	Vector p = source.rotation.rotate(Vector(it->pose.position[0] * scale,
+						 it->pose.position[1] * scale,
+						 it->pose.position[2] * scale));
+	pose.timestamp = it->pose.timestamp;
+	for(unsigned i = 0; i < 3; i++ )
+	    pose.position[i] = p[i] + source.translation[i];
+	pose.orientation = source.rotation * it->pose.orientation;
+
+	object->set(pose, it->visible, it->confidence);
+    }
+}
+
+/**
+ * Find the hub's object for a tracker's, creating it the first time
+ */
+HubTrackedObject *TrackerHub::wrap(Source &source, TrackedObject *object)
+{
+    ObjectMap::iterator it = source.objects.find(object);
+    if( it != source.objects.end())
+	return it->second;
+
+    std::string name = source.prefix + object->getName();
+    if( this->objects.find(name) != this->objects.end()){
+	wclclog << "TrackerHub: Ignoring second object named '" << name << "'" << std::endl;
+	source.objects[object] = NULL;
+	return NULL;
+    }
+
+    HubTrackedObject *h = new HubTrackedObject(name, object->getType());
+    source.objects[object] = h;
+    this->objects[name] = h;
+    this->objectList.push_back(h);
+    return h;
+}
+
+TrackedObject *TrackerHub::getObject(std::string name)
+{
+    std::map<std::string, HubTrackedObject *>::iterator it = this->objects.find(name);
+    return it != this->objects.end() ? it->second : NULL;
+}
+
+std::vector<TrackedObject *> TrackerHub::getAllObjects()
+{
+    return std::vector<TrackedObject *>(this->objectList.begin(), this->objectList.end());
+}
+
+unsigned TrackerHub::getObjectCount()
+{
+    return this->objectList.size();
+}
+
+TrackedObject *TrackerHub::getObjectAt(const unsigned index)
+{
+    return index < this->objectList.size() ? this->objectList[index] : NULL;
+}
+
+void TrackerHub::setUnits(Units u)
+{
+    this->units = u;
+}
+
+};
@@ -0,0 +1,210 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_TRACKERHUB_H
+#define WCL_TRACKING_TRACKERHUB_H
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/maths/Quaternion.h>
+#include <wcl/maths/SMatrix.h>
+#include <wcl/tracking/HubTrackedObject.h>
+#include <wcl/tracking/PoseHistory.h>
+#include <wcl/tracking/Tracker.h>
+#include <wcl/util/TripleBuffer.h>
+
+namespace wcl
+{
+	/**
+	 * Merges several trackers into one, updating each on its own thread
+	 * so a tracker blocking on its device doesn't hold up the others or
+	 * the thread using the hub.
+	 *
+	 * Every tracker added is updated as fast as it delivers data and its
+	 * objects are handed to the hub after each update. update() on the
+	 * hub never blocks. It takes the latest data of every tracker,
+	 * converts it to the hub's units, moves it into the hub's coordinate
+	 * frame with the tracker's calibration and sets the hub's objects,
+	 * which then stay unchanged until the next update(). Every object of
+	 * the hub is timestamped with when its tracker measured it.
+	 *
+	 * The trackers must outlive the hub and shouldn't be used by
+	 * anything else while it exists. Their update must return now and
+	 * again, even if there's no new data, or the hub can't be destroyed.
+	 */
+	class WCL_API TrackerHub : public Tracker
+	{
+		public:
+			/**
+			 * How long a tracker's thread sleeps, in microseconds,
+			 * when an update brought no new data
+			 */
+			static const unsigned IDLE_DELAY = 1000;
+
+			/**
+			 * How long a tracker's thread waits, in microseconds,
+			 * before updating again after an exception
+			 */
+			static const unsigned ERROR_DELAY = 100000;
+
+			TrackerHub();
+
+			/**
+			 * Stops every tracker's thread
+			 */
+			~TrackerHub();
+
+			/**
+			 * Add a tracker and start updating it. The tracker's
+			 * units aren't changed, they are converted to the hub's
+			 * when its data is merged.
+			 *
+			 * @param tracker The tracker to add
+			 * @param units The units the tracker reports positions in
+			 * @param prefix Prepended to the names of the tracker's
+			 *        objects, to tell apart objects with the same name
+			 * @return The index of the tracker in the hub
+			 */
+			unsigned addTracker(Tracker &tracker, const Units units,
+					    const std::string &prefix = "");
+
+			/**
+			 * Set the transform from a tracker's coordinate frame,
+			 * once converted to the hub's units, to the hub's.
+			 *
+			 * @param index The tracker, as returned by addTracker
+			 * @param transform A 4x4 rigid transform
+			 */
+			void setCalibration(const unsigned index, const SMatrix &transform);
+			SMatrix getCalibration(const unsigned index) const;
+
+			unsigned getTrackerCount() const;
+
+			/**
+			 * The number of updates of a tracker that brought new
+			 * data
+			 */
+			uint64_t getUpdateCount(const unsigned index) const;
+
+			/**
+			 * The number of updates of a tracker that threw an
+			 * exception
+			 */
+			uint64_t getErrorCount(const unsigned index) const;
+
+			/**
+			 * Merge the latest data of every tracker into the
+			 * hub's objects. Doesn't block.
+			 */
+			virtual void update();
+
+			virtual TrackedObject* getObject(std::string name);
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+
+			/**
+			 * Set the units of the hub's objects, from the next
+			 * update
+			 */
+			virtual void setUnits(Units u);
+
+		private:
+			class PollThread;
+			friend class PollThread;
+
+			/**
+			 * An object as its tracker's thread last saw it
+			 */
+			struct Entry
+			{
+				TrackedObject *object;
+				PoseHistory::Pose pose;
+				bool visible;
+				float confidence;
+			};
+
+			/**
+			 * Every object of a tracker after one update. Once
+			 * handed over it isn't changed until update() hands it
+			 * back.
+			 */
+			struct Snapshot
+			{
+				std::vector<Entry> entries;
+			};
+
+			typedef std::map<TrackedObject *, HubTrackedObject *> ObjectMap;
+
+			struct Source
+			{
+				Source(Tracker &tracker, const Units units, const std::string &prefix);
+
+				Tracker &tracker;
+				Units units;
+				std::string prefix;
+
+				SMatrix calibration;
+				Quaternion rotation;
+				T translation[3];
+
+				/**
+				 * Snapshots from the tracker's thread, which fills
+				 * the back, to update(), which reads the front
+				 */
+				TripleBuffer<Snapshot> snapshots;
+
+				PollThread *thread;
+				volatile bool running;
+				volatile uint64_t updates;
+				volatile uint64_t errors;
+
+				/**
+				 * The hub's object for each of the tracker's, or
+				 * NULL if its name is taken by another tracker's
+				 */
+				ObjectMap objects;
+			};
+
+			std::vector<Source *> sources;
+			std::map<std::string, HubTrackedObject *> objects;
+			std::vector<HubTrackedObject *> objectList;
+			Units units;
+
+			void merge(Source &source, const Snapshot &snapshot);
+			HubTrackedObject *wrap(Source &source, TrackedObject *object);
+			Source &getSource(const unsigned index) const;
+
+			TrackerHub(const TrackerHub &);
+			TrackerHub &operator =(const TrackerHub &);
+	};
+};
+
+#endif
@@ -0,0 +1,210 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Private to the tracking module, the datagram format shared by
+ * TrackerPublisher and MulticastTracker, also used for the messages of
+ * SharedMemoryTrackerPublisher and SharedMemoryTracker. Only include this
+ * from source files.
+ *
+ * Each update of the published tracker is sent as one or more datagrams,
+ * all fields little endian:
+ *
+ *  header  magic u32, version u8, part u8, part count u8, reserved u8,
+ *          sequence u32, timestamp u64 (usec), object count u16
+ *  object  id u16, name length u8, name, type u8, flags u8,
+ *          confidence f32, position x,y,z f32 (mm), orientation w,x,y,z f32
+ *
+ * Every datagram is complete in itself, objects are only split between
+ * datagrams to keep each below the MTU. Shared memory messages are always
+ * a single part.
+ *
+ * Objects are identified by id, so receivers find them with an index
+ * rather than a name lookup. The name of an id is only sent with new
+ * objects and every NAME_INTERVAL updates, for receivers that joined late
+ * or lost the update announcing it, otherwise its length is 0. Objects of
+ * ids a receiver has no name for yet are skipped.
+ */
+#ifndef WCL_TRACKING_TRACKERPACKET_H
+#define WCL_TRACKING_TRACKERPACKET_H
+
+#include <string>
+#include <wcl/tracking/TrackedObject.h>
+#include <wcl/tracking/Tracker.h>
+#include "../network/WireFormat.h"
+
+namespace wcl
+{
+namespace TrackerPacket
+{
+    const uint32_t MAGIC = 0x544c4357; // "WCLT"
+    const uint8_t PROTOCOL_VERSION = 2;
+
+    const size_t HEADER_SIZE = 22;
+    const size_t MAX_DATAGRAM_SIZE = 1400;
+    const size_t MAX_NAME_LENGTH = 255;
+    const size_t MAX_OBJECTS = 0xFFFF;
+    const uint32_t NAME_INTERVAL = 64;
+
+    // Object flags
+    const uint8_t VISIBLE = 1;
+
+    struct Header {
+	uint8_t part;
+	uint8_t parts;
+	uint32_t sequence;
+	uint64_t timestamp;
+	uint16_t count;
+    };
+
+    struct Object {
+	uint16_t id;
+	uint8_t type;
+	uint8_t flags;
+	float confidence;
+	float position[3];
+	float orientation[4];
+    };
+
+    inline size_t getNameLength(const std::string &name)
+    {
+	return name.size() < MAX_NAME_LENGTH ? name.size() : MAX_NAME_LENGTH;
+    }
+
+    /**
+     * The size of an object on the wire, with or without its name
+     */
+    inline size_t getObjectSize(const std::string *name)
+    {
+	return 2 + 1 + (name ? getNameLength(*name) : 0) + 2 + 4 + 3 * 4 + 4 * 4;
+    }
+
+    inline void writeHeader(WireWriter &w, const Header &h)
+    {
+	w.put32(MAGIC);
+	w.put8(PROTOCOL_VERSION);
+	w.put8(h.part);
+	w.put8(h.parts);
+	w.put8(0);
+	w.put32(h.sequence);
+	w.put64(h.timestamp);
+	w.put16(h.count);
+    }
+
+    inline bool readHeader(WireReader &r, Header &h)
+    {
+	uint32_t magic = r.get32();
+	uint8_t version = r.get8();
+	h.part = r.get8();
+	h.parts = r.get8();
+	r.get8();
+	h.sequence = r.get32();
+	h.timestamp = r.get64();
+	h.count = r.get16();
+	return r.ok() && magic == MAGIC && version == PROTOCOL_VERSION;
+    }
+
+    /**
+     * @param name The name to announce with the object, or NULL
+     */
+    inline void writeObject(WireWriter &w, const Object &o, const std::string *name)
+    {
+	w.put16(o.id);
+	size_t length = name ? getNameLength(*name) : 0;
+	w.put8(length);
+	if( length > 0 )
+	    w.putBytes(name->data(), length);
+	w.put8(o.type);
+	w.put8(o.flags);
+	w.putFloat(o.confidence);
+	for(unsigned i = 0; i < 3; i++ )
+	    w.putFloat(o.position[i]);
+	for(unsigned i = 0; i < 4; i++ )
+	    w.putFloat(o.orientation[i]);
+    }
+
+    /**
+     * @param name Set to the name announced with the object, left empty
+     *        if there was none
+     */
+    inline bool readObject(WireReader &r, Object &o, std::string &name)
+    {
+	o.id = r.get16();
+	r.getBytes(name, r.get8());
+	o.type = r.get8();
+	o.flags = r.get8();
+	o.confidence = r.getFloat();
+	for(unsigned i = 0; i < 3; i++ )
+	    o.position[i] = r.getFloat();
+	for(unsigned i = 0; i < 4; i++ )
+	    o.orientation[i] = r.getFloat();
+	return r.ok();
+    }
+
+    /**
+     * Fill in an object from the current state of a tracked object, in
+     * the units of its tracker
+     */
+    inline void fromTrackedObject(const uint16_t id, TrackedObject *t, Object &o)
+    {
+	o.id = id;
+	o.type = t->getType();
+	o.flags = t->isVisible() ? VISIBLE : 0;
+	o.confidence = t->getConfidence();
+	o.position[0] = o.position[1] = o.position[2] = 0;
+	o.orientation[0] = 1;
+	o.orientation[1] = o.orientation[2] = o.orientation[3] = 0;
+
+	if( o.type != ORIENTATION ){
+	    Vector v = t->getTranslation();
+	    for(unsigned j = 0; j < 3; j++ )
+		o.position[j] = v[j];
+	}
+	if( o.type != POSITION ){
+	    Quaternion q = t->getOrientation();
+	    o.orientation[0] = q.w;
+	    o.orientation[1] = q.x;
+	    o.orientation[2] = q.y;
+	    o.orientation[3] = q.z;
+	}
+    }
+
+    /**
+     * The factor converting published positions, always in mm, to the
+     * given units
+     */
+    inline double getUnitScale(const Tracker::Units units)
+    {
+	switch( units ){
+	    case Tracker::CM: return 0.1;
+	    case Tracker::INCHES: return 1 / 25.4;
+	    default: return 1.0;
+	}
+    }
+};
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "TrackerPacket.h"
+#include "TrackerPacketObjects.h"
+
+namespace wcl
+{
+namespace TrackerPacket
+{
+
+ObjectTable::ObjectTable():
+    translation(3)
+{
+}
+
+ObjectTable::~ObjectTable()
+{
+    for(ObjectMap::iterator it = this->objects.begin(); it != this->objects.end(); ++it )
+	delete it->second;
+}
+
+bool ObjectTable::apply(WireReader &r, const unsigned count, const double scale,
+			Validator *validator)
+{
+    Object o;
+    std::string name;
+    for(unsigned i = 0; i < count && readObject(r, o, name); i++ ){
+	MulticastTrackedObject *t;
+	if( !name.empty() && (o.id >= this->ids.size() || this->ids[o.id] == NULL ||
+			      this->ids[o.id]->getName() != name)){
+	    // Don't file objects under a torn name or id
+	    if( validator && !validator->isValid())
+		return false;
+
+	    ObjectMap::iterator it = this->objects.find(name);
+	    if( it == this->objects.end()){
+		t = new MulticastTrackedObject(name, (ObjectType)o.type);
+		this->objects[name] = t;
+		this->objectList.push_back(t);
+	    } else {
+		t = it->second;
+	    }
+	    if( o.id >= this->ids.size())
+		this->ids.resize(o.id + 1, NULL);
+	    this->ids[o.id] = t;
+	} else if( o.id < this->ids.size() && this->ids[o.id] != NULL ){
+	    t = this->ids[o.id];
+	} else {
+	    // Not named yet, wait for the publisher to announce it
+	    continue;
+	}
+
+	for(unsigned j = 0; j < 3; j++ )
+	    this->translation[j] = o.position[j] * scale;
+	t->setData((ObjectType)o.type, o.flags & VISIBLE, o.confidence, this->translation,
+		   Quaternion(o.orientation[0], o.orientation[1], o.orientation[2], o.orientation[3]));
+    }
+    return true;
+}
+
+TrackedObject *ObjectTable::getObject(const std::string &name) const
+{
+    ObjectMap::const_iterator it = this->objects.find(name);
+    if( it != this->objects.end())
+	return it->second;
+    return NULL;
+}
+
+std::vector<TrackedObject *> ObjectTable::getAllObjects() const
+{
+    std::vector<TrackedObject *> all;
+    for(ObjectMap::const_iterator it = this->objects.begin(); it != this->objects.end(); ++it )
+	all.push_back(it->second);
+    return all;
+}
+
+unsigned ObjectTable::getObjectCount() const
+{
+    return this->objectList.size();
+}
+
+TrackedObject *ObjectTable::getObjectAt(const unsigned index) const
+{
+    return index < this->objectList.size() ? this->objectList[index] : NULL;
+}
+
+};
+};
@@ -0,0 +1,106 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Private to the tracking module, the objects of a tracker followed
+ * through TrackerPacket messages, shared by MulticastTracker and
+ * SharedMemoryTracker. Only include this from source files.
+ */
+#ifndef WCL_TRACKING_TRACKERPACKETOBJECTS_H
+#define WCL_TRACKING_TRACKERPACKETOBJECTS_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../network/WireFormat.h"
+#include <wcl/tracking/MulticastTrackedObject.h>
+
+namespace wcl
+{
+namespace TrackerPacket
+{
+    /**
+     * Tells whether the message being read is still intact, for readers
+     * whose message may be overwritten under them
+     */
+    class Validator
+    {
+	public:
+	    virtual ~Validator() {}
+	    virtual bool isValid() = 0;
+    };
+
+    /**
+     * The objects announced by a publisher, found by the ids it gives
+     * them. The table owns the objects.
+     */
+    class ObjectTable
+    {
+	public:
+	    ObjectTable();
+	    ~ObjectTable();
+
+	    /**
+	     * Apply the objects of a message, the reader must be just
+	     * past the header. Objects whose id hasn't been named yet
+	     * are skipped.
+	     *
+	     * @param count The number of objects in the message
+	     * @param scale The amount to multiply positions in mm by
+	     * @param validator If given, asked before a name read from the
+	     *        message is added to the table
+	     * @return false if the validator found the message overwritten,
+	     *         the table is then left as it was before that object
+	     */
+	    bool apply(WireReader &r, const unsigned count, const double scale,
+		       Validator *validator = NULL);
+
+	    TrackedObject *getObject(const std::string &name) const;
+	    std::vector<TrackedObject *> getAllObjects() const;
+	    unsigned getObjectCount() const;
+	    TrackedObject *getObjectAt(const unsigned index) const;
+
+	private:
+	    typedef std::map<std::string, MulticastTrackedObject *> ObjectMap;
+
+	    ObjectMap objects;
+	    std::vector<MulticastTrackedObject *> objectList;
+
+	    /**
+	     * The objects by the number the publisher gave them
+	     */
+	    std::vector<MulticastTrackedObject *> ids;
+
+	    Vector translation;
+
+	    ObjectTable(const ObjectTable &);
+	    ObjectTable &operator =(const ObjectTable &);
+    };
+};
+};
+
+#endif
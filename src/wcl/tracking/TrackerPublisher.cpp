@@ -0,0 +1,198 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <netinet/in.h>
+
+#include <wcl/IO.h>
+#include <wcl/tracking/TrackerPublisher.h>
+#include "TrackerPacket.h"
+
+using namespace std;
+
+namespace wcl
+{
+
+using namespace TrackerPacket;
+
+const char * const TrackerPublisher::DEFAULT_GROUP = "239.255.87.84";
+
+/**
+ * Updates and publishes the tracker until stopped
+ */
+class TrackerPublisher::PublisherThread: public Thread
+{
+    public:
+	PublisherThread(TrackerPublisher *ipublisher): publisher(ipublisher) {}
+
+    protected:
+	void run()
+	{
+	    while( this->publisher->running ){
+		try {
+		    this->publisher->update();
+		} catch( Exception &e ){
+		    wclclog << "TrackerPublisher: Stopping, " << e.what() << endl;
+		    this->publisher->running = false;
+		}
+	    }
+	}
+
+    private:
+	TrackerPublisher *publisher;
+};
+
+TrackerPublisher::TrackerPublisher(Tracker *itracker, const std::string &group,
+				   const unsigned port) throw (SocketException):
+    tracker(itracker), socket(group, port), sequence(0), announced(0), running(false), thread(NULL)
+{
+    this->address = Socket::resolve(group.c_str(), port);
+    this->tracker->setUnits(Tracker::MM);
+}
+
+TrackerPublisher::~TrackerPublisher()
+{
+    this->stop();
+    for(unsigned i = 0; i < this->packets.size(); i++ )
+	delete this->packets[i];
+}
+
+void TrackerPublisher::setTTL(const unsigned ttl) throw (SocketException)
+{
+    unsigned char value = ttl;
+    if( setsockopt(*this->socket, IPPROTO_IP, IP_MULTICAST_TTL, &value, sizeof(value)) == -1 )
+	throw SocketException(&this->socket);
+}
+
+void TrackerPublisher::publish() throw (SocketException)
+{
+    unsigned objects = this->tracker->getObjectCount();
+    if( objects > MAX_OBJECTS )
+	objects = MAX_OBJECTS;
+
+    Header h;
+    h.sequence = ++this->sequence;
+    h.timestamp = Tracker::getCurrentTime();
+
+    // Objects are identified by their index in the tracker, new ones are
+    // named straight away and all of them now and again
+    bool announceAll = h.sequence % NAME_INTERVAL == 1;
+    this->names.resize(objects);
+    this->announce.resize(objects);
+    for(unsigned i = 0; i < objects; i++ ){
+	TrackedObject *t = this->tracker->getObjectAt(i);
+	if( i >= this->announced )
+	    this->names[i] = t->getName();
+	this->announce[i] = announceAll || i >= this->announced;
+    }
+
+    // Split the objects between as few datagrams as fit
+    this->groups.clear();
+    size_t size = HEADER_SIZE;
+    unsigned count = 0;
+    for(unsigned i = 0; i < objects; i++ ){
+	size_t objectSize = getObjectSize(this->announce[i] ? &this->names[i] : NULL);
+	if( count > 0 && size + objectSize > MAX_DATAGRAM_SIZE ){
+	    this->groups.push_back(count);
+	    size = HEADER_SIZE;
+	    count = 0;
+	}
+	size += objectSize;
+	count++;
+    }
+    this->groups.push_back(count);
+
+    if( this->groups.size() > 255 ){
+	wclclog << "TrackerPublisher: Too many objects to publish" << endl;
+	this->groups.resize(255);
+    }
+
+    this->buffer.clear();
+    WireWriter w(this->buffer);
+    std::vector<size_t> offsets;
+    unsigned next = 0;
+    Object o;
+    h.parts = this->groups.size();
+    for(unsigned part = 0; part < this->groups.size(); part++ ){
+	offsets.push_back(this->buffer.size());
+	h.part = part;
+	h.count = this->groups[part];
+	writeHeader(w, h);
+
+	for(unsigned i = 0; i < this->groups[part]; i++, next++ ){
+	    fromTrackedObject(next, this->tracker->getObjectAt(next), o);
+	    writeObject(w, o, this->announce[next] ? &this->names[next] : NULL);
+	}
+    }
+    offsets.push_back(this->buffer.size());
+    this->announced = next;
+
+    while( this->packets.size() < this->groups.size())
+	this->packets.push_back(new UDPPacket(&this->buffer[0], 1));
+    for(unsigned part = 0; part < this->groups.size(); part++ ){
+	this->packets[part]->setData(&this->buffer[offsets[part]], offsets[part + 1] - offsets[part]);
+	this->packets[part]->setRecipient(this->address);
+    }
+
+    this->socket.write(&this->packets[0], (unsigned)this->groups.size());
+}
+
+void TrackerPublisher::update() throw (SocketException)
+{
+    this->tracker->update();
+    this->publish();
+}
+
+void TrackerPublisher::start()
+{
+    if( this->running )
+	return;
+
+    this->running = true;
+    this->thread = new PublisherThread(this);
+    this->thread->start();
+}
+
+void TrackerPublisher::stop()
+{
+    this->running = false;
+    if( this->thread ){
+	this->thread->join();
+	delete this->thread;
+	this->thread = NULL;
+    }
+}
+
+bool TrackerPublisher::isRunning() const
+{
+    return this->running;
+}
+
+uint32_t TrackerPublisher::getSequence() const
+{
+    return this->sequence;
+}
+
+};
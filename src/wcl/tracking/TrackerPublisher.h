@@ -0,0 +1,127 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_TRACKERPUBLISHER_H
+#define WCL_TRACKING_TRACKERPUBLISHER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/SocketException.h>
+#include <wcl/network/UDPPacket.h>
+#include <wcl/network/UDPSocket.h>
+#include <wcl/tracking/Tracker.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+	/**
+	 * Multicasts the state of a tracker so any number of MulticastTrackers
+	 * can follow it through a single connection to the tracking hardware.
+	 *
+	 * Each publish sends the pose of every object of the tracker, with a
+	 * sequence number and the time of the update, in as few datagrams as
+	 * fit the MTU. Objects are sent by number, their names only when they
+	 * are new and every so often after. Positions are sent in mm, so the
+	 * publisher sets the units of the tracker to MM.
+	 */
+	class WCL_API TrackerPublisher
+	{
+		public:
+			static const unsigned DEFAULT_PORT = 5700;
+			static const char * const DEFAULT_GROUP;
+
+			/**
+			 * @param tracker The tracker to publish, not owned by the publisher
+			 * @param group The multicast group to send to
+			 * @param port The port to send to
+			 * @throw SocketException if the socket can't be created
+			 */
+			TrackerPublisher(Tracker *tracker, const std::string &group = DEFAULT_GROUP,
+					 const unsigned port = DEFAULT_PORT) throw (SocketException);
+			~TrackerPublisher();
+
+			/**
+			 * Set how many routers the datagrams may cross, the
+			 * default of 1 keeps them on the local subnet
+			 */
+			void setTTL(const unsigned ttl) throw (SocketException);
+
+			/**
+			 * Send the current state of the tracker without updating it
+			 */
+			void publish() throw (SocketException);
+
+			/**
+			 * Update the tracker and publish the result
+			 */
+			void update() throw (SocketException);
+
+			/**
+			 * Call update continuously from a background thread
+			 */
+			void start();
+			void stop();
+			bool isRunning() const;
+
+			/**
+			 * The sequence number of the last update published
+			 */
+			uint32_t getSequence() const;
+
+		private:
+			class PublisherThread;
+			friend class PublisherThread;
+
+			Tracker *tracker;
+			UDPSocket socket;
+			sockaddr_in address;
+			uint32_t sequence;
+
+			/**
+			 * The names of the objects, and which to send with
+			 * this update. Only the first announced objects have
+			 * been named before.
+			 */
+			std::vector<std::string> names;
+			std::vector<bool> announce;
+			unsigned announced;
+
+			std::vector<unsigned char> buffer;
+			std::vector<unsigned> groups;
+			std::vector<UDPPacket *> packets;
+
+			volatile bool running;
+			PublisherThread *thread;
+
+			TrackerPublisher(const TrackerPublisher &);
+			TrackerPublisher &operator =(const TrackerPublisher &);
+	};
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include <wcl/tracking/TrackerRecorder.h>
+#include <wcl/tracking/TrackerRecording.h>
+
+namespace wcl
+{
+
+using namespace TrackerRecording;
+
+/**
+ * Frames recorded before setUnits was called are marked with this, and
+ * aren't converted on replay
+ */
+static const int UNKNOWN_UNITS = 0xff;
+
+TrackerRecorder::TrackerRecorder(Tracker &source, const std::string &path) throw (Exception) :
+    source(source),
+    units(UNKNOWN_UNITS),
+    framesWritten(0)
+{
+    this->file = fopen(path.c_str(), "wb");
+    if( this->file == NULL )
+	throw Exception("TrackerRecorder: Could not create the recording");
+
+    FileHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = MAGIC;
+    h.byteOrder = ENDIAN_MARK;
+    h.version = FORMAT_VERSION;
+    h.headerSize = sizeof(FileHeader);
+    h.created = getCurrentTime();
+
+    try {
+	this->write(&h, sizeof(h));
+    } catch( Exception & ){
+	fclose(this->file);
+	throw;
+    }
+}
+
+TrackerRecorder::~TrackerRecorder()
+{
+    fclose(this->file);
+}
+
+void TrackerRecorder::write(const void *data, const size_t size)
+{
+    if( fwrite(data, 1, size, this->file) != size )
+	throw Exception("TrackerRecorder: Could not write to the recording");
+}
+
+uint32_t TrackerRecorder::getId(TrackedObject *object)
+{
+    std::map<TrackedObject *, uint32_t>::iterator it = this->ids.find(object);
+    if( it != this->ids.end())
+	return it->second;
+
+    // Introduce the object before the frame it first appears in
+    std::string name = object->getName();
+    size_t size = align(sizeof(ObjectRecord) + name.size() + 1);
+    std::vector<unsigned char> record(size, 0);
+
+    ObjectRecord *o = (ObjectRecord *)&record[0];
+    o->header.type = OBJECT;
+    o->header.size = size;
+    o->id = this->ids.size();
+    o->type = object->getType();
+    memcpy(&record[sizeof(ObjectRecord)], name.c_str(), name.size());
+    this->write(&record[0], size);
+
+    this->ids[object] = o->id;
+    return o->id;
+}
+
+void TrackerRecorder::update()
+{
+    this->source.update();
+    this->record();
+}
+
+void TrackerRecorder::record() throw (Exception)
+{
+    unsigned count = this->source.getObjectCount();
+    size_t size = sizeof(FrameRecord) + count * sizeof(ObjectState);
+    if( this->buffer.size() < size )
+	this->buffer.resize(size);
+    memset(&this->buffer[0], 0, size);
+
+    unsigned recorded = 0;
+    ObjectState *states = (ObjectState *)&this->buffer[sizeof(FrameRecord)];
+    for(unsigned i = 0; i < count; i++ ){
+	TrackedObject *object = this->source.getObjectAt(i);
+	if( object == NULL )
+	    continue;
+
+	ObjectState &s = states[recorded++];
+	s.id = this->getId(object);
+	s.type = object->getType();
+	s.flags = object->isVisible() ? VISIBLE : 0;
+	s.confidence = object->getConfidence();
+
+	Vector position = object->getTranslation();
+	Quaternion orientation = object->getOrientation();
+	for(unsigned j = 0; j < 3; j++ )
+	    s.position[j] = position[j];
+	s.orientation[0] = orientation.w;
+	s.orientation[1] = orientation.x;
+	s.orientation[2] = orientation.y;
+	s.orientation[3] = orientation.z;
+    }
+
+    size = sizeof(FrameRecord) + recorded * sizeof(ObjectState);
+    FrameRecord *f = (FrameRecord *)&this->buffer[0];
+    f->header.type = FRAME;
+    f->header.size = size;
+    f->timestamp = getCurrentTime();
+    f->count = recorded;
+    f->units = this->units;
+
+    this->write(&this->buffer[0], size);
+    this->framesWritten++;
+}
+
+TrackedObject *TrackerRecorder::getObject(std::string name)
+{
+    return this->source.getObject(name);
+}
+
+std::vector<TrackedObject *> TrackerRecorder::getAllObjects()
+{
+    return this->source.getAllObjects();
+}
+
+unsigned TrackerRecorder::getObjectCount()
+{
+    return this->source.getObjectCount();
+}
+
+TrackedObject *TrackerRecorder::getObjectAt(const unsigned index)
+{
+    return this->source.getObjectAt(index);
+}
+
+void TrackerRecorder::setUnits(Units u)
+{
+    this->source.setUnits(u);
+    this->units = u;
+}
+
+void TrackerRecorder::flush()
+{
+    fflush(this->file);
+}
+
+unsigned TrackerRecorder::getFramesWritten() const
+{
+    return this->framesWritten;
+}
+
+Tracker &TrackerRecorder::getSource()
+{
+    return this->source;
+}
+
+};
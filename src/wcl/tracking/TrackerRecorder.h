@@ -0,0 +1,127 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_TRACKERRECORDER_H
+#define WCL_TRACKING_TRACKERRECORDER_H
+
+#include <map>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+#include <wcl/tracking/Tracker.h>
+
+namespace wcl
+{
+	/**
+	 * Records every update of another tracker to a file that a
+	 * ReplayTracker can play back, so tracking code can be run and
+	 * profiled without the tracking hardware.
+	 *
+	 * The recorder is itself a tracker, put it in place of the one it
+	 * records. Each update writes a frame with the time and the pose,
+	 * visibility and confidence of every object. The file is a compact
+	 * binary format meant to be memory mapped, in host byte order.
+	 */
+	class WCL_API TrackerRecorder : public Tracker
+	{
+		public:
+			/**
+			 * @param source The tracker to record, which must
+			 *               outlive the recorder
+			 * @param path The file to write, replaced if it exists
+			 * @throw Exception if the file can't be created
+			 */
+			TrackerRecorder(Tracker &source, const std::string &path) throw (Exception);
+
+			/**
+			 * Closes the recording
+			 */
+			~TrackerRecorder();
+
+			/**
+			 * Update the recorded tracker and record the result
+			 *
+			 * @throw Exception if the frame can't be written
+			 */
+			virtual void update();
+
+			/**
+			 * Record the current state of the tracker without
+			 * updating it.
+			 *
+			 * @throw Exception if the frame can't be written
+			 */
+			void record() throw (Exception);
+
+			virtual TrackedObject* getObject(std::string name);
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+
+			/**
+			 * Set the units of the recorded tracker. Frames are
+			 * marked with the units, so a ReplayTracker can convert
+			 * them.
+			 */
+			virtual void setUnits(Units u);
+
+			/**
+			 * Write out buffered frames
+			 */
+			void flush();
+
+			/**
+			 * The number of frames recorded
+			 */
+			unsigned getFramesWritten() const;
+
+			Tracker &getSource();
+
+		private:
+			Tracker &source;
+			FILE *file;
+			int units;
+			unsigned framesWritten;
+
+			/**
+			 * Ids given to objects, in the order they appeared
+			 */
+			std::map<TrackedObject *, uint32_t> ids;
+			std::vector<unsigned char> buffer;
+
+			uint32_t getId(TrackedObject *object);
+			void write(const void *data, const size_t size);
+
+			TrackerRecorder(const TrackerRecorder &);
+			TrackerRecorder &operator =(const TrackerRecorder &);
+	};
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Private to the tracker recorder, the layout of a recording written by
+ * TrackerRecorder and played by ReplayTracker. Only include this from
+ * source files.
+ *
+ * A recording is meant to be mapped and read in place, so everything is a
+ * plain struct in host byte order, aligned to 8 bytes. The file header is
+ * followed by records, each starting with a RecordHeader giving its type
+ * and its size including padding. An OBJECT record introduces an object
+ * before the first frame it appears in. A FRAME record holds the state of
+ * every object after one update.
+ */
+#ifndef WCL_TRACKING_TRACKERRECORDING_H
+#define WCL_TRACKING_TRACKERRECORDING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace wcl
+{
+namespace TrackerRecording
+{
+    const uint32_t MAGIC = 0x544c4357; // "WCLT"
+    const uint32_t ENDIAN_MARK = 0x01020304;
+    const uint16_t FORMAT_VERSION = 1;
+
+    enum RecordType {
+	OBJECT = 1,
+	FRAME = 2
+    };
+
+    enum Flags {
+	VISIBLE = 1
+    };
+
+    struct FileHeader {
+	uint32_t magic;
+	uint32_t byteOrder;
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t reserved;
+	uint64_t created; // usec since the epoch
+	uint64_t reserved2;
+    };
+
+    struct RecordHeader {
+	uint32_t type;
+	uint32_t size;
+    };
+
+    /**
+     * Followed by the name, nul terminated
+     */
+    struct ObjectRecord {
+	RecordHeader header;
+	uint32_t id;
+	uint32_t type;
+    };
+
+    struct ObjectState {
+	double position[3];
+	double orientation[4]; // w, x, y, z
+	uint32_t id;
+	float confidence;
+	uint8_t type;
+	uint8_t flags;
+	uint16_t reserved;
+	uint32_t reserved2;
+    };
+
+    /**
+     * Followed by count ObjectStates
+     */
+    struct FrameRecord {
+	RecordHeader header;
+	uint64_t timestamp; // usec since the epoch
+	uint32_t count;
+	uint8_t units;
+	uint8_t reserved[3];
+    };
+
+    inline size_t align(const size_t size)
+    {
+	return (size + 7) & ~(size_t)7;
+    }
+};
+};
+
+#endif
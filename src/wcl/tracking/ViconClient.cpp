@@ -35,11 +35,41 @@
 #include "config.h"
 #include "ViconClient.h"
 #include "../Exception.h"
+#include "../IO.h"
 #include <iostream>
+#include <sys/socket.h>
 
 using namespace std;
 using namespace wcl;
 
+/**
+ * Receives frames from the server until stopped or the connection fails
+ */
+class ViconClient::ReceiveThread : public Thread
+{
+	public:
+		ReceiveThread(ViconClient *iclient) : client(iclient) {}
+
+	protected:
+		void run()
+		{
+			try
+			{
+				while (client->running)
+					client->receive();
+			}
+			catch (Exception &e)
+			{
+				if (client->running)
+					wclclog << "ViconClient: Connection lost, " << e.what() << endl;
+			}
+			client->failed = true;
+		}
+
+	private:
+		ViconClient *client;
+};
+
 
 /**
  * Reverses the order of bytes in an int.
@@ -106,24 +136,76 @@ int32_t ViconClient::REQUEST = 0;
 int32_t ViconClient::REPLY = 1;
 #endif
 
-ViconClient::ViconClient(std::string hostname, int port)
-	: units(MM)
+ViconClient::ViconClient(std::string hostname, int port, unsigned timeout)
+	: thread(NULL), running(false), failed(false),
+	  framesReceived(0), time(0), timestamp(0), frameNumber(0), framesSkipped(0),
+	  units(MM)
 {
 
-	this->socket = new TCPSocket(hostname, port);
+	this->socket = new TCPSocket(hostname, port, timeout == 0);
+	if (timeout)
+	{
+		try
+		{
+			socket->setTimeout(timeout);
+			socket->connect(timeout);
+		}
+		catch (SocketException &)
+		{
+			delete this->socket;
+			throw;
+		}
+	}
 	socket->setBlockingMode(socket->BLOCKING);
-	loadTrackedObjects();
+	this->stream = new SocketStream(*this->socket);
+
+	try
+	{
+		loadTrackedObjects();
+
+		// Every frame has a value per channel, allocate for them now
+		Snapshot empty;
+		empty.values.resize(channelNames.size());
+		empty.timestamp = 0;
+		empty.number = 0;
+		snapshots.reset(empty);
 
-	isStreaming = false;
+		//turn on streaming yeah!
+		stream->writeInt32(ViconClient::STREAMING_ON, SocketStream::HOST);
+		stream->writeInt32(ViconClient::REQUEST, SocketStream::HOST);
+		stream->flush();
+	}
+	catch (Exception &)
+	{
+		delete this->stream;
+		delete this->socket;
+		throw;
+	}
+
+	running = true;
+	thread = new ReceiveThread(this);
+	thread->start();
 }
 
 
 ViconClient::~ViconClient()
 {
+	// Shutting the socket down wakes the receiving thread
+	running = false;
+	::shutdown(**socket, SHUT_RDWR);
+	thread->join();
+	delete thread;
+
 	socket->close();
+	delete this->stream;
 	delete this->socket;
 }
 
+void ViconClient::setTimeout(unsigned milliseconds)
+{
+	socket->setTimeout(milliseconds);
+}
+
 void ViconClient::setUnits(Units u)
 {
 	this->units = u;
@@ -134,77 +216,32 @@ void ViconClient::setUnits(Units u)
 
 std::vector<std::string> ViconClient::getChannelNames()
 {
-	std::vector<std::string> list;
-	
-	//This is taken from the example source...
-	if (!socket->isValid())
-	{
-		throw Exception("Error: Trying to get channel names, but socket is not valid");
-	}
-	//send it an info request...
-	int32_t request[] = {ViconClient::INFO, ViconClient::REQUEST};
-
-	socket->writeUntil(request, 8);
-
-	int32_t packet;
-	int32_t type;
-	
-	socket->readUntil(&packet, 4);
-	socket->readUntil(&type, 4);
-
-
-	//make sure we're getting the right data back!
-	if (packet == ViconClient::INFO && type == ViconClient::REPLY)
-	{
-		int32_t numChannels;
-		socket->readUntil(&numChannels, 4);
-
-		#ifdef WORDS_BIGENDIAN
-		numChannels = reverseByteOrder(numChannels);
-		#endif
-
-		for (int i=0;i<numChannels;i++)
-		{
-			list.push_back(readChannel());
-		}
-		return list;		
-		
-	}
-	return list;
+	// The server only sends the names once, before streaming starts
+	return channelNames;
 }
 
 
 void ViconClient::loadTrackedObjects()
 {
 	// Make a request for info...
-	int32_t info = ViconClient::INFO;
-	int32_t request = ViconClient::REQUEST;
 	if (!socket->isValid())
 	{
 		throw Exception("Socket is not open!");
 	}
 	
 	//send it an info request...
-	socket->writeUntil(&info, 4);
-	socket->writeUntil(&request, 4);
-	
-	int32_t packet;
-	int32_t type;
+	stream->writeInt32(ViconClient::INFO, SocketStream::HOST);
+	stream->writeInt32(ViconClient::REQUEST, SocketStream::HOST);
+	stream->flush();
 	
-	socket->readUntil(&packet, 4);
-	socket->readUntil(&type, 4);
-
+	int32_t packet = stream->readInt32(SocketStream::HOST);
+	int32_t type = stream->readInt32(SocketStream::HOST);
 	
 	//make sure we're getting the right data back!
 	if (packet == ViconClient::INFO && type == ViconClient::REPLY)
 	{
 		
-		int32_t numChannels;
-		socket->readUntil(&numChannels, 4);
-
-		#ifdef WORDS_BIGENDIAN
-		numChannels = reverseByteOrder(numChannels);
-		#endif
+		int32_t numChannels = stream->readInt32(SocketStream::LITTLE);
 
 		//cout << "We are expecting " << numChannels << " channels" << endl;
 
@@ -219,6 +256,7 @@ void ViconClient::loadTrackedObjects()
 			 * we actually have.
 			 */
 			std::string channel = readChannel();
+			channelNames.push_back(channel);
 
 			//The real name is the first part of the name, so we can leave anything beyond the space
 			channel = channel.substr(0, channel.find(" "));
@@ -297,71 +335,113 @@ vector<TrackedObject *> ViconClient::getAllObjects()
 }
 
 
+unsigned ViconClient::getObjectCount()
+{
+	return objects.size();
+}
+
+TrackedObject *ViconClient::getObjectAt(const unsigned index)
+{
+	return index < objects.size() ? &objects[index] : NULL;
+}
+
+
 void ViconClient::update()
 {
-	if (!isStreaming)
+	// Hand back the frame we had and take the newest
+	if (!snapshots.take())
 	{
-		//turn on streaming yeah!
-		int32_t data = ViconClient::STREAMING_ON;
-		int32_t request = ViconClient::REQUEST;
-		socket->writeUntil(&data, 4);
-		socket->writeUntil(&request, 4);
-		isStreaming = true;
+		if (failed)
+			throw Exception("ViconClient: Connection to the server lost");
+		return;
+	}
+	Snapshot &s = snapshots.getFront();
+
+	if (frameNumber > 0 && s.number > frameNumber + 1)
+		framesSkipped += s.number - frameNumber - 1;
+	frameNumber = s.number;
+	timestamp = s.timestamp;
+	#ifdef WORDS_BIGENDIAN
+	time = s.values.empty() ? 0 : reverseBytesDouble(s.values[0]);
+	#else
+	time = s.values.empty() ? 0 : s.values[0];
+	#endif
+
+	int offset = 1;
+	for (unsigned int i=0;i<objects.size();i++) {
+		objects[i].updateData(&s.values[0], offset);
 	}
 
-	int32_t packet[2];
-	socket->readUntil(packet, 8);
+	recordPoses(timestamp);
+}
 
-	if (packet[0] == ViconClient::DATA && packet[1] == ViconClient::REPLY)
-	{
-	
-		int32_t count;
-		socket->readUntil(&count, 4);
+void ViconClient::receive()
+{
+	Snapshot &s = snapshots.getBack();
 
-		#ifdef WORDS_BIGENDIAN
-		count = reverseByteOrder(count);
-		#endif
+	// packet, type and channel count
+	int32_t header[3];
+	stream->read(header, sizeof(header));
 
-		double* values = new double[count];
+	if (header[0] != ViconClient::DATA || header[1] != ViconClient::REPLY)
+	{
+		throw Exception("Unexpected packet type");
+	}
 
-		// read all values in one big block
-		socket->readUntil(values, 8*count);
+	#ifdef WORDS_BIGENDIAN
+	int32_t count = reverseByteOrder(header[2]);
+	#else
+	int32_t count = header[2];
+	#endif
 
-		int offset = 1;
-		for (unsigned int i=0;i<objects.size();i++) {
-			objects[i].updateData(values, offset);
-		}
-		
-		delete values;
-	}
-	else 
+	if (count != (int32_t)s.values.size())
 	{
-		throw Exception("Unexpected packet type");
+		throw Exception("Frame doesn't match the channels");
 	}
+
+	// read all values in one big block, the objects swap them as needed
+	if (count > 0)
+		stream->read(&s.values[0], 8*count);
+
+	s.timestamp = getCurrentTime();
+	s.number = framesReceived + 1;
+
+	// Publish the frame, and take whichever update() isn't using
+	snapshots.publish();
+	framesReceived = s.number;
+}
+
+double ViconClient::getFrameTime() const
+{
+	return time;
+}
+
+uint64_t ViconClient::getTimestamp() const
+{
+	return timestamp;
+}
+
+uint64_t ViconClient::getFramesReceived() const
+{
+	return framesReceived;
+}
+
+uint64_t ViconClient::getFramesSkipped() const
+{
+	return framesSkipped;
 }
 
 std::string ViconClient::readChannel() 
 {
 	if (socket->isValid())
 	{
-		int32_t letterCount;
-		socket->readUntil(&letterCount, 4);
+		int32_t letterCount = stream->readInt32(SocketStream::LITTLE);
 
 		//cout << "The length of this channel name is " << letterCount << " letters" << endl;
 
-		#ifdef WORDS_BIGENDIAN
-		letterCount = reverseByteOrder(letterCount);
-		#endif
-
-		char *name = new char[letterCount+1];
-
-		socket->readUntil(name, letterCount);
-		name[letterCount] = '\0';
-		
-		delete name;
-		
-		//cout << "New channel is " << std::string(name) << endl;
-		return std::string(name);
+		// Names may be padded with nulls
+		std::string name = stream->readString(letterCount);
+		return name.substr(0, name.find('\0'));
 	}
 	return 0;
 }
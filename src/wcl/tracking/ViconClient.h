@@ -39,7 +39,10 @@
 #include <stdint.h>
 #include <wcl/api.h>
 #include <wcl/network/TCPSocket.h>
+#include <wcl/network/SocketStream.h>
 #include <wcl/tracking/Tracker.h>
+#include <wcl/util/Thread.h>
+#include <wcl/util/TripleBuffer.h>
 #include "ViconTrackedObject.h"
 
 
@@ -53,6 +56,12 @@ namespace wcl
 	 * You then call update() to get the latest data from the system,
 	 * so update() will probabaly be called inside your render loop.
 	 *
+	 * Frames are received by a background thread as the server streams
+	 * them, into buffers allocated when the client connects. The newest
+	 * frame is handed to update() through a lock free triple buffer, so
+	 * neither the receiving thread nor update() ever wait on each other
+	 * and update() never blocks.
+	 *
 	 * To get data from the system you can just hold a reference to one
 	 * of the TrackedObjects. For example, using OpenSceneGraph you
 	 * would create a Callback node that stores a TrackedObject and then
@@ -88,8 +97,10 @@ namespace wcl
 			 * 
 			 * @param hostname The hostname (or IP) of the server to connect to.
 			 * @param port The port to connect to, by default this is 800.
+			 * @param timeout The time in milliseconds to wait for the server
+			 *        when connecting and reading, 0 waits forever.
 			 */
-			ViconClient(std::string hostname, int port=800);
+			ViconClient(std::string hostname, int port=800, unsigned timeout=0);
 
 			/**
 			 * Destructor.
@@ -105,18 +116,48 @@ namespace wcl
 			 * To get the encapsulated data, the objects vector should be used.
 			 * 
 			 * @return A vector containing the list of channel names.
-			 * @throw Throws a std::string if the connection to the server fails.
 			 */
 			std::vector<std::string> getChannelNames(); 
 
 			/**
-			 * Fills the tracked objects with the latest frame of data from the server.
+			 * Fills the tracked objects with the newest frame received
+			 * from the server. If no frame has arrived since the last
+			 * call the objects are left as they are. This never blocks.
 			 *
-			 * @throw Throws a std::string if the connection fails or invalid data is received
-			 *        from the server.
+			 * @throw Exception if the connection to the server has been
+			 *        lost or the server sent invalid data.
 			 */
 			virtual void update();
 
+			/**
+			 * Limit how long the server is waited for. Once set, the
+			 * connection is taken as lost if the server stops sending
+			 * frames for this long.
+			 *
+			 * @param milliseconds The time to wait, 0 waits forever.
+			 */
+			void setTimeout(unsigned milliseconds);
+
+			/**
+			 * The value of the Time channel of the frame last applied
+			 * by update().
+			 */
+			double getFrameTime() const;
+
+			/**
+			 * When the frame last applied by update() was received, in
+			 * microseconds since the epoch.
+			 */
+			uint64_t getTimestamp() const;
+
+			/**
+			 * The number of frames received from the server, and the
+			 * number of those update() never applied because a newer
+			 * frame arrived first.
+			 */
+			uint64_t getFramesReceived() const;
+			uint64_t getFramesSkipped() const;
+
 			/**
 			 * Gets a tracked object with the specified name.
 			 * 
@@ -130,6 +171,8 @@ namespace wcl
 			 * Get all Tracked objects
 			 */
 			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
 
 			virtual void setUnits(Units u);
 
@@ -158,15 +201,51 @@ namespace wcl
 			static double reverseBytesDouble(double n);
 
 		private:
+			class ReceiveThread;
+			friend class ReceiveThread;
+
+			/**
+			 * A frame as received from the server. Once handed over it
+			 * isn't changed until update() hands it back.
+			 */
+			struct Snapshot
+			{
+				std::vector<double> values;
+				uint64_t timestamp;
+				uint64_t number;
+			};
+
 			/**
 			 * The socket handling the connection to the server.
 			 */
 			TCPSocket* socket;
 
+			/**
+			 * Buffers the connection so each message is read with
+			 * as few system calls as possible.
+			 */
+			SocketStream* stream;
+
+			/**
+			 * Frames from the receiving thread, which fills the
+			 * back, to update(), which reads the front.
+			 */
+			TripleBuffer<Snapshot> snapshots;
+
+			ReceiveThread *thread;
+			volatile bool running;
+			volatile bool failed;
+			volatile uint64_t framesReceived;
+
 			/**
 			 * The current frame that we have received data for.
 			 */
 			double time;
+			uint64_t timestamp;
+			uint64_t frameNumber;
+			uint64_t framesSkipped;
+
+			std::vector<std::string> channelNames;
 
 			/**
 			 * Reads a channel name from the server.
@@ -190,8 +269,13 @@ namespace wcl
 			 */
 			void loadTrackedObjects();
 
+			/**
+			 * Read the next frame from the server into the back
+			 * buffer and hand it to update().
+			 */
+			void receive();
+
 			Units units;
-			bool isStreaming;
 
 
 	};
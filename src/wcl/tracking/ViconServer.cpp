@@ -0,0 +1,308 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <time.h>
+
+#include <wcl/IO.h>
+#include <wcl/tracking/ViconServer.h>
+#include "../network/WireFormat.h"
+
+using namespace std;
+
+namespace wcl
+{
+
+// Packets and types, little endian on the wire
+enum { CLOSE = 0, INFO, DATA, STREAMING_ON, STREAMING_OFF };
+enum { REQUEST = 0, REPLY };
+
+static const char * const MARKER_CHANNELS[] = { "<P-X>", "<P-Y>", "<P-Z>", "<P-O>" };
+static const char * const SIX_DOF_CHANNELS[] = { "<A-X>", "<A-Y>", "<A-Z>", "<T-X>", "<T-Y>", "<T-Z>" };
+
+// Connection user data for clients that have asked for streaming
+static char streaming;
+
+/**
+ * Serves clients until stopped
+ */
+class ViconServer::ServerThread: public Thread
+{
+    public:
+	ServerThread(ViconServer *iserver): server(iserver) {}
+
+    protected:
+	void run()
+	{
+	    while( this->server->running ){
+		try {
+		    this->server->reactor.poll(100);
+		} catch( Exception &e ){
+		    wclclog << "ViconServer: Stopping, " << e.what() << endl;
+		    this->server->running = false;
+		}
+	    }
+	}
+
+    private:
+	ViconServer *server;
+};
+
+static double getTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+ViconServer::ViconServer(const unsigned port, const unsigned rate) throw (SocketException):
+    server(port), interval(rate >= 1000 ? 1 : (rate ? 1000 / rate : 0)),
+    framesSent(0), clients(0), running(false), thread(NULL)
+{
+    this->channels.push_back("Time");
+    this->values.push_back(0);
+    this->reactor.listen(this->server, this);
+}
+
+ViconServer::~ViconServer()
+{
+    this->stop();
+}
+
+void ViconServer::addChannels(const std::string &name, const ObjectType type,
+			      const char * const *suffixes, const unsigned count)
+{
+    ScopedLock l(this->lock);
+
+    Object o;
+    o.name = name;
+    o.type = type;
+    o.offset = this->channels.size();
+    this->objects.push_back(o);
+
+    for(unsigned i = 0; i < count; i++ ){
+	this->channels.push_back(name + " " + suffixes[i]);
+	this->values.push_back(0);
+    }
+}
+
+void ViconServer::addMarker(const std::string &name)
+{
+    this->addChannels(name, POSITION, MARKER_CHANNELS, 4);
+}
+
+void ViconServer::addSixDOF(const std::string &name)
+{
+    this->addChannels(name, SIX_DOF, SIX_DOF_CHANNELS, 6);
+}
+
+ViconServer::Object *ViconServer::findObject(const std::string &name)
+{
+    for(unsigned i = 0; i < this->objects.size(); i++ ){
+	if( this->objects[i].name == name )
+	    return &this->objects[i];
+    }
+    return NULL;
+}
+
+bool ViconServer::setMarker(const std::string &name, const double x, const double y,
+			    const double z, const bool visible)
+{
+    ScopedLock l(this->lock);
+    Object *o = this->findObject(name);
+    if( o == NULL || o->type != POSITION )
+	return false;
+
+    // The last channel is occlusion, 0 when visible
+    double *v = &this->values[o->offset];
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+    v[3] = visible ? 0 : 1;
+    return true;
+}
+
+bool ViconServer::setSixDOF(const std::string &name, const double rx, const double ry,
+			    const double rz, const double x, const double y, const double z)
+{
+    ScopedLock l(this->lock);
+    Object *o = this->findObject(name);
+    if( o == NULL || o->type != SIX_DOF )
+	return false;
+
+    double *v = &this->values[o->offset];
+    v[0] = rx;
+    v[1] = ry;
+    v[2] = rz;
+    v[3] = x;
+    v[4] = y;
+    v[5] = z;
+    return true;
+}
+
+void ViconServer::start()
+{
+    if( this->running )
+	return;
+
+    if( this->interval )
+	this->reactor.addTimer(this->interval, this);
+    this->running = true;
+    this->thread = new ServerThread(this);
+    this->thread->start();
+}
+
+void ViconServer::stop()
+{
+    this->running = false;
+    if( this->thread ){
+	this->thread->join();
+	delete this->thread;
+	this->thread = NULL;
+    }
+}
+
+unsigned ViconServer::getClientCount()
+{
+    ScopedLock l(this->lock);
+    return this->clients;
+}
+
+uint64_t ViconServer::getFramesSent()
+{
+    ScopedLock l(this->lock);
+    return this->framesSent;
+}
+
+void ViconServer::connected(TCPConnection *)
+{
+    ScopedLock l(this->lock);
+    this->clients++;
+}
+
+void ViconServer::disconnected(TCPConnection *)
+{
+    ScopedLock l(this->lock);
+    this->clients--;
+}
+
+void ViconServer::dataReceived(TCPConnection *c)
+{
+    while( c->getReadSize() >= 8 ){
+	WireReader r(c->getReadData(), 8);
+	uint32_t packet = r.get32();
+	uint32_t type = r.get32();
+	c->consume(8);
+
+	if( type != REQUEST )
+	    continue;
+
+	switch( packet ){
+	    case INFO:
+		this->writeInfo(c);
+		break;
+	    case DATA:
+		this->writeFrame(c);
+		break;
+	    case STREAMING_ON:
+		c->setUserData(&streaming);
+		break;
+	    case STREAMING_OFF:
+		c->setUserData(NULL);
+		break;
+	    case CLOSE:
+		c->close();
+		return;
+	}
+    }
+}
+
+void ViconServer::timerExpired(const unsigned long)
+{
+    this->reactor.addTimer(this->interval, this);
+
+    const std::list<TCPConnection *> &connections = this->reactor.getConnections();
+    bool built = false;
+    for(std::list<TCPConnection *>::const_iterator it = connections.begin();
+	it != connections.end(); ++it ){
+	TCPConnection *c = *it;
+
+	// Don't queue frames behind a client that isn't keeping up
+	if( c->getUserData() != &streaming || c->getWriteQueueSize() > 0 )
+	    continue;
+	if( !built ){
+	    this->buildFrame();
+	    built = true;
+	}
+	c->write(&this->frame[0], this->frame.size());
+    }
+}
+
+void ViconServer::writeInfo(TCPConnection *c)
+{
+    std::vector<unsigned char> info;
+    WireWriter w(info);
+    w.put32(INFO);
+    w.put32(REPLY);
+
+    ScopedLock l(this->lock);
+    w.put32(this->channels.size());
+    for(unsigned i = 0; i < this->channels.size(); i++ ){
+	const std::string &name = this->channels[i];
+	w.put32(name.size());
+	for(unsigned j = 0; j < name.size(); j++ )
+	    w.put8(name[j]);
+    }
+    c->write(&info[0], info.size());
+}
+
+void ViconServer::writeFrame(TCPConnection *c)
+{
+    this->buildFrame();
+    c->write(&this->frame[0], this->frame.size());
+}
+
+/**
+ * Encode the current values, the buffer is reused for every frame
+ */
+void ViconServer::buildFrame()
+{
+    ScopedLock l(this->lock);
+    this->values[0] = getTime();
+
+    this->frame.clear();
+    WireWriter w(this->frame);
+    w.put32(DATA);
+    w.put32(REPLY);
+    w.put32(this->values.size());
+    for(unsigned i = 0; i < this->values.size(); i++ ){
+	uint64_t bits;
+	memcpy(&bits, &this->values[i], sizeof(bits));
+	w.put64(bits);
+    }
+    this->framesSent++;
+}
+
+};
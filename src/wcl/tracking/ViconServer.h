@@ -0,0 +1,137 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_TRACKING_VICONSERVER_H
+#define WCL_TRACKING_VICONSERVER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/Reactor.h>
+#include <wcl/network/SocketException.h>
+#include <wcl/network/TCPServer.h>
+#include <wcl/tracking/TrackedObject.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+	/**
+	 * A stand in for a Vicon server, speaking enough of the protocol
+	 * for ViconClient to connect and stream from it. It is meant for
+	 * testing and benchmarking without the motion capture hardware.
+	 *
+	 * Markers and six DOF objects are added before the server is
+	 * started, then their poses can be set at any time from any
+	 * thread. Streaming clients are sent a frame at the given rate.
+	 * The Time channel of each frame is the time it was sent, in
+	 * seconds on the monotonic clock, so a client on the same machine
+	 * can measure how old a frame is.
+	 */
+	class WCL_API ViconServer : public TCPConnectionHandler, public TimerHandler
+	{
+		public:
+			/**
+			 * @param port The port to listen on
+			 * @param rate The frames per second to stream, up to 1000
+			 * @throw SocketException if the port can't be used
+			 */
+			ViconServer(const unsigned port = 800, const unsigned rate = 100) throw (SocketException);
+			~ViconServer();
+
+			/**
+			 * Add objects, only before the server is started
+			 */
+			void addMarker(const std::string &name);
+			void addSixDOF(const std::string &name);
+
+			/**
+			 * Set the pose of an object, positions are in mm
+			 *
+			 * @return false if there is no such object
+			 */
+			bool setMarker(const std::string &name, const double x, const double y,
+				       const double z, const bool visible = true);
+
+			/**
+			 * @param rx,ry,rz The rotation as an axis scaled by the angle in radians
+			 */
+			bool setSixDOF(const std::string &name, const double rx, const double ry,
+				       const double rz, const double x, const double y, const double z);
+
+			/**
+			 * Serve clients from a background thread
+			 */
+			void start();
+			void stop();
+
+			unsigned getClientCount();
+			uint64_t getFramesSent();
+
+			// TCPConnectionHandler and TimerHandler, called from the server thread
+			virtual void connected(TCPConnection *c);
+			virtual void dataReceived(TCPConnection *c);
+			virtual void disconnected(TCPConnection *c);
+			virtual void timerExpired(const unsigned long id);
+
+		private:
+			class ServerThread;
+			friend class ServerThread;
+
+			struct Object {
+				std::string name;
+				ObjectType type;
+				unsigned offset; // Of the first channel
+			};
+
+			TCPServer server;
+			Reactor reactor;
+			unsigned interval;
+
+			std::vector<Object> objects;
+			std::vector<std::string> channels;
+			std::vector<double> values;
+			std::vector<unsigned char> frame;
+			uint64_t framesSent;
+			unsigned clients;
+
+			volatile bool running;
+			ServerThread *thread;
+			Mutex lock;
+
+			Object *findObject(const std::string &name);
+			void addChannels(const std::string &name, const ObjectType type,
+					 const char * const *suffixes, const unsigned count);
+			void writeInfo(TCPConnection *c);
+			void writeFrame(TCPConnection *c);
+			void buildFrame();
+
+			ViconServer(const ViconServer &);
+			ViconServer &operator =(const ViconServer &);
+	};
+};
+
+#endif
@@ -28,76 +28,86 @@
 
 #include <netinet/in.h>
 #include <stdint.h>
+#include <string.h>
 
 namespace wcl
 {
-	VirtualTracker::VirtualTracker(std::string host, unsigned int port)
+	const size_t VirtualTracker::NAME_SIZE;
+	const size_t VirtualTracker::RECORD_SIZE;
+
+	VirtualTracker::VirtualTracker(std::string host, unsigned int port):
+		units(MM), scale(1.0)
 	{
 		socket = new wcl::TCPSocket(host, port);
+		stream = new wcl::SocketStream(*socket);
 	}
 
 	VirtualTracker::~VirtualTracker()
 	{
+		delete stream;
 		delete socket;
 	}
 
 	void VirtualTracker::update()
 	{
-		int32_t objectCount=0;
-		socket->readUntil(&objectCount, 4);
-		objectCount = ntohl(objectCount);
-
-		for (int32_t i=0;i<objectCount;i++)
+		int32_t objectCount = stream->readInt32(SocketStream::BIG);
+		if (objectCount <= 0)
 		{
-			char name[9];
-			name[8] = '\0';
-			socket->readUntil(name, 8);
-			double data[7];
-			VirtualTrackedObject* to;
+			recordPoses(getCurrentTime());
+			return;
+		}
 
-			if ((objects.find(name)) == objects.end())
-			{
-				to = new VirtualTrackedObject(name);
-				objects[name] = to;
-			}
-			else
-			{
-				to = objects[name];
-			}
-			socket->readUntil(data, 56);
+		// Wait for the whole frame so it is parsed straight out of the
+		// stream's buffer
+		const size_t size = (size_t)objectCount * RECORD_SIZE;
+		const unsigned char *record = stream->peek(size);
 
+		if (frameObjects.size() < (size_t)objectCount)
+		{
+			frameNames.resize(objectCount * NAME_SIZE, 0);
+			frameObjects.resize(objectCount, NULL);
+		}
 
-			switch (units)
+		for (int32_t i=0;i<objectCount;i++, record += RECORD_SIZE)
+		{
+			// Servers send the objects in the same order every frame,
+			// so the name only needs looking up when it changes
+			VirtualTrackedObject* to = frameObjects[i];
+			char *known = &frameNames[i * NAME_SIZE];
+			if (to == NULL || memcmp(known, record, NAME_SIZE) != 0)
 			{
-				case MM:
-					to->setData(data[0],
-							    data[1],
-							    data[2],
-							    data[3],
-							    data[4],
-							    data[5],
-							    data[6]);
-					break;
-				case CM:
-					to->setData(data[0]/10.0,
-							    data[1]/10.0,
-							    data[2]/10.0,
-							    data[3],
-							    data[4],
-							    data[5],
-							    data[6]);
-					break;
-				case INCHES:
-					to->setData(data[0]/25.4,
-							    data[1]/25.4,
-							    data[2]/25.4,
-							    data[3],
-							    data[4],
-							    data[5],
-							    data[6]);
-					break;
+				char name[NAME_SIZE + 1];
+				memcpy(name, record, NAME_SIZE);
+				name[NAME_SIZE] = '\0';
+
+				std::map<std::string, VirtualTrackedObject*>::iterator it = objects.find(name);
+				if (it == objects.end())
+				{
+					to = new VirtualTrackedObject(name);
+					objects[name] = to;
+					objectList.push_back(to);
+				}
+				else
+				{
+					to = it->second;
+				}
+				memcpy(known, record, NAME_SIZE);
+				frameObjects[i] = to;
 			}
+
+			double data[7];
+			memcpy(data, record + NAME_SIZE, sizeof(data));
+			to->setData(data[0] * scale,
+				    data[1] * scale,
+				    data[2] * scale,
+				    data[3],
+				    data[4],
+				    data[5],
+				    data[6]);
 		}
+		stream->consume(size);
+
+		recordPoses(getCurrentTime());
 	}
 
 	TrackedObject* VirtualTracker::getObject(std::string name)
@@ -109,9 +119,25 @@ namespace wcl
 		return NULL;
 	}
 
+	std::vector<TrackedObject *> VirtualTracker::getAllObjects()
+	{
+		return std::vector<TrackedObject *>(objectList.begin(), objectList.end());
+	}
+
+	unsigned VirtualTracker::getObjectCount()
+	{
+		return objectList.size();
+	}
+
+	TrackedObject *VirtualTracker::getObjectAt(const unsigned index)
+	{
+		return index < objectList.size() ? objectList[index] : NULL;
+	}
+
 	void VirtualTracker::setUnits(Units u)
 	{
 		this->units = u;
+		this->scale = 1.0 / getMillimetres(u);
 	}
 
 }
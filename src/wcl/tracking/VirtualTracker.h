@@ -32,6 +32,7 @@
 
 #include <wcl/api.h>
 #include <wcl/network/TCPSocket.h>
+#include <wcl/network/SocketStream.h>
 #include <wcl/tracking/VirtualTrackedObject.h>
 #include <wcl/tracking/Tracker.h>
 
@@ -62,6 +63,13 @@ namespace wcl
 			 */
 			virtual TrackedObject* getObject(std::string name);
 
+			/**
+			 * Returns all the objects received from the server so far.
+			 */
+			virtual std::vector<TrackedObject *> getAllObjects();
+			virtual unsigned getObjectCount();
+			virtual TrackedObject *getObjectAt(const unsigned index);
+
 			/**
 			 * Sets the units of measurements used by the tracker.
 			 *
@@ -69,10 +77,28 @@ namespace wcl
 			 */
 			virtual void setUnits(Units u);
 
+			/**
+			 * Each object is sent as an 8 byte name followed by
+			 * the position in mm and the orientation as 7 doubles.
+			 */
+			static const size_t NAME_SIZE = 8;
+			static const size_t RECORD_SIZE = NAME_SIZE + 7 * sizeof(double);
+
 		private:
 			std::map<std::string, VirtualTrackedObject*> objects;
+			std::vector<VirtualTrackedObject *> objectList;
+
+			/**
+			 * The name and object at each position of the last
+			 * frame.
+			 */
+			std::vector<char> frameNames;
+			std::vector<VirtualTrackedObject *> frameObjects;
+
 			Units units;
+			double scale;
 			wcl::TCPSocket * socket;
+			wcl::SocketStream * stream;
 
 	};
 
@@ -0,0 +1,248 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include <wcl/IO.h>
+#include <wcl/tracking/VirtualTracker.h>
+#include <wcl/tracking/VirtualTrackerPublisher.h>
+
+// Without MSG_NOSIGNAL the SIGPIPE blocked by Socket does the job
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+using namespace std;
+
+namespace wcl
+{
+
+/**
+ * Updates and publishes the tracker until stopped
+ */
+class VirtualTrackerPublisher::PublisherThread: public Thread
+{
+    public:
+	PublisherThread(VirtualTrackerPublisher *ipublisher): publisher(ipublisher) {}
+
+    protected:
+	void run()
+	{
+	    while( this->publisher->running ){
+		try {
+		    this->publisher->update();
+		} catch( Exception &e ){
+		    wclclog << "VirtualTrackerPublisher: Stopping, " << e.what() << endl;
+		    this->publisher->running = false;
+		}
+	    }
+	}
+
+    private:
+	VirtualTrackerPublisher *publisher;
+};
+
+VirtualTrackerPublisher::VirtualTrackerPublisher(Tracker *itracker, const unsigned port)
+    throw (SocketException):
+    tracker(itracker), server(port), skippedFrames(0), running(false), thread(NULL)
+{
+    this->server.setBlockingMode(Socket::NONBLOCKING);
+    this->tracker->setUnits(Tracker::MM);
+}
+
+VirtualTrackerPublisher::~VirtualTrackerPublisher()
+{
+    this->stop();
+    for(unsigned i = 0; i < this->clients.size(); i++ ){
+	delete this->clients[i]->socket;
+	delete this->clients[i];
+    }
+}
+
+void VirtualTrackerPublisher::accept()
+{
+    for(;;){
+	TCPSocket *socket = new TCPSocket();
+	socket->setBlockingMode(Socket::NONBLOCKING);
+	if( !this->server.accept(socket)){
+	    delete socket;
+	    return;
+	}
+
+	// Frames are small and latency matters more than packing
+	int on = 1;
+	setsockopt(**socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+	Client *c = new Client;
+	c->socket = socket;
+	c->pendingOffset = 0;
+	this->clients.push_back(c);
+    }
+}
+
+void VirtualTrackerPublisher::publish()
+{
+    this->accept();
+    if( this->clients.empty())
+	return;
+
+    unsigned objects = this->tracker->getObjectCount();
+    this->buffer.resize(sizeof(uint32_t) + objects * VirtualTracker::RECORD_SIZE);
+
+    uint32_t count = htonl(objects);
+    memcpy(&this->buffer[0], &count, sizeof(count));
+
+    unsigned char *record = &this->buffer[sizeof(count)];
+    for(unsigned i = 0; i < objects; i++, record += VirtualTracker::RECORD_SIZE ){
+	TrackedObject *t = this->tracker->getObjectAt(i);
+	string name = t->getName();
+	memset(record, 0, VirtualTracker::NAME_SIZE);
+	memcpy(record, name.data(), min(name.size(), VirtualTracker::NAME_SIZE));
+
+	Vector position = t->getTranslation();
+	Quaternion orientation = t->getOrientation();
+	double data[7] = { position[0], position[1], position[2],
+			   orientation.w, orientation.x, orientation.y, orientation.z };
+	memcpy(record + VirtualTracker::NAME_SIZE, data, sizeof(data));
+    }
+
+    for(unsigned i = 0; i < this->clients.size(); ){
+	Client *c = this->clients[i];
+	if( this->send(c)){
+	    i++;
+	    continue;
+	}
+	delete c->socket;
+	delete c;
+	this->clients.erase(this->clients.begin() + i);
+    }
+}
+
+/**
+ * Write as much of a client's queued frame as the socket takes
+ *
+ * @return false if the client has gone
+ */
+bool VirtualTrackerPublisher::flush(Client *c)
+{
+    while( c->pendingOffset < c->pending.size()){
+	ssize_t amount = ::send(**c->socket, &c->pending[c->pendingOffset],
+				c->pending.size() - c->pendingOffset, MSG_DONTWAIT | MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    return errno == EAGAIN || errno == EWOULDBLOCK;
+	}
+	c->pendingOffset += amount;
+    }
+
+    c->pending.clear();
+    c->pendingOffset = 0;
+    return true;
+}
+
+/**
+ * Send the frame in buffer to a client, or skip it if the client hasn't
+ * taken the previous frame yet. Frames are never split between writes of
+ * other frames, so the client only ever sees whole frames.
+ *
+ * @return false if the client has gone
+ */
+bool VirtualTrackerPublisher::send(Client *c)
+{
+    if( !this->flush(c))
+	return false;
+    if( !c->pending.empty()){
+	this->skippedFrames++;
+	return true;
+    }
+
+    // Write directly, only the part that doesn't fit is copied
+    size_t offset = 0;
+    while( offset < this->buffer.size()){
+	ssize_t amount = ::send(**c->socket, &this->buffer[offset], this->buffer.size() - offset,
+				MSG_DONTWAIT | MSG_NOSIGNAL);
+	if( amount == -1 ){
+	    if( errno == EINTR )
+		continue;
+	    if( errno != EAGAIN && errno != EWOULDBLOCK )
+		return false;
+	    break;
+	}
+	offset += amount;
+    }
+
+    c->pending.assign(this->buffer.begin() + offset, this->buffer.end());
+    c->pendingOffset = 0;
+    return true;
+}
+
+void VirtualTrackerPublisher::update()
+{
+    this->tracker->update();
+    this->publish();
+}
+
+void VirtualTrackerPublisher::start()
+{
+    if( this->running )
+	return;
+
+    this->running = true;
+    this->thread = new PublisherThread(this);
+    this->thread->start();
+}
+
+void VirtualTrackerPublisher::stop()
+{
+    this->running = false;
+    if( this->thread ){
+	this->thread->join();
+	delete this->thread;
+	this->thread = NULL;
+    }
+}
+
+bool VirtualTrackerPublisher::isRunning() const
+{
+    return this->running;
+}
+
+unsigned VirtualTrackerPublisher::getClientCount() const
+{
+    return this->clients.size();
+}
+
+uint64_t VirtualTrackerPublisher::getSkippedFrames() const
+{
+    return this->skippedFrames;
+}
+
+};
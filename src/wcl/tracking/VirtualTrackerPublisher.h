@@ -0,0 +1,123 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_TRACKING_VIRTUALTRACKERPUBLISHER_H
+#define WCL_TRACKING_VIRTUALTRACKERPUBLISHER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <wcl/api.h>
+#include <wcl/network/SocketException.h>
+#include <wcl/network/TCPServer.h>
+#include <wcl/network/TCPSocket.h>
+#include <wcl/tracking/Tracker.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+	/**
+	 * Serves the state of a tracker to VirtualTrackers over TCP.
+	 *
+	 * Each publish sends every connected client a frame of the object
+	 * count as a big endian 32 bit integer followed by, for each object,
+	 * its name padded or cut to 8 bytes and its position in mm and
+	 * orientation as 7 doubles in host order. The publisher sets the units
+	 * of the tracker to MM.
+	 *
+	 * Clients are accepted as they connect and dropped when a write to
+	 * them fails. Writes never block, a client still busy with the last
+	 * frame skips this one so it can't hold up the others.
+	 */
+	class WCL_API VirtualTrackerPublisher
+	{
+		public:
+			/**
+			 * @param tracker The tracker to publish, not owned by the publisher
+			 * @param port The port to listen on
+			 * @throw SocketException if the port can't be listened on
+			 */
+			VirtualTrackerPublisher(Tracker *tracker, const unsigned port) throw (SocketException);
+			~VirtualTrackerPublisher();
+
+			/**
+			 * Accept any waiting clients and send them all the
+			 * current state of the tracker without updating it
+			 */
+			void publish();
+
+			/**
+			 * Update the tracker and publish the result
+			 */
+			void update();
+
+			/**
+			 * Call update continuously from a background thread
+			 */
+			void start();
+			void stop();
+			bool isRunning() const;
+
+			/**
+			 * The number of clients connected at the last publish
+			 */
+			unsigned getClientCount() const;
+
+			/**
+			 * The number of frames not sent to a client because
+			 * it hadn't taken the previous one yet
+			 */
+			uint64_t getSkippedFrames() const;
+
+		private:
+			class PublisherThread;
+			friend class PublisherThread;
+
+			struct Client {
+				TCPSocket *socket;
+				std::vector<unsigned char> pending;
+				size_t pendingOffset;
+			};
+
+			Tracker *tracker;
+			TCPServer server;
+			std::vector<Client *> clients;
+			std::vector<unsigned char> buffer;
+			uint64_t skippedFrames;
+
+			volatile bool running;
+			PublisherThread *thread;
+
+			void accept();
+			bool flush(Client *c);
+			bool send(Client *c);
+
+			VirtualTrackerPublisher(const VirtualTrackerPublisher &);
+			VirtualTrackerPublisher &operator =(const VirtualTrackerPublisher &);
+	};
+};
+
+#endif
@@ -0,0 +1,342 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include <wcl/IO.h>
+#include "SharedMemoryRing.h"
+
+// "WCLR"
+#define MAGIC 0x524c4357
+#define PROTOCOL_VERSION 1
+
+// Keep the header and each slot on their own cache lines
+#define ALIGNMENT 64
+
+using namespace std;
+
+namespace wcl {
+
+/**
+ * The start of the shared memory. The magic is written last, so a reader
+ * that sees it sees a complete header.
+ */
+struct SharedMemoryRing::Header
+{
+    volatile uint32_t magic;
+    uint32_t version;
+    uint32_t slots;
+    volatile uint32_t closed;
+    uint64_t slotSize;
+    volatile uint64_t sequence; // The latest message published
+    volatile int32_t futex;     // Changes with every message, readers wait on it
+    volatile int32_t waiters;   // Readers waiting, the writer only wakes if there are any
+};
+
+/**
+ * Each slot starts with a sequence lock. While message n is being written
+ * the lock is 2n - 1, once written it is 2n.
+ */
+struct SharedMemoryRing::Slot
+{
+    volatile uint64_t lock;
+    volatile uint64_t length;
+};
+
+static size_t align( const size_t size )
+{
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+static int futex( volatile int32_t *address, const int operation, const int value,
+		  const struct timespec *timeout )
+{
+    return syscall(SYS_futex, address, operation, value, timeout, NULL, 0);
+}
+
+static uint64_t getMilliseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+SharedMemoryRing::SharedMemoryRing( const std::string &iname, const unsigned slots,
+				    const size_t slotSize, const mode_t mode ) throw (Exception):
+    name(iname), writer(true), memory(NULL), size(0), header(NULL)
+{
+    if( slots < 2 )
+	throw Exception("SharedMemoryRing: A ring needs at least two slots");
+
+    std::string path = getPath(name);
+    this->slotStride = align(sizeof(Slot)) + align(slotSize);
+    this->size = align(sizeof(Header)) + slots * this->slotStride;
+
+    int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, mode);
+    if( fd == -1 && errno == EEXIST ){
+	// Only a ring its writer has closed is replaced, another may be
+	// being written to
+	bool closed = false;
+	try {
+	    SharedMemoryRing old(iname);
+	    closed = old.isClosed();
+	} catch( Exception & ){
+	}
+
+	if( !closed ){
+	    wclclog << "SharedMemoryRing: " << path << " exists and hasn't been closed" << endl;
+	    throw Exception("SharedMemoryRing: Ring already exists");
+	}
+
+	// Readers still attached to the old ring keep it until they let go
+	shm_unlink(path.c_str());
+	fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, mode);
+    }
+    if( fd == -1 ){
+	wclclog << "SharedMemoryRing: Can't create " << path << ", " << strerror(errno) << endl;
+	throw Exception("SharedMemoryRing: Can't create shared memory");
+    }
+
+    // Give readers the access asked for whatever the umask
+    fchmod(fd, mode);
+    if( ftruncate(fd, this->size) == -1 ){
+	::close(fd);
+	shm_unlink(path.c_str());
+	throw Exception("SharedMemoryRing: Can't size shared memory");
+    }
+
+    void *m = mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if( m == MAP_FAILED ){
+	shm_unlink(path.c_str());
+	throw Exception("SharedMemoryRing: Can't map shared memory");
+    }
+
+    this->memory = (unsigned char *)m;
+    this->header = (Header *)m;
+    this->header->version = PROTOCOL_VERSION;
+    this->header->slots = slots;
+    this->header->closed = 0;
+    this->header->slotSize = slotSize;
+    this->header->sequence = 0;
+    this->header->futex = 0;
+    this->header->waiters = 0;
+    __sync_synchronize();
+    this->header->magic = MAGIC;
+}
+
+SharedMemoryRing::SharedMemoryRing( const std::string &iname ) throw (Exception):
+    name(iname), writer(false), memory(NULL), size(0), header(NULL), slotStride(0)
+{
+    std::string path = getPath(name);
+    int fd = shm_open(path.c_str(), O_RDWR, 0);
+    if( fd == -1 )
+	throw Exception("SharedMemoryRing: No such ring");
+
+    struct stat st;
+    if( fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(Header)){
+	::close(fd);
+	throw Exception("SharedMemoryRing: Ring isn't ready");
+    }
+
+    this->size = st.st_size;
+    void *m = mmap(NULL, this->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if( m == MAP_FAILED )
+	throw Exception("SharedMemoryRing: Can't map shared memory");
+
+    this->memory = (unsigned char *)m;
+    this->header = (Header *)m;
+
+    bool valid = this->header->magic == MAGIC;
+    __sync_synchronize();
+    if( valid ){
+	this->slotStride = align(sizeof(Slot)) + align(this->header->slotSize);
+	valid = this->header->version == PROTOCOL_VERSION &&
+	    align(sizeof(Header)) + this->header->slots * this->slotStride <= this->size;
+    }
+
+    if( !valid ){
+	munmap(this->memory, this->size);
+	throw Exception("SharedMemoryRing: Not a ring, or not ready");
+    }
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if( this->writer ){
+	// Wake any readers so they notice
+	this->header->closed = 1;
+	__sync_fetch_and_add(&this->header->futex, 1);
+	futex(&this->header->futex, FUTEX_WAKE, INT_MAX, NULL);
+	shm_unlink(getPath(this->name).c_str());
+    }
+    munmap(this->memory, this->size);
+}
+
+unsigned char *SharedMemoryRing::beginWrite()
+{
+    uint64_t next = this->header->sequence + 1;
+    Slot *slot = this->getSlot(next);
+    slot->lock = next * 2 - 1;
+    __sync_synchronize();
+    return (unsigned char *)slot + align(sizeof(Slot));
+}
+
+void SharedMemoryRing::endWrite( const size_t length )
+{
+    uint64_t next = this->header->sequence + 1;
+    Slot *slot = this->getSlot(next);
+    slot->length = length < this->header->slotSize ? length : this->header->slotSize;
+    __sync_synchronize();
+    slot->lock = next * 2;
+    __sync_synchronize();
+    this->header->sequence = next;
+
+    __sync_fetch_and_add(&this->header->futex, 1);
+    if( this->header->waiters > 0 )
+	futex(&this->header->futex, FUTEX_WAKE, INT_MAX, NULL);
+}
+
+void SharedMemoryRing::write( const void *data, const size_t length )
+{
+    unsigned char *slot = this->beginWrite();
+    memcpy(slot, data, length < this->header->slotSize ? length : this->header->slotSize);
+    this->endWrite(length);
+}
+
+bool SharedMemoryRing::wait( const uint64_t sequence, const int timeout ) const
+{
+    uint64_t deadline = getMilliseconds() + (timeout > 0 ? timeout : 0);
+
+    for(;;){
+	int32_t value = this->header->futex;
+	__sync_synchronize();
+	if( this->header->sequence > sequence )
+	    return true;
+	if( this->header->closed || timeout == 0 )
+	    return false;
+
+	struct timespec ts;
+	struct timespec *limit = NULL;
+	if( timeout > 0 ){
+	    uint64_t now = getMilliseconds();
+	    if( now >= deadline )
+		return false;
+	    ts.tv_sec = (deadline - now) / 1000;
+	    ts.tv_nsec = (deadline - now) % 1000 * 1000000;
+	    limit = &ts;
+	}
+
+	// The futex only sleeps if nothing was published since it was read
+	__sync_fetch_and_add(&this->header->waiters, 1);
+	futex(&this->header->futex, FUTEX_WAIT, value, limit);
+	__sync_fetch_and_sub(&this->header->waiters, 1);
+    }
+}
+
+const unsigned char *SharedMemoryRing::read( uint64_t &sequence, size_t &length ) const
+{
+    // The writer may lap the slot between reading the sequence and the
+    // slot, in which case try the newer message
+    for(;;){
+	uint64_t latest = this->header->sequence;
+	__sync_synchronize();
+	if( latest == 0 )
+	    return NULL;
+
+	Slot *slot = this->getSlot(latest);
+	uint64_t lock = slot->lock;
+	__sync_synchronize();
+	size_t l = slot->length;
+	__sync_synchronize();
+	if( lock != latest * 2 || slot->lock != lock )
+	    continue;
+
+	sequence = latest;
+	length = l;
+	return (const unsigned char *)slot + align(sizeof(Slot));
+    }
+}
+
+bool SharedMemoryRing::isValid( const uint64_t sequence ) const
+{
+    __sync_synchronize();
+    return this->getSlot(sequence)->lock == sequence * 2;
+}
+
+uint64_t SharedMemoryRing::getSequence() const
+{
+    return this->header->sequence;
+}
+
+bool SharedMemoryRing::isClosed() const
+{
+    return this->header->closed;
+}
+
+unsigned SharedMemoryRing::getSlotCount() const
+{
+    return this->header->slots;
+}
+
+size_t SharedMemoryRing::getSlotSize() const
+{
+    return this->header->slotSize;
+}
+
+const std::string &SharedMemoryRing::getName() const
+{
+    return this->name;
+}
+
+bool SharedMemoryRing::isWriter() const
+{
+    return this->writer;
+}
+
+SharedMemoryRing::Slot *SharedMemoryRing::getSlot( const uint64_t sequence ) const
+{
+    size_t index = sequence % this->header->slots;
+    return (Slot *)(this->memory + align(sizeof(Header)) + index * this->slotStride);
+}
+
+std::string SharedMemoryRing::getPath( const std::string &name )
+{
+    if( !name.empty() && name[0] == '/' )
+	return name;
+    return "/" + name;
+}
+
+}; // namespace wcl
@@ -0,0 +1,158 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_UTIL_SHAREDMEMORYRING_H
+#define WCL_UTIL_SHAREDMEMORYRING_H
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <string>
+
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+
+namespace wcl {
+
+/**
+ * A SharedMemoryRing passes messages from one writer process to any number
+ * of reader processes on the same host through a POSIX shared memory
+ * object. Messages are written into a ring of fixed size slots, each
+ * guarded by a sequence lock, and readers waiting for a message sleep on a
+ * futex in the shared memory that the writer wakes.
+ *
+ * Readers always see the latest message and read it where it lies in the
+ * shared memory, without copying. A slot is only reused once the writer has
+ * gone all the way around the ring, so a message stays intact until that
+ * many newer messages have been written. isValid tells a reader whether
+ * that has happened to the message it read.
+ *
+ * Readers never block the writer, and a reader that falls behind skips
+ * to the latest message.
+ */
+class WCL_API SharedMemoryRing
+{
+    public:
+	/**
+	 * Create a ring to write to. A ring of the same name is only
+	 * replaced if its writer closed it, one left behind by a writer
+	 * that crashed has to be removed by hand. The ring is removed when
+	 * the writer is destroyed.
+	 *
+	 * @param name The name of the ring, shared with the readers
+	 * @param slots The number of messages the ring holds
+	 * @param slotSize The largest message the ring holds
+	 * @param mode The permissions of the shared memory. Readers map it
+	 *             writable to wait on it, so anyone allowed to read can
+	 *             also write messages. The default keeps the ring to the
+	 *             user that created it.
+	 * @throws Exception if the shared memory couldn't be created, or a
+	 *         ring of the same name exists that hasn't been closed
+	 */
+	SharedMemoryRing( const std::string &name, const unsigned slots,
+			  const size_t slotSize, const mode_t mode = 0600 ) throw (Exception);
+
+	/**
+	 * Attach to a ring created by a writer to read from it
+	 *
+	 * @throws Exception if there is no such ring
+	 */
+	SharedMemoryRing( const std::string &name ) throw (Exception);
+	~SharedMemoryRing();
+
+	/**
+	 * Obtain the slot the next message is to be written into. The
+	 * message is published by endWrite.
+	 *
+	 * @return Space for getSlotSize bytes
+	 */
+	unsigned char *beginWrite();
+	void endWrite( const size_t length );
+
+	/**
+	 * Copy a message into the ring and publish it
+	 */
+	void write( const void *data, const size_t length );
+
+	/**
+	 * Wait for a message newer than the one given to be published
+	 *
+	 * @param sequence The sequence number of the last message seen
+	 * @param timeout The time to wait in milliseconds, 0 returns
+	 *                immediately and -1 waits forever
+	 * @return true if there is a newer message, false if the wait timed
+	 *         out or the writer has gone
+	 */
+	bool wait( const uint64_t sequence, const int timeout ) const;
+
+	/**
+	 * Obtain the latest message without copying it
+	 *
+	 * @param sequence Set to the sequence number of the message
+	 * @param length Set to the length of the message
+	 * @return The message, or NULL if none has been published
+	 */
+	const unsigned char *read( uint64_t &sequence, size_t &length ) const;
+
+	/**
+	 * Is the message still intact, or has the writer reused its slot
+	 */
+	bool isValid( const uint64_t sequence ) const;
+
+	/**
+	 * The sequence number of the latest message, numbers start at 1
+	 */
+	uint64_t getSequence() const;
+
+	/**
+	 * Has the writer destroyed the ring
+	 */
+	bool isClosed() const;
+
+	unsigned getSlotCount() const;
+	size_t getSlotSize() const;
+	const std::string &getName() const;
+	bool isWriter() const;
+
+    private:
+	struct Header;
+	struct Slot;
+
+	std::string name;
+	bool writer;
+	unsigned char *memory;
+	size_t size;
+	Header *header;
+	size_t slotStride;
+
+	Slot *getSlot( const uint64_t sequence ) const;
+	static std::string getPath( const std::string &name );
+
+	SharedMemoryRing( const SharedMemoryRing & );
+	SharedMemoryRing &operator =( const SharedMemoryRing & );
+};
+
+}; // namespace wcl
+
+#endif
@@ -0,0 +1,155 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <errno.h>
+#include <sys/time.h>
+
+#include "Thread.h"
+
+namespace wcl {
+
+Mutex::Mutex()
+{
+    pthread_mutex_init(&this->mutex, NULL);
+}
+
+Mutex::~Mutex()
+{
+    pthread_mutex_destroy(&this->mutex);
+}
+
+void Mutex::lock()
+{
+    pthread_mutex_lock(&this->mutex);
+}
+
+void Mutex::unlock()
+{
+    pthread_mutex_unlock(&this->mutex);
+}
+
+bool Mutex::tryLock()
+{
+    return pthread_mutex_trylock(&this->mutex) == 0;
+}
+
+
+ScopedLock::ScopedLock(Mutex &m):
+    mutex(m)
+{
+    this->mutex.lock();
+}
+
+ScopedLock::~ScopedLock()
+{
+    this->mutex.unlock();
+}
+
+
+Condition::Condition()
+{
+    pthread_cond_init(&this->cond, NULL);
+}
+
+Condition::~Condition()
+{
+    pthread_cond_destroy(&this->cond);
+}
+
+void Condition::wait(Mutex &m)
+{
+    pthread_cond_wait(&this->cond, &m.mutex);
+}
+
+bool Condition::wait(Mutex &m, const unsigned long usec)
+{
+    struct timeval now;
+    struct timespec until;
+
+    gettimeofday(&now, NULL);
+    unsigned long long nsec = (now.tv_usec + (unsigned long long)usec) * 1000ULL;
+    until.tv_sec = now.tv_sec + nsec / 1000000000ULL;
+    until.tv_nsec = nsec % 1000000000ULL;
+
+    return pthread_cond_timedwait(&this->cond, &m.mutex, &until) != ETIMEDOUT;
+}
+
+void Condition::signal()
+{
+    pthread_cond_signal(&this->cond);
+}
+
+void Condition::broadcast()
+{
+    pthread_cond_broadcast(&this->cond);
+}
+
+
+Thread::Thread():
+    running(false)
+{}
+
+Thread::~Thread()
+{
+    // A subclass must join before it is destroyed, as run() is pure
+    // virtual and the thread may still be using the object. We can
+    // only make sure we don't leak the thread here.
+    if( this->running )
+	pthread_detach(this->thread);
+}
+
+void Thread::start()
+{
+    if( this->running )
+	throw Exception("Thread::start: Thread is already running");
+
+    if( pthread_create(&this->thread, NULL, Thread::entry, this) != 0 )
+	throw Exception("Thread::start: Unable to create thread");
+
+    this->running = true;
+}
+
+void Thread::join()
+{
+    if( !this->running )
+	return;
+
+    pthread_join(this->thread, NULL);
+    this->running = false;
+}
+
+bool Thread::isRunning() const
+{
+    return this->running;
+}
+
+void *Thread::entry(void *arg)
+{
+    Thread *t = (Thread *)arg;
+    t->run();
+    return NULL;
+}
+
+}; // namespace wcl
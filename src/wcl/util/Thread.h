@@ -0,0 +1,155 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_UTIL_THREAD_H
+#define WCL_UTIL_THREAD_H
+
+#include <pthread.h>
+#include <wcl/api.h>
+#include <wcl/Exception.h>
+
+namespace wcl {
+
+/**
+ * A thin wrapper around a pthread mutex. The mutex is not recursive.
+ */
+class WCL_API Mutex
+{
+    public:
+	Mutex();
+	~Mutex();
+
+	void lock();
+	void unlock();
+
+	/**
+	 * Attempt to obtain the lock without blocking
+	 *
+	 * @return true if the lock was obtained, false if it is held elsewhere
+	 */
+	bool tryLock();
+
+    private:
+	pthread_mutex_t mutex;
+
+	friend class Condition;
+
+	Mutex(const Mutex &);
+	Mutex &operator =(const Mutex &);
+};
+
+/**
+ * Hold a mutex for the lifetime of the ScopedLock object. This
+ * guarantees the mutex is released even if an exception is thrown.
+ */
+class WCL_API ScopedLock
+{
+    public:
+	ScopedLock(Mutex &m);
+	~ScopedLock();
+
+    private:
+	Mutex &mutex;
+
+	ScopedLock(const ScopedLock &);
+	ScopedLock &operator =(const ScopedLock &);
+};
+
+/**
+ * A condition variable, always used together with a Mutex that the
+ * caller holds when calling wait.
+ */
+class WCL_API Condition
+{
+    public:
+	Condition();
+	~Condition();
+
+	/**
+	 * Atomically release the mutex and wait to be signalled. The mutex
+	 * is held again upon return.
+	 */
+	void wait(Mutex &m);
+
+	/**
+	 * As per wait, but give up after the given number of microseconds.
+	 *
+	 * @return false if the wait timed out, true if signalled
+	 */
+	bool wait(Mutex &m, const unsigned long usec);
+
+	void signal();
+	void broadcast();
+
+    private:
+	pthread_cond_t cond;
+
+	Condition(const Condition &);
+	Condition &operator =(const Condition &);
+};
+
+/**
+ * Base class for anything that wants to run in it's own thread.
+ * Subclasses implement run(), which is called from the new thread once
+ * start() is called. The owner must call join() before the object is
+ * destroyed.
+ */
+class WCL_API Thread
+{
+    public:
+	Thread();
+	virtual ~Thread();
+
+	/**
+	 * Start the thread running
+	 *
+	 * @throws Exception if the thread could not be created or is already running
+	 */
+	void start();
+
+	/**
+	 * Wait for the thread to finish. Safe to call if the thread was
+	 * never started or has already been joined.
+	 */
+	void join();
+
+	bool isRunning() const;
+
+    protected:
+	virtual void run() = 0;
+
+    private:
+	pthread_t thread;
+	bool running;
+
+	static void *entry(void *);
+
+	Thread(const Thread &);
+	Thread &operator =(const Thread &);
+};
+
+}; // namespace wcl
+
+#endif
@@ -0,0 +1,135 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_UTIL_TRIPLEBUFFER_H
+#define WCL_UTIL_TRIPLEBUFFER_H
+
+namespace wcl
+{
+	/**
+	 * Hands values from one thread to another without either waiting.
+	 *
+	 * The writer fills the back buffer and publishes it, the reader
+	 * takes the newest buffer published and reads it at the front. The
+	 * third buffer is passed between them with an atomic exchange, so
+	 * neither blocks the other and a reader that falls behind only
+	 * misses values. A buffer taken by the reader isn't touched by the
+	 * writer until the reader takes another.
+	 *
+	 * Only one thread may write and only one may read.
+	 */
+	template<typename T> class TripleBuffer
+	{
+		public:
+			TripleBuffer() : shared(0), front(1), back(2) {}
+
+			/**
+			 * Set every buffer to a value and forget anything
+			 * published. Only call this while neither thread is
+			 * using the buffer.
+			 */
+			void reset(const T &value)
+			{
+				for (unsigned i = 0; i < 3; i++)
+					buffers[i] = value;
+				shared = 0;
+				front = 1;
+				back = 2;
+			}
+
+			/**
+			 * The buffer the writer fills next
+			 */
+			T &getBack()
+			{
+				return buffers[back];
+			}
+
+			/**
+			 * Hand the back buffer to the reader and take another
+			 * to fill. Only the writer may call this.
+			 */
+			void publish()
+			{
+				__sync_synchronize();
+				back = __sync_lock_test_and_set(&shared, back | FRESH) & ~FRESH;
+			}
+
+			/**
+			 * Whether a buffer has been published that the reader
+			 * hasn't taken
+			 */
+			bool isFresh() const
+			{
+				return shared & FRESH;
+			}
+
+			/**
+			 * Take the newest buffer published, handing back the
+			 * one at the front. Only the reader may call this.
+			 *
+			 * @return false, leaving the front as it was, if
+			 *         nothing has been published since the last take
+			 */
+			bool take()
+			{
+				if (!(shared & FRESH))
+					return false;
+				front = __sync_lock_test_and_set(&shared, front) & ~FRESH;
+				return true;
+			}
+
+			/**
+			 * The buffer the reader took last
+			 */
+			T &getFront()
+			{
+				return buffers[front];
+			}
+
+			const T &getFront() const
+			{
+				return buffers[front];
+			}
+
+		private:
+			/**
+			 * Set in shared when it holds a buffer the reader
+			 * hasn't taken
+			 */
+			enum { FRESH = 4 };
+
+			T buffers[3];
+			volatile int shared;
+			int front;
+			int back;
+
+			TripleBuffer(const TripleBuffer &);
+			TripleBuffer &operator =(const TripleBuffer &);
+	};
+};
+
+#endif
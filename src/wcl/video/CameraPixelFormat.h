@@ -0,0 +1,53 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+/*
+ * Private to the video module, maps camera image formats to libav pixel
+ * formats. Only include this from source files, after config.h.
+ */
+#ifndef WCL_VIDEO_CAMERAPIXELFORMAT_H
+#define WCL_VIDEO_CAMERAPIXELFORMAT_H
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+};
+#include <wcl/camera/Camera.h>
+
+namespace wcl
+{
+/**
+ * Obtain the libav pixel format of frames from a camera. MJPEG frames are
+ * decoded to planar YUV 4:2:2 first. PIX_FMT_NONE is returned for formats
+ * libav can't handle.
+ */
+#ifdef NEW_AVCODEC
+AVPixelFormat getInputPixelFormat(const Camera::ImageFormat format);
+#else
+PixelFormat getInputPixelFormat(const Camera::ImageFormat format);
+#endif
+};
+
+#endif
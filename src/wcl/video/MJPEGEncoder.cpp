@@ -0,0 +1,155 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <string.h>
+
+#include "config.h"
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+};
+#include "MJPEGEncoder.h"
+#include "CameraPixelFormat.h"
+
+#include <wcl/IO.h>
+
+using namespace std;
+
+namespace wcl
+{
+
+MJPEGEncoder::MJPEGEncoder(const unsigned iwidth, const unsigned iheight,
+			   const Camera::ImageFormat iformat,
+			   const unsigned quality) throw (const std::string &):
+    codecContext(NULL), imageConvertContext(NULL), inputFrame(NULL), outputFrame(NULL),
+    width(iwidth), height(iheight), format(iformat), frameNumber(0)
+{
+    if( this->format == Camera::MJPEG || getInputPixelFormat(this->format) == PIX_FMT_NONE )
+	throw std::string("Unsupported Input Format For MJPEG Encoding");
+
+    avcodec_register_all();
+
+    AVCodec *c = avcodec_find_encoder(CODEC_ID_MJPEG);
+    if( c == NULL )
+	throw std::string("Encoding Codec not found");
+
+    this->codecContext = avcodec_alloc_context3(c);
+    if( this->codecContext == NULL )
+	throw std::string("Unable to allocate encoding Codec");
+
+    // Map the quality onto the JPEG quantiser scale, 2 (best) to 31
+    unsigned q = quality < 1 ? 1 : (quality > 100 ? 100 : quality);
+    int qscale = 2 + ((100 - q) * 29) / 99;
+
+    this->codecContext->codec_type = AVMEDIA_TYPE_VIDEO;
+    this->codecContext->width = this->width;
+    this->codecContext->height = this->height;
+    this->codecContext->time_base.num = 1;
+    this->codecContext->time_base.den = 30;
+    this->codecContext->pix_fmt = PIX_FMT_YUVJ420P;
+    this->codecContext->qmin = qscale;
+    this->codecContext->qmax = qscale;
+
+    if( avcodec_open2(this->codecContext, c, NULL) < 0 ){
+	this->destroy();
+	throw std::string("Unable to open encoding Codec");
+    }
+
+#ifdef NEW_AVCODEC
+    this->inputFrame = av_frame_alloc();
+    this->outputFrame = av_frame_alloc();
+#else
+    this->inputFrame = avcodec_alloc_frame();
+    this->outputFrame = avcodec_alloc_frame();
+#endif
+
+    this->outputBuffer.resize(avpicture_get_size(PIX_FMT_YUVJ420P, this->width, this->height));
+    avpicture_fill((AVPicture *)this->outputFrame, &this->outputBuffer[0],
+		   PIX_FMT_YUVJ420P, this->width, this->height);
+    this->imageConvertContext = sws_getContext(this->width, this->height,
+					       getInputPixelFormat(this->format),
+					       this->width, this->height,
+					       PIX_FMT_YUVJ420P, SWS_BICUBIC,
+					       NULL, NULL, NULL);
+    if( this->imageConvertContext == NULL ){
+	this->destroy();
+	throw std::string("Unable to create image conversion context");
+    }
+}
+
+MJPEGEncoder::~MJPEGEncoder()
+{
+    this->destroy();
+}
+
+const unsigned char *MJPEGEncoder::encode(const unsigned char *data, unsigned &size)
+{
+    AVPacket packet;
+    int gotPacket = 0;
+
+    size = 0;
+
+    avpicture_fill((AVPicture *)this->inputFrame, data, getInputPixelFormat(this->format),
+		   this->width, this->height);
+    sws_scale(this->imageConvertContext,
+	      this->inputFrame->data, this->inputFrame->linesize,
+	      0, this->height,
+	      this->outputFrame->data, this->outputFrame->linesize);
+    this->outputFrame->pts = this->frameNumber++;
+
+    av_init_packet(&packet);
+    packet.data = NULL;
+    packet.size = 0;
+    if( avcodec_encode_video2(this->codecContext, &packet, this->outputFrame, &gotPacket) < 0 || !gotPacket ){
+	wclclog << "MJPEGEncoder: Unable to encode frame" << endl;
+	return NULL;
+    }
+
+    // Keep the image buffer between frames, JPEG sizes vary little
+    if( this->image.size() < (unsigned)packet.size )
+	this->image.resize(packet.size);
+    memcpy(&this->image[0], packet.data, packet.size);
+    size = packet.size;
+    av_free_packet(&packet);
+
+    return &this->image[0];
+}
+
+void MJPEGEncoder::destroy()
+{
+    if( this->codecContext ){
+	avcodec_close(this->codecContext);
+	av_free(this->codecContext);
+	this->codecContext = NULL;
+    }
+    sws_freeContext(this->imageConvertContext);
+    this->imageConvertContext = NULL;
+    av_free(this->inputFrame);
+    this->inputFrame = NULL;
+    av_free(this->outputFrame);
+    this->outputFrame = NULL;
+}
+
+};
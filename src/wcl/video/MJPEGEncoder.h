@@ -0,0 +1,95 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef WCL_VIDEO_MJPEGENCODER_H
+#define WCL_VIDEO_MJPEGENCODER_H
+
+#include <string>
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/camera/Camera.h>
+
+struct AVCodecContext;
+struct AVFrame;
+struct SwsContext;
+
+namespace wcl
+{
+    /**
+     * Compress individual camera frames to JPEG images in memory, for
+     * sending over a network rather than writing to a file like
+     * VideoEncoder.
+     */
+    class WCL_API MJPEGEncoder
+    {
+    public:
+	/**
+	 * Create an encoder for frames of the given size and format.
+	 *
+	 * @param width The width of the frames
+	 * @param height The height of the frames
+	 * @param format The camera format of the frames, MJPEG frames are
+	 *               already compressed and are not accepted
+	 * @param quality The image quality from 1 (smallest) to 100 (best)
+	 * @throw std::string if the format is not supported or the codec
+	 *        can't be opened
+	 */
+	MJPEGEncoder(const unsigned width, const unsigned height,
+		     const Camera::ImageFormat format,
+		     const unsigned quality = 80) throw (const std::string &);
+
+	~MJPEGEncoder();
+
+	/**
+	 * Compress a frame. The returned image is valid until the next call.
+	 *
+	 * @param data The frame in the format given when the encoder was created
+	 * @param size Set to the size of the JPEG image
+	 * @return The JPEG image, or NULL if the frame could not be encoded
+	 */
+	const unsigned char *encode(const unsigned char *data, unsigned &size);
+
+    private:
+	AVCodecContext *codecContext;
+	SwsContext *imageConvertContext;
+	AVFrame *inputFrame;
+	AVFrame *outputFrame;
+	std::vector<unsigned char> outputBuffer;
+	std::vector<unsigned char> image;
+	unsigned width;
+	unsigned height;
+	Camera::ImageFormat format;
+	int64_t frameNumber;
+
+	void destroy();
+
+	// Not copyable
+	MJPEGEncoder(const MJPEGEncoder &);
+	MJPEGEncoder &operator =(const MJPEGEncoder &);
+    };
+};
+
+#endif
@@ -24,7 +24,9 @@
  * SUCH DAMAGE.
  */
 #include <assert.h>
+#include <string.h>
 #include "VideoDecoder.h"
+#include "VideoDecoderPool.h"
 
 #include "config.h"
 
@@ -64,10 +66,31 @@ CodecID getCodecID(wcl::VideoDecoder::VideoCodec id)
 namespace wcl
 {
 
-VideoDecoder::VideoDecoder(const std::string &path , const bool iautofpslimit, const bool autoplay)
+/**
+ * The background thread used when decoding ahead, it simply runs
+ * VideoDecoder::decodeLoop until told to stop
+ */
+class VideoDecoder::DecodeThread: public Thread
+{
+public:
+    DecodeThread(VideoDecoder *idecoder): decoder(idecoder) {}
+
+protected:
+    void run() { this->decoder->decodeLoop(); }
+
+private:
+    VideoDecoder *decoder;
+};
+
+VideoDecoder::VideoDecoder(const std::string &path , const bool iautofpslimit, const bool autoplay, const unsigned idecodeAhead, const int codecThreads)
     throw( const std::string &):
-	codecContext(NULL), formatContext(NULL), imageConvertContext(NULL),
-	isvalid(false),playedFrames(0),autoFPSLimit(iautofpslimit), paused(!autoplay)
+	userBuffer(NULL), outputFormat(RGB24),
+	codecContext(NULL), formatContext(NULL), imageConvertContext(NULL), conversionSource(-1),
+	isvalid(false),playedFrames(0),autoFPSLimit(iautofpslimit), paused(!autoplay),
+	decodeAhead(idecodeAhead), current(NULL), decodedFrames(0),
+	decodeStop(false), decodeEOF(false), decodeThread(NULL),
+	pool(NULL), missedDeadlines(0),
+	indexedFrames(-1), pendingSeek(-1), seekCacheSize(4)
 {
     VideoDecoder::libraryInit();
 
@@ -90,6 +113,9 @@ VideoDecoder::VideoDecoder(const std::string &path , const bool iautofpslimit, c
 
     AVCodec* c = findDecoder(this->codecContext->codec_id);
 
+    if( codecThreads >= 0 )
+	this->codecContext->thread_count = codecThreads;
+
     if(avcodec_open2(this->codecContext, c, NULL)<0)
 	throw std::string("Unable to open decoding Codec");
 
@@ -99,23 +125,32 @@ VideoDecoder::VideoDecoder(const std::string &path , const bool iautofpslimit, c
 	this->codecContext->time_base.den=1000;
 
 
-    this->allocateConversionBuffer( this->codecContext->width,
-				    this->codecContext->height );
-
     this->width = this->codecContext->width;
     this->height = this->codecContext->height;
 
+    this->allocateConversionBuffer();
+
     this->startTime = av_gettime();
 
 	if (paused)
 		this->pauseTime = this->startTime;
+
+    if( this->decodeAhead ){
+	this->allocateFramePool();
+	this->startDecodeThread();
+    }
 }
 
 VideoDecoder::VideoDecoder(const unsigned iwidth, const unsigned iheight,
 			   const VideoCodec codec, const bool iautofpslimit, const bool autoplay):
+    userBuffer(NULL), outputFormat(RGB24),
     formatContext(NULL),
     isvalid(false),width(iwidth),height(iheight),
-    index(-1),playedFrames(0),autoFPSLimit(iautofpslimit), paused(!autoplay)
+    index(-1),playedFrames(0),autoFPSLimit(iautofpslimit), paused(!autoplay),
+    decodeAhead(0), current(NULL), decodedFrames(0),
+    decodeStop(false), decodeEOF(false), decodeThread(NULL),
+    pool(NULL), missedDeadlines(0),
+    indexedFrames(-1), pendingSeek(-1), seekCacheSize(4)
 {
     VideoDecoder::libraryInit();
 
@@ -140,7 +175,7 @@ VideoDecoder::VideoDecoder(const unsigned iwidth, const unsigned iheight,
     // codecs
     if(this->codecContext->time_base.num>1000 && this->codecContext->time_base.den==1)
 	this->codecContext->time_base.den=1000;
-    this->allocateConversionBuffer( this->width, this->height );
+    this->allocateConversionBuffer();
 
     this->startTime = av_gettime();
 
@@ -175,6 +210,11 @@ int VideoDecoder::findVideoStream(const int nth)
 
 VideoDecoder::~VideoDecoder()
 {
+    if( this->pool )
+	this->pool->detach(this);
+    this->stopDecodeThread();
+    this->destroyFramePool();
+    this->destroySeekCache();
     this->destroyConversionBuffer();
     avcodec_close(this->codecContext);
 
@@ -202,10 +242,16 @@ const unsigned char *VideoDecoder::getFrame()
 	// case, next frame will not be called hence we must read from the file
 	// We also rate limit based on the internal playback rate of the file
 	if( this->formatContext ){
-		AVPacket packet;
-		bool found=false;
+		int64_t neededFrame=0;
+
+		if( this->decodeAhead ){
+			const unsigned char *frame = this->getQueuedFrame();
 
-		int64_t neededFrame=0;;
+			// A slot may have been freed for the pool to decode into
+			if( this->pool )
+				this->pool->wake();
+			return frame;
+		}
 
 		if (paused)
 			return (unsigned char *)this->buffer;
@@ -214,42 +260,29 @@ const unsigned char *VideoDecoder::getFrame()
 		// played back if we are and we are limiting the frames, simply return
 		// the same buffer;
 		if( this->autoFPSLimit ){
-			neededFrame= (int)(((av_gettime()-this->startTime)/1000000.0)*this->getFPS());
+			neededFrame= this->getNeededFrame();
 			if(neededFrame <= this->playedFrames )
 				return (unsigned char *)this->buffer;
 		}
 
-		// Keep processing frames until we find the next frame we are
-		// after. This may be more than one frame if autofps limiting is enabled
-		while(!found && av_read_frame(this->formatContext, &packet) >= 0){
-			if( packet.stream_index==this->index){
-				avcodec_decode_video2(this->codecContext, this->someFrame,
-						&this->isvalid, &packet);
-				if( this->isvalid ){
-					this->playedFrames++;
-					sws_scale(this->imageConvertContext,
-							this->someFrame->data, this->someFrame->linesize,
-							0, this->height,
-							this->RGBFrame->data, this->RGBFrame->linesize);
-
-					// If we are rate limiting, keep decoding frames until
-					// we catch up to where we should be
-					if(this->autoFPSLimit ){
-						if(this->playedFrames >= neededFrame )
-							found=true;
-					}
-					// Else we simply return the next frame
-					else {
-						found=true;
-					}
-				}
-			}
-			av_free_packet(&packet);
+		// A seek satisfied from the cache leaves the decoder where it was
+		if( this->pendingSeek >= 0 ){
+			if( !this->positionDecoder(this->pendingSeek))
+				return NULL;
+			this->pendingSeek = -1;
 		}
 
-		// No more frames in the file
-		if(!found)
-			return NULL;
+		// Keep decoding frames until we find the next frame we are after.
+		// This may be more than one frame if autofps limiting is enabled,
+		// only the frame we return needs converting
+		do {
+			// No more frames in the file
+			if( !this->decodeNextFrame())
+				return NULL;
+			this->playedFrames++;
+		} while( this->autoFPSLimit && this->playedFrames < neededFrame );
+
+		this->convertFrame(this->RGBFrame);
 	} 
 	else {
 		//
@@ -257,16 +290,338 @@ const unsigned char *VideoDecoder::getFrame()
 		//
 		if( this->isvalid ){
 			this->playedFrames++;
-			sws_scale(this->imageConvertContext,
-					this->someFrame->data, this->someFrame->linesize,
-					0, this->height,
-					this->RGBFrame->data, this->RGBFrame->linesize);
+			this->updateConversion();
+			this->convertFrame(this->RGBFrame);
 		}
 	}
 	return (unsigned char *)this->buffer;
 }
 
 
+bool VideoDecoder::decodeNextFrame()
+{
+	AVPacket packet;
+	bool found=false;
+
+	while(!found && av_read_frame(this->formatContext, &packet) >= 0){
+		if( packet.stream_index==this->index){
+			avcodec_decode_video2(this->codecContext, this->someFrame,
+					&this->isvalid, &packet);
+			if( this->isvalid )
+				found=true;
+		}
+		av_free_packet(&packet);
+	}
+
+	return found;
+}
+
+void VideoDecoder::convertFrame(AVFrame *dst)
+{
+	if( this->imageConvertContext ){
+		sws_scale(this->imageConvertContext,
+				this->someFrame->data, this->someFrame->linesize,
+				0, this->height,
+				dst->data, dst->linesize);
+	}
+	// The luma plane of planar YUV is already the greyscale image
+	else if( this->outputFormat == GRAY8 ){
+		for(unsigned y = 0; y < this->height; y++ )
+			memcpy(dst->data[0] + y * dst->linesize[0],
+			       this->someFrame->data[0] + y * this->someFrame->linesize[0],
+			       this->width);
+	}
+	else {
+		av_picture_copy((AVPicture *)dst, (const AVPicture *)this->someFrame,
+				this->codecContext->pix_fmt, this->width, this->height);
+	}
+}
+
+/**
+ * Obtain the libav pixel format matching an output format
+ */
+#ifdef NEW_AVCODEC
+static AVPixelFormat getPixelFormat(const VideoDecoder::OutputFormat format,
+				    const AVPixelFormat native)
+#else
+static PixelFormat getPixelFormat(const VideoDecoder::OutputFormat format,
+				  const PixelFormat native)
+#endif
+{
+	switch(format){
+		case VideoDecoder::RGB24:   return PIX_FMT_RGB24;
+		case VideoDecoder::BGR24:   return PIX_FMT_BGR24;
+		case VideoDecoder::RGBA32:  return PIX_FMT_RGBA;
+		case VideoDecoder::GRAY8:   return PIX_FMT_GRAY8;
+		case VideoDecoder::YUV420P: return PIX_FMT_YUV420P;
+		case VideoDecoder::YUV422P: return PIX_FMT_YUV422P;
+		case VideoDecoder::NATIVE:
+		default:
+			return native;
+	}
+}
+
+/**
+ * Indicate if the first plane of the given format is luma
+ */
+#ifdef NEW_AVCODEC
+static bool hasLumaPlane(const AVPixelFormat format)
+#else
+static bool hasLumaPlane(const PixelFormat format)
+#endif
+{
+	switch(format){
+		case PIX_FMT_YUV420P:
+		case PIX_FMT_YUV422P:
+		case PIX_FMT_YUV444P:
+		case PIX_FMT_YUV411P:
+		case PIX_FMT_YUVJ420P:
+		case PIX_FMT_YUVJ422P:
+		case PIX_FMT_YUVJ444P:
+		case PIX_FMT_GRAY8:
+			return true;
+		default:
+			return false;
+	}
+}
+
+
+int64_t VideoDecoder::getNeededFrame() const
+{
+	return (int64_t)(((av_gettime()-this->startTime)/1000000.0)*this->getFPS());
+}
+
+const unsigned char *VideoDecoder::getQueuedFrame()
+{
+	ScopedLock lock(this->queueLock);
+	DecodedFrame *previous = this->current;
+	int64_t neededFrame;
+
+	if( this->paused )
+		return this->getQueuedOutput(false);
+
+	if( this->autoFPSLimit ){
+		neededFrame = this->getNeededFrame();
+		if( this->current && neededFrame <= this->playedFrames )
+			return this->getQueuedOutput(false);
+	}
+	else
+		neededFrame = this->playedFrames + 1;
+
+	// Only wait for the decoder if there is nothing to show yet, or we are
+	// not rate limiting. Otherwise a slow frame just repeats the last one
+	while( this->ready.empty() && !this->decodeEOF &&
+	       (this->current == NULL || !this->autoFPSLimit ))
+		this->queueNotEmpty.wait(this->queueLock);
+
+	// Take the newest queued frame that is due, recycling any we skip
+	while( !this->ready.empty()){
+		DecodedFrame *f = this->ready.front();
+		if( this->current && f->number > neededFrame )
+			break;
+		this->ready.pop_front();
+		if( this->current )
+			this->spare.push_back(this->current);
+		this->current = f;
+		this->queueNotFull.signal();
+		if( f->number >= neededFrame )
+			break;
+	}
+
+	// No more frames in the file
+	if( this->current == NULL ||
+	    (this->decodeEOF && this->ready.empty() && this->current->number < neededFrame))
+		return NULL;
+
+	this->playedFrames = this->current->number;
+	return this->getQueuedOutput(this->current != previous);
+}
+
+const unsigned char *VideoDecoder::getQueuedOutput(const bool changed)
+{
+	if( this->userBuffer == NULL )
+		return this->current ? this->current->buffer : this->buffer;
+
+	if( changed && this->current )
+		memcpy(this->userBuffer, this->current->buffer, this->getFrameSize());
+	return this->userBuffer;
+}
+
+void VideoDecoder::decodeLoop()
+{
+	while( this->decodeStep(true))
+		;
+}
+
+bool VideoDecoder::decodeStep(const bool wait)
+{
+	DecodedFrame *slot;
+	int64_t number;
+	bool late = false;
+
+	if( this->pendingSeek >= 0 ){
+		bool positioned = this->positionDecoder(this->pendingSeek);
+		this->pendingSeek = -1;
+		if( !positioned ){
+			ScopedLock lock(this->queueLock);
+			this->decodeEOF = true;
+			this->queueNotEmpty.broadcast();
+			return false;
+		}
+	}
+
+	{
+		ScopedLock lock(this->queueLock);
+		while( this->spare.empty() && !this->decodeStop ){
+			if( !wait )
+				return false;
+			this->queueNotFull.wait(this->queueLock);
+		}
+		if( this->decodeStop )
+			return false;
+		slot = this->spare.back();
+		this->spare.pop_back();
+	}
+
+	bool found = this->decodeNextFrame();
+
+	ScopedLock lock(this->queueLock);
+	if( !found ){
+		this->spare.push_back(slot);
+		this->decodeEOF = true;
+		this->queueNotEmpty.broadcast();
+		return false;
+	}
+
+	number = ++this->decodedFrames;
+
+	// Don't bother converting frames the playback clock has already
+	// passed, unless the player has nothing to show at all
+	if( this->autoFPSLimit && !this->paused && this->current != NULL )
+		late = number < this->getNeededFrame();
+
+	if( late ){
+		this->missedDeadlines++;
+		this->spare.push_back(slot);
+		return true;
+	}
+
+	this->queueLock.unlock();
+	this->convertFrame(slot->frame);
+	this->queueLock.lock();
+
+	if( this->autoFPSLimit && av_gettime() > this->getFrameDeadline(number))
+		this->missedDeadlines++;
+
+	slot->number = number;
+	this->ready.push_back(slot);
+	this->queueNotEmpty.signal();
+	return true;
+}
+
+bool VideoDecoder::getNextDeadline(int64_t &deadline)
+{
+	ScopedLock lock(this->queueLock);
+
+	if( this->decodeStop || this->decodeEOF )
+		return false;
+
+	// Moving the decoder to a new position is always urgent
+	if( this->pendingSeek >= 0 ){
+		deadline = av_gettime();
+		return true;
+	}
+
+	if( this->spare.empty())
+		return false;
+
+	deadline = this->autoFPSLimit ? this->getFrameDeadline(this->decodedFrames + 1) : av_gettime();
+	return true;
+}
+
+int64_t VideoDecoder::getFrameDeadline(const int64_t frame) const
+{
+	int64_t deadline = this->startTime + (int64_t)(frame / this->getFrameRate() * 1000000.0);
+
+	// The playback clock stands still while paused
+	if( this->paused )
+		deadline += av_gettime() - this->pauseTime;
+	return deadline;
+}
+
+uint64_t VideoDecoder::getMissedDeadlines()
+{
+	ScopedLock lock(this->queueLock);
+	return this->missedDeadlines;
+}
+
+void VideoDecoder::allocateFramePool()
+{
+	int size = this->getFrameSize();
+
+	// One more slot than the queue length, the caller holds the current frame
+	this->framePool.resize(this->decodeAhead + 1);
+	for(unsigned i = 0; i < this->framePool.size(); i++ ){
+		DecodedFrame &f = this->framePool[i];
+#ifdef NEW_AVCODEC
+		f.frame = av_frame_alloc();
+#else
+		f.frame = avcodec_alloc_frame();
+#endif
+		f.buffer = new uint8_t[size];
+		f.number = 0;
+		avpicture_fill((AVPicture *)f.frame, f.buffer, getPixelFormat(this->outputFormat, this->codecContext->pix_fmt), this->width, this->height);
+		this->spare.push_back(&f);
+	}
+}
+
+void VideoDecoder::destroyFramePool()
+{
+	for(unsigned i = 0; i < this->framePool.size(); i++ ){
+		delete [] this->framePool[i].buffer;
+		av_free(this->framePool[i].frame);
+	}
+	this->framePool.clear();
+	this->spare.clear();
+	this->ready.clear();
+	this->current = NULL;
+}
+
+void VideoDecoder::startDecodeThread()
+{
+	this->decodeStop = false;
+	this->decodeEOF = false;
+
+	if( this->pool ){
+		this->pool->resume(this);
+		return;
+	}
+
+	this->decodeThread = new DecodeThread(this);
+	this->decodeThread->start();
+}
+
+void VideoDecoder::stopDecodeThread()
+{
+	if( this->pool ){
+		this->pool->suspend(this);
+		return;
+	}
+
+	if( this->decodeThread == NULL )
+		return;
+
+	{
+		ScopedLock lock(this->queueLock);
+		this->decodeStop = true;
+		this->queueNotFull.broadcast();
+	}
+
+	this->decodeThread->join();
+	delete this->decodeThread;
+	this->decodeThread = NULL;
+}
+
 void VideoDecoder::libraryInit()
 {
     static int init;
@@ -276,7 +631,7 @@ void VideoDecoder::libraryInit()
     }
 }
 
-void VideoDecoder::allocateConversionBuffer(const unsigned width, const unsigned height)
+void VideoDecoder::allocateConversionBuffer()
 {
 #ifdef NEW_AVCODEC
     this->someFrame = av_frame_alloc();
@@ -285,23 +640,57 @@ void VideoDecoder::allocateConversionBuffer(const unsigned width, const unsigned
     this->someFrame = avcodec_alloc_frame();
     this->RGBFrame= avcodec_alloc_frame();
 #endif
-    int size = avpicture_get_size(PIX_FMT_RGB24, width, height);
-    this->buffer = new uint8_t[size];
-    avpicture_fill((AVPicture *)this->RGBFrame, this->buffer, PIX_FMT_RGB24, width, height);
-    this->imageConvertContext =  sws_getContext( width, height,
-						 this->codecContext->pix_fmt,
-						 width, height,
-						 PIX_FMT_RGB24, SWS_BICUBIC,
-						 NULL, NULL, NULL );
+    this->setupConversion();
+}
+
+void VideoDecoder::setupConversion()
+{
+#ifdef NEW_AVCODEC
+    AVPixelFormat format = getPixelFormat(this->outputFormat, this->codecContext->pix_fmt);
+#else
+    PixelFormat format = getPixelFormat(this->outputFormat, this->codecContext->pix_fmt);
+#endif
+    int size = avpicture_get_size(format, this->width, this->height);
+    this->ownBuffer = new uint8_t[size];
+    this->buffer = this->userBuffer ? this->userBuffer : this->ownBuffer;
+    avpicture_fill((AVPicture *)this->RGBFrame, this->buffer, format, this->width, this->height);
+    this->conversionSource = this->codecContext->pix_fmt;
+
+    // Only go through swscale if the planes can't simply be copied
+    if( format == this->codecContext->pix_fmt ||
+	(this->outputFormat == GRAY8 && hasLumaPlane(this->codecContext->pix_fmt)))
+	this->imageConvertContext = NULL;
+    else
+	this->imageConvertContext =  sws_getContext( this->width, this->height,
+						     this->codecContext->pix_fmt,
+						     this->width, this->height,
+						     format, SWS_BICUBIC,
+						     NULL, NULL, NULL );
+}
+
+void VideoDecoder::teardownConversion()
+{
+    delete [] this->ownBuffer;
+    this->ownBuffer = NULL;
+    sws_freeContext( this->imageConvertContext);
+    this->imageConvertContext = NULL;
+}
+
+void VideoDecoder::updateConversion()
+{
+    if( this->codecContext->pix_fmt == this->conversionSource )
+	return;
+
+    this->teardownConversion();
+    this->setupConversion();
 }
 
 void VideoDecoder::destroyConversionBuffer()
 {
-    delete [] this->buffer;
+    this->teardownConversion();
 
     av_free(this->RGBFrame);
     av_free(this->someFrame);
-    sws_freeContext( this->imageConvertContext);
 }
 
 unsigned VideoDecoder::getWidth() const
@@ -314,12 +703,62 @@ unsigned VideoDecoder::getHeight() const
     return this->height;
 }
 
+void VideoDecoder::setOutputFormat(const OutputFormat format)
+{
+    if( format == this->outputFormat )
+	return;
+
+    this->stopDecodeThread();
+    this->destroyFramePool();
+    this->destroySeekCache();
+    this->destroyConversionBuffer();
+
+    this->outputFormat = format;
+    this->allocateConversionBuffer();
+
+    if( this->decodeAhead ){
+	this->allocateFramePool();
+
+	// Frames decoded ahead have been discarded, so decoding must
+	// continue from the last frame played
+	if( this->pendingSeek < 0 && this->decodedFrames != this->playedFrames ){
+	    if( this->indexedFrames < 0 && this->playedFrames > 0 )
+		this->buildKeyFrameIndex();
+	    this->pendingSeek = this->playedFrames;
+	}
+	this->decodedFrames = this->playedFrames;
+	this->startDecodeThread();
+    }
+}
+
+VideoDecoder::OutputFormat VideoDecoder::getOutputFormat() const
+{
+    return this->outputFormat;
+}
+
+unsigned VideoDecoder::getFrameSize() const
+{
+    return avpicture_get_size(getPixelFormat(this->outputFormat, this->codecContext->pix_fmt), this->width, this->height);
+}
+
+void VideoDecoder::setOutputBuffer(unsigned char *ibuffer)
+{
+    ScopedLock lock(this->queueLock);
+
+    this->userBuffer = ibuffer;
+    this->buffer = ibuffer ? ibuffer : this->ownBuffer;
+    avpicture_fill((AVPicture *)this->RGBFrame, this->buffer, getPixelFormat(this->outputFormat, this->codecContext->pix_fmt),
+		   this->width, this->height);
+
+    // Make sure the new buffer holds the frame being displayed
+    if( this->decodeAhead )
+	this->getQueuedOutput(true);
+}
+
 float VideoDecoder::getFPS() const
 {
     if( this->formatContext &&  this->autoFPSLimit ){
-	return(1.0 *
-	       this->formatContext->streams[this->index]->r_frame_rate.num /
-	       (float) this->formatContext->streams[this->index]->r_frame_rate.den);
+	return this->getFrameRate();
     } else {
 	float t = (av_gettime()-this->startTime)/1000000.0;
 	return (t>1? this->playedFrames / t : 0);
@@ -343,15 +782,232 @@ void VideoDecoder::rewind()
 {
 	if( this->formatContext )
 	{
+		this->stopDecodeThread();
+
 		av_seek_frame(this->formatContext, this->index,0, AVSEEK_FLAG_BACKWARD);
 		avcodec_flush_buffers(this->codecContext);
 		playedFrames = 0;
+		pendingSeek = -1;
 		startTime = av_gettime();
+		if (paused)
+			pauseTime = startTime;
+
+		if( this->decodeAhead ){
+			this->resetFrameQueue();
+			this->decodedFrames = 0;
+			this->startDecodeThread();
+		}
+	}
+}
+
+const unsigned char *VideoDecoder::seekToFrame(int64_t frame)
+{
+	if( this->formatContext == NULL )
+		return NULL;
+
+	this->stopDecodeThread();
+
+	if( this->indexedFrames < 0 )
+		this->buildKeyFrameIndex();
+
+	if( frame < 1 )
+		frame = 1;
+
+	if( frame > this->indexedFrames ){
+		if( this->decodeAhead )
+			this->startDecodeThread();
+		return NULL;
+	}
+
+	AVFrame *dstFrame = this->RGBFrame;
+	uint8_t *dst = this->buffer;
+	const unsigned char *result = dst;
+	if( this->decodeAhead ){
+		this->resetFrameQueue();
+		this->current = this->spare.back();
+		this->spare.pop_back();
+		this->current->number = frame;
+		dstFrame = this->current->frame;
+		dst = this->current->buffer;
+	}
+
+	uint8_t *cached = this->findCachedFrame(frame);
+	if( cached ){
+		// Only move the decoder if playback continues from here
+		memcpy(dst, cached, this->getFrameSize());
+		this->pendingSeek = frame;
+	}
+	else {
+		if( !this->positionDecoder(frame)){
+			// Leave the decoder to find its own way back on the next frame
+			this->pendingSeek = this->decodeAhead ? this->decodedFrames : this->playedFrames;
+			if( this->decodeAhead ){
+				this->spare.push_back(this->current);
+				this->current = NULL;
+				this->startDecodeThread();
+			}
+			return NULL;
+		}
+		this->pendingSeek = -1;
+		this->convertFrame(dstFrame);
+		this->cacheFrame(frame, dst);
 	}
+
+	// Move the playback clock so the seeked frame is the one now due
+	this->playedFrames = frame;
+	this->decodedFrames = frame;
+	this->startTime = av_gettime() - (int64_t)(frame / this->getFrameRate() * 1000000.0);
+	if( this->paused )
+		this->pauseTime = av_gettime();
+
+	if( this->decodeAhead ){
+		result = this->getQueuedOutput(true);
+		this->startDecodeThread();
+	}
+
+	return result;
+}
+
+const unsigned char *VideoDecoder::seekToTime(const double seconds)
+{
+	if( this->formatContext == NULL )
+		return NULL;
+
+	return this->seekToFrame((int64_t)(seconds * this->getFrameRate()) + 1);
+}
+
+void VideoDecoder::setSeekCacheSize(const unsigned frames)
+{
+	this->seekCacheSize = frames;
+	while( this->seekCache.size() > frames ){
+		delete [] this->seekCache.back().buffer;
+		this->seekCache.pop_back();
+	}
+}
+
+void VideoDecoder::resetFrameQueue()
+{
+	// Return every queued frame to the pool
+	while( !this->ready.empty()){
+		this->spare.push_back(this->ready.front());
+		this->ready.pop_front();
+	}
+	if( this->current ){
+		this->spare.push_back(this->current);
+		this->current = NULL;
+	}
+}
+
+void VideoDecoder::buildKeyFrameIndex()
+{
+	AVPacket packet;
+	int64_t frame = 0;
+
+	// Only the packets are read, nothing is decoded. This assumes one
+	// frame per packet and closed GOPs, which holds for the containers we use
+	av_seek_frame(this->formatContext, this->index, 0, AVSEEK_FLAG_BACKWARD);
+	while( av_read_frame(this->formatContext, &packet) >= 0 ){
+		if( packet.stream_index == this->index ){
+			frame++;
+			if( packet.flags & AV_PKT_FLAG_KEY ){
+				KeyFrame k;
+				k.frame = frame;
+				k.timestamp = packet.dts != (int64_t)AV_NOPTS_VALUE ? packet.dts : packet.pts;
+				this->keyFrames.push_back(k);
+			}
+		}
+		av_free_packet(&packet);
+	}
+
+	this->indexedFrames = frame;
+	this->pendingSeek = this->decodeAhead ? this->decodedFrames : this->playedFrames;
+}
+
+bool VideoDecoder::positionDecoder(const int64_t frame)
+{
+	int64_t decoded = 0;
+	size_t lo = 0, hi = this->keyFrames.size();
+
+	// Binary search for the first keyframe after the frame we are after
+	while( lo < hi ){
+		size_t mid = (lo + hi) / 2;
+		if( this->keyFrames[mid].frame <= frame )
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	if( lo == 0 ){
+		av_seek_frame(this->formatContext, this->index, 0, AVSEEK_FLAG_BACKWARD);
+	}
+	else {
+		const KeyFrame &k = this->keyFrames[lo - 1];
+		av_seek_frame(this->formatContext, this->index, k.timestamp, AVSEEK_FLAG_BACKWARD);
+		decoded = k.frame - 1;
+	}
+	avcodec_flush_buffers(this->codecContext);
+
+	while( decoded < frame ){
+		if( !this->decodeNextFrame())
+			return false;
+		decoded++;
+	}
+	return true;
+}
+
+uint8_t *VideoDecoder::findCachedFrame(const int64_t frame)
+{
+	for(std::list<CachedFrame>::iterator it = this->seekCache.begin();
+	    it != this->seekCache.end(); ++it ){
+		if( it->number == frame ){
+			this->seekCache.splice(this->seekCache.begin(), this->seekCache, it);
+			return it->buffer;
+		}
+	}
+	return NULL;
+}
+
+void VideoDecoder::cacheFrame(const int64_t frame, const uint8_t *data)
+{
+	int size = this->getFrameSize();
+
+	if( this->seekCacheSize == 0 )
+		return;
+
+	// Reuse the least recently used entry once the cache is full
+	if( this->seekCache.size() >= this->seekCacheSize ){
+		this->seekCache.splice(this->seekCache.begin(), this->seekCache,
+				       --this->seekCache.end());
+	}
+	else {
+		CachedFrame c;
+		c.buffer = new uint8_t[size];
+		this->seekCache.push_front(c);
+	}
+
+	this->seekCache.front().number = frame;
+	memcpy(this->seekCache.front().buffer, data, size);
+}
+
+void VideoDecoder::destroySeekCache()
+{
+	for(std::list<CachedFrame>::iterator it = this->seekCache.begin();
+	    it != this->seekCache.end(); ++it )
+		delete [] it->buffer;
+	this->seekCache.clear();
+}
+
+double VideoDecoder::getFrameRate() const
+{
+	return this->formatContext->streams[this->index]->r_frame_rate.num /
+	       (double) this->formatContext->streams[this->index]->r_frame_rate.den;
 }
 
 void VideoDecoder::setPaused(bool p)
 {
+	// The decode thread reads the playback clock
+	ScopedLock lock(this->queueLock);
+
 	if (p && !this->paused)
 	{
 		this->pauseTime = av_gettime();
@@ -366,6 +1022,17 @@ void VideoDecoder::setPaused(bool p)
 }
 
 
+unsigned VideoDecoder::getDecodeAhead() const
+{
+    return this->decodeAhead;
+}
+
+unsigned VideoDecoder::getQueuedFrames()
+{
+    ScopedLock lock(this->queueLock);
+    return this->ready.size();
+}
+
 bool VideoDecoder::atEnd() const
 {
     if( this->formatContext && this->getCurrentFrame() >= this->getLastFrame())
@@ -32,11 +32,16 @@ extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libswscale/swscale.h>
 };
+#include <deque>
+#include <list>
 #include <string>
+#include <vector>
 #include <wcl/api.h>
+#include <wcl/util/Thread.h>
 
 namespace wcl
 {
+    class VideoDecoderPool;
 
     /**
      * VideoDecoder provides the means to decode a video off disk or from memory
@@ -52,7 +57,36 @@ namespace wcl
 		enum VideoCodec {
 			MJPEG
 		};
-	VideoDecoder(const std::string &path, const bool autofpslimit=true, const bool autoplay = true) throw (const std::string &);
+
+		/**
+		 * The formats frames can be returned in. Planar formats are
+		 * returned as consecutive Y, U and V planes without padding.
+		 */
+		enum OutputFormat {
+			RGB24,   // R8 G8 B8, the default
+			BGR24,   // B8 G8 R8
+			RGBA32,  // R8 G8 B8 A8
+			GRAY8,   // Luma only, copied straight from planar YUV video
+			YUV420P, // Planar YUV 4:2:0
+			YUV422P, // Planar YUV 4:2:2
+			NATIVE   // Whatever the codec decodes to, no conversion at all
+		};
+	/**
+	 * Open a video file for decoding.
+	 *
+	 * @param path The file to open
+	 * @param autofpslimit Limit the frames returned to the frame rate of the file
+	 * @param autoplay Start playing immediately, else start paused
+	 * @param decodeAhead If non zero, a background thread demuxes, decodes and
+	 *        converts up to this many frames ahead of playback. getFrame then
+	 *        only picks the queued frame matching the playback clock, so
+	 *        decoding hiccups don't stall the caller. 0 decodes in getFrame.
+	 * @param codecThreads The amount of threads libavcodec may use to decode
+	 *        the video, -1 leaves it to libavcodec. Decoders added to a
+	 *        VideoDecoderPool should use 1 so the pool controls the load.
+	 * @throws std::string if the file can't be opened or decoded
+	 */
+	VideoDecoder(const std::string &path, const bool autofpslimit=true, const bool autoplay = true, const unsigned decodeAhead = 0, const int codecThreads = -1) throw (const std::string &);
 	VideoDecoder(const unsigned width, const unsigned height, const VideoCodec codec, bool autofpslimit=true, const bool autoplay = true);
 	~VideoDecoder();
 
@@ -60,7 +94,12 @@ namespace wcl
 
 	/**
          * Obtain a pointer to the next frame of the video. This frame will
-	 * always be returned in RGB24 (R8,G8,B8) format.
+	 * be returned in the format given to setOutputFormat, RGB24 (R8,G8,B8)
+	 * by default. If an output buffer has been set this is returned.
+	 *
+	 * When decoding ahead, the returned frame remains valid until the next
+	 * call to getFrame or rewind. If the decode thread has fallen behind the
+	 * playback clock the last frame is returned again rather than blocking.
 	 *
 	 * @return A pointer to the current frame, NULL when end of file is reached (if reading from file)
 	 */
@@ -69,6 +108,35 @@ namespace wcl
 	unsigned getHeight() const;
 	unsigned getWidth() const;
 
+	/**
+	 * Set the format frames are returned in. Where the video is already
+	 * in the requested format (or NATIVE is requested), or only the luma
+	 * is wanted from a planar YUV video, the decoded planes are copied
+	 * as is rather than going through a colour conversion.
+	 *
+	 * Changing the format discards any frames that have been decoded ahead
+	 * or cached and invalidates the pointer last returned by getFrame.
+	 */
+	void setOutputFormat(const OutputFormat format);
+	OutputFormat getOutputFormat() const;
+
+	/**
+	 * Obtain the size in bytes of a frame in the current output format
+	 */
+	unsigned getFrameSize() const;
+
+	/**
+	 * Supply the buffer frames are written to, for example a mapped
+	 * texture or shared memory. The buffer must be at least getFrameSize()
+	 * bytes and remain valid until it is replaced. When decoding ahead,
+	 * frames are decoded into the queue and copied to the buffer once
+	 * chosen by getFrame, otherwise they are written directly into it.
+	 *
+	 * @param buffer The buffer to write frames to, NULL to use the
+	 *        decoders own buffer
+	 */
+	void setOutputBuffer(unsigned char *buffer);
+
 	/**
 	 * Indicate if we have reached the end of a video. This only makes sense
 	 * in the case of a file.
@@ -99,6 +167,37 @@ namespace wcl
 	 */
 	void rewind();
 
+	/**
+	 * Move to the given frame of a file based video. Frames are numbered
+	 * as per getCurrentFrame, the first frame being 1. Only the frames
+	 * from the nearest keyframe before the requested frame are decoded.
+	 * The keyframe index is built by scanning the file on the first seek.
+	 * Recently seeked to frames are kept in a small cache so scrubbing
+	 * back and forth over the same frames doesn't decode them again.
+	 *
+	 * Playback continues from the frame seeked to, when paused the frame
+	 * is held.
+	 *
+	 * @param frame The frame to move to
+	 * @return The requested frame in the output format, NULL if it does not exist
+	 */
+	const unsigned char *seekToFrame(int64_t frame);
+
+	/**
+	 * Move to the frame that is displayed at the given time of a file based
+	 * video. See seekToFrame.
+	 *
+	 * @param seconds The time from the start of the video
+	 * @return The frame at the given time in the output format, NULL if it does not exist
+	 */
+	const unsigned char *seekToTime(const double seconds);
+
+	/**
+	 * Set the amount of frames the seek cache holds. Each entry holds
+	 * one frame in the output format. 0 disables the cache. The default is 4.
+	 */
+	void setSeekCacheSize(const unsigned frames);
+
 	/**
 	 * Pauses/unpauses the video.
 	 */
@@ -112,13 +211,65 @@ namespace wcl
 	 */
 	float getFPS() const;
 
+	/**
+	 * Obtain the amount of frames the decoder was asked to decode ahead
+	 *
+	 * @return The size of the decode ahead queue, 0 if decoding is done in getFrame
+	 */
+	unsigned getDecodeAhead() const;
+
+	/**
+	 * Obtain the amount of decoded frames currently waiting to be played
+	 */
+	unsigned getQueuedFrames();
+
+	/**
+	 * Obtain the amount of frames that were not decoded by the time the
+	 * playback clock reached them. Only counted when decoding ahead with
+	 * autofpslimit set.
+	 */
+	uint64_t getMissedDeadlines();
+
     private:
-	uint8_t *buffer;
+	/**
+	 * A preallocated, converted frame used by the decode ahead queue
+	 */
+	struct DecodedFrame {
+	    AVFrame *frame;
+	    uint8_t *buffer;
+	    int64_t number;
+	};
+
+	/**
+	 * A keyframe in the seek index. timestamp is in stream timebase units
+	 */
+	struct KeyFrame {
+	    int64_t frame;
+	    int64_t timestamp;
+	};
+
+	/**
+	 * A converted frame in the seek cache
+	 */
+	struct CachedFrame {
+	    int64_t number;
+	    uint8_t *buffer;
+	};
+
+	class DecodeThread;
+	friend class DecodeThread;
+	friend class VideoDecoderPool;
+
+	uint8_t *buffer; // Where frames are written, either ownBuffer or userBuffer
+	uint8_t *ownBuffer;
+	uint8_t *userBuffer;
+	OutputFormat outputFormat;
 	AVFrame *someFrame;
 	AVFrame *RGBFrame;
 	AVCodecContext *codecContext;
 	AVFormatContext *formatContext;
 	SwsContext *imageConvertContext;
+	int conversionSource; // The pixel format the conversion was set up for
 	int isvalid;
 	unsigned width;
 	unsigned height;
@@ -129,6 +280,30 @@ namespace wcl
 	bool autoFPSLimit; // Should this class limit the frame rate
 	bool paused;
 
+	// Decode ahead state. ready and spare are protected by queueLock,
+	// as is startTime while the decode thread is running
+	unsigned decodeAhead;
+	std::vector<DecodedFrame> framePool;
+	std::deque<DecodedFrame *> ready;
+	std::vector<DecodedFrame *> spare;
+	DecodedFrame *current;
+	int64_t decodedFrames;
+	bool decodeStop;
+	bool decodeEOF;
+	DecodeThread *decodeThread;
+	VideoDecoderPool *pool; // Decodes for us instead of decodeThread if set
+	uint64_t missedDeadlines;
+	Mutex queueLock;
+	Condition queueNotFull;
+	Condition queueNotEmpty;
+
+	// Seek state
+	std::vector<KeyFrame> keyFrames;
+	int64_t indexedFrames; // -1 until the index has been built
+	int64_t pendingSeek; // Frame the decoder must be moved to before continuing, -1 if none
+	std::list<CachedFrame> seekCache; // Most recently used first
+	unsigned seekCacheSize;
+
 	/**
 	 * Find the nth video stream in the avcodec context and return the
 	 * stream number of that stream. 
@@ -142,8 +317,70 @@ namespace wcl
 	/**
 	 * Routines to aid in converting from format X to RGB
 	 */
-	void allocateConversionBuffer(const unsigned width, const unsigned height);
+	void allocateConversionBuffer();
 	void destroyConversionBuffer();
+	void setupConversion();
+	void teardownConversion();
+
+	/**
+	 * Set the conversion up again if the codec decoded to a different
+	 * pixel format than it was set up for. Streams only find out the
+	 * real format from the first frame.
+	 */
+	void updateConversion();
+
+	/**
+	 * Read packets from the file until the next video frame has been
+	 * decoded into someFrame.
+	 *
+	 * @return false if the end of the file was reached
+	 */
+	bool decodeNextFrame();
+
+	/**
+	 * Convert the last decoded frame to RGB into the given frame
+	 */
+	void convertFrame(AVFrame *dst);
+
+	/**
+	 * The frame number the playback clock says should be displayed
+	 */
+	int64_t getNeededFrame() const;
+
+	/**
+	 * Decode ahead support. decodeLoop is the body of the decode thread,
+	 * decodeStep decodes a single frame into the queue and is also used
+	 * by VideoDecoderPool. decodeStep returns false when decoding should
+	 * stop, or there was no room in the queue and wait was not set.
+	 */
+	void allocateFramePool();
+	void destroyFramePool();
+	void startDecodeThread();
+	void stopDecodeThread();
+	void decodeLoop();
+	bool decodeStep(const bool wait);
+
+	/**
+	 * Obtain when the next frame to decode is due
+	 *
+	 * @return false if there is nothing to decode
+	 */
+	bool getNextDeadline(int64_t &deadline);
+	int64_t getFrameDeadline(const int64_t frame) const;
+	const unsigned char *getQueuedFrame();
+	const unsigned char *getQueuedOutput(const bool changed);
+	void resetFrameQueue();
+
+	/**
+	 * Seek support. positionDecoder leaves the decoder having just
+	 * decoded the given frame (or at the start of the file for frame 0)
+	 */
+	void buildKeyFrameIndex();
+	bool positionDecoder(const int64_t frame);
+	uint8_t *findCachedFrame(const int64_t frame);
+	void cacheFrame(const int64_t frame, const uint8_t *data);
+	void destroySeekCache();
+	double getFrameRate() const;
 
 	/**
 	 * Initialise AvCodec Library if not already initialised
@@ -0,0 +1,226 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <unistd.h>
+
+#include "VideoDecoderPool.h"
+#include "VideoDecoder.h"
+
+namespace wcl
+{
+
+/**
+ * A pool thread, it simply runs VideoDecoderPool::work until the pool stops
+ */
+class VideoDecoderPool::Worker: public Thread
+{
+public:
+    Worker(VideoDecoderPool *ipool): pool(ipool) {}
+
+protected:
+    void run() { this->pool->work(); }
+
+private:
+    VideoDecoderPool *pool;
+};
+
+VideoDecoderPool::VideoDecoderPool(const unsigned threads):
+    generation(0), stopping(false)
+{
+    unsigned count = threads;
+    if( count == 0 ){
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	count = cpus > 0 ? cpus : 1;
+    }
+
+    for(unsigned i = 0; i < count; i++ ){
+	Worker *w = new Worker(this);
+	this->workers.push_back(w);
+	w->start();
+    }
+}
+
+VideoDecoderPool::~VideoDecoderPool()
+{
+    while( this->size())
+	this->remove(this->streams.back().decoder);
+
+    {
+	ScopedLock l(this->lock);
+	this->stopping = true;
+	this->workAvailable.broadcast();
+    }
+
+    for(unsigned i = 0; i < this->workers.size(); i++ ){
+	this->workers[i]->join();
+	delete this->workers[i];
+    }
+}
+
+void VideoDecoderPool::add(VideoDecoder *decoder)
+{
+    if( decoder->decodeAhead == 0 || decoder->formatContext == NULL )
+	throw Exception("VideoDecoderPool::add: Decoder must decode ahead from a file");
+    if( decoder->pool )
+	throw Exception("VideoDecoderPool::add: Decoder is already in a pool");
+
+    // Take over from the decoders own thread
+    decoder->stopDecodeThread();
+    {
+	ScopedLock q(decoder->queueLock);
+	decoder->decodeStop = false;
+    }
+
+    ScopedLock l(this->lock);
+    Stream s;
+    s.decoder = decoder;
+    s.busy = false;
+    s.suspended = false;
+    this->streams.push_back(s);
+    decoder->pool = this;
+
+    this->generation++;
+    this->workAvailable.broadcast();
+}
+
+void VideoDecoderPool::remove(VideoDecoder *decoder)
+{
+    if( decoder->pool != this )
+	return;
+
+    this->detach(decoder);
+    decoder->startDecodeThread();
+}
+
+void VideoDecoderPool::detach(VideoDecoder *decoder)
+{
+    this->suspend(decoder);
+
+    ScopedLock l(this->lock);
+    for(std::vector<Stream>::iterator it = this->streams.begin();
+	it != this->streams.end(); ++it ){
+	if( it->decoder == decoder ){
+	    this->streams.erase(it);
+	    break;
+	}
+    }
+    decoder->pool = NULL;
+}
+
+unsigned VideoDecoderPool::size()
+{
+    ScopedLock l(this->lock);
+    return this->streams.size();
+}
+
+unsigned VideoDecoderPool::getThreadCount() const
+{
+    return this->workers.size();
+}
+
+VideoDecoderPool::Stream *VideoDecoderPool::findStream(const VideoDecoder *decoder)
+{
+    for(unsigned i = 0; i < this->streams.size(); i++ ){
+	if( this->streams[i].decoder == decoder )
+	    return &this->streams[i];
+    }
+    return NULL;
+}
+
+void VideoDecoderPool::wake()
+{
+    ScopedLock l(this->lock);
+    this->generation++;
+    this->workAvailable.broadcast();
+}
+
+void VideoDecoderPool::suspend(VideoDecoder *decoder)
+{
+    ScopedLock l(this->lock);
+    Stream *s = this->findStream(decoder);
+    if( s == NULL )
+	return;
+
+    s->suspended = true;
+    while( this->findStream(decoder)->busy )
+	this->streamIdle.wait(this->lock);
+}
+
+void VideoDecoderPool::resume(VideoDecoder *decoder)
+{
+    ScopedLock l(this->lock);
+    Stream *s = this->findStream(decoder);
+    if( s == NULL )
+	return;
+
+    s->suspended = false;
+    this->generation++;
+    this->workAvailable.broadcast();
+}
+
+void VideoDecoderPool::work()
+{
+    ScopedLock l(this->lock);
+
+    while( !this->stopping ){
+	unsigned seen = this->generation;
+	VideoDecoder *next = NULL;
+	int64_t nextDeadline = 0;
+
+	// Find the stream whose next frame is due first
+	for(unsigned i = 0; i < this->streams.size(); i++ ){
+	    Stream &s = this->streams[i];
+	    int64_t deadline;
+
+	    if( s.busy || s.suspended )
+		continue;
+	    if( s.decoder->getNextDeadline(deadline) &&
+		(next == NULL || deadline < nextDeadline)){
+		next = s.decoder;
+		nextDeadline = deadline;
+	    }
+	}
+
+	if( next ){
+	    this->findStream(next)->busy = true;
+
+	    this->lock.unlock();
+	    next->decodeStep(false);
+	    this->lock.lock();
+
+	    // The stream can't have been removed while busy
+	    this->findStream(next)->busy = false;
+	    this->streamIdle.broadcast();
+	    continue;
+	}
+
+	// Nothing to do, wait for a frame to be consumed. The timeout
+	// catches streams becoming ready without telling us, eg unpausing
+	if( seen == this->generation )
+	    this->workAvailable.wait(this->lock, 10000);
+    }
+}
+
+};
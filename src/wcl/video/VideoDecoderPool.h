@@ -0,0 +1,126 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_VIDEO_VIDEODECODERPOOL_H
+#define WCL_VIDEO_VIDEODECODERPOOL_H
+
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+    class VideoDecoder;
+
+    /**
+     * VideoDecoderPool decodes frames for many VideoDecoders on a fixed
+     * number of shared threads, rather than each decoder using a thread of
+     * its own. Whenever a thread is free it decodes the next frame of the
+     * stream whose frame is due soonest, so streams falling behind get
+     * the cpu first. Use VideoDecoder::getMissedDeadlines to see how well
+     * each stream is keeping up.
+     *
+     * Only file based decoders that decode ahead can be added. Decoders
+     * should be created with a single codec thread so the pool is the
+     * only source of decoding threads.
+     */
+    class WCL_API VideoDecoderPool
+    {
+    public:
+	/**
+	 * Create the pool and start its threads
+	 *
+	 * @param threads The amount of decoding threads, 0 uses one per cpu
+	 */
+	VideoDecoderPool(const unsigned threads = 0);
+
+	/**
+	 * Stop the pool. Any decoders still in the pool go back to
+	 * decoding in their own thread.
+	 */
+	~VideoDecoderPool();
+
+	/**
+	 * Have the pool decode frames for the given decoder. The decoder
+	 * stops its own decoding thread.
+	 *
+	 * @param decoder The decoder, must have been created from a file with decodeAhead set
+	 * @throws Exception if the decoder doesn't decode ahead or is already in a pool
+	 */
+	void add(VideoDecoder *decoder);
+
+	/**
+	 * Remove a decoder from the pool. It goes back to decoding in its
+	 * own thread. Decoders that are destroyed are removed automatically.
+	 */
+	void remove(VideoDecoder *decoder);
+
+	/**
+	 * Obtain the amount of decoders in the pool
+	 */
+	unsigned size();
+
+	/**
+	 * Obtain the amount of decoding threads
+	 */
+	unsigned getThreadCount() const;
+
+    private:
+	struct Stream {
+	    VideoDecoder *decoder;
+	    bool busy;      // A thread is decoding for this stream
+	    bool suspended; // The decoder is being repositioned or removed
+	};
+
+	class Worker;
+	friend class Worker;
+	friend class VideoDecoder;
+
+	std::vector<Stream> streams;
+	std::vector<Worker *> workers;
+	unsigned generation; // Changes whenever there may be new work
+	bool stopping;
+	Mutex lock;
+	Condition workAvailable;
+	Condition streamIdle;
+
+	void work();
+	Stream *findStream(const VideoDecoder *decoder);
+
+	/**
+	 * Used by VideoDecoder to control decoding in place of its own thread.
+	 * None of these may be called with the decoders queue lock held.
+	 */
+	void wake();
+	void suspend(VideoDecoder *decoder);
+	void resume(VideoDecoder *decoder);
+	void detach(VideoDecoder *decoder);
+
+	VideoDecoderPool(const VideoDecoderPool &);
+	VideoDecoderPool &operator =(const VideoDecoderPool &);
+    };
+};
+
+#endif
@@ -0,0 +1,507 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include <string.h>
+
+#include "config.h"
+#include "VideoEncoder.h"
+#include "VideoDecoder.h"
+#include "CameraPixelFormat.h"
+
+#include <wcl/IO.h>
+
+using namespace std;
+
+namespace wcl
+{
+
+/**
+ * The background thread that encodes queued frames, it simply runs
+ * VideoEncoder::encodeLoop until the encoder is closed
+ */
+class VideoEncoder::EncodeThread: public Thread
+{
+public:
+    EncodeThread(VideoEncoder *iencoder): encoder(iencoder) {}
+
+protected:
+    void run() { this->encoder->encodeLoop(); }
+
+private:
+    VideoEncoder *encoder;
+};
+
+#ifdef NEW_AVCODEC
+AVPixelFormat getInputPixelFormat(const Camera::ImageFormat format)
+#else
+PixelFormat getInputPixelFormat(const Camera::ImageFormat format)
+#endif
+{
+    switch(format){
+	case Camera::RGB8:    return PIX_FMT_RGB24;
+	case Camera::BGR8:    return PIX_FMT_BGR24;
+	case Camera::MONO8:   return PIX_FMT_GRAY8;
+	case Camera::YUYV422: return PIX_FMT_YUYV422;
+	case Camera::YUYV411: return PIX_FMT_UYYVYY411;
+	case Camera::MJPEG:   return PIX_FMT_YUV422P;
+#ifdef WORDS_BIGENDIAN
+	case Camera::RGB16:   return PIX_FMT_RGB48BE;
+	case Camera::MONO16:  return PIX_FMT_GRAY16BE;
+#else
+	case Camera::RGB16:   return PIX_FMT_RGB48LE;
+	case Camera::MONO16:  return PIX_FMT_GRAY16LE;
+#endif
+	default:
+	    return PIX_FMT_NONE;
+    }
+}
+
+/**
+ * Obtain the pixel format a codec should encode frames from the given
+ * camera format in. FFV1 keeps as much of the source as it can.
+ */
+#ifdef NEW_AVCODEC
+static AVPixelFormat getEncoderPixelFormat(const VideoEncoder::Codec codec,
+					   const Camera::ImageFormat format)
+#else
+static PixelFormat getEncoderPixelFormat(const VideoEncoder::Codec codec,
+					 const Camera::ImageFormat format)
+#endif
+{
+    switch(codec){
+	case VideoEncoder::MJPEG:
+	    return PIX_FMT_YUVJ420P;
+	case VideoEncoder::H264:
+	    return PIX_FMT_YUV420P;
+	case VideoEncoder::FFV1:
+	default:
+	    switch(format){
+		case Camera::MONO8:   return PIX_FMT_GRAY8;
+		case Camera::MONO16:  return getInputPixelFormat(format);
+		case Camera::MJPEG:
+		case Camera::YUYV422: return PIX_FMT_YUV422P;
+		case Camera::YUYV411: return PIX_FMT_YUV411P;
+		default:              return PIX_FMT_RGB32;
+	    }
+    }
+}
+
+#ifdef NEW_AVCODEC
+static AVCodecID getCodecID(const VideoEncoder::Codec codec)
+#else
+static CodecID getCodecID(const VideoEncoder::Codec codec)
+#endif
+{
+    switch(codec){
+	case VideoEncoder::H264: return CODEC_ID_H264;
+	case VideoEncoder::FFV1: return CODEC_ID_FFV1;
+	case VideoEncoder::MJPEG:
+	default:
+	    return CODEC_ID_MJPEG;
+    }
+}
+
+
+VideoEncoder::VideoEncoder(const std::string &path,
+			   const unsigned iwidth, const unsigned iheight,
+			   const Camera::ImageFormat iformat, const Codec icodec,
+			   const unsigned fps, const unsigned queueSize,
+			   const QueuePolicy ipolicy, const unsigned threads)
+    throw (const std::string &):
+    formatContext(NULL), codecContext(NULL), stream(NULL),
+    imageConvertContext(NULL), inputFrame(NULL), outputFrame(NULL),
+    outputBuffer(NULL), mjpegDecoder(NULL),
+    width(iwidth), height(iheight), format(iformat), codec(icodec),
+    policy(ipolicy), inputSize(0), opened(false),
+    submittedFrames(0), encodedFrames(0), droppedFrames(0),
+    encodeStop(false), encodeThread(NULL)
+{
+    if( getInputPixelFormat(this->format) == PIX_FMT_NONE )
+	throw std::string("Unsupported Camera Format For Encoding");
+
+    this->passthrough = (this->format == Camera::MJPEG && this->codec == MJPEG);
+
+    av_register_all();
+
+    try {
+	avformat_alloc_output_context2(&this->formatContext, NULL, NULL, path.c_str());
+	if( this->formatContext == NULL )
+	    throw std::string("Unable To Determine Video Container From File Name");
+
+	this->openCodec(fps, threads);
+
+	if( !(this->formatContext->oformat->flags & AVFMT_NOFILE)){
+	    if( avio_open(&this->formatContext->pb, path.c_str(), AVIO_FLAG_WRITE) < 0 )
+		throw std::string("Unable To Open Video File");
+	}
+
+	if( avformat_write_header(this->formatContext, NULL) < 0 )
+	    throw std::string("Unable To Write Video Header");
+
+	if( !this->passthrough ){
+	    if( this->format == Camera::MJPEG ){
+		this->mjpegDecoder = new VideoDecoder(this->width, this->height, VideoDecoder::MJPEG, false);
+		this->mjpegDecoder->setOutputFormat(VideoDecoder::YUV422P);
+	    }
+
+#ifdef NEW_AVCODEC
+	    this->inputFrame = av_frame_alloc();
+#else
+	    this->inputFrame = avcodec_alloc_frame();
+#endif
+	    this->inputSize = avpicture_get_size(getInputPixelFormat(this->format),
+						 this->width, this->height);
+
+	    // Frames already in the format the codec wants are encoded
+	    // straight from the queue
+	    if( getInputPixelFormat(this->format) != this->codecContext->pix_fmt ){
+#ifdef NEW_AVCODEC
+		this->outputFrame = av_frame_alloc();
+#else
+		this->outputFrame = avcodec_alloc_frame();
+#endif
+		this->outputBuffer = new uint8_t[avpicture_get_size(this->codecContext->pix_fmt,
+								    this->width, this->height)];
+		avpicture_fill((AVPicture *)this->outputFrame, this->outputBuffer,
+			       this->codecContext->pix_fmt, this->width, this->height);
+		this->imageConvertContext = sws_getContext(this->width, this->height,
+							   getInputPixelFormat(this->format),
+							   this->width, this->height,
+							   this->codecContext->pix_fmt, SWS_BICUBIC,
+							   NULL, NULL, NULL);
+	    }
+	}
+    }
+    catch( const std::string & ){
+	this->destroy();
+	throw;
+    }
+
+    // Preallocate the queue so adding frames doesn't allocate
+    this->framePool.resize(queueSize ? queueSize : 1);
+    for(unsigned i = 0; i < this->framePool.size(); i++ ){
+	this->framePool[i].data.resize(this->inputSize ? this->inputSize
+				       : this->width * this->height * 3);
+	this->spare.push_back(&this->framePool[i]);
+    }
+
+    this->opened = true;
+    this->encodeThread = new EncodeThread(this);
+    this->encodeThread->start();
+}
+
+VideoEncoder::~VideoEncoder()
+{
+    this->close();
+}
+
+void VideoEncoder::openCodec(const unsigned fps, const unsigned threads)
+    throw (const std::string &)
+{
+    AVDictionary *options = NULL;
+    AVCodec *c = avcodec_find_encoder(getCodecID(this->codec));
+
+    if( c == NULL ){
+	if( this->codec == H264 )
+	    throw std::string("H.264 Encoding Codec not found, libavcodec must be built with libx264");
+	throw std::string("Encoding Codec not found");
+    }
+
+    this->stream = avformat_new_stream(this->formatContext, c);
+    if( this->stream == NULL )
+	throw std::string("Unable To Create Video Stream");
+
+    this->codecContext = this->stream->codec;
+    this->codecContext->codec_id = getCodecID(this->codec);
+    this->codecContext->codec_type = AVMEDIA_TYPE_VIDEO;
+    this->codecContext->width = this->width;
+    this->codecContext->height = this->height;
+    this->codecContext->time_base.num = 1;
+    this->codecContext->time_base.den = fps;
+    this->codecContext->pix_fmt = getEncoderPixelFormat(this->codec, this->format);
+    this->stream->time_base = this->codecContext->time_base;
+
+    // Let the codec encode several frames at once
+    this->codecContext->thread_count = threads;
+    this->codecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+    switch(this->codec){
+	case MJPEG:
+	    // Constant, high quality
+	    this->codecContext->qmin = 2;
+	    this->codecContext->qmax = 3;
+	    break;
+	case H264:
+	    av_dict_set(&options, "preset", "veryfast", 0);
+	    av_dict_set(&options, "crf", "23", 0);
+	    break;
+	case FFV1:
+	    // Every frame a keyframe so the video can be seeked cheaply
+	    this->codecContext->gop_size = 1;
+	    break;
+    }
+
+    if( this->formatContext->oformat->flags & AVFMT_GLOBALHEADER )
+	this->codecContext->flags |= CODEC_FLAG_GLOBAL_HEADER;
+
+    if( avcodec_open2(this->codecContext, c, &options) < 0 ){
+	av_dict_free(&options);
+	throw std::string("Unable to open encoding Codec");
+    }
+    av_dict_free(&options);
+}
+
+bool VideoEncoder::addFrame(const unsigned char *data, const unsigned size)
+{
+    ScopedLock lock(this->queueLock);
+    QueuedFrame *f;
+
+    if( !this->opened || this->encodeStop )
+	return false;
+
+    if( this->format != Camera::MJPEG && size < this->inputSize )
+	return false;
+
+    int64_t number = this->submittedFrames++;
+
+    if( this->spare.empty()){
+	switch( this->policy ){
+	    case BLOCK:
+		while( this->spare.empty() && !this->encodeStop )
+		    this->queueNotFull.wait(this->queueLock);
+		if( this->encodeStop )
+		    return false;
+		break;
+	    case DROP_OLDEST:
+		// The frame being encoded can't be dropped
+		if( !this->ready.empty()){
+		    this->spare.push_back(this->ready.front());
+		    this->ready.pop_front();
+		    this->droppedFrames++;
+		    break;
+		}
+		// Fall through
+	    case DROP_NEWEST:
+		this->droppedFrames++;
+		return false;
+	}
+    }
+
+    f = this->spare.back();
+    this->spare.pop_back();
+
+    // Copy without holding the lock so the encoder isn't held up
+    this->queueLock.unlock();
+    if( f->data.size() < size )
+	f->data.resize(size);
+    memcpy(&f->data[0], data, size);
+    f->size = size;
+    f->number = number;
+    this->queueLock.lock();
+
+    // The encoder may have been closed while copying
+    if( this->encodeStop ){
+	this->spare.push_back(f);
+	return false;
+    }
+
+    this->ready.push_back(f);
+    this->queueNotEmpty.signal();
+    return true;
+}
+
+void VideoEncoder::encodeLoop()
+{
+    for(;;){
+	QueuedFrame *f;
+
+	{
+	    ScopedLock lock(this->queueLock);
+	    while( this->ready.empty() && !this->encodeStop )
+		this->queueNotEmpty.wait(this->queueLock);
+
+	    // Only finish once everything queued has been encoded
+	    if( this->ready.empty())
+		return;
+	    f = this->ready.front();
+	    this->ready.pop_front();
+	}
+
+	this->encodeQueuedFrame(f);
+
+	ScopedLock lock(this->queueLock);
+	this->encodedFrames++;
+	this->spare.push_back(f);
+	this->queueNotFull.signal();
+    }
+}
+
+void VideoEncoder::encodeQueuedFrame(QueuedFrame *f)
+{
+    AVPacket packet;
+    int gotPacket = 0;
+    const uint8_t *data = &f->data[0];
+
+    av_init_packet(&packet);
+
+    if( this->passthrough ){
+	packet.data = &f->data[0];
+	packet.size = f->size;
+	packet.pts = packet.dts = f->number;
+	packet.flags |= AV_PKT_FLAG_KEY;
+	this->writePacket(&packet);
+	return;
+    }
+
+    if( this->mjpegDecoder ){
+	this->mjpegDecoder->nextFrame(data, f->size);
+	data = this->mjpegDecoder->getFrame();
+    }
+
+    avpicture_fill((AVPicture *)this->inputFrame, data, getInputPixelFormat(this->format),
+		   this->width, this->height);
+
+    AVFrame *frame = this->inputFrame;
+    if( this->imageConvertContext ){
+	sws_scale(this->imageConvertContext,
+		  this->inputFrame->data, this->inputFrame->linesize,
+		  0, this->height,
+		  this->outputFrame->data, this->outputFrame->linesize);
+	frame = this->outputFrame;
+    }
+    frame->pts = f->number;
+
+    packet.data = NULL;
+    packet.size = 0;
+    if( avcodec_encode_video2(this->codecContext, &packet, frame, &gotPacket) < 0 ){
+	wclclog << "VideoEncoder: Unable to encode frame " << f->number << endl;
+	return;
+    }
+
+    if( gotPacket )
+	this->writePacket(&packet);
+}
+
+void VideoEncoder::writePacket(AVPacket *packet)
+{
+    if( packet->pts != (int64_t)AV_NOPTS_VALUE )
+	packet->pts = av_rescale_q(packet->pts, this->codecContext->time_base, this->stream->time_base);
+    if( packet->dts != (int64_t)AV_NOPTS_VALUE )
+	packet->dts = av_rescale_q(packet->dts, this->codecContext->time_base, this->stream->time_base);
+    packet->stream_index = this->stream->index;
+
+    if( av_interleaved_write_frame(this->formatContext, packet) < 0 )
+	wclclog << "VideoEncoder: Unable to write frame" << endl;
+}
+
+void VideoEncoder::flushEncoder()
+{
+    if( this->passthrough )
+	return;
+
+    // Codecs using several threads or B frames hold frames back
+    for(;;){
+	AVPacket packet;
+	int gotPacket = 0;
+
+	av_init_packet(&packet);
+	packet.data = NULL;
+	packet.size = 0;
+	if( avcodec_encode_video2(this->codecContext, &packet, NULL, &gotPacket) < 0 || !gotPacket )
+	    return;
+	this->writePacket(&packet);
+    }
+}
+
+void VideoEncoder::close()
+{
+    if( !this->opened )
+	return;
+
+    {
+	ScopedLock lock(this->queueLock);
+	this->encodeStop = true;
+	this->queueNotEmpty.broadcast();
+	this->queueNotFull.broadcast();
+    }
+
+    this->encodeThread->join();
+    delete this->encodeThread;
+    this->encodeThread = NULL;
+
+    this->flushEncoder();
+    av_write_trailer(this->formatContext);
+
+    this->opened = false;
+    this->destroy();
+}
+
+void VideoEncoder::destroy()
+{
+    if( this->codecContext ){
+	avcodec_close(this->codecContext);
+	this->codecContext = NULL;
+    }
+
+    if( this->formatContext ){
+	if( !(this->formatContext->oformat->flags & AVFMT_NOFILE) &&
+	    this->formatContext->pb )
+	    avio_close(this->formatContext->pb);
+	avformat_free_context(this->formatContext);
+	this->formatContext = NULL;
+	this->stream = NULL;
+    }
+
+    sws_freeContext(this->imageConvertContext);
+    this->imageConvertContext = NULL;
+    av_free(this->inputFrame);
+    this->inputFrame = NULL;
+    av_free(this->outputFrame);
+    this->outputFrame = NULL;
+    delete [] this->outputBuffer;
+    this->outputBuffer = NULL;
+    delete this->mjpegDecoder;
+    this->mjpegDecoder = NULL;
+}
+
+unsigned VideoEncoder::getQueuedFrames()
+{
+    ScopedLock lock(this->queueLock);
+    return this->ready.size();
+}
+
+uint64_t VideoEncoder::getEncodedFrames()
+{
+    ScopedLock lock(this->queueLock);
+    return this->encodedFrames;
+}
+
+uint64_t VideoEncoder::getDroppedFrames()
+{
+    ScopedLock lock(this->queueLock);
+    return this->droppedFrames;
+}
+
+};
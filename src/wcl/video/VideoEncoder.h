@@ -0,0 +1,185 @@
+/*-
+ * Copyright (c) 2026 LibWCL Authors (see AUTHORS)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#ifndef WCL_VIDEO_VIDEOENCODER_H
+#define WCL_VIDEO_VIDEOENCODER_H
+
+extern "C" {
+#include <stdint.h>
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libswscale/swscale.h>
+};
+#include <deque>
+#include <string>
+#include <vector>
+#include <wcl/api.h>
+#include <wcl/camera/Camera.h>
+#include <wcl/util/Thread.h>
+
+namespace wcl
+{
+    class VideoDecoder;
+
+    /**
+     * VideoEncoder writes frames, as obtained from a Camera, to a video file.
+     * Encoding happens in a background thread. Frames are copied into a
+     * bounded queue by addFrame, what happens when the queue is full is
+     * determined by the QueuePolicy. The container is picked from the file
+     * extension, eg .avi or .mkv.
+     *
+     * MJPEG camera frames written to an MJPEG video are stored as is
+     * without being decoded or encoded again.
+     */
+    class WCL_API VideoEncoder
+    {
+    public:
+	enum Codec {
+	    MJPEG, // Motion JPEG
+	    H264,  // H.264, requires libavcodec to be built with libx264
+	    FFV1   // Lossless
+	};
+
+	enum QueuePolicy {
+	    BLOCK,       // addFrame waits until there is space in the queue
+	    DROP_NEWEST, // The frame being added is dropped
+	    DROP_OLDEST  // The oldest queued frame is dropped to make room
+	};
+
+	/**
+	 * Create a new video file
+	 *
+	 * @param path The file to write to
+	 * @param width The width of the frames
+	 * @param height The height of the frames
+	 * @param format The format frames will be given to addFrame in. RGB32,
+	 *        RAW8, RAW16 and FORMAT7 are not supported
+	 * @param codec The codec to encode the video with
+	 * @param fps The frame rate of the video
+	 * @param queueSize The amount of frames that can wait to be encoded
+	 * @param policy What to do with frames when the queue is full
+	 * @param threads The amount of threads the codec may use to encode
+	 *        frames in parallel, 0 lets the codec decide
+	 * @throws std::string if the file or the codec could not be set up
+	 */
+	VideoEncoder(const std::string &path,
+		     const unsigned width, const unsigned height,
+		     const Camera::ImageFormat format, const Codec codec,
+		     const unsigned fps = 30, const unsigned queueSize = 8,
+		     const QueuePolicy policy = BLOCK, const unsigned threads = 0) throw (const std::string &);
+
+	/**
+	 * Destroy the encoder, closing the file if it is still open
+	 */
+	~VideoEncoder();
+
+	/**
+	 * Queue a frame to be encoded. The frame is copied so the
+	 * buffer may be reused as soon as addFrame returns. Each frame added,
+	 * including dropped ones, advances the video by one frame so
+	 * playback timing is kept.
+	 *
+	 * @param data The frame in the format given to the constructor
+	 * @param size The size of the frame in bytes. For MJPEG this is
+	 *        the size of the JPEG image
+	 * @return false if the frame was dropped or the encoder is closed
+	 */
+	bool addFrame(const unsigned char *data, const unsigned size);
+
+	/**
+	 * Encode all queued frames and finish writing the file. No more
+	 * frames can be added once the file is closed.
+	 */
+	void close();
+
+	/**
+	 * Obtain the amount of frames waiting to be encoded
+	 */
+	unsigned getQueuedFrames();
+
+	/**
+	 * Obtain the amount of frames that have been encoded
+	 */
+	uint64_t getEncodedFrames();
+
+	/**
+	 * Obtain the amount of frames dropped due to the queue being full
+	 */
+	uint64_t getDroppedFrames();
+
+    private:
+	/**
+	 * A preallocated slot in the input queue
+	 */
+	struct QueuedFrame {
+	    std::vector<unsigned char> data;
+	    unsigned size;
+	    int64_t number;
+	};
+
+	class EncodeThread;
+	friend class EncodeThread;
+
+	AVFormatContext *formatContext;
+	AVCodecContext *codecContext;
+	AVStream *stream;
+	SwsContext *imageConvertContext;
+	AVFrame *inputFrame;
+	AVFrame *outputFrame;
+	uint8_t *outputBuffer;
+	VideoDecoder *mjpegDecoder;
+
+	unsigned width;
+	unsigned height;
+	Camera::ImageFormat format;
+	Codec codec;
+	QueuePolicy policy;
+	unsigned inputSize; // Size of an uncompressed input frame
+	bool passthrough; // MJPEG frames are written without re-encoding
+	bool opened;
+
+	// The queue, protected by queueLock
+	std::vector<QueuedFrame> framePool;
+	std::deque<QueuedFrame *> ready;
+	std::vector<QueuedFrame *> spare;
+	int64_t submittedFrames;
+	uint64_t encodedFrames;
+	uint64_t droppedFrames;
+	bool encodeStop;
+	EncodeThread *encodeThread;
+	Mutex queueLock;
+	Condition queueNotFull;
+	Condition queueNotEmpty;
+
+	void openCodec(const unsigned fps, const unsigned threads) throw (const std::string &);
+	void encodeLoop();
+	void encodeQueuedFrame(QueuedFrame *frame);
+	void writePacket(AVPacket *packet);
+	void flushEncoder();
+	void destroy();
+    };
+};
+
+#endif
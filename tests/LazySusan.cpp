@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+
+#include <wcl/network/Reactor.h>
+#include <wcl/tracking/LazySusan.h>
+
+/**
+ * Pretends to be the turntable on the master side of a pty, the LazySusan
+ * class talks to the slave side as if it were a serial port.
+ */
+class LazySusanTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        ASSERT_GE(master, 0);
+        ASSERT_EQ(0, grantpt(master));
+        ASSERT_EQ(0, unlockpt(master));
+        slave = ptsname(master);
+    }
+
+    virtual void TearDown() {
+        close(master);
+    }
+
+    void send(const std::string &bytes) {
+        ASSERT_EQ((ssize_t)bytes.size(), write(master, bytes.data(), bytes.size()));
+    }
+
+    /**
+     * The number of requests the turntable has been sent
+     */
+    unsigned requests() {
+        char buffer[64];
+        unsigned count = 0;
+        ssize_t n;
+        while ((n = read(master, buffer, sizeof(buffer))) > 0)
+            pending.append(buffer, n);
+
+        std::string::size_type at;
+        while ((at = pending.find("p\r")) != std::string::npos) {
+            pending.erase(0, at + 2);
+            count++;
+        }
+        return count;
+    }
+
+    int master;
+    std::string slave;
+    std::string pending;
+};
+
+static double rotationOf(wcl::LazySusan &susan) {
+    wcl::Quaternion q = susan.getObject("")->getOrientation();
+    return 2 * atan2(q.y, q.w) * 180 / M_PI;
+}
+
+TEST_F(LazySusanTest, pollsFromUpdate) {
+
+    wcl::LazySusan susan(slave);
+    susan.update();
+    usleep(10000);
+    EXPECT_EQ(1u, requests());
+
+    send("0400$\r\n");
+    usleep(10000);
+    susan.update();
+    EXPECT_EQ(1u, susan.getSampleCount());
+    EXPECT_NEAR(90, rotationOf(susan), 1e-6);
+    EXPECT_GT(susan.getObject("")->getTimestamp(), 0u);
+    EXPECT_GT(susan.getLatency(), 0);
+
+    // The next reading is asked for straight away
+    usleep(10000);
+    EXPECT_EQ(1u, requests());
+}
+
+TEST_F(LazySusanTest, resynchronisesAfterPartialReading) {
+
+    wcl::LazySusan susan(slave);
+    susan.update();
+
+    send("00$\r\n0800$\r\n");
+    for (unsigned i = 0; i < 100 && susan.getSampleCount() == 0; i++) {
+        usleep(1000);
+        susan.update();
+    }
+    EXPECT_EQ(1u, susan.getSampleCount());
+    EXPECT_EQ(1u, susan.getErrorCount());
+    EXPECT_NEAR(180, rotationOf(susan), 1e-6);
+}
+
+TEST_F(LazySusanTest, streamsFromReactor) {
+
+    wcl::Reactor reactor;
+    wcl::LazySusan susan(slave, reactor);
+
+    // Answer every request with the table a little further round
+    static const char *readings[] = { "0000$\r\n", "0010$\r\n", "0020$\r\n", "0030$\r\n", "0040$\r\n" };
+    unsigned answered = 0;
+    for (unsigned i = 0; i < 1000 && answered < 5; i++) {
+        if (requests() > 0)
+            send(readings[answered++]);
+        reactor.poll(5);
+    }
+    ASSERT_EQ(5u, answered);
+
+    for (unsigned i = 0; i < 100 && susan.getSampleCount() < 5; i++) {
+        reactor.poll(5);
+        susan.update();
+    }
+    EXPECT_EQ(5u, susan.getSampleCount());
+    EXPECT_EQ(0u, susan.getErrorCount());
+    EXPECT_NEAR(0x40 * 360.0 / 4096, rotationOf(susan), 1e-6);
+    EXPECT_GT(susan.getRotationRate(), 0);
+    EXPECT_GT(susan.getSampleRate(), 0);
+    EXPECT_GT(susan.getLatency(), 0);
+}
+
+TEST_F(LazySusanTest, asksAgainAfterTimeout) {
+
+    wcl::Reactor reactor;
+    wcl::LazySusan susan(slave, reactor);
+
+    for (unsigned i = 0; i < 50 && susan.getTimeoutCount() == 0; i++)
+        reactor.poll(10);
+    EXPECT_EQ(1u, susan.getTimeoutCount());
+    EXPECT_EQ(2u, requests());
+}
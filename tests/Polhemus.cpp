@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+
+#include <wcl/tracking/Polhemus.h>
+#include <wcl/util/Thread.h>
+
+/**
+ * Pretends to be the tracker on the master side of a pty, the Polhemus
+ * class talks to the slave side as if it were a serial port.
+ */
+class PolhemusTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        ASSERT_GE(master, 0);
+        ASSERT_EQ(0, grantpt(master));
+        ASSERT_EQ(0, unlockpt(master));
+        slave = ptsname(master);
+    }
+
+    virtual void TearDown() {
+        close(master);
+    }
+
+    void send(const std::string &bytes) {
+        ASSERT_EQ((ssize_t)bytes.size(), write(master, bytes.data(), bytes.size()));
+    }
+
+    int master;
+    std::string slave;
+};
+
+static void putFloat(std::string &s, float f) {
+    uint32_t u;
+    memcpy(&u, &f, 4);
+    for (int i = 0; i < 4; i++)
+        s += (char)((u >> (8 * i)) & 0xff);
+}
+
+/**
+ * A Patriot binary record, position in cm and a quaternion
+ */
+static std::string binaryRecord(unsigned station, float x, float y, float z,
+                                float w = 1, float qx = 0, float qy = 0, float qz = 0) {
+    std::string s("PA");
+    s += (char)station;
+    s += 'P';
+    s += ' ';
+    s += '\0';
+    s += (char)28;
+    s += '\0';
+    putFloat(s, x);
+    putFloat(s, y);
+    putFloat(s, z);
+    putFloat(s, w);
+    putFloat(s, qx);
+    putFloat(s, qy);
+    putFloat(s, qz);
+    return s;
+}
+
+namespace {
+
+class DelayedWriter : public wcl::Thread {
+public:
+    DelayedWriter(int fd, const std::string &bytes) : fd(fd), bytes(bytes) {}
+
+    void run() {
+        usleep(20000);
+        if (write(fd, bytes.data(), bytes.size()) < 0)
+            perror("write");
+    }
+
+    int fd;
+    std::string bytes;
+};
+
+}
+
+TEST_F(PolhemusTest, parsesBinaryRecords) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT, wcl::Polhemus::BINARY);
+
+    send(binaryRecord(1, 1, 2, 3) + binaryRecord(2, -4, 5.5, 6, 0, 1, 0, 0));
+    tracker.update();
+
+    // Units are mm, the tracker sends cm
+    wcl::Vector a = tracker.getObject("sensor1")->getTranslation();
+    ASSERT_FLOAT_EQ(10, a[0]);
+    ASSERT_FLOAT_EQ(20, a[1]);
+    ASSERT_FLOAT_EQ(30, a[2]);
+
+    wcl::TrackedObject *b = tracker.getObject("sensor2");
+    ASSERT_FLOAT_EQ(-40, b->getTranslation()[0]);
+    ASSERT_FLOAT_EQ(55, b->getTranslation()[1]);
+    ASSERT_FLOAT_EQ(1, b->getOrientation().x);
+    ASSERT_EQ(0u, tracker.getResyncCount());
+    ASSERT_GT(b->getTimestamp(), 0u);
+}
+
+TEST_F(PolhemusTest, resynchronisesAfterCorruption) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT, wcl::Polhemus::BINARY);
+
+    // Line noise, a header with a bad length, a record cut short and one
+    // whose values are rubbish, before the real records
+    std::string noise("\x13\x37PAxPQ", 7);
+    std::string badLength = binaryRecord(1, 9, 9, 9);
+    badLength[6] = 99;
+    std::string cut = binaryRecord(2, 9, 9, 9).substr(0, 20);
+    std::string rubbish = binaryRecord(1, 9, 9, 9, 7, 7, 7, 7);
+
+    send(noise + badLength + cut + rubbish + binaryRecord(1, 1, 1, 1) + binaryRecord(2, 2, 2, 2));
+    tracker.update();
+
+    ASSERT_FLOAT_EQ(10, tracker.getObject("sensor1")->getTranslation()[0]);
+    ASSERT_FLOAT_EQ(20, tracker.getObject("sensor2")->getTranslation()[0]);
+    ASSERT_GT(tracker.getResyncCount(), 0u);
+
+    // And carries on in step
+    send(binaryRecord(1, 3, 3, 3) + binaryRecord(2, 4, 4, 4));
+    tracker.update();
+    ASSERT_FLOAT_EQ(30, tracker.getObject("sensor1")->getTranslation()[0]);
+    ASSERT_FLOAT_EQ(40, tracker.getObject("sensor2")->getTranslation()[0]);
+}
+
+TEST_F(PolhemusTest, givesUpOnCorruptedReply) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT, wcl::Polhemus::BINARY);
+
+    // Station 2's record is rubbish and no good one follows
+    send(binaryRecord(1, 1, 1, 1) + binaryRecord(2, 9, 9, 9, 7, 7, 7, 7));
+    tracker.update();
+    ASSERT_FLOAT_EQ(10, tracker.getObject("sensor1")->getTranslation()[0]);
+    ASSERT_GT(tracker.getResyncCount(), 0u);
+
+    // The next reply is read in full
+    send(binaryRecord(1, 3, 3, 3) + binaryRecord(2, 4, 4, 4));
+    tracker.update();
+    ASSERT_FLOAT_EQ(30, tracker.getObject("sensor1")->getTranslation()[0]);
+    ASSERT_FLOAT_EQ(40, tracker.getObject("sensor2")->getTranslation()[0]);
+}
+
+TEST_F(PolhemusTest, throwsWithoutReply) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT, wcl::Polhemus::BINARY);
+
+    ASSERT_THROW(tracker.update(), wcl::Exception);
+
+    // A record cut short never completes either
+    send(binaryRecord(1, 1, 1, 1).substr(0, 20));
+    ASSERT_THROW(tracker.update(), wcl::Exception);
+}
+
+TEST_F(PolhemusTest, waitsForRecordsSplitAcrossReads) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT, wcl::Polhemus::BINARY);
+
+    std::string stream = binaryRecord(1, 1, 2, 3) + binaryRecord(2, 4, 5, 6);
+    send(stream.substr(0, 50));
+    DelayedWriter writer(master, stream.substr(50));
+    writer.start();
+
+    tracker.update();
+    writer.join();
+
+    ASSERT_FLOAT_EQ(60, tracker.getObject("sensor2")->getTranslation()[2]);
+    ASSERT_EQ(0u, tracker.getResyncCount());
+}
+
+TEST_F(PolhemusTest, continuousModeTakesTheNewest) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT, wcl::Polhemus::BINARY);
+    tracker.setContinuous(true);
+
+    send(binaryRecord(1, 1, 0, 0) + binaryRecord(2, 1, 0, 0) +
+         binaryRecord(1, 2, 0, 0) + binaryRecord(2, 2, 0, 0));
+    tracker.update();
+
+    ASSERT_FLOAT_EQ(20, tracker.getObject("sensor1")->getTranslation()[0]);
+    ASSERT_FLOAT_EQ(20, tracker.getObject("sensor2")->getTranslation()[0]);
+    tracker.setContinuous(false);
+}
+
+TEST_F(PolhemusTest, parsesAsciiLines) {
+
+    wcl::Polhemus tracker(slave, wcl::Polhemus::PATRIOT);
+
+    send("garbage\r\n"
+         "01   1.000  2.000  3.000  1.0000  0.0000  0.0000  0.0000\r\n"
+         "02   4.000 -5.000  6.500  0.0000  0.0000  1.0000  0.0000\r\n");
+    tracker.update();
+
+    ASSERT_FLOAT_EQ(20, tracker.getObject("sensor1")->getTranslation()[1]);
+    ASSERT_FLOAT_EQ(-50, tracker.getObject("sensor2")->getTranslation()[1]);
+    ASSERT_FLOAT_EQ(1, tracker.getObject("sensor2")->getOrientation().y);
+    ASSERT_EQ(1u, tracker.getResyncCount());
+}
+
+TEST_F(PolhemusTest, binaryIsPatriotOnly) {
+
+    ASSERT_THROW(wcl::Polhemus tracker(slave, wcl::Polhemus::FASTRAK, wcl::Polhemus::BINARY),
+                 wcl::Exception);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/DummyTrackedObject.h>
+#include <wcl/tracking/PoseFilter.h>
+#include <wcl/tracking/PredictiveTracker.h>
+
+class PoseFilterTest : public ::testing::Test {
+};
+
+static wcl::PoseHistory::Pose makePose(uint64_t timestamp, double x, double angle) {
+    wcl::PoseHistory::Pose p;
+    p.timestamp = timestamp;
+    p.position[0] = x;
+    p.position[1] = 0;
+    p.position[2] = 0;
+    p.orientation.set(cos(angle / 2), 0, 0, sin(angle / 2));
+    return p;
+}
+
+TEST_F(PoseFilterTest, predictsConstantVelocity) {
+
+    wcl::PoseFilter filter;
+    wcl::PoseHistory::Pose pose;
+    ASSERT_FALSE(filter.predict(0, pose));
+
+    // 100 units and 1 radian a second, sampled at 100Hz
+    for (unsigned i = 0; i < 200; i++)
+        filter.update(makePose(i * 10000, i, i * 0.01));
+
+    ASSERT_NEAR(100, filter.getVelocity()[0], 1e-3);
+    ASSERT_NEAR(1, filter.getAngularVelocity()[2], 1e-3);
+
+    ASSERT_TRUE(filter.predict(199 * 10000 + 50000, pose));
+    ASSERT_NEAR(204, pose.position[0], 1e-3);
+    ASSERT_NEAR(cos(2.04 / 2), pose.orientation.w, 1e-4);
+    ASSERT_NEAR(sin(2.04 / 2), pose.orientation.z, 1e-4);
+
+    // Not past the prediction limit
+    filter.predict(199 * 10000 + 10 * wcl::PoseFilter::DEFAULT_PREDICTION_LIMIT, pose);
+    ASSERT_NEAR(209, pose.position[0], 1e-3);
+}
+
+TEST_F(PoseFilterTest, restartsAfterAGap) {
+
+    wcl::PoseFilter filter;
+    for (unsigned i = 0; i < 20; i++)
+        filter.update(makePose(i * 10000, i, 0));
+
+    filter.update(makePose(10000000, 500, 0));
+    ASSERT_DOUBLE_EQ(0, filter.getVelocity()[0]);
+
+    wcl::PoseHistory::Pose pose;
+    ASSERT_TRUE(filter.predict(10050000, pose));
+    ASSERT_DOUBLE_EQ(500, pose.position[0]);
+}
+
+TEST_F(PoseFilterTest, predictiveTrackerWrapsObjects) {
+
+    wcl::DummyTracker dummy;
+    dummy.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3)));
+
+    wcl::PredictiveTracker tracker(dummy, 0.02);
+    ASSERT_TRUE(tracker.getObject("b") == NULL);
+
+    tracker.update();
+    ASSERT_EQ(1u, tracker.getObjectCount());
+
+    wcl::TrackedObject *a = tracker.getObject("a");
+    ASSERT_EQ(a, tracker.getObjectAt(0));
+    ASSERT_EQ("a", a->getName());
+    ASSERT_TRUE(a->isVisible());
+
+    // A stationary object stays put however far ahead
+    wcl::Vector translation = a->getTranslation();
+    ASSERT_DOUBLE_EQ(1, translation[0]);
+    ASSERT_DOUBLE_EQ(3, translation[2]);
+
+    wcl::PoseHistory::Pose pose;
+    ASSERT_TRUE(((wcl::PredictedTrackedObject *)a)->predict(0.05, pose));
+    ASSERT_DOUBLE_EQ(2, pose.position[1]);
+}
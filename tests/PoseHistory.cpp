@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/DummyTrackedObject.h>
+#include <wcl/tracking/PoseHistory.h>
+#include <wcl/util/Thread.h>
+
+class PoseHistoryTest : public ::testing::Test {
+};
+
+TEST_F(PoseHistoryTest, interpolatesBetweenPoses) {
+
+    wcl::PoseHistory history;
+    wcl::PoseHistory::Pose pose;
+    ASSERT_FALSE(history.getPoseAt(1000, pose));
+
+    // A quarter turn about z over 100us
+    history.push(1000, wcl::Vector(0, 0, 0), wcl::Quaternion(1, 0, 0, 0));
+    history.push(1100, wcl::Vector(10, 20, 30), wcl::Quaternion(sqrt(0.5), 0, 0, sqrt(0.5)));
+
+    ASSERT_FALSE(history.getPoseAt(999, pose));
+
+    ASSERT_TRUE(history.getPoseAt(1050, pose));
+    ASSERT_EQ(1050u, pose.timestamp);
+    ASSERT_DOUBLE_EQ(5, pose.position[0]);
+    ASSERT_DOUBLE_EQ(10, pose.position[1]);
+    ASSERT_DOUBLE_EQ(15, pose.position[2]);
+    ASSERT_NEAR(cos(M_PI / 8), pose.orientation.w, 1e-9);
+    ASSERT_NEAR(sin(M_PI / 8), pose.orientation.z, 1e-9);
+
+    ASSERT_TRUE(history.getPoseAt(1000, pose));
+    ASSERT_DOUBLE_EQ(0, pose.position[0]);
+    ASSERT_TRUE(history.getPoseAt(1100, pose));
+    ASSERT_DOUBLE_EQ(10, pose.position[0]);
+}
+
+TEST_F(PoseHistoryTest, extrapolatesWithinLimit) {
+
+    wcl::PoseHistory history;
+    history.setExtrapolationLimit(100);
+    history.push(1000, wcl::Vector(0, 0, 0), wcl::Quaternion(1, 0, 0, 0));
+    history.push(1100, wcl::Vector(10, 0, 0), wcl::Quaternion(1, 0, 0, 0));
+
+    wcl::PoseHistory::Pose pose;
+    ASSERT_TRUE(history.getPoseAt(1150, pose));
+    ASSERT_DOUBLE_EQ(15, pose.position[0]);
+    ASSERT_TRUE(history.getPoseAt(1200, pose));
+    ASSERT_DOUBLE_EQ(20, pose.position[0]);
+    ASSERT_FALSE(history.getPoseAt(1201, pose));
+}
+
+TEST_F(PoseHistoryTest, keepsTheNewestPoses) {
+
+    wcl::PoseHistory history;
+    unsigned total = wcl::PoseHistory::CAPACITY + 10;
+    for (unsigned i = 1; i <= total; i++)
+        history.push(i * 10, wcl::Vector(i, 0, 0), wcl::Quaternion(1, 0, 0, 0));
+
+    // Older and same time poses
+    history.push(5, wcl::Vector(-1, 0, 0), wcl::Quaternion(1, 0, 0, 0));
+    history.push(total * 10, wcl::Vector(-2, 0, 0), wcl::Quaternion(1, 0, 0, 0));
+
+    ASSERT_EQ(wcl::PoseHistory::CAPACITY, history.getSize());
+    ASSERT_EQ(total * 10, history.getLatestTime());
+
+    wcl::PoseHistory::Pose pose;
+    ASSERT_FALSE(history.getPoseAt(100, pose));
+    ASSERT_TRUE(history.getPoseAt(205, pose));
+    ASSERT_DOUBLE_EQ(20.5, pose.position[0]);
+    ASSERT_TRUE(history.getLatest(pose));
+    ASSERT_DOUBLE_EQ(-2, pose.position[0]);
+}
+
+TEST_F(PoseHistoryTest, trackerUpdateRecordsPoses) {
+
+    wcl::DummyTracker tracker;
+    wcl::DummyTrackedObject *a = new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3));
+    tracker.addTrackedObject(a);
+    ASSERT_EQ(0u, a->getTimestamp());
+
+    uint64_t before = wcl::Tracker::getCurrentTime();
+    tracker.update();
+    ASSERT_GE(a->getTimestamp(), before);
+
+    wcl::PoseHistory::Pose pose;
+    ASSERT_TRUE(a->getPoseAt(a->getTimestamp(), pose));
+    ASSERT_DOUBLE_EQ(1, pose.position[0]);
+    ASSERT_DOUBLE_EQ(3, pose.position[2]);
+}
+
+namespace {
+
+class Reader : public wcl::Thread {
+public:
+    Reader(const wcl::PoseHistory &history) : history(history), torn(0), stopped(false) {}
+
+    void run() {
+        wcl::PoseHistory::Pose pose;
+        while (!stopped) {
+            uint64_t latest = history.getLatestTime();
+            if (latest > 0 && history.getPoseAt(latest, pose)) {
+                // Every pose pushed has x, y and z equal
+                if (pose.position[0] != pose.position[1] || pose.position[1] != pose.position[2])
+                    torn++;
+            }
+        }
+    }
+
+    const wcl::PoseHistory &history;
+    unsigned torn;
+    volatile bool stopped;
+};
+
+}
+
+TEST_F(PoseHistoryTest, readsFromAnotherThread) {
+
+    wcl::PoseHistory history;
+    Reader reader(history);
+    reader.start();
+
+    for (unsigned i = 1; i <= 200000; i++)
+        history.push(i, wcl::Vector(i, i, i), wcl::Quaternion(1, 0, 0, 0));
+
+    reader.stopped = true;
+    reader.join();
+    ASSERT_EQ(0u, reader.torn);
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unistd.h>
+
+#include <wcl/network/Reactor.h>
+#include <wcl/network/TCPServer.h>
+#include <wcl/projector/MatrixSwitch.h>
+#include <wcl/projector/ProjectorGroup.h>
+#include <wcl/projector/RemoteProjector.h>
+#include <wcl/util/Thread.h>
+
+#define PORT 55570
+
+/**
+ * Stands in for a switch or projector on the loopback device. It records
+ * what it is sent, and depending on the mode acknowledges projector
+ * commands, stays silent, or hangs up after every command.
+ */
+class StandIn : public wcl::TCPConnectionHandler, public wcl::Thread
+{
+    public:
+	enum Mode { SILENT, ACKNOWLEDGE, HANG_UP };
+
+	StandIn(const unsigned port, const Mode imode)
+	    : server(port), mode(imode), connections(0), disconnections(0)
+	{
+	    reactor.listen(server, this);
+	    start();
+	}
+
+	~StandIn()
+	{
+	    reactor.stop();
+	    join();
+	}
+
+	void connected(wcl::TCPConnection *)
+	{
+	    wcl::ScopedLock l(lock);
+	    connections++;
+	}
+
+	void dataReceived(wcl::TCPConnection *c)
+	{
+	    lock.lock();
+	    received.append((const char *)c->getReadData(), c->getReadSize());
+
+	    if (mode == ACKNOWLEDGE) {
+		// Answer each complete command with the acknowledgement
+		while (c->getReadSize() >= 6) {
+		    unsigned char ack[6] = { (unsigned char)(c->getReadData()[0] | 0x20), 0, 1, 0, 0, 0 };
+		    c->consume(6);
+		    c->write(ack, sizeof(ack));
+		}
+	    }
+	    else
+		c->consume(c->getReadSize());
+	    lock.unlock();
+
+	    // Closing tells disconnected straight away
+	    if (mode == HANG_UP)
+		c->close();
+	}
+
+	void disconnected(wcl::TCPConnection *)
+	{
+	    wcl::ScopedLock l(lock);
+	    disconnections++;
+	}
+
+	/**
+	 * Wait for the given amount of data to arrive
+	 */
+	std::string waitFor(const size_t size)
+	{
+	    for (unsigned i = 0; i < 200; i++) {
+		{
+		    wcl::ScopedLock l(lock);
+		    if (received.size() >= size)
+			return received;
+		}
+		usleep(10000);
+	    }
+	    wcl::ScopedLock l(lock);
+	    return received;
+	}
+
+	unsigned getConnections()
+	{
+	    wcl::ScopedLock l(lock);
+	    return connections;
+	}
+
+	unsigned waitForDisconnections(const unsigned count)
+	{
+	    for (unsigned i = 0; i < 200; i++) {
+		{
+		    wcl::ScopedLock l(lock);
+		    if (disconnections >= count)
+			break;
+		}
+		usleep(10000);
+	    }
+	    wcl::ScopedLock l(lock);
+	    return disconnections;
+	}
+
+    protected:
+	void run()
+	{
+	    reactor.run();
+	}
+
+    private:
+	wcl::Reactor reactor;
+	wcl::TCPServer server;
+	Mode mode;
+	wcl::Mutex lock;
+	std::string received;
+	unsigned connections;
+	unsigned disconnections;
+};
+
+static std::string command(unsigned output, unsigned input)
+{
+    char message[14];
+    snprintf(message, sizeof(message), "*%3d0004%2d%2d!", 1, output, input);
+    return message;
+}
+
+class ProjectorControlTest : public ::testing::Test {
+};
+
+TEST_F(ProjectorControlTest, switchReusesConnection) {
+
+    StandIn standIn(PORT, StandIn::SILENT);
+    wcl::MatrixSwitch sw("127.0.0.1", 1, NULL, PORT);
+
+    std::string expected;
+    for (unsigned output = 1; output <= wcl::MatrixSwitch::MAX_ID; output++) {
+	ASSERT_TRUE(sw.route(output, output));
+	expected += command(output, output);
+    }
+    ASSERT_TRUE(sw.disconnect(5));
+    expected += command(5, 0);
+
+    ASSERT_EQ(expected, standIn.waitFor(expected.size()));
+    ASSERT_EQ(1u, standIn.getConnections());
+
+    ASSERT_FALSE(sw.route(0, 1));
+    ASSERT_FALSE(sw.route(1, 37));
+    ASSERT_FALSE(sw.disconnect(37));
+}
+
+TEST_F(ProjectorControlTest, applyRoutingTable) {
+
+    StandIn standIn(PORT + 1, StandIn::SILENT);
+    wcl::MatrixSwitch sw("127.0.0.1", 1, NULL, PORT + 1);
+
+    // A bad entry means nothing is sent
+    wcl::MatrixSwitch::RoutingTable bad;
+    bad[1] = 2;
+    bad[40] = 1;
+    ASSERT_FALSE(sw.applyRoutingTable(bad));
+
+    wcl::MatrixSwitch::RoutingTable table;
+    std::string expected;
+    for (unsigned output = 1; output <= wcl::MatrixSwitch::MAX_ID; output++) {
+	table[output] = output % 3 ? wcl::MatrixSwitch::MAX_ID + 1 - output : 0;
+	expected += command(output, table[output]);
+    }
+    ASSERT_TRUE(sw.applyRoutingTable(table));
+
+    ASSERT_EQ(expected, standIn.waitFor(expected.size()));
+    ASSERT_EQ(1u, standIn.getConnections());
+}
+
+TEST_F(ProjectorControlTest, reconnectsAfterHangUp) {
+
+    StandIn standIn(PORT + 2, StandIn::HANG_UP);
+    wcl::ConnectionPool pool(1000);
+    wcl::MatrixSwitch sw("127.0.0.1", 1, &pool, PORT + 2);
+
+    ASSERT_TRUE(sw.route(1, 2));
+    ASSERT_EQ(1u, standIn.waitForDisconnections(1));
+
+    ASSERT_TRUE(sw.route(3, 4));
+    std::string expected = command(2, 1) + command(4, 3);
+    ASSERT_EQ(expected, standIn.waitFor(expected.size()));
+    ASSERT_EQ(2u, standIn.getConnections());
+    ASSERT_EQ(1u, pool.getReconnectCount());
+}
+
+TEST_F(ProjectorControlTest, projectorGroup) {
+
+    StandIn a(PORT + 3, StandIn::ACKNOWLEDGE);
+    StandIn b(PORT + 4, StandIn::ACKNOWLEDGE);
+    StandIn c(PORT + 5, StandIn::ACKNOWLEDGE);
+    StandIn silent(PORT + 6, StandIn::SILENT);
+
+    wcl::ProjectorGroup group(NULL, 200);
+    for (unsigned i = 3; i <= 6; i++)
+	group.addProjector("127.0.0.1", PORT + i);
+
+    ASSERT_EQ(3u, group.turnOn());
+    ASSERT_TRUE(group.isAcknowledged(0));
+    ASSERT_TRUE(group.isAcknowledged(2));
+    ASSERT_FALSE(group.isAcknowledged(3));
+
+    ASSERT_EQ(3u, group.turnOff());
+    std::string expected((const char *)wcl::RemoteProjector::POWER_ON, 6);
+    expected.append((const char *)wcl::RemoteProjector::POWER_OFF, 6);
+    ASSERT_EQ(expected, b.waitFor(expected.size()));
+    ASSERT_EQ(1u, b.getConnections());
+
+    // No answer in time closes the connection, the next command reconnects
+    ASSERT_EQ(2u, silent.getConnections());
+}
+
+TEST_F(ProjectorControlTest, unreachableProjector) {
+
+    wcl::ProjectorGroup group(NULL, 200);
+    group.addProjector("127.0.0.1", PORT + 7);
+    ASSERT_EQ(0u, group.turnOn());
+    ASSERT_FALSE(group.isAcknowledged(0));
+}
+
+TEST_F(ProjectorControlTest, unreachableWriteIsNotRetried) {
+
+    wcl::ConnectionPool pool(200);
+    unsigned char c[6] = { 0 };
+    ASSERT_THROW(pool.write("127.0.0.1", PORT + 8, c, sizeof(c)), wcl::SocketException);
+    ASSERT_EQ(0u, pool.getConnectionCount());
+    ASSERT_EQ(0u, pool.getReconnectCount());
+}
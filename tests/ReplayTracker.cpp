@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <wcl/Exception.h>
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/DummyTrackedObject.h>
+#include <wcl/tracking/ReplayTracker.h>
+#include <wcl/tracking/TrackerRecorder.h>
+
+class ReplayTrackerTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        strcpy(path, "/tmp/replaytracker_testXXXXXX");
+        int fd = mkstemp(path);
+        ASSERT_NE(-1, fd);
+        close(fd);
+
+        // Ten frames of "a" moving along x, "b" standing still
+        wcl::DummyTracker dummy;
+        wcl::DummyTrackedObject *a = new wcl::DummyTrackedObject("a", wcl::Vector(0, 0, 0));
+        dummy.addTrackedObject(a);
+        dummy.addTrackedObject(new wcl::DummyTrackedObject("b", wcl::Vector(1, 2, 3)));
+
+        wcl::TrackerRecorder recorder(dummy, path);
+        recorder.setUnits(wcl::Tracker::CM);
+        for (unsigned i = 0; i < 10; i++) {
+            a->setPosition(wcl::Vector(i, 0, 0));
+            recorder.update();
+            usleep(2000);
+        }
+        ASSERT_EQ(10u, recorder.getFramesWritten());
+    }
+
+    virtual void TearDown() {
+        unlink(path);
+    }
+
+    char path[32];
+};
+
+TEST_F(ReplayTrackerTest, playsFramesInOrder) {
+
+    wcl::ReplayTracker replay(path, wcl::ReplayTracker::AS_FAST_AS_POSSIBLE);
+    ASSERT_EQ(10u, replay.getFrameCount());
+    ASSERT_EQ(2u, replay.getObjectCount());
+    ASSERT_GE(replay.getDuration(), 18000u);
+
+    wcl::TrackedObject *a = replay.getObject("a");
+    wcl::TrackedObject *b = replay.getObject("b");
+    ASSERT_TRUE(a != NULL);
+    ASSERT_TRUE(b != NULL);
+    ASSERT_TRUE(replay.getObject("c") == NULL);
+    ASSERT_FALSE(a->isVisible());
+
+    for (unsigned i = 0; i < 10; i++) {
+        ASSERT_FALSE(replay.isFinished());
+        replay.update();
+        ASSERT_TRUE(a->isVisible());
+        ASSERT_DOUBLE_EQ(i, a->getTranslation()[0]);
+        ASSERT_DOUBLE_EQ(3, b->getTranslation()[2]);
+    }
+    ASSERT_TRUE(replay.isFinished());
+    ASSERT_EQ(10u, a->getHistory().getSize());
+
+    // Recorded in cm
+    replay.setUnits(wcl::Tracker::MM);
+    replay.setLoop(true);
+    replay.update();
+    ASSERT_EQ(1u, replay.getPosition());
+    ASSERT_DOUBLE_EQ(30, b->getTranslation()[2]);
+    ASSERT_EQ(11u, a->getHistory().getSize());
+}
+
+TEST_F(ReplayTrackerTest, playsInRealTime) {
+
+    wcl::ReplayTracker replay(path);
+    replay.update();
+    ASSERT_EQ(1u, replay.getPosition());
+
+    uint64_t before = wcl::Tracker::getCurrentTime();
+    while (!replay.isFinished())
+        replay.update();
+    uint64_t elapsed = wcl::Tracker::getCurrentTime() - before;
+
+    ASSERT_GE(elapsed + 1000, replay.getDuration());
+    ASSERT_DOUBLE_EQ(9, replay.getObject("a")->getTranslation()[0]);
+}
+
+TEST_F(ReplayTrackerTest, stopsAtATruncatedFrame) {
+
+    FILE *f = fopen(path, "r+");
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    ASSERT_EQ(0, truncate(path, size - 10));
+
+    wcl::ReplayTracker replay(path);
+    ASSERT_EQ(9u, replay.getFrameCount());
+}
+
+TEST_F(ReplayTrackerTest, rejectsOtherFiles) {
+
+    FILE *f = fopen(path, "w");
+    fprintf(f, "not a recording, but long enough to have a header\n");
+    fclose(f);
+
+    ASSERT_THROW(wcl::ReplayTracker replay(path), wcl::Exception);
+    ASSERT_THROW(wcl::ReplayTracker replay("/nonexistent/recording"), wcl::Exception);
+}
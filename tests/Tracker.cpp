@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <wcl/Exception.h>
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/DummyTrackedObject.h>
+
+class TrackerTest : public ::testing::Test {
+};
+
+TEST_F(TrackerTest, handlesResolveToObjects) {
+
+    wcl::DummyTracker tracker;
+    wcl::DummyTrackedObject *a = new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3));
+    tracker.addTrackedObject(a);
+
+    wcl::Tracker::ObjectHandle ha = tracker.getHandle("a");
+    wcl::Tracker::ObjectHandle hb = tracker.getHandle("b");
+    ASSERT_NE(ha, hb);
+    ASSERT_EQ(ha, tracker.getHandle("a"));
+
+    ASSERT_EQ(a, tracker.get(ha));
+    ASSERT_TRUE(tracker.get(hb) == NULL);
+    ASSERT_TRUE(tracker.get(hb + 1) == NULL);
+
+    // Objects added later are picked up by existing handles
+    wcl::DummyTrackedObject *b = new wcl::DummyTrackedObject("b", wcl::Vector(4, 5, 6));
+    tracker.addTrackedObject(b);
+    ASSERT_EQ(b, tracker.get(hb));
+}
+
+namespace {
+
+/**
+ * Counts the lookups by name, and throws for names it doesn't know
+ */
+class CountingTracker : public wcl::DummyTracker {
+public:
+    CountingTracker() : lookups(0) {}
+
+    wcl::TrackedObject *getObject(std::string name) {
+        lookups++;
+        wcl::TrackedObject *object = wcl::DummyTracker::getObject(name);
+        if (!object)
+            throw wcl::Exception("no such object");
+        return object;
+    }
+
+    unsigned lookups;
+};
+
+}
+
+TEST_F(TrackerTest, unresolvedHandlesWaitForNewObjects) {
+
+    CountingTracker tracker;
+    tracker.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3)));
+
+    wcl::Tracker::ObjectHandle hb = tracker.getHandle("b");
+    unsigned lookups = tracker.lookups;
+    for (unsigned i = 0; i < 100; i++)
+        ASSERT_TRUE(tracker.get(hb) == NULL);
+    ASSERT_EQ(lookups, tracker.lookups);
+
+    // An added object, even under another name, looks the handle up again
+    tracker.addTrackedObject(new wcl::DummyTrackedObject("c", wcl::Vector(1, 2, 3)));
+    ASSERT_TRUE(tracker.get(hb) == NULL);
+    ASSERT_EQ(lookups + 1, tracker.lookups);
+
+    wcl::DummyTrackedObject *b = new wcl::DummyTrackedObject("b", wcl::Vector(4, 5, 6));
+    tracker.addTrackedObject(b);
+    ASSERT_EQ(b, tracker.get(hb));
+    ASSERT_EQ(b, tracker.get(hb));
+    ASSERT_EQ(lookups + 2, tracker.lookups);
+}
+
+TEST_F(TrackerTest, iteratesByIndex) {
+
+    wcl::DummyTracker tracker;
+    ASSERT_EQ(0u, tracker.getObjectCount());
+
+    tracker.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3)));
+    tracker.addTrackedObject(new wcl::DummyTrackedObject("b", wcl::Vector(4, 5, 6)));
+
+    ASSERT_EQ(2u, tracker.getObjectCount());
+    ASSERT_EQ("a", tracker.getObjectAt(0)->getName());
+    ASSERT_EQ("b", tracker.getObjectAt(1)->getName());
+    ASSERT_TRUE(tracker.getObjectAt(2) == NULL);
+}
+
+namespace {
+
+/**
+ * Only lists its objects, as trackers from outside the library may
+ */
+class ListingTracker : public wcl::Tracker {
+public:
+    void update() {}
+    wcl::TrackedObject *getObject(std::string) { return NULL; }
+    std::vector<wcl::TrackedObject *> getAllObjects() { return objects; }
+    void setUnits(Units) {}
+
+    std::vector<wcl::TrackedObject *> objects;
+};
+
+}
+
+TEST_F(TrackerTest, iteratesThroughAllObjectsByDefault) {
+
+    wcl::DummyTrackedObject a("a", wcl::Vector(1, 2, 3));
+    wcl::DummyTrackedObject b("b", wcl::Vector(4, 5, 6));
+    ListingTracker tracker;
+    ASSERT_EQ(0u, tracker.getObjectCount());
+    ASSERT_TRUE(tracker.getObjectAt(0) == NULL);
+
+    tracker.objects.push_back(&a);
+    tracker.objects.push_back(&b);
+    ASSERT_EQ(2u, tracker.getObjectCount());
+    ASSERT_EQ(&a, tracker.getObjectAt(0));
+    ASSERT_EQ(&b, tracker.getObjectAt(1));
+    ASSERT_TRUE(tracker.getObjectAt(2) == NULL);
+
+    // Listed objects are found through their handles too
+    ASSERT_EQ(&b, tracker.get(tracker.getHandle("b")));
+}
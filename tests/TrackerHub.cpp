@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <math.h>
+#include <unistd.h>
+
+#include <wcl/Exception.h>
+#include <wcl/tracking/DummyTracker.h>
+#include <wcl/tracking/DummyTrackedObject.h>
+#include <wcl/tracking/TrackerHub.h>
+
+class TrackerHubTest : public ::testing::Test {
+};
+
+/**
+ * A tracker whose device has gone away
+ */
+class FailingTracker : public wcl::Tracker {
+public:
+    void update() { throw wcl::Exception("no device"); }
+    wcl::TrackedObject *getObject(std::string) { return NULL; }
+    std::vector<wcl::TrackedObject *> getAllObjects() { return std::vector<wcl::TrackedObject *>(); }
+    void setUnits(Units) {}
+};
+
+/**
+ * Update the hub until it has the named object, or give up after a second
+ */
+static wcl::TrackedObject *waitFor(wcl::TrackerHub &hub, const std::string &name) {
+    for (unsigned i = 0; i < 1000; i++) {
+        hub.update();
+        wcl::TrackedObject *object = hub.getObject(name);
+        if (object)
+            return object;
+        usleep(1000);
+    }
+    return NULL;
+}
+
+TEST_F(TrackerHubTest, mergesTrackersWithPrefixes) {
+
+    wcl::DummyTracker first;
+    first.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3)));
+    wcl::DummyTracker second;
+    second.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(4, 5, 6)));
+
+    wcl::TrackerHub hub;
+    EXPECT_EQ(0u, hub.addTracker(first, wcl::Tracker::MM, "first/"));
+    EXPECT_EQ(1u, hub.addTracker(second, wcl::Tracker::MM, "second/"));
+    EXPECT_EQ(2u, hub.getTrackerCount());
+
+    wcl::TrackedObject *a = waitFor(hub, "first/a");
+    wcl::TrackedObject *b = waitFor(hub, "second/a");
+    ASSERT_TRUE(a != NULL);
+    ASSERT_TRUE(b != NULL);
+    EXPECT_EQ(2u, hub.getObjectCount());
+
+    EXPECT_TRUE(a->isVisible());
+    EXPECT_NEAR(1, a->getTranslation()[0], 1e-9);
+    EXPECT_NEAR(6, b->getTranslation()[2], 1e-9);
+    EXPECT_GT(a->getTimestamp(), 0u);
+    EXPECT_GT(hub.getUpdateCount(0), 0u);
+    EXPECT_EQ(0u, hub.getErrorCount(0));
+}
+
+TEST_F(TrackerHubTest, appliesUnitsAndCalibration) {
+
+    wcl::DummyTracker dummy;
+    dummy.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(1, 2, 3)));
+
+    // A quarter turn about z, then up 100mm
+    wcl::SMatrix calibration(4);
+    calibration[0][1] = -1;
+    calibration[1][0] = 1;
+    calibration[2][2] = 1;
+    calibration[3][3] = 1;
+    calibration[2][3] = 100;
+
+    wcl::TrackerHub hub;
+    unsigned index = hub.addTracker(dummy, wcl::Tracker::CM);
+    hub.setCalibration(index, calibration);
+    EXPECT_NEAR(100, hub.getCalibration(index)[2][3], 1e-9);
+
+    wcl::TrackedObject *a = waitFor(hub, "a");
+    ASSERT_TRUE(a != NULL);
+    wcl::Vector p = a->getTranslation();
+    EXPECT_NEAR(-20, p[0], 1e-9);
+    EXPECT_NEAR(10, p[1], 1e-9);
+    EXPECT_NEAR(130, p[2], 1e-9);
+
+    wcl::Quaternion q = a->getOrientation();
+    wcl::Quaternion expected = wcl::Quaternion(cos(M_PI / 4), 0, 0, sin(M_PI / 4)) *
+        dummy.getObject("a")->getOrientation();
+    EXPECT_NEAR(expected.w, q.w, 1e-9);
+    EXPECT_NEAR(expected.x, q.x, 1e-9);
+    EXPECT_NEAR(expected.y, q.y, 1e-9);
+    EXPECT_NEAR(expected.z, q.z, 1e-9);
+
+    EXPECT_THROW(hub.setCalibration(1, calibration), wcl::Exception);
+}
+
+TEST_F(TrackerHubTest, keepsObjectsUntilUpdated) {
+
+    wcl::DummyTracker dummy;
+    dummy.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(0, 0, 0)));
+
+    wcl::TrackerHub hub;
+    hub.addTracker(dummy, wcl::Tracker::MM);
+    wcl::TrackedObject *a = waitFor(hub, "a");
+    ASSERT_TRUE(a != NULL);
+
+    uint64_t timestamp = a->getTimestamp();
+    usleep(20000);
+    EXPECT_EQ(timestamp, a->getTimestamp());
+    hub.update();
+    EXPECT_GT(a->getTimestamp(), timestamp);
+}
+
+TEST_F(TrackerHubTest, survivesFailingTracker) {
+
+    FailingTracker failing;
+    wcl::DummyTracker dummy;
+    dummy.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(0, 0, 0)));
+    dummy.addTrackedObject(new wcl::DummyTrackedObject("b", wcl::Vector(0, 0, 0)));
+    wcl::DummyTracker clash;
+    clash.addTrackedObject(new wcl::DummyTrackedObject("a", wcl::Vector(1, 1, 1)));
+
+    wcl::TrackerHub hub;
+    unsigned bad = hub.addTracker(failing, wcl::Tracker::MM);
+    hub.addTracker(dummy, wcl::Tracker::MM);
+    hub.addTracker(clash, wcl::Tracker::MM);
+
+    ASSERT_TRUE(waitFor(hub, "b") != NULL);
+    for (unsigned i = 0; i < 1000 && hub.getUpdateCount(2) == 0; i++)
+        usleep(1000);
+    hub.update();
+
+    // The second "a" is ignored rather than replacing the first
+    EXPECT_EQ(2u, hub.getObjectCount());
+    EXPECT_NEAR(0, hub.getObject("a")->getTranslation()[0], 1e-9);
+
+    EXPECT_GT(hub.getErrorCount(bad), 0u);
+    EXPECT_EQ(0u, hub.getUpdateCount(bad));
+}
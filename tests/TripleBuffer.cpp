@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <wcl/util/Thread.h>
+#include <wcl/util/TripleBuffer.h>
+
+class TripleBufferTest : public ::testing::Test {
+};
+
+TEST_F(TripleBufferTest, handsOverNewestValue) {
+
+    wcl::TripleBuffer<int> buffer;
+    buffer.reset(0);
+    ASSERT_FALSE(buffer.isFresh());
+    ASSERT_FALSE(buffer.take());
+
+    buffer.getBack() = 1;
+    buffer.publish();
+    buffer.getBack() = 2;
+    buffer.publish();
+    ASSERT_TRUE(buffer.isFresh());
+
+    // Only the newest value is seen, and only once
+    ASSERT_TRUE(buffer.take());
+    ASSERT_EQ(2, buffer.getFront());
+    ASSERT_FALSE(buffer.isFresh());
+    ASSERT_FALSE(buffer.take());
+    ASSERT_EQ(2, buffer.getFront());
+
+    // The writer never fills the buffer the reader holds
+    for (int i = 3; i < 10; i++) {
+        ASSERT_NE(&buffer.getFront(), &buffer.getBack());
+        buffer.getBack() = i;
+        buffer.publish();
+    }
+    ASSERT_EQ(2, buffer.getFront());
+    ASSERT_TRUE(buffer.take());
+    ASSERT_EQ(9, buffer.getFront());
+}
+
+namespace {
+
+struct Value {
+    unsigned a;
+    unsigned b;
+};
+
+class Writer : public wcl::Thread {
+public:
+    Writer(wcl::TripleBuffer<Value> &buffer, const unsigned count) : buffer(buffer), count(count) {}
+
+    void run() {
+        for (unsigned i = 1; i <= count; i++) {
+            Value &v = buffer.getBack();
+            v.a = i;
+            v.b = i;
+            buffer.publish();
+        }
+    }
+
+    wcl::TripleBuffer<Value> &buffer;
+    unsigned count;
+};
+
+}
+
+TEST_F(TripleBufferTest, readsFromAnotherThread) {
+
+    const unsigned COUNT = 200000;
+    Value zero = {0, 0};
+    wcl::TripleBuffer<Value> buffer;
+    buffer.reset(zero);
+
+    Writer writer(buffer, COUNT);
+    writer.start();
+
+    unsigned last = 0;
+    unsigned torn = 0;
+    unsigned backwards = 0;
+    while (last < COUNT) {
+        if (!buffer.take())
+            continue;
+        const Value &v = buffer.getFront();
+        if (v.a != v.b)
+            torn++;
+        if (v.a <= last)
+            backwards++;
+        last = v.a;
+    }
+
+    writer.join();
+    ASSERT_EQ(0u, torn);
+    ASSERT_EQ(0u, backwards);
+}
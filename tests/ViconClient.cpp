@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <wcl/Exception.h>
+#include <wcl/tracking/ViconClient.h>
+#include <wcl/tracking/ViconServer.h>
+
+#define PORT 55580
+
+/**
+ * Call update until the client has applied a frame sent after the given
+ * number of frames, or give up after two seconds
+ */
+static bool waitForFrame(wcl::ViconClient &client, const uint64_t received)
+{
+    for (unsigned i = 0; i < 200; i++) {
+	client.update();
+	if (client.getFramesReceived() > received && client.getTimestamp() > 0)
+	    return true;
+	usleep(10000);
+    }
+    return false;
+}
+
+class ViconClientTest : public ::testing::Test {
+};
+
+TEST_F(ViconClientTest, readsChannelsAndObjects) {
+
+    wcl::ViconServer server(PORT, 200);
+    server.addMarker("Wand");
+    server.addSixDOF("Table");
+    server.start();
+
+    wcl::ViconClient client("127.0.0.1", PORT, 1000);
+
+    std::vector<std::string> channels = client.getChannelNames();
+    ASSERT_EQ(11u, channels.size());
+    ASSERT_EQ("Time", channels[0]);
+    ASSERT_EQ("Wand <P-X>", channels[1]);
+    ASSERT_EQ("Table <T-Z>", channels[10]);
+
+    ASSERT_EQ(2u, client.objects.size());
+    ASSERT_EQ(wcl::POSITION, client.objects[0].getType());
+    ASSERT_EQ(wcl::SIX_DOF, client.objects[1].getType());
+    ASSERT_TRUE(client.getObject("Table") != NULL);
+    ASSERT_TRUE(client.getObject("Chair") == NULL);
+}
+
+TEST_F(ViconClientTest, updateAppliesNewestFrame) {
+
+    wcl::ViconServer server(PORT + 1, 200);
+    server.addMarker("Wand");
+    server.addSixDOF("Table");
+    server.start();
+
+    wcl::ViconClient client("127.0.0.1", PORT + 1, 1000);
+
+    // Nothing may have arrived yet, but update never blocks
+    client.update();
+
+    ASSERT_TRUE(server.setMarker("Wand", 1, 2, 3, false));
+    ASSERT_TRUE(server.setSixDOF("Table", 0, 0, 0, 10, 20, 30));
+    ASSERT_FALSE(server.setMarker("Table", 1, 2, 3));
+
+    // Skip frames that may have been sent before the poses were set
+    uint64_t received = server.getFramesSent();
+    ASSERT_TRUE(waitForFrame(client, received + 1));
+
+    wcl::Vector wand = client.getObject("Wand")->getTranslation();
+    ASSERT_DOUBLE_EQ(1, wand[0]);
+    ASSERT_DOUBLE_EQ(2, wand[1]);
+    ASSERT_DOUBLE_EQ(3, wand[2]);
+    ASSERT_FALSE(client.getObject("Wand")->isVisible());
+
+    wcl::Vector table = client.getObject("Table")->getTranslation();
+    ASSERT_DOUBLE_EQ(10, table[0]);
+    ASSERT_DOUBLE_EQ(30, table[2]);
+    ASSERT_GT(client.getFrameTime(), 0);
+}
+
+TEST_F(ViconClientTest, skipsFramesBetweenUpdates) {
+
+    wcl::ViconServer server(PORT + 2, 1000);
+    server.addMarker("Wand");
+    server.start();
+
+    wcl::ViconClient client("127.0.0.1", PORT + 2, 1000);
+    ASSERT_TRUE(waitForFrame(client, 0));
+
+    usleep(100000);
+    uint64_t before = client.getFramesReceived();
+    ASSERT_GT(before, 10u);
+    client.update();
+    ASSERT_GT(client.getFramesSkipped(), 0u);
+}
+
+TEST_F(ViconClientTest, updateThrowsOnceServerIsGone) {
+
+    wcl::ViconServer *server = new wcl::ViconServer(PORT + 3, 100);
+    server->addMarker("Wand");
+    server->start();
+
+    wcl::ViconClient client("127.0.0.1", PORT + 3, 1000);
+    ASSERT_TRUE(waitForFrame(client, 0));
+    delete server;
+
+    bool threw = false;
+    for (unsigned i = 0; i < 200 && !threw; i++) {
+	try {
+	    client.update();
+	    usleep(10000);
+	} catch (wcl::Exception &) {
+	    threw = true;
+	}
+    }
+    ASSERT_TRUE(threw);
+}
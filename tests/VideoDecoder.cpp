@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+
+#include <stdlib.h>
+#include <vector>
+
+#include <wcl/video/MJPEGEncoder.h>
+#include <wcl/video/VideoDecoder.h>
+
+class VideoDecoderTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        // A flat grey JPEG image, the luma of every pixel is close to 128
+        std::vector<unsigned char> rgb(WIDTH * HEIGHT * 3, 128);
+        wcl::MJPEGEncoder encoder(WIDTH, HEIGHT, wcl::Camera::RGB8);
+        unsigned size;
+        const unsigned char *jpeg = encoder.encode(&rgb[0], size);
+        image.assign(jpeg, jpeg + size);
+    }
+
+    void expectGrey(const unsigned char *luma) {
+        ASSERT_TRUE(luma != NULL);
+        for (unsigned i = 0; i < (unsigned)(WIDTH * HEIGHT); i += 97)
+            ASSERT_NEAR(128, luma[i], 4);
+    }
+
+    enum { WIDTH = 64, HEIGHT = 48 };
+    std::vector<unsigned char> image;
+};
+
+TEST_F(VideoDecoderTest, decodesStreamsToNativeFormat) {
+
+    wcl::VideoDecoder decoder(WIDTH, HEIGHT, wcl::VideoDecoder::MJPEG, false);
+    decoder.setOutputFormat(wcl::VideoDecoder::NATIVE);
+
+    for (unsigned i = 0; i < 3; i++) {
+        decoder.nextFrame(&image[0], image.size());
+        expectGrey(decoder.getFrame());
+    }
+}
+
+TEST_F(VideoDecoderTest, decodesStreamsToLuma) {
+
+    wcl::VideoDecoder decoder(WIDTH, HEIGHT, wcl::VideoDecoder::MJPEG, false);
+    decoder.setOutputFormat(wcl::VideoDecoder::GRAY8);
+
+    decoder.nextFrame(&image[0], image.size());
+    expectGrey(decoder.getFrame());
+    ASSERT_EQ((unsigned)(WIDTH * HEIGHT), decoder.getFrameSize());
+}